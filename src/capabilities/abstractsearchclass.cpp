@@ -22,6 +22,11 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
 #include <QtCore/QHash>
+#include <QtCore/QThread>
+
+#include "jobcheckpoint.h"
+
+#include <algorithm>
 
 #include "abstractsearchclass.h"
 
@@ -29,8 +34,29 @@ AbstractSearchClass::AbstractSearchClass(QObject* parent)
     : QObject(parent)
     , m_interrupt(false)
 {
-    m_threadpool = QThreadPool::globalInstance();
-    m_threadpool->setMaxThreadCount(qApp->instance()->property("threads").toInt());
+    m_threadpool = m_context.Executor();
+    m_threadpool->setMaxThreadCount(m_context.Threads());
+}
+
+void AbstractSearchClass::setExecutionContext(const ExecutionContext& context)
+{
+    m_context = context;
+    m_threadpool = m_context.Executor();
+    m_threadpool->setMaxThreadCount(m_context.Threads());
+    if (m_model)
+        m_model->setExecutionContext(ThreadContext());
+}
+
+ExecutionContext AbstractSearchClass::ThreadContext() const
+{
+    return m_context.Split(m_context.Threads());
+}
+
+qint64 AbstractSearchClass::RandomSeed()
+{
+    if (!m_controller.contains("RandomSeed"))
+        m_controller["RandomSeed"] = m_context.hasSeed() ? qint64(m_context.Seed()) : QDateTime::currentMSecsSinceEpoch();
+    return m_controller["RandomSeed"].toVariant().toLongLong();
 }
 
 AbstractSearchClass::~AbstractSearchClass()
@@ -44,6 +70,17 @@ void AbstractSearchClass::Interrupt()
     m_threadpool->clear();
 }
 
+void AbstractSearchClass::WaitForThreads()
+{
+    QCoreApplication* app = QCoreApplication::instance();
+    if (!app || QThread::currentThread() != app->thread() || !app->inherits("QGuiApplication")) {
+        m_threadpool->waitForDone();
+        return;
+    }
+    while (!m_threadpool->waitForDone(50))
+        QCoreApplication::processEvents();
+}
+
 void AbstractSearchClass::ExportResults(const QString& filename)
 {
     QJsonObject toplevel;
@@ -88,12 +125,43 @@ QHash<int, Pair> AbstractSearchClass::DemandCalc()
 {
     QMutexLocker lock(&mutex);
 
-    if (m_batch.isEmpty())
+    /* A cancelled job hands out nothing more, every thread stops after its current batch */
+    if (m_batch.isEmpty() || m_context.isCancelled())
         return QHash<int, Pair>();
     else
         return m_batch.dequeue();
 }
 
+void AbstractSearchClass::Requeue(const QHash<int, Pair>& batch)
+{
+    QMutexLocker lock(&mutex);
+    m_batch.enqueue(batch);
+}
+
+int AbstractSearchClass::Queued()
+{
+    QMutexLocker lock(&mutex);
+    return m_batch.size();
+}
+
+void AbstractSearchClass::SkipCompleted(const BatchResults& done)
+{
+    QMutexLocker lock(&mutex);
+    QQueue<QHash<int, Pair>> remaining;
+    while (!m_batch.isEmpty()) {
+        const QHash<int, Pair> batch = m_batch.dequeue();
+        const QList<int> keys = batch.keys();
+        if (keys.isEmpty() || !done.blocks.contains(*std::min_element(keys.begin(), keys.end()))) {
+            remaining.enqueue(batch);
+            continue;
+        }
+        /* Only the dependent tables are made per batch, the independent one may be shared */
+        for (const Pair& pair : batch)
+            delete pair.second;
+    }
+    m_batch = remaining;
+}
+
 void AbstractSearchClass::clear()
 {
     while (!m_batch.isEmpty()) {
@@ -33,6 +33,9 @@
 typedef QPair<QPointer<DataTable>, QPointer<DataTable>> Pair;
 
 class AbstractModel;
+class JobCheckpoint;
+class WorkerPool;
+struct BatchResults;
 
 class AbstractSearchThread : public QObject, public QRunnable {
     Q_OBJECT
@@ -44,7 +47,7 @@ public:
         setAutoDelete(false);
     }
     inline ~AbstractSearchThread() { m_model.clear(); }
-    inline void setModel(const QSharedPointer<AbstractModel> model) { m_model = model->Clone(false); }
+    inline void setModel(const QSharedPointer<AbstractModel> model) { m_model = model->Replica(); }
     inline void setController(const QJsonObject& controller) { m_controller = controller; }
     inline QHash<int, QJsonObject> Models() const { return m_models; }
 
@@ -71,8 +74,13 @@ public:
     virtual inline void setModel(const QSharedPointer<AbstractModel> model)
     {
         m_model = model->Clone(false);
+        m_model->setExecutionContext(ThreadContext());
     }
 
+    /*! \brief Budget, executor and cancellation of the job; set before setModel() */
+    void setExecutionContext(const ExecutionContext& context);
+    inline const ExecutionContext& Context() const { return m_context; }
+
     virtual bool Run() = 0;
     inline void setController(const QJsonObject& controller) { m_controller = controller; }
 
@@ -86,6 +94,16 @@ public:
 
     QHash<int, Pair> DemandCalc();
 
+    /*! \brief Give a batch taken with DemandCalc() back to the queue */
+    void Requeue(const QHash<int, Pair>& batch);
+    int Queued();
+
+    /*! \brief Refit the batch queue on these worker processes first, the threads only take what is left */
+    inline void setWorkerPool(WorkerPool* pool) { m_workers = pool; }
+
+    /*! \brief Record finished batches here, and skip those a resumed checkpoint already holds */
+    inline void setCheckpoint(JobCheckpoint* checkpoint) { m_checkpoint = checkpoint; }
+
     virtual void clear();
 public slots:
     virtual void Interrupt();
@@ -100,8 +118,28 @@ protected:
     QList<QList<QPointF>> m_series;
     bool m_interrupt;
     QQueue<QHash<int, Pair>> m_batch;
+    WorkerPool* m_workers = nullptr;
+    JobCheckpoint* m_checkpoint = nullptr;
+    ExecutionContext m_context;
 
     virtual QJsonObject Controller() const { return m_controller; }
+
+    /*! \brief Share of the budget for each model that is refitted by one of the threads of this search */
+    ExecutionContext ThreadContext() const;
+
+    /*! \brief "RandomSeed" of the controller; the seed of the context or the time if there is none, recorded */
+    qint64 RandomSeed();
+
+    /*! \brief Block until all jobs in the thread pool are done
+     *
+     * Sleeps on the pool instead of polling it. Only the main thread of the GUI handles its
+     * events (progress, interrupt button) in between; workers and headless runs simply block.
+     */
+    void WaitForThreads();
+
+    /*! \brief Take the batches that were finished elsewhere out of the queue, matched by their first step */
+    void SkipCompleted(const BatchResults& done);
+
     QMutex mutex;
     qint64 m_multicore_time = 0;
 
@@ -173,7 +173,7 @@ void GlobalSearch::ConvertList(const QVector<QVector<double>>& full_list)
     m_results.clear();
 
     QVector<int> position(full_list.size(), 0);
-    int maxthreads = qApp->instance()->property("threads").toInt();
+    int maxthreads = m_context.Threads();
     m_allow_break = false;
 
     QVector<double> parameter = m_model->AllParameter();
@@ -220,14 +220,13 @@ void GlobalSearch::ConvertList(const QVector<QVector<double>>& full_list)
         QPointer<SearchBatch> thread = new SearchBatch(this);
         thread->setController(m_controller);
         connect(thread, SIGNAL(IncrementProgress(int)), this, SIGNAL(IncrementProgress(int)));
-        connect(this, &GlobalSearch::InterruptAll, thread, &SearchBatch::Interrupt);
+        connect(this, &GlobalSearch::InterruptAll, thread, &SearchBatch::Interrupt, Qt::DirectConnection);
         thread->setModel(m_model);
         threads << thread;
         m_threadpool->start(thread);
     }
 
-    while (m_threadpool->activeThreadCount())
-        QCoreApplication::processEvents();
+    WaitForThreads();
 
     m_multicore_time = QDateTime::currentMSecsSinceEpoch() - t0;
 
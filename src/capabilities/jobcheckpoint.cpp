@@ -0,0 +1,255 @@
+/*
+ * SupraFit - checkpoints of long running statistics jobs
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "src/core/fitcache.h"
+#include "src/core/models/AbstractModel.h"
+
+#include <QtCore/QCborArray>
+#include <QtCore/QCborMap>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#include <algorithm>
+
+#include "workerpool.h"
+
+#include "jobcheckpoint.h"
+
+void BatchResults::clear()
+{
+    blocks.clear();
+    parameters.clear();
+    models.clear();
+}
+
+void BatchResults::addBlock(QVector<int> steps)
+{
+    if (steps.isEmpty())
+        return;
+    std::sort(steps.begin(), steps.end());
+    blocks.insert(steps.first(), steps);
+}
+
+void BatchResults::merge(const BatchResults& other)
+{
+    for (auto block = other.blocks.cbegin(); block != other.blocks.cend(); ++block)
+        blocks.insert(block.key(), block.value());
+    for (auto step = other.parameters.cbegin(); step != other.parameters.cend(); ++step)
+        parameters.insert(step.key(), step.value());
+    for (auto model = other.models.cbegin(); model != other.models.cend(); ++model)
+        models.insert(model.key(), model.value());
+}
+
+QMap<int, ParameterAccumulator> BatchResults::Accumulate(const QSharedPointer<AbstractModel>& model, bool keep_raw) const
+{
+    /* A replica carries the tables of one refit at a time, exactly like the model of a MonteCarloBatch */
+    QSharedPointer<AbstractModel> replica = model->Replica();
+    ParameterAccumulator empty;
+    empty.setModel(replica.data(), keep_raw);
+
+    QMap<int, ParameterAccumulator> accumulators;
+    for (auto block = blocks.cbegin(); block != blocks.cend(); ++block) {
+        ParameterAccumulator& accumulator = accumulators.insert(block.key(), empty).value();
+        for (int step : block.value()) {
+            const QPair<Eigen::MatrixXd, Eigen::MatrixXd> parameter = parameters.value(step);
+            replica->GlobalTable()->setTable(parameter.first);
+            replica->LocalTable()->setTable(parameter.second);
+            accumulator.add(replica.data());
+        }
+    }
+    return accumulators;
+}
+
+JobCheckpoint::JobCheckpoint(const QString& path, qint64 interval_msecs)
+    : m_path(path)
+    , m_interval(interval_msecs)
+{
+}
+
+bool JobCheckpoint::isEnabled()
+{
+    return qApp->instance()->property("Checkpoint").toBool();
+}
+
+QByteArray JobCheckpoint::Key(AbstractModel* model, const QJsonObject& job)
+{
+    QJsonObject settings = job;
+    settings.remove("timestamp");
+    settings.remove("Repeat");
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QByteArrayLiteral("SupraFit checkpoint 1"));
+    hash.addData(FitCache::Key(model));
+    hash.addData(QJsonDocument(settings).toJson(QJsonDocument::Compact));
+    return hash.result();
+}
+
+QString JobCheckpoint::Directory()
+{
+    const QString directory = qApp->instance()->property("CheckpointDir").toString();
+    if (directory.isEmpty())
+        return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/checkpoints";
+    return directory;
+}
+
+QString JobCheckpoint::Path(AbstractModel* model, const QJsonObject& job)
+{
+    return Directory() + "/" + QString::fromLatin1(Key(model, job).toHex()) + ".checkpoint";
+}
+
+int JobCheckpoint::RemoveStale(const QString& directory, qint64 max_age_secs)
+{
+    const QDateTime limit = QDateTime::currentDateTime().addSecs(-max_age_secs);
+    int removed = 0;
+    for (const QFileInfo& info : QDir(directory).entryInfoList(QStringList() << "*.checkpoint", QDir::Files))
+        if (info.lastModified() < limit && QFile::remove(info.absoluteFilePath()))
+            ++removed;
+    return removed;
+}
+
+bool JobCheckpoint::Load()
+{
+    QMutexLocker locker(&m_mutex);
+
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    const QCborMap content = QCborValue::fromCbor(file.readAll()).toMap();
+    if (content[QStringLiteral("version")].toInteger() != 1)
+        return false;
+
+    m_restored.clear();
+    for (const QCborValue& value : content[QStringLiteral("blocks")].toArray()) {
+        QVector<int> steps;
+        for (const QCborValue& entry : value.toArray()) {
+            const QCborMap step = entry.toMap();
+            const int index = int(step[QStringLiteral("step")].toInteger());
+            steps << index;
+            m_restored.parameters.insert(index, qMakePair(WorkerProtocol::ToMatrix(step[QStringLiteral("global")]), WorkerProtocol::ToMatrix(step[QStringLiteral("local")])));
+            if (step.contains(QStringLiteral("model")))
+                m_restored.models.insert(index, step[QStringLiteral("model")].toJsonValue().toObject());
+        }
+        m_restored.addBlock(steps);
+    }
+    m_has_seed = content.contains(QStringLiteral("seed"));
+    m_seed = content[QStringLiteral("seed")].toInteger();
+    m_results = m_restored;
+    m_resumed = true;
+    return true;
+}
+
+void JobCheckpoint::setSeed(qint64 seed)
+{
+    QMutexLocker locker(&m_mutex);
+    m_seed = seed;
+    m_has_seed = true;
+}
+
+void JobCheckpoint::Record(const BatchResults& batch)
+{
+    Snapshot snapshot;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_results.merge(batch);
+        ++m_generation;
+
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        if (now - m_last_write < m_interval)
+            return;
+        m_last_write = now;
+        snapshot = TakeSnapshot();
+    }
+    Write(snapshot);
+}
+
+void JobCheckpoint::Flush()
+{
+    Snapshot snapshot;
+    {
+        QMutexLocker locker(&m_mutex);
+        snapshot = TakeSnapshot();
+    }
+    Write(snapshot);
+}
+
+void JobCheckpoint::Remove()
+{
+    QMutexLocker locker(&m_write_mutex);
+    QFile::remove(m_path);
+    m_removed = true;
+}
+
+JobCheckpoint::Snapshot JobCheckpoint::TakeSnapshot() const
+{
+    Snapshot snapshot;
+    snapshot.results = m_results;
+    snapshot.seed = m_seed;
+    snapshot.has_seed = m_has_seed;
+    snapshot.generation = m_generation;
+    return snapshot;
+}
+
+void JobCheckpoint::Write(const Snapshot& snapshot)
+{
+    QMutexLocker locker(&m_write_mutex);
+    /* Nothing new since the last write, or a newer snapshot got here first */
+    if (m_removed || snapshot.generation <= m_written)
+        return;
+    if (!QDir().mkpath(QFileInfo(m_path).absolutePath()))
+        return;
+
+    const BatchResults& results = snapshot.results;
+    QCborArray blocks;
+    for (const QVector<int>& steps : results.blocks) {
+        QCborArray block;
+        for (int index : steps) {
+            const QPair<Eigen::MatrixXd, Eigen::MatrixXd> parameter = results.parameters.value(index);
+            QCborMap step;
+            step[QStringLiteral("step")] = index;
+            step[QStringLiteral("global")] = WorkerProtocol::FromMatrix(parameter.first);
+            step[QStringLiteral("local")] = WorkerProtocol::FromMatrix(parameter.second);
+            if (results.models.contains(index))
+                step[QStringLiteral("model")] = QCborValue::fromJsonValue(results.models.value(index));
+            block << step;
+        }
+        blocks << block;
+    }
+
+    QCborMap content;
+    content[QStringLiteral("version")] = 1;
+    if (snapshot.has_seed)
+        content[QStringLiteral("seed")] = snapshot.seed;
+    content[QStringLiteral("blocks")] = blocks;
+
+    /* Renamed into place, a node preempted while writing leaves the previous checkpoint intact */
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    file.write(content.toCborValue().toCbor());
+    if (file.commit())
+        m_written = snapshot.generation;
+}
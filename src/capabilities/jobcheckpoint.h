@@ -0,0 +1,135 @@
+/*
+ * SupraFit - checkpoints of long running statistics jobs
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "src/core/streamingstatistics.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMap>
+#include <QtCore/QMutex>
+#include <QtCore/QPair>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include <Eigen/Dense>
+
+class AbstractModel;
+
+/*! \brief Refits of whole batches, done outside the thread pool of a search
+ *
+ * Holds the exact global and local parameters of every step (and the refitted model, if it is stored),
+ * grouped by batch. Accumulate() sums them per batch in step order, which gives the same summaries as
+ * the MonteCarloBatch that would have refitted them in this process.
+ */
+struct BatchResults {
+    /* First step of the batch -> all steps of the batch */
+    QMap<int, QVector<int>> blocks;
+    QHash<int, QPair<Eigen::MatrixXd, Eigen::MatrixXd>> parameters;
+    QHash<int, QJsonObject> models;
+
+    inline int Count() const { return parameters.size(); }
+    void clear();
+
+    /*! \brief Add a finished batch; the parameters of all \a steps must have been inserted */
+    void addBlock(QVector<int> steps);
+    void merge(const BatchResults& other);
+
+    QMap<int, ParameterAccumulator> Accumulate(const QSharedPointer<AbstractModel>& model, bool keep_raw) const;
+};
+
+/*! \brief Side file with the finished batches of a Monte Carlo or cross validation run
+ *
+ * Every finished batch is recorded; the file is rewritten at most every "CheckpointInterval" seconds
+ * and once more when the run is interrupted. A run that completes removes it, and checkpoints that
+ * were not resumed within "CheckpointMaxAge" days are removed when the next one is opened. The random numbers of
+ * a step only depend on the seed and the step index, so the seed is all there is to store of the
+ * random state - a resumed run queues the remaining batches and draws exactly the data the first run
+ * would have drawn.
+ *
+ * The file is found by Key(): the content of the model (as for the fit cache) and the job settings, so
+ * a resume only picks up a checkpoint of the very same job.
+ */
+class JobCheckpoint {
+public:
+    explicit JobCheckpoint(const QString& path, qint64 interval_msecs = 60000);
+
+    /*! \brief Application property "Checkpoint" is set */
+    static bool isEnabled();
+
+    /*! \brief "CheckpointDir", the cache location if it is not set */
+    static QString Directory();
+
+    /*! \brief Checkpoint file of \a job on \a model below Directory() */
+    static QString Path(AbstractModel* model, const QJsonObject& job);
+    static QByteArray Key(AbstractModel* model, const QJsonObject& job);
+
+    /*! \brief Read the file, false if there is none or it is unreadable */
+    bool Load();
+    inline bool Resumed() const { return m_resumed; }
+    inline QString FilePath() const { return m_path; }
+
+    inline bool hasSeed() const { return m_has_seed; }
+    inline qint64 Seed() const { return m_seed; }
+    void setSeed(qint64 seed);
+
+    /*! \brief Batches finished in the run that was resumed */
+    inline const BatchResults& Restored() const { return m_restored; }
+
+    /*! \brief Record a finished batch, thread safe; writes the file if the interval has passed
+     *
+     * Only the merge and a copy of the results happen under the lock, the file is written outside
+     * of it - the other threads keep recording while one of them writes. */
+    void Record(const BatchResults& batch);
+    void Flush();
+
+    /*! \brief Delete the file; nothing is written afterwards */
+    void Remove();
+
+    /*! \brief Delete the checkpoints in \a directory that were last written more than \a max_age_secs
+     *  ago, returns how many */
+    static int RemoveStale(const QString& directory, qint64 max_age_secs);
+
+private:
+    /* Everything a write needs, copied under m_mutex */
+    struct Snapshot {
+        BatchResults results;
+        qint64 seed = 0;
+        bool has_seed = false;
+        qint64 generation = 0;
+    };
+    Snapshot TakeSnapshot() const;
+    void Write(const Snapshot& snapshot);
+
+    QString m_path;
+    qint64 m_interval, m_last_write = 0, m_seed = 0;
+    bool m_resumed = false, m_has_seed = false;
+    BatchResults m_restored, m_results;
+    /* Counts the changes of m_results; a write of an older generation than the file holds is dropped */
+    qint64 m_generation = 0;
+    QMutex m_mutex;
+
+    /* Serialises the writes, guards m_written and m_removed */
+    qint64 m_written = 0;
+    bool m_removed = false;
+    QMutex m_write_mutex;
+};
@@ -18,17 +18,22 @@
  */
 
 #include "globalsearch.h"
+#include "jobcheckpoint.h"
 #include "modelcomparison.h"
 #include "montecarlostatistics.h"
 #include "resampleanalyse.h"
 #include "weakenedgridsearch.h"
+#include "workerpool.h"
 
 #include "src/core/models/models.h"
 
 #include "src/global.h"
 
 #include <QtCore/QDateTime>
+#include <QtCore/QMutexLocker>
 #include <QtCore/QObject>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QThread>
 
 #include "src/core/phasetiming.h"
 
@@ -67,76 +72,176 @@ JobManager::JobManager(QObject* parent)
     connect(m_globalsearch, SIGNAL(setMaximumSteps(int)), this, SIGNAL(prepare(int)), Qt::DirectConnection);
     connect(m_globalsearch, &AbstractSearchClass::Message, this, &JobManager::Message);
 
+    m_workers = new WorkerPool(this);
+    connect(this, SIGNAL(Interrupt()), m_workers, SLOT(Interrupt()), Qt::DirectConnection);
+    connect(m_workers, SIGNAL(IncrementProgress(int)), this, SIGNAL(incremented(int)), Qt::DirectConnection);
+    connect(m_workers, &WorkerPool::Message, this, &JobManager::Message);
+
+    m_executor = new QThreadPool(this);
+
+    /* Set at once, also if the interrupt comes from a thread - the checkpoint is kept after a blocking Run();
+     * the queue of an asynchronous run is dropped when its thread has finished */
     connect(this, &JobManager::Interrupt, this, [this]() {
+        QMutexLocker locker(&m_job_mutex);
         m_interrupt = true;
-    });
+        m_job_context.Cancel();
+    }, Qt::DirectConnection);
 }
 
 JobManager::~JobManager()
 {
+    if (m_worker) {
+        emit Interrupt();
+        m_worker->wait();
+        delete m_worker;
+    }
 }
 
 void JobManager::RunJobs()
 {
     m_working = true;
-    m_interrupt = false;
+    {
+        /* An Interrupt() from another thread either comes before the new token and is dropped with
+         * the old one, or after it and cancels it - never in between */
+        QMutexLocker locker(&m_job_mutex);
+        m_interrupt = false;
+        m_job_context = m_context.Child();
+    }
     int start = 0;
-    int threads = qApp->instance()->property("threads").toInt();
-    if (m_model->PreventThreads())
-        qApp->instance()->setProperty("threads", 1);
     for (const QJsonObject& object : m_jobs) {
-        SupraFit::Method method = static_cast<SupraFit::Method>(object["Method"].toInt());
-        QJsonObject result;
-
-        qint64 t0 = 0, t1 = 0;
         emit started();
-        t0 = QDateTime::currentMSecsSinceEpoch();
-
-        switch (method) {
-        case SupraFit::Method::WeakenedGridSearch:
-            result = RunGridSearch(object);
-            break;
-
-        case SupraFit::Method::ModelComparison:
-        case SupraFit::Method::FastConfidence:
-            result = RunModelComparison(object);
-            break;
-
-
-        case SupraFit::Method::Reduction:
-        case SupraFit::Method::CrossValidation:
-            result = RunResample(object);
-            break;
-
-        case SupraFit::Method::MonteCarlo:
-            result = RunMonteCarlo(object);
-            break;
-
-        case SupraFit::Method::GlobalSearch:
-            result = RunGlobalSearch(object);
-            break;
-        }
+        qint64 t0 = QDateTime::currentMSecsSinceEpoch();
+        QJsonObject result = RunJob(object);
         start++;
-        t1 = QDateTime::currentMSecsSinceEpoch();
-        const QString final_message = QString("%1 took %2 msecs (%3 msecs in parallel processes) for %4 in %5").arg(Method2Name(method)).arg(t1 - t0).arg(m_last_multicore).arg(m_model->Name()).arg(m_model->ProjectTitle());
-        emit m_model->Info()->Message(final_message);
-        emit Message(final_message);
-
-        // NOTE: finished() hides the progress dialog, but the two calls below still run — so from
-        // here on the user gets no feedback at all. Timed separately for exactly that reason. CG.
-        emit finished(start, m_jobs.size(), t1 - t0);
-        int index = m_model->UpdateStatistic(result);
-        PhaseTiming::Mark(QStringLiteral("store statistic in model (after progress hidden)"));
-        emit ShowResult(method, index);
+        qint64 t1 = QDateTime::currentMSecsSinceEpoch();
+        StoreResult(object, result, start, m_jobs.size(), t1 - t0, m_last_multicore);
         if (m_interrupt)
             break;
     }
     m_jobs.clear();
     m_working = false;
-    qApp->instance()->setProperty("threads", threads);
     emit AllFinished();
 }
 
+void JobManager::RunJobsAsync()
+{
+    if (m_working || m_jobs.isEmpty())
+        return;
+
+    m_working = true;
+    m_interrupt = false;
+
+    const QList<QJsonObject> jobs = m_jobs;
+    m_jobs.clear();
+    QSharedPointer<AbstractModel> snapshot = m_model->Clone();
+
+    const ExecutionContext context = m_context;
+    m_worker = QThread::create([this, jobs, snapshot, context]() {
+        /* Created on the worker, so the handlers and the batches they spawn live in this thread;
+         * everything they emit reaches this JobManager as a queued signal */
+        JobManager runner;
+        runner.setModel(snapshot);
+        runner.setExecutionContext(context);
+        runner.m_job_context = context.Child(); // before the Interrupt() connection below
+        connect(&runner, &JobManager::incremented, this, &JobManager::incremented);
+        connect(&runner, &JobManager::prepare, this, &JobManager::prepare);
+        connect(&runner, &JobManager::Message, this, &JobManager::Message);
+        connect(this, &JobManager::Interrupt, &runner, &JobManager::Interrupt, Qt::DirectConnection);
+
+        for (int i = 0; i < jobs.size() && !m_interrupt; ++i) {
+            emit started();
+            qint64 t0 = QDateTime::currentMSecsSinceEpoch();
+            const QJsonObject result = runner.RunJob(jobs[i]);
+            qint64 t1 = QDateTime::currentMSecsSinceEpoch();
+            const qint64 multicore = runner.m_last_multicore;
+            const QJsonObject job = jobs[i];
+            const int all = jobs.size();
+            QMetaObject::invokeMethod(
+                this, [this, job, result, i, all, t0, t1, multicore]() {
+                    StoreResult(job, result, i + 1, all, t1 - t0, multicore);
+                },
+                Qt::QueuedConnection);
+        }
+    });
+
+    /* Queued after the last StoreResult, so AllFinished always comes last; jobs added meanwhile
+     * are started right away and AllFinished waits for them, so it comes once per drained queue */
+    connect(m_worker, &QThread::finished, this, [this]() {
+        m_worker->deleteLater();
+        m_working = false;
+        if (m_interrupt)
+            m_jobs.clear();
+        if (!m_jobs.isEmpty()) {
+            RunJobsAsync();
+            return;
+        }
+        emit AllFinished();
+    });
+    m_worker->start();
+}
+
+ExecutionContext JobManager::JobContext() const
+{
+    QMutexLocker locker(&m_job_mutex);
+    return m_job_context;
+}
+
+QJsonObject JobManager::RunJob(const QJsonObject& job)
+{
+    /* Monte Carlo and cross validation queue independent batches, those can go to worker processes */
+    m_workers->ReadSettings();
+    WorkerPool* workers = m_workers->Size() ? m_workers.data() : nullptr;
+    m_montecarlo_handler->setWorkerPool(workers);
+    m_resample_handler->setWorkerPool(workers);
+
+    /* Each job gets the whole budget of this manager on its own pool, a model that can not run in
+     * parallel gets a single thread - without touching the budget of any other job in the process */
+    ExecutionContext context = JobContext();
+    if (m_model->PreventThreads())
+        context.setThreads(1);
+    context.setExecutor(m_executor);
+    m_montecarlo_handler->setExecutionContext(context);
+    m_gridsearch_handler->setExecutionContext(context);
+    m_modelcomparison_handler->setExecutionContext(context);
+    m_resample_handler->setExecutionContext(context);
+    m_globalsearch->setExecutionContext(context);
+
+    switch (static_cast<SupraFit::Method>(job["Method"].toInt())) {
+    case SupraFit::Method::WeakenedGridSearch:
+        return RunGridSearch(job);
+
+    case SupraFit::Method::ModelComparison:
+    case SupraFit::Method::FastConfidence:
+        return RunModelComparison(job);
+
+    case SupraFit::Method::Reduction:
+    case SupraFit::Method::CrossValidation:
+        return RunResample(job);
+
+    case SupraFit::Method::MonteCarlo:
+        return RunMonteCarlo(job);
+
+    case SupraFit::Method::GlobalSearch:
+        return RunGlobalSearch(job);
+    }
+    return QJsonObject();
+}
+
+void JobManager::StoreResult(const QJsonObject& job, const QJsonObject& result, int current, int all, qint64 time, qint64 multicore)
+{
+    SupraFit::Method method = static_cast<SupraFit::Method>(job["Method"].toInt());
+    const QString final_message = QString("%1 took %2 msecs (%3 msecs in parallel processes) for %4 in %5").arg(Method2Name(method)).arg(time).arg(multicore).arg(m_model->Name()).arg(m_model->ProjectTitle());
+    emit m_model->Info()->Message(final_message);
+    emit Message(final_message);
+
+    // NOTE: finished() hides the progress dialog, but the two calls below still run — so from
+    // here on the user gets no feedback at all. Timed separately for exactly that reason. CG.
+    emit finished(current, all, time);
+    int index = m_model->UpdateStatistic(result);
+    PhaseTiming::Mark(QStringLiteral("store statistic in model (after progress hidden)"));
+    emit ShowResult(method, index);
+}
+
 void JobManager::AddSingleJob(const QJsonObject& job)
 {
     if (!job.contains("Repeat"))
@@ -176,8 +281,12 @@ QJsonObject JobManager::RunMonteCarlo(const QJsonObject& job)
 
     m_montecarlo_handler->setController(block);
 
+    QScopedPointer<JobCheckpoint> checkpoint(OpenCheckpoint(block));
+    m_montecarlo_handler->setCheckpoint(checkpoint.data());
     m_montecarlo_handler->setModel(m_model);
     m_montecarlo_handler->Run();
+    CloseCheckpoint(checkpoint.data());
+    m_montecarlo_handler->setCheckpoint(nullptr);
 
     QJsonObject result = m_montecarlo_handler->Result();
     m_last_multicore = m_montecarlo_handler->MultiCoreTime();
@@ -210,9 +319,15 @@ QJsonObject JobManager::RunResample(const QJsonObject& job)
     for (const QString& key : job.keys())
         block[key] = job[key];
 
+    QScopedPointer<JobCheckpoint> checkpoint;
+    if (block["Method"].toInt() == SupraFit::Method::CrossValidation)
+        checkpoint.reset(OpenCheckpoint(block));
+    m_resample_handler->setCheckpoint(checkpoint.data());
     m_resample_handler->setModel(m_model);
     m_resample_handler->setController(block);
     m_resample_handler->Run();
+    CloseCheckpoint(checkpoint.data());
+    m_resample_handler->setCheckpoint(nullptr);
 
     QJsonObject result = m_resample_handler->Result();
     m_last_multicore = m_resample_handler->MultiCoreTime();
@@ -221,6 +336,35 @@ QJsonObject JobManager::RunResample(const QJsonObject& job)
     return result;
 }
 
+JobCheckpoint* JobManager::OpenCheckpoint(const QJsonObject& job)
+{
+    if (!JobCheckpoint::isEnabled())
+        return nullptr;
+
+    /* Checkpoints nobody resumed in time are only taking space */
+    const qint64 days = qApp->instance()->property("CheckpointMaxAge").isValid() ? qApp->instance()->property("CheckpointMaxAge").toLongLong() : 14;
+    const int stale = JobCheckpoint::RemoveStale(JobCheckpoint::Directory(), days * 24 * 3600);
+    if (stale)
+        emit Message(tr("Removed %1 checkpoints older than %2 days").arg(stale).arg(days));
+
+    const qint64 interval = qApp->instance()->property("CheckpointInterval").isValid() ? qApp->instance()->property("CheckpointInterval").toLongLong() : 60;
+    JobCheckpoint* checkpoint = new JobCheckpoint(JobCheckpoint::Path(m_model.data(), job), interval * 1000);
+    if (qApp->instance()->property("Resume").toBool() && checkpoint->Load())
+        emit Message(tr("Resuming %1 refits from %2").arg(checkpoint->Restored().Count()).arg(checkpoint->FilePath()));
+    return checkpoint;
+}
+
+void JobManager::CloseCheckpoint(JobCheckpoint* checkpoint)
+{
+    if (!checkpoint)
+        return;
+    /* An interrupted job keeps its refits for the next run, a finished one does not need them anymore */
+    if (m_interrupt)
+        checkpoint->Flush();
+    else
+        checkpoint->Remove();
+}
+
 QJsonObject JobManager::RunGlobalSearch(const QJsonObject& job)
 {
     m_globalsearch->setController(job);
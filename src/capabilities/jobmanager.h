@@ -19,18 +19,27 @@
 
 #pragma once
 
+#include "src/core/executioncontext.h"
+
 #include "src/global.h"
 
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QPointer>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+
+#include <atomic>
 
 class AbstractModel;
 class GlobalSearch;
+class JobCheckpoint;
 class MonteCarloStatistics;
 class ModelComparison;
 class WeakenedGridSearch;
 class ResampleAnalyse;
+class WorkerPool;
 
 /* Standard Settings for Task are given here */
 
@@ -226,9 +235,26 @@ public:
     inline void setModel(const QSharedPointer<AbstractModel>& model) { m_model = model; }
     void AddSingleJob(const QJsonObject& job);
 
+    /*! \brief Thread budget and seed of the jobs run here; follows the application property "threads"
+     * unless the context sets a budget. Every manager starts its jobs on a thread pool of its own. */
+    inline void setExecutionContext(const ExecutionContext& context) { m_context = context; }
+    inline const ExecutionContext& Context() const { return m_context; }
+
     void RunJobs();
 
+    /*! \brief Run the queued jobs on a worker thread and return immediately
+     *
+     * The jobs work on a snapshot of the model taken now, so the model may be edited while they run.
+     * Progress signals are delivered in the thread of the JobManager; each result is stored in the
+     * model there, followed by finished() and ShowResult(), and AllFinished() once the queue is done.
+     * Jobs added while the queue runs are picked up before AllFinished(), which therefore comes once
+     * however many jobs were added. Interrupt() stops the running job and drops the remaining ones.
+     */
+    void RunJobsAsync();
+
     inline bool Working() const { return m_working; }
+    /*! \brief Thread of the running asynchronous queue, nullptr if none runs */
+    inline QThread* Worker() const { return m_worker; }
 public slots:
 
 private:
@@ -241,15 +267,31 @@ private:
     QJsonObject RunModelComparison(const QJsonObject& job);
     QJsonObject RunGlobalSearch(const QJsonObject& job);
 
+    QJsonObject RunJob(const QJsonObject& job);
+
+    /*! \brief Checkpoint of \a job if "Checkpoint" is set, loaded if "Resume" is set too; owned by the caller */
+    JobCheckpoint* OpenCheckpoint(const QJsonObject& job);
+    void CloseCheckpoint(JobCheckpoint* checkpoint);
+    void StoreResult(const QJsonObject& job, const QJsonObject& result, int current, int all, qint64 time, qint64 multicore);
+    ExecutionContext JobContext() const;
+
     QPointer<MonteCarloStatistics> m_montecarlo_handler;
     QPointer<WeakenedGridSearch> m_gridsearch_handler;
     QPointer<ModelComparison> m_modelcomparison_handler;
     QPointer<ResampleAnalyse> m_resample_handler;
     QPointer<GlobalSearch> m_globalsearch;
+    QPointer<WorkerPool> m_workers;
+    QPointer<QThreadPool> m_executor;
+    /* The context of the running jobs has its own cancellation token, cancelled by Interrupt();
+     * Interrupt() may come from any thread, so once it is connected m_job_context is only touched
+     * under m_job_mutex */
+    ExecutionContext m_context, m_job_context;
+    mutable QMutex m_job_mutex;
 
     bool m_working = false;
-    bool m_interrupt = false;
+    std::atomic<bool> m_interrupt = false;
     qint64 m_last_multicore = 0;
+    QPointer<QThread> m_worker;
 
 signals:
     void started();
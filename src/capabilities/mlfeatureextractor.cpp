@@ -21,6 +21,7 @@
 
 #include "src/core/jsonutils.h"
 #include "src/core/analyse.h"
+#include "src/core/resultsink.h"
 
 #include <QtCore/QDateTime>
 #include <QtCore/QDebug>
@@ -87,7 +88,12 @@ QJsonObject MLFeatureExtractor::parseMLPipelineData(const QString& filename)
 
         root = doc.object();
     }
-    
+
+    return parseMLPipelineRoot(root, filename);
+}
+
+QJsonObject MLFeatureExtractor::parseMLPipelineRoot(const QJsonObject& root, const QString& source)
+{
     // Simplified Multi-Project format parsing - Claude Generated
     // Expects project_X format created by new ML Pipeline Manager
     QJsonObject mlData;
@@ -178,7 +184,7 @@ QJsonObject MLFeatureExtractor::parseMLPipelineData(const QString& filename)
         
         qDebug() << "MLFeatureExtractor: Created ML data structure with" << fittedModels.size() << "models";
     } else {
-        qWarning() << "MLFeatureExtractor: No Multi-Project entries (project_X, model_X) found in" << filename;
+        qWarning() << "MLFeatureExtractor: No Multi-Project entries (project_X, model_X) found in" << source;
         qDebug() << "MLFeatureExtractor: Available root keys:" << root.keys();
     }
 
@@ -250,21 +256,39 @@ QJsonObject MLFeatureExtractor::extractCompactTrainingSample(const QJsonObject&
 QVector<QJsonObject> MLFeatureExtractor::extractBatchTrainingData(const QVector<QString>& filenames)
 {
     QVector<QJsonObject> trainingSamples;
-    
-    for (const QString& filename : filenames) {
-        QJsonObject mlData = parseMLPipelineData(filename);
-        if (!mlData.isEmpty()) {
-            QJsonObject sample = extractCompactTrainingSample(mlData);
-            if (!sample.isEmpty()) {
-                trainingSamples.append(sample);
-            }
-        }
-    }
-    
+    streamTrainingData(filenames, [&trainingSamples](const QJsonObject& sample) {
+        trainingSamples.append(sample);
+    });
+
     qDebug() << "MLFeatureExtractor: Extracted" << trainingSamples.size() << "training samples from" << filenames.size() << "files";
     return trainingSamples;
 }
 
+qint64 MLFeatureExtractor::streamTrainingData(const QVector<QString>& filenames, const std::function<void(const QJsonObject&)>& visitor)
+{
+    qint64 samples = 0;
+    auto extract = [this, &visitor, &samples](const QJsonObject& mlData) {
+        if (mlData.isEmpty())
+            return;
+        QJsonObject sample = extractCompactTrainingSample(mlData);
+        if (sample.isEmpty())
+            return;
+        visitor(sample);
+        ++samples;
+    };
+
+    for (const QString& filename : filenames) {
+        if (ResultSink::isStream(filename)) {
+            ResultSink::ForEach(filename, [this, &extract, &filename](const QJsonObject& record) {
+                extract(parseMLPipelineRoot(record, filename));
+                return true;
+            });
+        } else
+            extract(parseMLPipelineData(filename));
+    }
+    return samples;
+}
+
 QJsonObject MLFeatureExtractor::exportNeuralNetFormat(const QVector<QJsonObject>& trainingSamples)
 {
     QJsonObject result;
@@ -26,6 +26,8 @@
 #include <QtCore/QString>
 #include <QtCore/QVector>
 
+#include <functional>
+
 // SupraFit core includes for statistical feature extraction - Claude Generated
 #include "src/core/toolset.h"
 #include "src/core/analyse.h"
@@ -60,6 +62,14 @@ public:
      */
     QJsonObject parseMLPipelineData(const QString& filename);
 
+    /**
+     * @brief Parse ML Pipeline RawData from an already loaded Multi-Project object
+     * @param root Multi-Project object (project_X/model_X entries), e.g. one record of a result stream
+     * @param source Origin of \p root, used in diagnostics only
+     * @return QJsonObject with parsed ML RawData structure, empty if no projects were found
+     */
+    QJsonObject parseMLPipelineRoot(const QJsonObject& root, const QString& source);
+
     /**
      * @brief Extract compact training sample from ML RawData
      * @param mlRawData Complete ML pipeline data structure
@@ -74,6 +84,14 @@ public:
      */
     QVector<QJsonObject> extractBatchTrainingData(const QVector<QString>& filenames);
 
+    /**
+     * @brief Extract training samples one by one without collecting them
+     * @param filenames JSON/.suprafit files (one dataset each) or *.ndjson result streams (one dataset per line)
+     * @param visitor Receives every extracted training sample
+     * @return Number of samples passed to \p visitor
+     */
+    qint64 streamTrainingData(const QVector<QString>& filenames, const std::function<void(const QJsonObject&)>& visitor);
+
     /**
      * @brief Export training samples in neural network optimized format
      * @param trainingSamples Vector of training samples from extractBatchTrainingData
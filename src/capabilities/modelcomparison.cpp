@@ -22,21 +22,19 @@
 
 #include "src/core/models/AbstractModel.h"
 
+#include "src/core/randomstream.h"
 #include "src/core/toolset.h"
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
 #include <QtCore/QJsonObject>
-#include <QtCore/QRandomGenerator>
 #include <QtCore/QVector>
 
 #include "modelcomparison.h"
 
 void MCThread::run()
 {
-    QVector<QVector<qreal>> applied_parameters;
     QVector<qreal> parameters = m_model.data()->CollectOptimizationParameters();
-    applied_parameters << parameters;
 
     m_ParameterIndex = m_controller["ParameterIndex"].toInt(0);
     m_MaxParameter = m_controller["MaxParameter"].toDouble();
@@ -67,11 +65,12 @@ void MCThread::run()
                 return;
 
             QVector<qreal> consts = parameters;
+            RandomStream stream(m_seed, RandomJob::ModelComparison, m_first + step);
 
             int j = 0;
             for (int i = 0; i < param.size(); ++i) {
                 if (param[i])
-                    consts[j] = QRandomGenerator::global()->generateDouble() * (m_box[j][1] - m_box[j][0]) + m_box[j][0];
+                    consts[j] = stream.Uniform() * (m_box[j][1] - m_box[j][0]) + m_box[j][0];
                 j++;
             }
 
@@ -88,37 +87,39 @@ void MCThread::run()
         }
     } else { // The second one
 
-        auto GenerateRandom = [](const QVector<int>& indicies, const QList<int>& param, int max) -> int {
-            int j = QRandomGenerator::global()->bounded(0, param.size());
+        auto GenerateRandom = [](RandomStream& stream, const QVector<int>& indicies, const QList<int>& param, int max) -> int {
+            int j = int(stream.Bounded(param.size()));
             while ((indicies.contains(j) || param[j] == 0) && indicies.size() < max)
-                j = QRandomGenerator::global()->bounded(0, param.size());
+                j = int(stream.Bounded(param.size()));
             if (max == indicies.size())
                 return -1;
             return j;
         };
 
-        auto GenerateParameter = [=](int j, QVector<qreal>& consts) -> qreal {
-            consts[j] = QRandomGenerator::global()->generateDouble() * (m_box[j][1] - m_box[j][0]) + m_box[j][0];
+        auto GenerateParameter = [=](RandomStream& stream, int j, QVector<qreal>& consts) -> qreal {
+            consts[j] = stream.Uniform() * (m_box[j][1] - m_box[j][0]) + m_box[j][0];
             m_model->setParameter(consts);
             m_model->Calculate();
             return m_model->StatisticVector()[m_ParameterIndex];
         };
 
-        QVector<qreal> consts = applied_parameters[QRandomGenerator::global()->bounded(0, applied_parameters.size())];
-
         for (int step = 0; step < m_maxsteps; ++step) {
             if (m_interrupt)
                 return;
             bool allow_loop = true;
+            RandomStream stream(m_seed, RandomJob::ModelComparison, m_first + step);
+            /* Every step walks from the optimum, so it depends on its own stream only and not on the
+             * steps the same thread took before */
+            QVector<qreal> consts = parameters;
 
             QVector<int> indicies;
 
             QVector<qreal> oldconsts = consts;
-            int j = GenerateRandom(indicies, param, max);
+            int j = GenerateRandom(stream, indicies, param, max);
             int current = 0;
             while ((current < max && allow_loop && indicies.size() < parameters.size())) {
 
-                j = GenerateRandom(indicies, param, max);
+                j = GenerateRandom(stream, indicies, param, max);
                 if (j == -1)
                     break;
 
@@ -131,7 +132,7 @@ void MCThread::run()
                     int attemps = 0;
                     while (attemps < 10) {
                         oldconsts = consts;
-                        qreal SSE = GenerateParameter(j, consts);
+                        qreal SSE = GenerateParameter(stream, j, consts);
                         if (SSE <= m_MaxParameter) {
                             oldconsts = consts;
                             current++;
@@ -143,13 +144,8 @@ void MCThread::run()
             }
             m_model->setParameter(consts);
             m_model->Calculate();
-            if (m_model->StatisticVector()[m_ParameterIndex] <= m_MaxParameter) {
+            if (m_model->StatisticVector()[m_ParameterIndex] <= m_MaxParameter)
                 m_results << m_model->ExportModel(false);
-                applied_parameters << consts;
-                consts = applied_parameters[QRandomGenerator::global()->bounded(0, applied_parameters.size())];
-            } else {
-                consts = parameters;
-            }
             m_steps++;
             if (step % update_intervall == 0) {
                 emit IncrementProgress(QDateTime::currentMSecsSinceEpoch() - t0);
@@ -290,8 +286,7 @@ bool ModelComparison::FastConfidence()
         threads << thread;
     }
     if (!m_model.data()->SupportThreads()) {
-        while (m_threadpool->activeThreadCount())
-            QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+        WaitForThreads();
     }
     m_multicore_time = QDateTime::currentMSecsSinceEpoch() - t0;
 
@@ -391,26 +386,32 @@ void ModelComparison::MCSearch(const QVector<QVector<qreal>>& box)
 
     int maxsteps = m_controller["MaxSteps"].toInt();
     emit setMaximumSteps(maxsteps / update_intervall);
-    int thread_count = qApp->instance()->property("threads").toInt();
+    int thread_count = m_context.Threads();
     m_threadpool->setMaxThreadCount(thread_count);
     qint64 t0 = QDateTime::currentMSecsSinceEpoch();
 
+    const qint64 seed = RandomSeed();
+
+    /* Each thread takes a contiguous range of the steps and draws step i from stream i, so the
+     * threads together evaluate the same samples for every thread count */
+    int first = 0;
     for (int i = 0; i < thread_count; ++i) {
+        const int steps = maxsteps / thread_count + (i < maxsteps % thread_count ? 1 : 0);
         MCThread* thread = new MCThread();
         connect(thread, SIGNAL(IncrementProgress(int)), this, SIGNAL(IncrementProgress(int)));
-        connect(this, &ModelComparison::StopSubThreads, thread, &MCThread::Interrupt);
+        connect(this, &ModelComparison::StopSubThreads, thread, &MCThread::Interrupt, Qt::DirectConnection);
 
         thread->setModel(m_model);
         thread->setController(m_controller);
         thread->setError(m_effective_error);
-        thread->setMaxSteps(maxsteps / thread_count);
+        thread->setMaxSteps(steps);
+        thread->setSeed(seed, first);
         thread->setBox(box);
         threads << thread;
         m_threadpool->start(thread);
+        first += steps;
     }
-    while (m_threadpool->activeThreadCount()) {
-        QCoreApplication::processEvents();
-    }
+    WaitForThreads();
     m_multicore_time = QDateTime::currentMSecsSinceEpoch() - t0;
 
     QList<QJsonObject> results;
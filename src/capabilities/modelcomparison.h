@@ -46,6 +46,12 @@ public:
     void run() override;
     QList<QJsonObject> Results() const { return m_results; }
     inline void setMaxSteps(int steps) { m_maxsteps = steps; }
+    /*! \brief Steps are drawn from RandomStream(seed, RandomJob::ModelComparison, first + step) */
+    inline void setSeed(quint64 seed, int first)
+    {
+        m_seed = seed;
+        m_first = first;
+    }
     inline void setBox(const QVector<QVector<qreal>>& box) { m_box = box; }
     inline void setError(qreal error) { m_effective_error = error; }
     inline int Steps() const { return m_steps; }
@@ -53,7 +59,8 @@ public:
 private:
     QSharedPointer<AbstractModel> m_model;
     QList<QJsonObject> m_results;
-    int m_maxsteps, m_steps = 0, m_ParameterIndex = 0;
+    int m_maxsteps, m_steps = 0, m_ParameterIndex = 0, m_first = 0;
+    quint64 m_seed = 0;
     qreal m_MaxParameter;
     QVector<QVector<qreal>> m_box;
     qreal m_effective_error;
@@ -35,11 +35,14 @@
 #include <QtCore/QTimer>
 #include <QtCore/QVector>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
-#include <random>
 
 #include "src/core/phasetiming.h"
+#include "src/core/randomstream.h"
+
+#include "workerpool.h"
 
 #include "montecarlostatistics.h"
 
@@ -121,26 +124,58 @@ void MonteCarloBatch::run()
 {
     m_fit_thread = new NonLinearFitThread(false);
     m_counter = 0;
+    /* Every step starts from the parameters the model came with, not from the previous refit of this
+     * worker - otherwise the result of a step would depend on what the worker fitted before */
+    const Eigen::MatrixXd global = m_model->GlobalTable()->Table();
+    const Eigen::MatrixXd local = m_model->LocalTable()->Table();
+    Pair previous;
     while (true) {
         if (m_interrupt)
             break;
         QHash<int, Pair> tables = m_parent->DemandCalc();
+        QList<int> keys = tables.keys();
+        std::sort(keys.begin(), keys.end());
+        if (m_sampler && !keys.isEmpty())
+            m_target = &m_blocks.insert(keys.first(), m_accumulator).value();
+
         int counter = 0;
         int time = 0;
-        for (const QPair<QPointer<DataTable>, QPointer<DataTable>>& table : tables) {
+        for (int key : qAsConst(keys)) {
+            const Pair table = m_sampler ? m_sampler->Sample(key) : tables.value(key);
             if (table.first && table.second) {
                 m_model->OverrideInDependentTable(table.first);
                 if (!m_checked)
                     m_model->OverrideDependentTable(table.second);
                 else
                     m_model->OverrideCheckedTable(table.second);
+                m_model->GlobalTable()->setTable(global);
+                m_model->LocalTable()->setTable(local);
 
-                time += optimise(tables.key(table));
+                time += optimise(key);
                 counter++;
 
+                /* Sampled tables belong to this worker; the model holds on to the current ones */
+                if (m_sampler) {
+                    delete previous.first;
+                    delete previous.second;
+                    previous = table;
+                }
             } else
                 continue;
         }
+        /* A block cut short by an interrupt is refitted again after a resume */
+        if (m_checkpoint && counter && !m_interrupt) {
+            BatchResults done;
+            for (int key : qAsConst(keys)) {
+                if (!m_parameters.contains(key))
+                    continue;
+                done.parameters.insert(key, m_parameters.value(key));
+                if (m_store_models)
+                    done.models.insert(key, m_models.value(key));
+            }
+            done.addBlock(done.parameters.keys().toVector());
+            m_checkpoint->Record(done);
+        }
         emit IncrementProgress(time);
         if (!counter)
             break;
@@ -148,6 +183,12 @@ void MonteCarloBatch::run()
     delete m_fit_thread;
 }
 
+void MonteCarloBatch::setAccumulate(bool store_models, bool keep_raw)
+{
+    m_store_models = store_models;
+    m_accumulator.setModel(m_model.data(), keep_raw);
+}
+
 int MonteCarloBatch::optimise(int key)
 {
     if (!m_model || m_interrupt) {
@@ -167,7 +208,11 @@ int MonteCarloBatch::optimise(int key)
     m_model->Calculate();
 
     m_model->setConverged(m_finished);
-    m_models.insert(key, m_model->ExportModel(false, false)); //;
+    m_target->add(m_model.data());
+    if (m_store_models)
+        m_models.insert(key, m_model->ExportModel(false, false));
+    if (m_keep_parameters)
+        m_parameters.insert(key, qMakePair(m_model->GlobalTable()->Table(), m_model->LocalTable()->Table()));
     m_counter++;
 
     qint64 t1 = QDateTime::currentMSecsSinceEpoch();
@@ -176,6 +221,28 @@ int MonteCarloBatch::optimise(int key)
     return time;
 }
 
+Pair MonteCarloSampler::Sample(int step) const
+{
+    if (!dependent || !independent)
+        return Pair();
+
+    RandomStream dependent_stream(seed, RandomJob::MonteCarlo, step);
+    QPointer<DataTable> dep_table;
+    if (bootstrap)
+        dep_table = dependent->PrepareBootStrap(dependent_stream, residuals);
+    else
+        dep_table = dependent->PrepareMC(QVector<double>() << sigma, dependent_stream);
+
+    QPointer<DataTable> indep_table;
+    if (independent_cols.contains(1)) {
+        RandomStream independent_stream(seed, RandomJob::MonteCarloIndependent, step);
+        indep_table = independent->PrepareMC(independent_sigma, independent_stream, independent_cols);
+    } else
+        indep_table = new DataTable(independent.data());
+
+    return Pair(indep_table, dep_table);
+}
+
 MonteCarloStatistics::MonteCarloStatistics(QObject* parent)
     : AbstractSearchClass(parent)
 {
@@ -188,13 +255,11 @@ MonteCarloStatistics::~MonteCarloStatistics()
 bool MonteCarloStatistics::Run()
 {
     m_models.clear();
-    // Runs on the CALLING thread and allocates ~3 DataTables per step before the first worker starts,
-    // so it is wall time the progress bar never covers. Claude Generated.
+    // Only queues the step indices; the workers draw the perturbed data of each step themselves
     QVector<QPointer<MonteCarloBatch>> threads = GenerateData();
-    PhaseTiming::Mark(QStringLiteral("generate resampled data tables (single-threaded)"));
+    PhaseTiming::Mark(QStringLiteral("queue resampling steps"));
 
-    while (m_threadpool->activeThreadCount())
-        QCoreApplication::processEvents();
+    WaitForThreads();
 
     m_multicore_time = QDateTime::currentMSecsSinceEpoch() - m_t0;
     // QCoreApplication::processEvents();
@@ -202,21 +267,19 @@ bool MonteCarloStatistics::Run()
 
     Collect(threads);
     PhaseTiming::Mark(QStringLiteral("collect results + free data tables"));
-    if (m_models.size() == 0)
+    if (m_accumulator.Count() == 0)
         return false;
 
-    bool lightweight = m_controller["LightWeight"].toBool();
-
-    m_results = ToolSet::Model2Parameter(m_models);
-    ToolSet::Parameter2Statistic(m_results, m_model.data());
+    /* The parameters were summarised while fitting; without LightWeight the raw values were kept
+     * and everything below is exact, with LightWeight it is estimated from the quantile digests.
+     * All parameters are evaluated at once on the threads of the job, each sorted a single time */
+    const int entropy_bins = m_controller["EntropyBins"].toInt(qApp->instance()->property("EntropyBins").toInt());
+    const QVector<ParameterStatistics> statistics = m_accumulator.Evaluate(100 - m_controller["confidence"].toDouble(), m_controller["PlotBins"].toInt(), entropy_bins, m_context);
+    m_results = m_accumulator.Parameter(m_model.data(), statistics);
     for (int i = 0; i < m_results.count(); ++i) {
         QJsonObject data = m_results[i];
-        if (data.isEmpty())
-            continue;
-        QList<qreal> list = ToolSet::String2DoubleList(data["data"].toObject()["raw"].toString());
-        int bins = m_controller["PlotBins"].toInt();
 
-        auto histogram = ToolSet::List2Histogram(list.toVector(), bins);
+        auto histogram = statistics[i].histogram;
         ToolSet::Normalise(histogram);
         QVector<qreal> x, y;
 
@@ -224,21 +287,21 @@ bool MonteCarloStatistics::Run()
             x << pair.first;
             y << pair.second;
         }
-        SupraFit::ConfidenceBar bar = ToolSet::Confidence(list, 100 - m_controller["confidence"].toDouble());
+        const SupraFit::ConfidenceBar& bar = statistics[i].confidence;
         QJsonObject confidence;
         confidence["lower"] = bar.lower;
         confidence["upper"] = bar.upper;
         confidence["error"] = m_controller["confidence"].toDouble();
-        if (lightweight) {
-            QJsonObject d = data["data"].toObject();
-            d["raw"] = QJsonObject();
-            data["data"] = d;
-        }
         data["confidence"] = confidence;
         data["x"] = ToolSet::DoubleVec2String(x);
         data["y"] = ToolSet::DoubleVec2String(y);
         m_results[i] = data;
     }
+    /* Correlation of the global parameters over all refits, row-major (symmetric anyway) */
+    if (m_accumulator.GlobalCovariance().Dimension() > 1) {
+        const Eigen::MatrixXd correlation = m_accumulator.GlobalCovariance().Correlation();
+        m_controller["GlobalCorrelation"] = ToolSet::DoubleList2String(Vector(Eigen::Map<const Vector>(correlation.data(), correlation.size())));
+    }
     PhaseTiming::Mark(QStringLiteral("evaluate parameters (histograms, confidence)"));
 
     return true;
@@ -246,15 +309,15 @@ bool MonteCarloStatistics::Run()
 
 QVector<QPointer<MonteCarloBatch>> MonteCarloStatistics::GenerateData()
 {
-    // Claude Generated: Support configurable RandomSeed for reproducibility
-    qint64 seed;
-    if (m_controller.contains("RandomSeed")) {
-        seed = m_controller["RandomSeed"].toVariant().toLongLong();
-    } else {
-        seed = QDateTime::currentMSecsSinceEpoch();
-    }
+    qint64 seed = RandomSeed();
+    /* A resumed run has to draw the very same data as the one it continues */
+    if (m_checkpoint && m_checkpoint->Resumed() && m_checkpoint->hasSeed())
+        seed = m_checkpoint->Seed();
+    if (m_checkpoint)
+        m_checkpoint->setSeed(seed);
     qDebug() << m_controller << seed;
-    rng.seed(seed);
+    /* Recorded, so the run can be repeated exactly */
+    m_controller["RandomSeed"] = seed;
     m_model->setFast(false);
     m_model->Calculate();
     m_model->setFast(true);
@@ -291,105 +354,101 @@ QVector<QPointer<MonteCarloBatch>> MonteCarloStatistics::GenerateData()
         sigma = 0.01;  // Use small positive default
     }
     qDebug() << "Using sigma:" << sigma;
-    Phi = std::normal_distribution<double>(0, sigma);
 
     m_controller["Variance"] = sigma;
     int MaxSteps = m_controller["MaxSteps"].toInt();
 
-    int maxthreads = qApp->instance()->property("threads").toInt();
-    if (maxthreads < 1)
-        maxthreads = 1; // property unset (e.g. headless/test context) -> avoid an integer div-by-zero. CG
-    int blocksize = MaxSteps / maxthreads / 20;
+    int maxthreads = m_context.Threads();
+    /* The block layout depends on MaxSteps only: blocks are summarised on their own and merged in
+     * order, which keeps the result independent of the number of threads */
+    int blocksize = MaxSteps / 256;
     if (blocksize < 1)
         blocksize = 1;
 
     m_threadpool->setMaxThreadCount(maxthreads);
     qDebug() << "Using" << maxthreads << "threads with blocksize" << blocksize;
-    m_table = new DataTable(m_model->ModelTable());
-    m_ptr_table << m_table;
     QVector<QPointer<MonteCarloBatch>> threads;
     m_generate = true;
-    QVector<qreal> vector = m_model->ErrorVector();
-    
-    // Claude Generated - Fix invalid uniform_int_distribution range when vector is empty
-    if (vector.isEmpty()) {
-        qDebug() << "Warning: ErrorVector is empty - creating minimal distribution range";
-        Uni = std::uniform_int_distribution<int>(0, 0);  // Single point distribution
-    } else {
-        Uni = std::uniform_int_distribution<int>(0, vector.size() - 1);
-    }
-    qDebug() << "Using uniform distribution from 0 to" << vector.size() - 1;
-    bool original = m_controller["OriginalData"].toBool();
-
-    QVector<qreal> indep_variance = ToolSet::String2DoubleVec(m_controller["IndependentRowVariance"].toString());
 
-    QVector<std::normal_distribution<double>> indep_phi;
-    for (int i = 0; i < indep_variance.size(); ++i) {
-        if (indep_variance[i] <= 0.0) {
+    m_sampler = MonteCarloSampler();
+    m_sampler.seed = seed;
+    m_sampler.sigma = sigma;
+    m_sampler.bootstrap = bootstrap;
+    m_sampler.residuals = m_model->ErrorVector();
+    if (bootstrap && m_sampler.residuals.isEmpty())
+        qDebug() << "Warning: ErrorVector is empty - bootstrap leaves the data unchanged";
+
+    if (m_controller["OriginalData"].toBool())
+        m_sampler.dependent = new DataTable(m_model->DependentModel());
+    else {
+        m_sampler.dependent = new DataTable(m_model->ModelTable());
+        m_sampler.dependent->setCheckedTable(m_model->DependentModel()->CheckedTable());
+    }
+    m_ptr_table << m_sampler.dependent;
+
+    m_sampler.independent = new DataTable(m_model->IndependentModel());
+    m_ptr_table << m_sampler.independent;
+    const QVector<qreal> indep_variance = ToolSet::String2DoubleVec(m_controller["IndependentRowVariance"].toString());
+    const int indep_columns = m_sampler.independent->columnCount();
+    m_sampler.independent_sigma = QVector<qreal>(indep_columns, 0);
+    m_sampler.independent_cols = QVector<int>(indep_columns, 0);
+    for (int i = 0; i < indep_variance.size() && i < indep_columns; ++i) {
+        if (indep_variance[i] <= 0.0)
             continue;
-        }
         qDebug() << "Independent variance for column" << i << ":" << indep_variance[i];
-        std::normal_distribution<double> phi = std::normal_distribution<double>(0, indep_variance[i]);
-        indep_phi << phi;
+        m_sampler.independent_sigma[i] = indep_variance[i];
+        m_sampler.independent_cols[i] = 1;
     }
-    int thread_count = 1;
+
 #ifdef DEBUG_ON
     qDebug() << "Starting MC Simulation with" << MaxSteps << "steps";
 #endif
+    /* Only the step indices are queued, the workers draw the data themselves */
     QHash<int, Pair> block;
     for (int step = 0; step < MaxSteps; ++step) {
-        QPointer<DataTable> dep_table;
-        if (original)
-            dep_table = new DataTable(m_model->DependentModel());
-        else {
-            dep_table = m_model->ModelTable();
-            dep_table->setCheckedTable(m_model->DependentModel()->CheckedTable());
-        }
-        m_ptr_table << dep_table;
-        if (bootstrap) {
-            QPointer<DataTable> tmp = dep_table->PrepareBootStrap(Uni, rng, vector);
-            m_ptr_table << tmp;
-            dep_table = tmp;
-        } else {
-            QPointer<DataTable> tmp = dep_table->PrepareMC(Phi, rng);
-            m_ptr_table << tmp;
-            dep_table = tmp;
-        }
-
-        QPointer<DataTable> indep_table = new DataTable(m_model->IndependentModel());
-        m_ptr_table << indep_table;
-        for (int i = 0; i < indep_variance.size(); ++i) {
-            QVector<int> cols(indep_variance.size(), 0);
-            if (indep_variance[i] > 0) {
-                cols[i] = 1;
-                QPointer<DataTable> tmp = indep_table->PrepareMC(indep_phi[i], rng, cols);
-                m_ptr_table << tmp;
-                indep_table = tmp;
-            }
-        }
-
-        block.insert(step, Pair(indep_table, dep_table));
+        block.insert(step, Pair());
         if (block.size() == blocksize) {
             m_batch.enqueue(block);
-            thread_count++;
-            if (thread_count == maxthreads && blocksize == 2) {
-                thread_count = 1;
-                blocksize--;
-            }
             block.clear();
         }
     }
-    m_batch.enqueue(block);
+    if (!block.isEmpty())
+        m_batch.enqueue(block);
+
+    BatchResults done;
+    if (m_checkpoint && m_checkpoint->Resumed()) {
+        SkipCompleted(m_checkpoint->Restored());
+        done = m_checkpoint->Restored();
+        std::cout << "Resumed " << done.Count() << " calculation from " << m_checkpoint->FilePath().toStdString() << std::endl;
+    }
     emit setMaximumSteps(m_batch.size());
 
     m_t0 = QDateTime::currentMSecsSinceEpoch();
+    /* Worker processes take the queue first, the threads only refit what they left over */
+    if (m_workers) {
+        WorkerPool::Task task;
+        task.sampler = &m_sampler;
+        task.store_models = m_controller["StoreRaw"].toBool();
+        task.checkpoint = m_checkpoint;
+        m_workers->Process(this, m_model, task);
+        done.merge(m_workers->Results());
+        std::cout << "Worker processes performed " << m_workers->Results().Count() << " calculation." << std::endl;
+    }
+    m_done_blocks = done.Accumulate(m_model, !m_controller["LightWeight"].toBool());
+    if (m_controller["StoreRaw"].toBool())
+        m_done_models = done.models;
+    if (m_workers && (!m_generate || Queued() == 0))
+        return threads;
     for (int i = 0; i < maxthreads; ++i) {
         QPointer<MonteCarloBatch> thread = new MonteCarloBatch(this);
         thread->setChecked(false);
         // connect(thread, SIGNAL(IncrementProgress(int)), this, SIGNAL(IncrementProgress(int)));
         connect(thread, &MonteCarloBatch::IncrementProgress, this, &MonteCarloStatistics::IncrementProgress, Qt::DirectConnection);
-        connect(this, &MonteCarloStatistics::InterruptAll, thread, &MonteCarloBatch::Interrupt);
+        connect(this, &MonteCarloStatistics::InterruptAll, thread, &MonteCarloBatch::Interrupt, Qt::DirectConnection);
         thread->setModel(m_model);
+        thread->setAccumulate(m_controller["StoreRaw"].toBool(), !m_controller["LightWeight"].toBool());
+        thread->setSampler(&m_sampler);
+        thread->setCheckpoint(m_checkpoint);
         threads << thread;
         m_threadpool->start(thread);
     }
@@ -400,19 +459,41 @@ void MonteCarloStatistics::Collect(const QVector<QPointer<MonteCarloBatch>>& thr
 {
     m_steps = 0;
     int calculation = 0;
+    m_accumulator.setModel(m_model.data(), !m_controller["LightWeight"].toBool());
+
+    /* Merge the block summaries and the models in step order, whichever thread produced them */
+    QMap<int, const ParameterAccumulator*> blocks;
+    QMap<int, QJsonObject> models;
     for (int i = 0; i < threads.size(); ++i) {
         if (threads[i]) {
-            m_models << threads[i]->Models().values();
+            for (auto block = threads[i]->Blocks().cbegin(); block != threads[i]->Blocks().cend(); ++block)
+                blocks.insert(block.key(), &block.value());
+            const QHash<int, QJsonObject> thread_models = threads[i]->Models();
+            for (auto model = thread_models.cbegin(); model != thread_models.cend(); ++model)
+                models.insert(model.key(), model.value());
             std::cout << "Thread " << i << " performed " << threads[i]->Counter() << " calculation in " << threads[i]->Timer() << " msecs." << std::endl;
             calculation += threads[i]->Counter();
             m_steps++;
-            delete threads[i];
         }
     }
+    for (auto block = m_done_blocks.cbegin(); block != m_done_blocks.cend(); ++block)
+        blocks.insert(block.key(), &block.value());
+    for (auto model = m_done_models.cbegin(); model != m_done_models.cend(); ++model)
+        models.insert(model.key(), model.value());
+    for (const ParameterAccumulator* block : qAsConst(blocks))
+        m_accumulator.merge(*block);
+    m_models << models.values();
+    m_done_blocks.clear();
+    m_done_models.clear();
+
+    for (int i = 0; i < threads.size(); ++i)
+        if (threads[i])
+            delete threads[i];
     std::cout << calculation << " in total" << std::endl;
     for (int i = 0; i < m_ptr_table.size(); ++i)
         if (m_ptr_table[i])
             delete m_ptr_table[i];
+    m_ptr_table.clear();
 }
 
 void MonteCarloStatistics::Interrupt()
@@ -22,8 +22,10 @@
 #include "abstractsearchclass.h"
 
 #include "src/core/models/models.h"
+#include "src/core/streamingstatistics.h"
 
 #include <QtCore/QJsonObject>
+#include <QtCore/QMap>
 #include <QtCore/QObject>
 #include <QtCore/QSharedPointer>
 
@@ -56,6 +58,22 @@ private:
     int m_index;
 };
 
+/*! \brief Recipe for the perturbed data of one Monte Carlo step, shared read-only by all workers
+ *
+ * Sample() draws the noise from RandomStream(seed, job, step), so the data of a step does not depend
+ * on the worker that fits it, the order of the steps or the number of threads.
+ */
+struct MonteCarloSampler {
+    Pair Sample(int step) const;
+
+    QPointer<DataTable> dependent, independent;
+    QVector<qreal> residuals, independent_sigma;
+    QVector<int> independent_cols;
+    qreal sigma = 0;
+    quint64 seed = 0;
+    bool bootstrap = false;
+};
+
 class MonteCarloBatch : public AbstractSearchThread {
     Q_OBJECT
 
@@ -68,12 +86,40 @@ public:
     inline int Counter() { return m_counter; }
     inline int Timer() { return m_indiv_time; }
 
+    /*! \brief Summarise every refit in Accumulator(); the refitted models are only kept (Models())
+     * if \a store_models is set. Call after setModel(). */
+    void setAccumulate(bool store_models, bool keep_raw);
+    inline const ParameterAccumulator& Accumulator() const { return m_accumulator; }
+
+    /*! \brief Draw the data of each step from \a sampler instead of taking the tables of the block.
+     * Every block is then summarised on its own (Blocks(), keyed by its first step), so that merging
+     * them in key order gives the same result for any distribution of the blocks over the threads. */
+    inline void setSampler(const MonteCarloSampler* sampler) { m_sampler = sampler; }
+    inline const QMap<int, ParameterAccumulator>& Blocks() const { return m_blocks; }
+
+    /*! \brief Keep the refitted global and local parameters of every step, exact unlike Models() */
+    inline void setKeepParameters(bool keep) { m_keep_parameters = keep; }
+    inline const QMap<int, QPair<Eigen::MatrixXd, Eigen::MatrixXd>>& Parameters() const { return m_parameters; }
+
+    /*! \brief Record every block that was refitted completely in \a checkpoint; keeps the parameters */
+    inline void setCheckpoint(JobCheckpoint* checkpoint)
+    {
+        m_checkpoint = checkpoint;
+        m_keep_parameters |= checkpoint != nullptr;
+    }
+
 private:
     int optimise(int key = 0);
     NonLinearFitThread* m_fit_thread;
 
     QPointer<AbstractSearchClass> m_parent;
-    bool m_finished, m_checked;
+    const MonteCarloSampler* m_sampler = nullptr;
+    JobCheckpoint* m_checkpoint = nullptr;
+    ParameterAccumulator m_accumulator;
+    ParameterAccumulator* m_target = &m_accumulator;
+    QMap<int, ParameterAccumulator> m_blocks;
+    QMap<int, QPair<Eigen::MatrixXd, Eigen::MatrixXd>> m_parameters;
+    bool m_finished, m_checked, m_store_models = true, m_keep_parameters = false;
     QJsonObject m_controller;
     int m_counter = 0, m_indiv_time = 0;
 };
@@ -94,10 +140,11 @@ private:
     QVector<QPointer<DataTable>> m_ptr_table;
     void Collect(const QVector<QPointer<MonteCarloBatch>>& threads);
 
-    std::mt19937 rng;
-    std::normal_distribution<double> Phi;
-    std::uniform_int_distribution<int> Uni;
-    DataTable* m_table;
+    ParameterAccumulator m_accumulator;
+    MonteCarloSampler m_sampler;
+    /* Blocks refitted outside the threads - restored from a checkpoint or done by worker processes */
+    QMap<int, ParameterAccumulator> m_done_blocks;
+    QHash<int, QJsonObject> m_done_models;
     bool m_generate;
     int m_steps;
     qint64 m_t0 = 0;
@@ -21,15 +21,16 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QHash>
 #include <QtCore/QMutexLocker>
-#include <QtCore/QRandomGenerator>
 
 #include "src/core/models/models.h"
 
 #include "src/core/libmath.h"
 #include "src/core/minimizer.h"
+#include "src/core/randomstream.h"
 #include "src/core/toolset.h"
 
 #include "src/capabilities/montecarlostatistics.h"
+#include "src/capabilities/workerpool.h"
 
 #include <cmath>
 #include <iostream>
@@ -72,7 +73,7 @@ void ResampleAnalyse::CrossValidation()
     int type = m_controller["CXO"].toInt();
     QHash<int, Pair> block;
     int blocksize;
-    int maxthreads = qApp->instance()->property("threads").toInt();
+    int maxthreads = m_context.Threads();
     QPointer<DataTable> table = new DataTable(m_model->DependentModel());
     QVector<QPointer<MonteCarloBatch>> threads;
 
@@ -156,6 +157,16 @@ void ResampleAnalyse::CrossValidation()
 
         double ratio = double(steps) / double(maxsteps);
 
+        /* The left-out sets are drawn from a counter-based stream, a given RandomSeed repeats them */
+        qint64 seed = RandomSeed();
+        /* A resumed run has to leave out the very same sets as the one it continues */
+        if (m_checkpoint && m_checkpoint->Resumed() && m_checkpoint->hasSeed())
+            seed = m_checkpoint->Seed();
+        if (m_checkpoint)
+            m_checkpoint->setSeed(seed);
+        m_controller["RandomSeed"] = seed;
+        RandomStream stream(seed, RandomJob::CrossValidation, 0);
+
         /* There is an ongoing process here, in the end, an ideal algorithm selection should be placed here
          *
          * The short start is:
@@ -197,7 +208,7 @@ void ResampleAnalyse::CrossValidation()
 
                 QVector<int> vector;
                 while (vector.size() < X) {
-                    int index = QRandomGenerator::global()->bounded(0, points);
+                    int index = int(stream.Bounded(points));
                     if (vector.contains(index))
                         continue;
                     vector << index;
@@ -310,7 +321,7 @@ void ResampleAnalyse::CrossValidation()
                 emit Message(tr("Running %1 jobs!").arg(steps));
 
                 while (used_indicies.size() < steps) {
-                    int index = QRandomGenerator::global()->bounded(0, vector_block.size());
+                    int index = int(stream.Bounded(vector_block.size()));
 
                     QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
 
@@ -346,14 +357,40 @@ void ResampleAnalyse::CrossValidation()
         }
         break;
     }
-    emit setMaximumSteps(m_batch.size());
     m_controller["MaxSteps"] = m_batch.size();
-    for (int i = 0; i < maxthreads; ++i) {
+    bool left_out_points = m_controller["LeftOutPoints"].toBool();
+    bool store_raw = m_controller["StoreRaw"].toBool();
+
+    /* Refits done outside the threads - restored from a checkpoint or by worker processes */
+    BatchResults done;
+    if (m_checkpoint && m_checkpoint->Resumed()) {
+        SkipCompleted(m_checkpoint->Restored());
+        done = m_checkpoint->Restored();
+        std::cout << "Resumed " << done.Count() << " calculation from " << m_checkpoint->FilePath().toStdString() << std::endl;
+    }
+    emit setMaximumSteps(m_batch.size());
+
+    /* Worker processes take the queue first, the threads only refit what they left over */
+    bool start_threads = true;
+    if (m_workers) {
+        WorkerPool::Task task;
+        task.checked = true;
+        task.store_models = left_out_points || store_raw;
+        task.checkpoint = m_checkpoint;
+        m_workers->Process(this, m_model, task);
+        done.merge(m_workers->Results());
+        std::cout << "Worker processes performed " << m_workers->Results().Count() << " calculation." << std::endl;
+        start_threads = Queued() > 0 && !m_workers->Interrupted();
+    }
+    for (int i = 0; start_threads && i < maxthreads; ++i) {
         QPointer<MonteCarloBatch> thread = new MonteCarloBatch(this);
         thread->setChecked(true);
         connect(thread, SIGNAL(IncrementProgress(int)), this, SIGNAL(IncrementProgress(int)), Qt::DirectConnection);
-        connect(this, &ResampleAnalyse::InterruptAll, thread, &MonteCarloBatch::Interrupt);
+        connect(this, &ResampleAnalyse::InterruptAll, thread, &MonteCarloBatch::Interrupt, Qt::DirectConnection);
         thread->setModel(m_model);
+        /* The refitted models are only needed for the left-out points and the raw block */
+        thread->setAccumulate(left_out_points || store_raw, !m_controller["LightWeight"].toBool());
+        thread->setCheckpoint(m_checkpoint);
         threads << thread;
         m_threadpool->start(thread);
     }
@@ -365,36 +402,45 @@ void ResampleAnalyse::CrossValidation()
 
     if (more_message)
         emit Message(tr("Final evaluation in progress! Sorry, but this is done in serial mode - no parallelisation right now!"));
-    bool left_out_points = m_controller["LeftOutPoints"].toBool();
     // NOTE: Parallelization candidate for future implementation - Claude Generated
     QSharedPointer<AbstractModel> calc_model = m_model->Clone();
     QJsonObject chart_block;
     int calculation = 0;
+    ParameterAccumulator accumulator;
+    accumulator.setModel(m_model.data(), !m_controller["LightWeight"].toBool());
+
+    auto collect = [&](const QHash<int, QJsonObject>& models) {
+        for (const QJsonObject& model : models) {
+            QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+            if (left_out_points) {
+                int index = models.key(model);
+                QVector<int> indicies = m_job.value(index);
+
+                calc_model->ImportModel(model);
+                calc_model->Calculate();
+                QString points = QString();
+                for (int j : indicies) {
+                    if (m_model->DependentModel()->isRowChecked(j))
+                        points = points + ToolSet::DoubleList2String(m_model->ModelTable()->Row(j)) + "|";
+                }
+                points.truncate(points.size() - 1);
+                chart_block[ToolSet::IntVec2String(indicies)] = points;
+            }
+            if (store_raw)
+                m_models << model;
+        }
+    };
+
+    for (const ParameterAccumulator& block : done.Accumulate(m_model, !m_controller["LightWeight"].toBool()))
+        accumulator.merge(block);
+    collect(done.models);
 
     for (int i = 0; i < threads.size(); ++i) {
         if (threads[i]) {
-            QHash<int, QJsonObject> models = threads[i]->Models();
+            accumulator.merge(threads[i]->Accumulator());
             std::cout << "Thread " << i << " performed " << threads[i]->Counter() << " calculation in " << threads[i]->Timer() << " msecs." << std::endl;
             calculation += threads[i]->Counter();
-
-            for (const QJsonObject& model : models) {
-                QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-                if (left_out_points) {
-                    int index = models.key(model);
-                    QVector<int> indicies = m_job.value(index);
-
-                    calc_model->ImportModel(model);
-                    calc_model->Calculate();
-                    QString points = QString();
-                    for (int j : indicies) {
-                        if (m_model->DependentModel()->isRowChecked(j))
-                            points = points + ToolSet::DoubleList2String(m_model->ModelTable()->Row(j)) + "|";
-                    }
-                    points.truncate(points.size() - 1);
-                    chart_block[ToolSet::IntVec2String(indicies)] = points;
-                }
-                m_models << model;
-            }
+            collect(threads[i]->Models());
             delete threads[i];
         }
     }
@@ -411,10 +457,8 @@ void ResampleAnalyse::CrossValidation()
         m_controller["DependentModel"] = m_model->DependentModel()->ExportTable(true);
     }
 
-    if (m_models.size()) {
-        m_results = ToolSet::Model2Parameter(m_models);
-        ToolSet::Parameter2Statistic(m_results, m_model.data());
-    }
+    if (accumulator.Count())
+        m_results = accumulator.Parameter(m_model.data(), accumulator.Evaluate(5, 10, m_controller["EntropyBins"].toInt(qApp->instance()->property("EntropyBins").toInt()), m_context));
     if (table)
         delete table;
     emit AnalyseFinished();
@@ -424,7 +468,7 @@ void ResampleAnalyse::PlainReduction()
 {
     m_controller["xlabel"] = m_model.data()->XLabel();
     m_controller["Cutoff"] = m_model.data()->ReductionCutOff();
-    int maxthreads = qApp->instance()->property("threads").toInt();
+    int maxthreads = m_context.Threads();
     m_threadpool->setMaxThreadCount(maxthreads);
     QPointer<DataTable> table = m_model->DependentModel();
     emit setMaximumSteps(m_model->DataEnd() - 4);
@@ -48,6 +48,7 @@ public:
     {
         m_model = model->Clone();
         m_model->detach();
+        m_model->setExecutionContext(ThreadContext());
     }
 
 public slots:
@@ -192,7 +192,7 @@ bool WeakenedGridSearch::Run()
 
     m_model.data()->Calculate();
     QList<QPair<QPointer<WGSearchThread>, QPointer<WGSearchThread>>> threads;
-    int maxthreads = qApp->instance()->property("threads").toInt();
+    int maxthreads = m_context.Threads();
     m_threadpool->setMaxThreadCount(maxthreads);
 
     QList<int> global_param, local_param, list_parameter;
@@ -226,9 +226,7 @@ bool WeakenedGridSearch::Run()
     }
 
     if (!m_model.data()->SupportThreads()) {
-        while (m_threadpool->activeThreadCount()) {
-            QCoreApplication::processEvents();
-        }
+        WaitForThreads();
     }
     m_multicore_time = QDateTime::currentMSecsSinceEpoch() - t0;
 
@@ -0,0 +1,621 @@
+/*
+ * SupraFit - resampling batches on worker processes
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "src/core/models/dataclass.h"
+#include "src/core/models/datatable.h"
+#include "src/core/models/models.h"
+
+#include "src/global.h"
+
+#include <QtCore/QCborArray>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QEventLoop>
+#include <QtCore/QProcess>
+#include <QtCore/QQueue>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTimer>
+#include <QtCore/QtEndian>
+
+#include <algorithm>
+
+#include "montecarlostatistics.h"
+
+#include "workerpool.h"
+
+namespace {
+/* Feeds the batches of one frame to a MonteCarloBatch inside the worker */
+class WorkerShard : public AbstractSearchClass {
+public:
+    inline void Enqueue(const QHash<int, Pair>& batch) { m_batch.enqueue(batch); }
+    inline bool Run() override { return true; }
+};
+
+const qint64 MaxFrame = qint64(1) << 30;
+
+QCborValue FromVector(const QVector<qreal>& vector)
+{
+    return WorkerProtocol::FromMatrix(Eigen::Map<const Eigen::VectorXd>(vector.data(), vector.size()));
+}
+
+QVector<qreal> ToVector(const QCborValue& value)
+{
+    const Eigen::MatrixXd matrix = WorkerProtocol::ToMatrix(value);
+    return QVector<qreal>(matrix.data(), matrix.data() + matrix.size());
+}
+
+QCborMap Error(const QString& message)
+{
+    QCborMap error;
+    error[QStringLiteral("type")] = QStringLiteral("error");
+    error[QStringLiteral("message")] = message;
+    return error;
+}
+}
+
+QByteArray WorkerProtocol::Frame(const QCborMap& message)
+{
+    const QByteArray body = message.toCborValue().toCbor();
+    QByteArray frame(4, Qt::Uninitialized);
+    qToBigEndian<quint32>(quint32(body.size()), frame.data());
+    return frame + body;
+}
+
+bool WorkerProtocol::TakeFrame(QByteArray& buffer, QCborMap& message)
+{
+    if (buffer.size() < 4)
+        return false;
+    const qint64 size = qFromBigEndian<quint32>(buffer.constData());
+    if (buffer.size() < 4 + size)
+        return false;
+    message = QCborValue::fromCbor(buffer.mid(4, size)).toMap();
+    buffer.remove(0, 4 + size);
+    return true;
+}
+
+bool WorkerProtocol::ReadFrame(QIODevice* device, QCborMap& message)
+{
+    /* Files (the standard input of the worker) block in read() and return 0 only at their end,
+     * sockets and processes have to be waited for */
+    const bool file = device->inherits("QFileDevice");
+    auto readExact = [device, file](char* data, qint64 size) -> bool {
+        qint64 done = 0;
+        while (done < size) {
+            const qint64 read = device->read(data + done, size - done);
+            if (read < 0)
+                return false;
+            if (read == 0 && (file || !device->waitForReadyRead(-1)))
+                return false;
+            done += read;
+        }
+        return true;
+    };
+
+    char header[4];
+    if (!readExact(header, 4))
+        return false;
+    const qint64 size = qFromBigEndian<quint32>(header);
+    if (size > MaxFrame)
+        return false;
+    QByteArray body(size, Qt::Uninitialized);
+    if (!readExact(body.data(), size))
+        return false;
+    message = QCborValue::fromCbor(body).toMap();
+    return true;
+}
+
+bool WorkerProtocol::WriteFrame(QIODevice* device, const QCborMap& message)
+{
+    const QByteArray frame = Frame(message);
+    qint64 done = 0;
+    while (done < frame.size()) {
+        const qint64 written = device->write(frame.constData() + done, frame.size() - done);
+        if (written < 0)
+            return false;
+        done += written;
+    }
+    while (device->bytesToWrite() > 0)
+        if (!device->waitForBytesWritten(-1))
+            break;
+    return true;
+}
+
+QCborValue WorkerProtocol::FromMatrix(const Eigen::MatrixXd& matrix)
+{
+    QByteArray data(matrix.size() * sizeof(double), Qt::Uninitialized);
+    for (Eigen::Index i = 0; i < matrix.size(); ++i)
+        qToLittleEndian<double>(matrix.data()[i], data.data() + i * sizeof(double));
+
+    QCborMap map;
+    map[QStringLiteral("rows")] = qint64(matrix.rows());
+    map[QStringLiteral("cols")] = qint64(matrix.cols());
+    map[QStringLiteral("data")] = data;
+    return map;
+}
+
+Eigen::MatrixXd WorkerProtocol::ToMatrix(const QCborValue& value)
+{
+    const QCborMap map = value.toMap();
+    const qint64 rows = map[QStringLiteral("rows")].toInteger();
+    const qint64 cols = map[QStringLiteral("cols")].toInteger();
+    const QByteArray data = map[QStringLiteral("data")].toByteArray();
+    if (rows < 0 || cols < 0 || data.size() != qint64(rows * cols * sizeof(double)))
+        return Eigen::MatrixXd();
+
+    Eigen::MatrixXd matrix(rows, cols);
+    for (Eigen::Index i = 0; i < matrix.size(); ++i)
+        matrix.data()[i] = qFromLittleEndian<double>(data.constData() + i * sizeof(double));
+    return matrix;
+}
+
+QCborValue WorkerProtocol::FromTable(const DataTable* table)
+{
+    if (!table)
+        return QCborValue();
+    QCborMap map;
+    map[QStringLiteral("table")] = FromMatrix(table->Table());
+    map[QStringLiteral("checked")] = FromMatrix(table->CheckedTable());
+    map[QStringLiteral("header")] = QCborArray::fromStringList(table->header());
+    return map;
+}
+
+DataTable* WorkerProtocol::ToTable(const QCborValue& value)
+{
+    if (!value.isMap())
+        return nullptr;
+    const QCborMap map = value.toMap();
+    QStringList header;
+    for (const QCborValue& entry : map[QStringLiteral("header")].toArray())
+        header << entry.toString();
+    return new DataTable(ToMatrix(map[QStringLiteral("table")]), ToMatrix(map[QStringLiteral("checked")]), header);
+}
+
+int WorkerProtocol::Serve(QIODevice* input, QIODevice* output)
+{
+    QCborMap hello;
+    hello[QStringLiteral("type")] = QStringLiteral("hello");
+    hello[QStringLiteral("protocol")] = Version;
+    hello[QStringLiteral("version")] = qint_version;
+    if (!WriteFrame(output, hello))
+        return 1;
+
+    /* The data outlive the model that was created from them */
+    QScopedPointer<DataClass> data;
+    QSharedPointer<AbstractModel> model;
+    MonteCarloSampler sampler;
+    bool use_sampler = false, checked = false, store_models = false;
+
+    QCborMap message;
+    while (ReadFrame(input, message)) {
+        const QString type = message[QStringLiteral("type")].toString();
+        if (type == QLatin1String("quit"))
+            break;
+
+        if (type == QLatin1String("setup")) {
+            model.clear();
+            delete sampler.dependent;
+            delete sampler.independent;
+            sampler = MonteCarloSampler();
+
+            const QJsonObject json = message[QStringLiteral("model")].toJsonValue().toObject();
+            data.reset(new DataClass(message[QStringLiteral("data")].toJsonValue().toObject()));
+            model = CreateModel(json["model"].toInt(), QPointer<DataClass>(data.data()));
+            if (!model) {
+                WriteFrame(output, Error(QStringLiteral("Model %1 is not known to this worker").arg(json["model"].toInt())));
+                continue;
+            }
+            model->ImportModel(json);
+            model->setOptimizerConfig(message[QStringLiteral("optimizer")].toJsonValue().toObject());
+
+            /* The exported tables are rounded, the exact ones replace them */
+            DataTable* independent = ToTable(message[QStringLiteral("independent")]);
+            DataTable* dependent = ToTable(message[QStringLiteral("dependent")]);
+            if (!independent || !dependent) {
+                delete independent;
+                delete dependent;
+                model.clear();
+                WriteFrame(output, Error(QStringLiteral("The setup carries no complete data tables")));
+                continue;
+            }
+            model->OverrideInDependentTable(independent);
+            const Eigen::MatrixXd dependent_checked = dependent->CheckedTable();
+            model->OverrideDependentTable(dependent);
+            dependent->setCheckedTable(dependent_checked);
+            model->GlobalTable()->setTable(ToMatrix(message[QStringLiteral("global")]));
+            model->LocalTable()->setTable(ToMatrix(message[QStringLiteral("local")]));
+            model->setDataBegin(message[QStringLiteral("begin")].toInteger());
+            model->setDataEnd(message[QStringLiteral("end")].toInteger());
+            model->setFast(true);
+
+            checked = message[QStringLiteral("checked")].toBool();
+            store_models = message[QStringLiteral("store_models")].toBool();
+            use_sampler = message.contains(QStringLiteral("sampler"));
+            if (use_sampler) {
+                const QCborMap recipe = message[QStringLiteral("sampler")].toMap();
+                sampler.dependent = ToTable(recipe[QStringLiteral("dependent")]);
+                sampler.independent = ToTable(recipe[QStringLiteral("independent")]);
+                sampler.residuals = ToVector(recipe[QStringLiteral("residuals")]);
+                sampler.independent_sigma = ToVector(recipe[QStringLiteral("independent_sigma")]);
+                for (qreal column : ToVector(recipe[QStringLiteral("independent_cols")]))
+                    sampler.independent_cols << int(column);
+                sampler.sigma = recipe[QStringLiteral("sigma")].toDouble();
+                sampler.seed = quint64(recipe[QStringLiteral("seed")].toInteger());
+                sampler.bootstrap = recipe[QStringLiteral("bootstrap")].toBool();
+                if (!sampler.dependent || !sampler.independent) {
+                    model.clear();
+                    WriteFrame(output, Error(QStringLiteral("The sampler carries no complete data tables")));
+                }
+            }
+            continue;
+        }
+
+        if (type != QLatin1String("batch")) {
+            WriteFrame(output, Error(QStringLiteral("Unknown message %1").arg(type)));
+            continue;
+        }
+        if (!model) {
+            WriteFrame(output, Error(QStringLiteral("Batch without a model")));
+            continue;
+        }
+
+        /* Without a sampler every step brings its tables; they belong to the model that holds them last */
+        QHash<int, Pair> batch;
+        QVector<QPointer<DataTable>> tables;
+        const QCborMap entries = message[QStringLiteral("tables")].toMap();
+        for (const QCborValue& step : message[QStringLiteral("steps")].toArray()) {
+            const QCborMap entry = entries[step.toInteger()].toMap();
+            Pair pair;
+            if (!entry.isEmpty()) {
+                pair = Pair(ToTable(entry[QStringLiteral("independent")]), ToTable(entry[QStringLiteral("dependent")]));
+                tables << pair.first << pair.second;
+            }
+            batch.insert(int(step.toInteger()), pair);
+        }
+
+        const qint64 t0 = QDateTime::currentMSecsSinceEpoch();
+        QCborArray steps;
+        {
+            WorkerShard shard;
+            shard.Enqueue(batch);
+            MonteCarloBatch thread(&shard);
+            thread.setChecked(checked);
+            thread.setModel(model);
+            thread.setAccumulate(store_models, false);
+            thread.setKeepParameters(true);
+            if (use_sampler)
+                thread.setSampler(&sampler);
+            thread.run();
+
+            const QHash<int, QJsonObject> models = thread.Models();
+            const auto& parameters = thread.Parameters();
+            for (auto step = parameters.cbegin(); step != parameters.cend(); ++step) {
+                QCborMap entry;
+                entry[QStringLiteral("step")] = step.key();
+                entry[QStringLiteral("global")] = FromMatrix(step.value().first);
+                entry[QStringLiteral("local")] = FromMatrix(step.value().second);
+                if (store_models)
+                    entry[QStringLiteral("model")] = QCborValue::fromJsonValue(models.value(step.key()));
+                steps << entry;
+            }
+        }
+        for (const QPointer<DataTable>& table : qAsConst(tables))
+            delete table;
+
+        QCborMap result;
+        result[QStringLiteral("type")] = QStringLiteral("result");
+        result[QStringLiteral("steps")] = steps;
+        result[QStringLiteral("msecs")] = QDateTime::currentMSecsSinceEpoch() - t0;
+        if (!WriteFrame(output, result))
+            return 1;
+    }
+    model.clear();
+    delete sampler.dependent;
+    delete sampler.independent;
+    return 0;
+}
+
+WorkerPool::WorkerPool(QObject* parent)
+    : QObject(parent)
+{
+}
+
+WorkerPool::~WorkerPool()
+{
+    for (Worker& worker : m_pool)
+        Stop(worker);
+}
+
+void WorkerPool::ReadSettings()
+{
+    m_workers = qApp->instance()->property("workers").toInt();
+    m_program = qApp->instance()->property("WorkerProgram").toString();
+    m_commands.clear();
+    for (const QString& command : qApp->instance()->property("WorkerCommands").toString().split(';'))
+        if (!command.trimmed().isEmpty())
+            m_commands << command.trimmed();
+}
+
+void WorkerPool::Interrupt()
+{
+    m_interrupt = true;
+}
+
+void WorkerPool::Stop(Worker& worker)
+{
+    /* Taken out of the pool and disconnected before waiting: waitForFinished() delivers finished() and
+     * errorOccurred() synchronously, and their handlers must neither see this worker again nor count
+     * its batch as failed a second time. Stop() may itself run inside such a signal. */
+    QProcess* process = worker.process;
+    const bool busy = worker.busy;
+    worker = Worker();
+    if (!process)
+        return;
+    process->disconnect();
+    if (process->state() != QProcess::NotRunning && !busy) {
+        QCborMap quit;
+        quit[QStringLiteral("type")] = QStringLiteral("quit");
+        process->write(WorkerProtocol::Frame(quit));
+        process->closeWriteChannel();
+        if (!process->waitForFinished(1000))
+            process->kill();
+    } else
+        process->kill();
+    process->waitForFinished(1000);
+    process->deleteLater();
+}
+
+bool WorkerPool::Start()
+{
+    for (int i = m_pool.size() - 1; i >= 0; --i) {
+        if (!m_pool[i].process || m_pool[i].process->state() != QProcess::Running) {
+            Stop(m_pool[i]);
+            m_pool.remove(i);
+        }
+    }
+
+    QString program = m_program;
+    if (program.isEmpty())
+        program = QStandardPaths::findExecutable("suprafit_worker", QStringList() << QCoreApplication::applicationDirPath());
+    if (program.isEmpty())
+        program = QStandardPaths::findExecutable("suprafit_worker");
+
+    QList<QStringList> commands;
+    for (int i = 0; i < m_workers && !program.isEmpty(); ++i)
+        commands << (QStringList() << program);
+    for (const QString& command : qAsConst(m_commands))
+        commands << QProcess::splitCommand(command);
+
+    for (int i = m_pool.size(); i < commands.size(); ++i) {
+        const QStringList& command = commands[i];
+        if (command.isEmpty())
+            continue;
+        Worker worker;
+        worker.process = new QProcess(this);
+        worker.process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+        worker.process->start(command.first(), command.mid(1));
+
+        /* The worker greets first; a mismatching protocol (another version on a remote machine) is refused */
+        QCborMap hello;
+        while (worker.process->waitForReadyRead(30000)) {
+            worker.buffer += worker.process->readAllStandardOutput();
+            if (WorkerProtocol::TakeFrame(worker.buffer, hello))
+                break;
+        }
+        if (hello[QStringLiteral("type")].toString() == QLatin1String("hello") && hello[QStringLiteral("protocol")].toInteger() == WorkerProtocol::Version) {
+            m_pool << worker;
+        } else {
+            emit Message(tr("Worker %1 did not start, its share is done by the threads.").arg(command.join(' ')));
+            Stop(worker);
+        }
+    }
+    return !m_pool.isEmpty();
+}
+
+QCborMap WorkerPool::Setup(const QSharedPointer<AbstractModel>& model, const Task& task) const
+{
+    QCborMap setup;
+    setup[QStringLiteral("type")] = QStringLiteral("setup");
+    setup[QStringLiteral("model")] = QCborValue::fromJsonValue(model->ExportModel(false, false));
+    setup[QStringLiteral("data")] = QCborValue::fromJsonValue(model->ExportData());
+    setup[QStringLiteral("optimizer")] = QCborValue::fromJsonValue(model->getOptimizerConfig());
+    setup[QStringLiteral("independent")] = WorkerProtocol::FromTable(model->IndependentModel());
+    setup[QStringLiteral("dependent")] = WorkerProtocol::FromTable(model->DependentModel());
+    setup[QStringLiteral("global")] = WorkerProtocol::FromMatrix(model->GlobalTable()->Table());
+    setup[QStringLiteral("local")] = WorkerProtocol::FromMatrix(model->LocalTable()->Table());
+    setup[QStringLiteral("begin")] = model->DataBegin();
+    setup[QStringLiteral("end")] = model->DataEnd();
+    setup[QStringLiteral("checked")] = task.checked;
+    setup[QStringLiteral("store_models")] = task.store_models;
+
+    if (task.sampler) {
+        const MonteCarloSampler* sampler = task.sampler;
+        QVector<qreal> cols;
+        for (int column : sampler->independent_cols)
+            cols << column;
+        QCborMap recipe;
+        recipe[QStringLiteral("dependent")] = WorkerProtocol::FromTable(sampler->dependent);
+        recipe[QStringLiteral("independent")] = WorkerProtocol::FromTable(sampler->independent);
+        recipe[QStringLiteral("residuals")] = FromVector(sampler->residuals);
+        recipe[QStringLiteral("independent_sigma")] = FromVector(sampler->independent_sigma);
+        recipe[QStringLiteral("independent_cols")] = FromVector(cols);
+        recipe[QStringLiteral("sigma")] = sampler->sigma;
+        recipe[QStringLiteral("seed")] = qint64(sampler->seed);
+        recipe[QStringLiteral("bootstrap")] = sampler->bootstrap;
+        setup[QStringLiteral("sampler")] = recipe;
+    }
+    return setup;
+}
+
+bool WorkerPool::Process(AbstractSearchClass* search, const QSharedPointer<AbstractModel>& model, const Task& task)
+{
+    m_results.clear();
+    m_interrupt = false;
+
+    /* A meta model is made of several data sets, a worker can not rebuild it from one */
+    if (!Size() || !search || !model || model->SFModel() == SupraFit::MetaModel)
+        return false;
+    if (!Start())
+        return false;
+
+    const QByteArray setup = WorkerProtocol::Frame(Setup(model, task));
+    QQueue<QHash<int, Pair>> retry;
+    QHash<int, int> failures;
+    QEventLoop loop;
+
+    auto firstStep = [](const QHash<int, Pair>& batch) {
+        const QList<int> steps = batch.keys();
+        return *std::min_element(steps.begin(), steps.end());
+    };
+
+    auto done = [&]() {
+        for (const Worker& worker : qAsConst(m_pool))
+            if (worker.busy)
+                return;
+        loop.quit();
+    };
+
+    auto dispatch = [&](int index) {
+        Worker& worker = m_pool[index];
+        worker.busy = false;
+        worker.batch.clear();
+        if (m_interrupt)
+            return;
+        const QHash<int, Pair> batch = retry.isEmpty() ? search->DemandCalc() : retry.dequeue();
+        if (batch.isEmpty())
+            return;
+
+        QList<int> keys = batch.keys();
+        std::sort(keys.begin(), keys.end());
+        QCborArray steps;
+        QCborMap tables;
+        for (int key : qAsConst(keys)) {
+            steps << key;
+            const Pair& pair = batch[key];
+            if (pair.first && pair.second) {
+                QCborMap entry;
+                entry[QStringLiteral("independent")] = WorkerProtocol::FromTable(pair.first);
+                entry[QStringLiteral("dependent")] = WorkerProtocol::FromTable(pair.second);
+                tables[key] = entry;
+            }
+        }
+        QCborMap message;
+        message[QStringLiteral("type")] = QStringLiteral("batch");
+        message[QStringLiteral("steps")] = steps;
+        message[QStringLiteral("tables")] = tables;
+        worker.batch = batch;
+        worker.busy = true;
+        worker.process->write(WorkerProtocol::Frame(message));
+    };
+
+    auto fail = [&](int index) {
+        Worker& worker = m_pool[index];
+        if (!worker.process)
+            return;
+        if (worker.busy) {
+            const int first = firstStep(worker.batch);
+            if (++failures[first] < 2)
+                retry.enqueue(worker.batch);
+            else {
+                /* Refitted by the threads of this process, like the retries nobody took */
+                emit Message(tr("Steps from %1 on failed on two workers and are left to the threads.").arg(first));
+                search->Requeue(worker.batch);
+            }
+        }
+        emit Message(tr("A worker process stopped, its batches are taken by the others."));
+        Stop(worker);
+        /* The batch given back has to find a new worker */
+        for (int i = 0; i < m_pool.size(); ++i)
+            if (m_pool[i].process && !m_pool[i].busy && !retry.isEmpty())
+                dispatch(i);
+        done();
+    };
+
+    auto receive = [&](int index) {
+        Worker& worker = m_pool[index];
+        if (!worker.process)
+            return;
+        worker.buffer += worker.process->readAllStandardOutput();
+        QCborMap message;
+        while (worker.process && WorkerProtocol::TakeFrame(worker.buffer, message)) {
+            if (message[QStringLiteral("type")].toString() != QLatin1String("result")) {
+                emit Message(tr("Worker error: %1").arg(message[QStringLiteral("message")].toString()));
+                fail(index);
+                return;
+            }
+            BatchResults batch;
+            QVector<int> block;
+            for (const QCborValue& value : message[QStringLiteral("steps")].toArray()) {
+                const QCborMap entry = value.toMap();
+                const int step = int(entry[QStringLiteral("step")].toInteger());
+                block << step;
+                batch.parameters.insert(step, qMakePair(WorkerProtocol::ToMatrix(entry[QStringLiteral("global")]), WorkerProtocol::ToMatrix(entry[QStringLiteral("local")])));
+                if (entry.contains(QStringLiteral("model")))
+                    batch.models.insert(step, entry[QStringLiteral("model")].toJsonValue().toObject());
+            }
+            batch.addBlock(block);
+            if (task.checkpoint)
+                task.checkpoint->Record(batch);
+            m_results.merge(batch);
+            emit IncrementProgress(int(message[QStringLiteral("msecs")].toInteger()));
+            dispatch(index);
+        }
+        done();
+    };
+
+    for (int i = 0; i < m_pool.size(); ++i) {
+        QProcess* process = m_pool[i].process;
+        connect(process, &QProcess::readyReadStandardOutput, &loop, [&receive, i]() { receive(i); });
+        connect(process, &QProcess::finished, &loop, [&fail, i]() { fail(i); });
+        connect(process, &QProcess::errorOccurred, &loop, [&fail, i](QProcess::ProcessError error) {
+            if (error == QProcess::Crashed || error == QProcess::WriteError || error == QProcess::FailedToStart)
+                fail(i);
+        });
+        process->write(setup);
+    }
+
+    QTimer interrupt;
+    connect(&interrupt, &QTimer::timeout, &loop, [&]() {
+        if (!m_interrupt)
+            return;
+        for (Worker& worker : m_pool)
+            if (worker.busy)
+                Stop(worker);
+        loop.quit();
+    });
+    interrupt.start(100);
+
+    for (int i = 0; i < m_pool.size(); ++i)
+        dispatch(i);
+    bool busy = false;
+    for (const Worker& worker : qAsConst(m_pool))
+        busy = busy || worker.busy;
+    if (busy)
+        loop.exec(QEventLoop::ExcludeUserInputEvents);
+
+    for (const Worker& worker : qAsConst(m_pool))
+        if (worker.process)
+            disconnect(worker.process, nullptr, &loop, nullptr);
+    m_pool.erase(std::remove_if(m_pool.begin(), m_pool.end(), [](const Worker& worker) { return !worker.process; }), m_pool.end());
+
+    /* Work nobody could do goes back to the threads of this process */
+    while (!retry.isEmpty())
+        search->Requeue(retry.dequeue());
+    return !m_interrupt && search->Queued() == 0;
+}
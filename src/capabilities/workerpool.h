@@ -0,0 +1,145 @@
+/*
+ * SupraFit - resampling batches on worker processes
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "abstractsearchclass.h"
+#include "jobcheckpoint.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QCborMap>
+#include <QtCore/QCborValue>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include <atomic>
+
+class DataTable;
+class QIODevice;
+class QProcess;
+struct MonteCarloSampler;
+
+/*! \brief Task protocol between JobManager and suprafit_worker
+ *
+ * Every message is one frame: a 32 bit big endian length followed by a CBOR map with a "type".
+ * The worker greets with "hello" (protocol version, SupraFit version), receives one "setup" with the
+ * model, the data and the exact start tables, then any number of "batch" frames, each answered by
+ * a "result" (or an "error"), until "quit" or the end of its input. Matrices travel as little endian
+ * doubles, so the refits see exactly the numbers of the coordinator. The frames run over any
+ * QIODevice - the pipes of a local QProcess, or a remote shell that starts the worker elsewhere.
+ */
+namespace WorkerProtocol {
+const int Version = 1;
+
+QByteArray Frame(const QCborMap& message);
+
+/*! \brief Take the next complete frame from the front of \a buffer, false if there is none yet */
+bool TakeFrame(QByteArray& buffer, QCborMap& message);
+
+/*! \brief Blocking read of one frame, false at the end of the input */
+bool ReadFrame(QIODevice* device, QCborMap& message);
+bool WriteFrame(QIODevice* device, const QCborMap& message);
+
+QCborValue FromMatrix(const Eigen::MatrixXd& matrix);
+Eigen::MatrixXd ToMatrix(const QCborValue& value);
+
+/*! \brief Table and checked table of \a table; ToTable() returns a new table owned by the caller */
+QCborValue FromTable(const DataTable* table);
+DataTable* ToTable(const QCborValue& value);
+
+/*! \brief Answer the frames on \a input until "quit" or its end, returns the exit code of the worker */
+int Serve(QIODevice* input, QIODevice* output);
+}
+
+/*! \brief Refits the batch queue of an AbstractSearchClass on worker processes
+ *
+ * Each worker is a suprafit_worker process, started locally ("workers" processes of "WorkerProgram")
+ * or by a command that runs it on another machine, e.g. "ssh node1 suprafit_worker" ("WorkerCommands").
+ * Every worker fetches one batch at a time with DemandCalc() and refits it exactly like a MonteCarloBatch
+ * thread would, starting from the same parameters. The refits are collected per step, so the merged
+ * result does not depend on the number of workers or on which worker took which batch.
+ *
+ * A worker that dies (a crashing script model, a lost connection) is dropped and its batch is handed to
+ * another one; a batch that fails twice is given up. Whatever could not be done is put back into the
+ * queue, where the threads of the calling process pick it up. The processes are kept between jobs.
+ */
+class WorkerPool : public QObject {
+    Q_OBJECT
+
+public:
+    /*! \brief What the workers need besides the model: the batches of Monte Carlo only carry the step
+     * index and are drawn from \a sampler, the tables of cross validation only change the checked rows */
+    struct Task {
+        const MonteCarloSampler* sampler = nullptr;
+        bool checked = false;
+        bool store_models = false;
+        JobCheckpoint* checkpoint = nullptr;
+    };
+
+    explicit WorkerPool(QObject* parent = nullptr);
+    ~WorkerPool();
+
+    inline void setWorkers(int workers) { m_workers = workers; }
+    inline void setProgram(const QString& program) { m_program = program; }
+    inline void setCommands(const QStringList& commands) { m_commands = commands; }
+
+    /*! \brief Number of workers configured, zero if the pool is not used */
+    inline int Size() const { return qMax(m_workers, 0) + m_commands.size(); }
+
+    /*! \brief Take "workers", "WorkerProgram" and "WorkerCommands" (separated by ';') from the application */
+    void ReadSettings();
+
+    /*! \brief Refit the queue of \a search on the workers; false if some of it was left to the threads */
+    bool Process(AbstractSearchClass* search, const QSharedPointer<AbstractModel>& model, const Task& task);
+
+    /*! \brief Refits of the last Process(); the models only if the task stored them */
+    inline const BatchResults& Results() const { return m_results; }
+    inline bool Interrupted() const { return m_interrupt; }
+
+public slots:
+    void Interrupt();
+
+private:
+    struct Worker {
+        QProcess* process = nullptr;
+        QByteArray buffer;
+        QHash<int, Pair> batch;
+        bool busy = false;
+    };
+
+    bool Start();
+    void Stop(Worker& worker);
+    QCborMap Setup(const QSharedPointer<AbstractModel>& model, const Task& task) const;
+
+    QVector<Worker> m_pool;
+    int m_workers = 0;
+    QString m_program;
+    QStringList m_commands;
+    std::atomic<bool> m_interrupt = false;
+
+    BatchResults m_results;
+
+signals:
+    void IncrementProgress(int msecs);
+    void Message(const QString& str);
+};
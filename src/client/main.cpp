@@ -30,6 +30,8 @@
 
 #include <QtCore/QFile>
 #include <QtCore/QIODevice>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QtCore/QDir>
 
 #include "src/global.h"
@@ -263,11 +265,19 @@ bool performFileJoin(const QStringList& inputFiles, const QString& outputFile)
     QJsonObject joinedData;
     int projectCounter = 0;
 
-    for (const QString& inputFile : inputFiles) {
+    // Reading and parsing the input files is independent, only the joining below keeps their order
+    QVector<QJsonObject> inputData(inputFiles.size());
+    QThreadPool pool;
+    pool.setMaxThreadCount(qBound(1, int(inputFiles.size()), QThread::idealThreadCount()));
+    for (int i = 0; i < inputFiles.size(); ++i)
+        pool.start([&inputFiles, &inputData, i]() { inputData[i] = JsonHandler::LoadFile(inputFiles[i]); });
+    pool.waitForDone();
+
+    for (int i = 0; i < inputFiles.size(); ++i) {
+        const QString& inputFile = inputFiles[i];
         std::cout << "Processing: " << inputFile.toStdString() << std::endl;
 
-        // Load input file
-        QJsonObject fileData = JsonHandler::LoadFile(inputFile);
+        const QJsonObject& fileData = inputData[i];
         if (fileData.isEmpty()) {
             std::cout << "   ERROR: Could not load file: " << inputFile.toStdString() << std::endl;
             continue;
@@ -575,7 +585,7 @@ bool executeTaskConfiguration(const QString& inputFile, const QString& outputOve
                 
                 // Export with JSON file containing ML RawData (with iteration number)
                 QVector<QString> processedFiles;
-                processedFiles.append(core->OutFile() + "-0.json");
+                processedFiles.append(core->StreamResults() ? core->MLProjectStreamFile() : core->OutFile() + "-0.json");
                 
                 bool exportSuccess = MlExport::exportMLTrainingData(processedFiles, outputFileName);
                 if (exportSuccess) {
@@ -733,6 +743,12 @@ void showComprehensiveHelp()
     std::cout << "  -j, --join             Join multiple input files into single multi-project file\n";
     std::cout << "  -l, --list             List file structure for debugging\n";
     std::cout << "  -n, --nproc <N>        Number of parallel threads (default: 4)\n";
+    std::cout << "  --workers <N>          Run resampling batches in N worker processes\n";
+    std::cout << "  --worker-command <cmd> Start an additional worker with cmd, e.g. on another machine\n";
+    std::cout << "  --resume               Continue interrupted Monte Carlo/cross validation runs from their checkpoint\n";
+    std::cout << "  --no-checkpoint        Do not write checkpoints of Monte Carlo/cross validation runs\n";
+    std::cout << "  --checkpoint-dir <dir> Directory for checkpoints (default: cache location)\n";
+    std::cout << "  --checkpoint-interval <s>  Seconds between checkpoint writes (default: 60)\n";
     std::cout << "  --ml-pipeline          Enable ML pipeline mode\n";
     std::cout << "  --batch-config <file>  Run ML pipeline batch processing\n";
     std::cout << "  -x, --extract-parameters [N]  Extract fitted parameters from models file (optional: specify model index)\n";
@@ -807,6 +823,34 @@ int main(int argc, char** argv)
         "Number of parallel threads", "threads", "4");
     parser.addOption(threads);
 
+    QCommandLineOption noFitCache(QStringList() << "no-fit-cache",
+        "Always refit, do not use the cache of converged fits");
+    parser.addOption(noFitCache);
+
+    QCommandLineOption workers(QStringList() << "workers",
+        "Run Monte Carlo and cross validation batches in N worker processes", "N", "0");
+    parser.addOption(workers);
+
+    QCommandLineOption workerCommand(QStringList() << "worker-command",
+        "Command that starts an additional worker, e.g. \"ssh node1 suprafit_worker\" (repeatable)", "command");
+    parser.addOption(workerCommand);
+
+    QCommandLineOption resume(QStringList() << "resume",
+        "Continue interrupted Monte Carlo and cross validation runs from their checkpoint");
+    parser.addOption(resume);
+
+    QCommandLineOption noCheckpoint(QStringList() << "no-checkpoint",
+        "Do not write checkpoints of Monte Carlo and cross validation runs");
+    parser.addOption(noCheckpoint);
+
+    QCommandLineOption checkpointDir(QStringList() << "checkpoint-dir",
+        "Directory for the checkpoints, e.g. on storage that survives a preempted node", "dir");
+    parser.addOption(checkpointDir);
+
+    QCommandLineOption checkpointInterval(QStringList() << "checkpoint-interval",
+        "Seconds between two writes of a checkpoint", "seconds", "60");
+    parser.addOption(checkpointInterval);
+
     QCommandLineOption project(QStringList() << "p" << "project",
         "Extract specific project from multi-project file (e.g., -p 0 for project_0)", "index");
     parser.addOption(project);
@@ -925,6 +969,13 @@ int main(int argc, char** argv)
     qApp->instance()->setProperty("series_confidence", true);
     qApp->instance()->setProperty("InitialiseRandom", true);
     qApp->instance()->setProperty("StoreRawData", true);
+    qApp->instance()->setProperty("FitCache", !parser.isSet(noFitCache));
+    qApp->instance()->setProperty("workers", parser.value(workers).toInt());
+    qApp->instance()->setProperty("WorkerCommands", parser.values(workerCommand).join(';'));
+    qApp->instance()->setProperty("Checkpoint", !parser.isSet(noCheckpoint));
+    qApp->instance()->setProperty("Resume", parser.isSet(resume) && !parser.isSet(noCheckpoint));
+    qApp->instance()->setProperty("CheckpointDir", parser.value(checkpointDir));
+    qApp->instance()->setProperty("CheckpointInterval", parser.value(checkpointInterval).toInt());
 
     // New simplified CLI logic - Claude Generated
 
@@ -23,6 +23,7 @@
 
 #include "src/capabilities/mlfeatureextractor.h"
 #include "src/core/projectmanager.h"
+#include "src/core/resultsink.h"
 
 #include <QtCore/QDir>
 #include <QtCore/QJsonObject>
@@ -51,7 +52,21 @@ bool MlExport::exportMLTrainingData(const QVector<QString>& inputFiles, const QS
     );
     
     fmt::print("🔧 Extracting ML training data from {} files...\n", inputFiles.size());
-    
+
+    // A *.ndjson target receives one training sample per line as soon as it is extracted,
+    // nothing is collected in memory
+    if (ResultSink::isStream(outputFile)) {
+        ResultSink sink(outputFile);
+        qint64 samples = sink.isOpen() ? extractor->streamTrainingData(inputFiles, [&sink](const QJsonObject& sample) { sink.Append(sample); }) : 0;
+        delete extractor;
+        if (samples == 0) {
+            fmt::print("❌ ERROR: No training samples could be written to {}\n", outputFile.toStdString());
+            return false;
+        }
+        fmt::print("✅ ML training data streamed: {} samples → {}\n", samples, outputFile.toStdString());
+        return true;
+    }
+
     // Extract training samples from all input files
     QVector<QJsonObject> trainingSamples = extractor->extractBatchTrainingData(inputFiles);
     
@@ -96,7 +111,8 @@ bool MlExport::exportMLTrainingDataBatch(const QString& inputDirectory, const QS
 
     // Find all JSON files in directory
     QStringList nameFilters;
-    nameFilters << "*.json";
+    nameFilters << "*.json"
+                << "*.ndjson";
     QStringList jsonFiles = dir.entryList(nameFilters, QDir::Files);
 
     if (jsonFiles.isEmpty()) {
@@ -31,6 +31,7 @@
 
 #include "src/core/analyse.h"
 #include "src/core/jsonhandler.h"
+#include "src/core/resultsink.h"
 #include "src/core/models/models.h"
 
 MLPipelineManager::MLPipelineManager(QObject* parent)
@@ -72,7 +73,7 @@ void MLPipelineManager::runBatchPipeline()
     
     m_isRunning = true;
     m_currentBatch = 0;
-    m_mlDataset.clear();
+    openMLDataset(m_batchConfig["BatchConfig"].toObject()["OutputDir"].toString());
     
     qDebug() << "Starting batch pipeline with" << m_totalBatches << "batches";
     
@@ -354,35 +355,69 @@ void MLPipelineManager::processBatch(int batchId, const QJsonObject& batchConfig
     emit batchCompleted(batchId);
 }
 
-void MLPipelineManager::saveMLDataset(const QString& outputDir, const QVector<QJsonObject>& mlData)
+void MLPipelineManager::openMLDataset(const QString& outputDir)
 {
+    m_mlOutputDir = outputDir;
+    m_mlBatches = 0;
     QDir dir(outputDir);
     if (!dir.exists()) {
         dir.mkpath(".");
     }
-    
-    // Save individual batch results
-    for (int i = 0; i < mlData.size(); ++i) {
-        QString filename = QString("%1/batch_%2.json").arg(outputDir).arg(i);
-        JsonHandler::WriteJsonFile(mlData[i], filename);
+
+    // BatchConfig/ResultSink = "ndjson": one line per batch in a single file, no per-batch files
+    if (m_batchConfig["BatchConfig"].toObject()["ResultSink"].toString().compare("ndjson", Qt::CaseInsensitive) == 0) {
+        m_mlSink.reset(new ResultSink(dir.absoluteFilePath("ml_dataset.ndjson")));
+        return;
     }
-    
-    // Save combined dataset
-    QJsonObject dataset;
-    QJsonArray batches;
-    for (const auto& batch : mlData) {
-        batches.append(batch);
+
+    // The combined dataset gets its batches appended as they finish and the metadata at the end
+    m_mlCombined.setFileName(dir.absoluteFilePath("ml_dataset_combined.json"));
+    if (m_mlCombined.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        m_mlCombined.write("{\"batches\":[");
+    else
+        qWarning() << "Failed to open" << m_mlCombined.fileName();
+}
+
+void MLPipelineManager::saveMLBatch(int batchId, const QJsonObject& batch)
+{
+    if (m_mlSink) {
+        m_mlSink->Append(batch);
+        ++m_mlBatches;
+        return;
     }
-    dataset["batches"] = batches;
-    dataset["metadata"] = QJsonObject{
-        {"total_batches", mlData.size()},
-        {"generation_timestamp", QDateTime::currentDateTime().toString(Qt::ISODate)}
-    };
-    
-    QString combinedFilename = QString("%1/ml_dataset_combined.json").arg(outputDir);
-    JsonHandler::WriteJsonFile(dataset, combinedFilename);
-    
-    qDebug() << "ML dataset saved to" << outputDir;
+
+    // Save the individual batch result
+    QString filename = QString("%1/batch_%2.json").arg(m_mlOutputDir).arg(batchId);
+    JsonHandler::WriteJsonFile(batch, filename);
+
+    if (m_mlCombined.isOpen()) {
+        if (m_mlBatches)
+            m_mlCombined.write(",");
+        m_mlCombined.write(QJsonDocument(batch).toJson(QJsonDocument::Compact));
+        m_mlCombined.flush();
+    }
+    ++m_mlBatches;
+}
+
+void MLPipelineManager::closeMLDataset()
+{
+    if (m_mlSink) {
+        qDebug() << "ML dataset streamed to" << m_mlSink->FileName() << "with" << m_mlSink->Records() << "batches";
+        m_mlSink.reset();
+        return;
+    }
+
+    if (m_mlCombined.isOpen()) {
+        const QJsonObject metadata{
+            { "total_batches", m_mlBatches },
+            { "generation_timestamp", QDateTime::currentDateTime().toString(Qt::ISODate) }
+        };
+        m_mlCombined.write("],\"metadata\":");
+        m_mlCombined.write(QJsonDocument(metadata).toJson(QJsonDocument::Compact));
+        m_mlCombined.write("}");
+        m_mlCombined.close();
+    }
+    qDebug() << "ML dataset saved to" << m_mlOutputDir;
 }
 
 void MLPipelineManager::saveStructuredResults(const QString& filename, const QJsonObject& results)
@@ -394,20 +429,19 @@ void MLPipelineManager::saveStructuredResults(const QString& filename, const QJs
     }
 }
 
-void MLPipelineManager::onBatchFinished()
+void MLPipelineManager::onBatchFinished(int batchId, const QJsonObject& results)
 {
     QMutexLocker locker(&m_dataMutex);
     m_currentBatch++;
-    
+
+    // Written right away, the batch is not kept once it is on disk
+    saveMLBatch(batchId, results);
+    emit mlDataGenerated(results);
+
     if (m_currentBatch >= m_totalBatches) {
         m_isRunning = false;
+        closeMLDataset();
         emit pipelineCompleted();
-        
-        // Save final dataset
-        if (!m_mlDataset.isEmpty()) {
-            QString outputDir = m_batchConfig["BatchConfig"].toObject()["OutputDir"].toString();
-            saveMLDataset(outputDir, m_mlDataset);
-        }
     }
 }
 
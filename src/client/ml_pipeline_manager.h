@@ -18,8 +18,10 @@
 
 #pragma once
 
+#include <QtCore/QFile>
 #include <QtCore/QJsonObject>
 #include <QtCore/QObject>
+#include <QtCore/QScopedPointer>
 #include <QtCore/QVector>
 #include <QtCore/QString>
 #include <QtCore/QThread>
@@ -27,6 +29,8 @@
 
 #include "suprafit_cli.h"
 
+class ResultSink;
+
 class MLPipelineManager : public QObject {
     Q_OBJECT
 
@@ -59,8 +63,10 @@ public:
     // Batch processing
     void processBatch(int batchId, const QJsonObject& batchConfig);
     
-    // Output methods
-    void saveMLDataset(const QString& outputDir, const QVector<QJsonObject>& mlData);
+    // Output methods - every batch is written as it finishes, nothing is collected in memory
+    void openMLDataset(const QString& outputDir);
+    void saveMLBatch(int batchId, const QJsonObject& batch);
+    void closeMLDataset();
     void saveStructuredResults(const QString& filename, const QJsonObject& results);
     
     // Progress tracking
@@ -82,7 +88,7 @@ signals:
     void mlDataGenerated(const QJsonObject& data);
 
 public slots:
-    void onBatchFinished();
+    void onBatchFinished(int batchId, const QJsonObject& results);
     void onPipelineError(int batchId, const QString& error);
 
 private:
@@ -96,8 +102,11 @@ private:
     int m_totalBatches;
     int m_numWorkerThreads;
     
-    // Data storage
-    QVector<QJsonObject> m_mlDataset;
+    // Data storage: the ndjson sink, or the batch files and the combined file written so far
+    QString m_mlOutputDir;
+    QScopedPointer<ResultSink> m_mlSink;
+    QFile m_mlCombined;
+    qint64 m_mlBatches = 0;
     QVector<QJsonObject> m_batchResults;
     
     // Threading
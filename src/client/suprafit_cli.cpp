@@ -30,6 +30,7 @@
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
 #include <QtCore/QRandomGenerator>
+#include <QtCore/QScopedPointer>
 #include <QtCore/QThreadPool>
 #include <QtCore/QTimer>
 
@@ -50,6 +51,7 @@
 #include "src/core/jsonhandler.h"
 #include "src/core/jsonutils.h"
 #include "src/core/minimizer.h"
+#include "src/core/resultsink.h"
 #include "src/core/toolset.h"
 #include "src/version.h"
 
@@ -82,6 +84,7 @@ SupraFitCli::SupraFitCli(SupraFitCli* core)
     m_prepare = core->m_prepare;
     m_simulation = core->m_simulation;
     m_data_json = core->m_data_json;
+    m_stream_results = core->m_stream_results;
     // Project state (data/models) lives in the shared ProjectManager singleton - Claude Generated
 
     // Initialize JobManager for statistical analysis - Claude Generated
@@ -270,10 +273,6 @@ bool SupraFitCli::LoadFile()
             if (!currentProject.isNull()) {
                 QSharedPointer<DataClass> project = currentProject.toStrongRef();
                 if (project) {
-                    // Update data vector for legacy compatibility
-                    m_data_vector.clear();
-                    m_data_vector = projectManager.getAllProjectsAsJson();
-
 #ifdef DEBUG_ON
                     SFDebugPrint("✅ DEBUG LoadFile: Successfully loaded project using ProjectManager\n");
                     SFDebugPrint("🔍 DEBUG LoadFile: Project UUID: {}\n", project->UUID().toStdString());
@@ -299,6 +298,8 @@ void SupraFitCli::ParseMain()
     if (m_main.isEmpty())
         return;
 
+    m_stream_results = m_main["ResultSink"].toString().compare("ndjson", Qt::CaseInsensitive) == 0;
+
     if (m_infile.isEmpty() || m_infile.isNull()) {
         if (m_main.contains("InFile"))
             m_infile = m_main["InFile"].toString();
@@ -455,7 +456,7 @@ void SupraFitCli::Work()
 {
     // Use ProjectManager to get all projects for processing
     SupraFit::ProjectManager& projectManager = SupraFit::ProjectManager::instance();
-    QVector<QJsonObject> projects = projectManager.getAllProjectsAsJson();
+    QVector<QSharedPointer<DataClass>> projects = projectManager.getAllProjectData();
 
     if (projects.isEmpty()) {
 #ifdef DEBUG_ON
@@ -480,14 +481,21 @@ void SupraFitCli::Work()
 
     qDebug() << "Processing" << projects.size() << "datasets with" << m_models.keys().size() << "models using ProjectManager";
 
+    QScopedPointer<ResultSink> sink;
+    if (m_stream_results)
+        sink.reset(new ResultSink(ResultStreamFile()));
+
     for (int i = 0; i < projects.size(); ++i) {
         const auto& project = projects[i];
 
         qDebug() << "Processing dataset" << (i + 1) << "/" << projects.size();
 
         QJsonObject result = PerformeJobs(project, m_models, m_jobs);
-        
-        if (!result.isEmpty()) {
+
+        if (!result.isEmpty() && sink) {
+            if (!sink->Append(QJsonObject{ { "dataset", i }, { "result", result } }))
+                qWarning() << "Failed to stream results of dataset" << i << "to:" << sink->FileName();
+        } else if (!result.isEmpty()) {
             // Save results for this dataset using ProjectManager
             QString outputFile = QString("%1_%2.json").arg(m_outfile).arg(i);
             if (SaveFile(outputFile, result)) {
@@ -498,6 +506,8 @@ void SupraFitCli::Work()
         }
     }
 
+    if (sink)
+        qDebug() << "Streamed" << sink->Records() << "results to:" << sink->FileName();
     qDebug() << "Work() completed for all datasets using ProjectManager";
 }
 
@@ -1445,25 +1455,31 @@ QJsonObject SupraFitCli::PerformeJobs(const QJsonObject& data, const QJsonObject
     qDebug() << "Jobs:" << jobs.keys();
     
     // Create DataClass from input data
-    QPointer<DataClass> dataClass;
-    if (data.contains("data")) {
-        dataClass = new DataClass(data["data"].toObject());
-    } else {
-        dataClass = new DataClass(data);
-    }
-    
+    QSharedPointer<DataClass> dataClass = QSharedPointer<DataClass>::create(data.contains("data") ? data["data"].toObject() : data);
+    return PerformeJobs(dataClass, models, jobs);
+}
+
+QJsonObject SupraFitCli::PerformeJobs(QSharedPointer<DataClass> dataClass, const QJsonObject& models, const QJsonObject& jobs)
+{
+    QJsonObject result;
+
     if (!dataClass) {
         qWarning() << "Failed to create DataClass from input data";
         return result;
     }
-    
+
+    /* Destroying a model clears the models stored with its data (~DataClass), so the job models are
+     * built on a detached copy and leave the ones the project loaded alone */
+    DataClass data(dataClass.data());
+    data.detach();
+
     // Test each model against the data
     QJsonObject modelResults;
     for (const QString& modelKey : models.keys()) {
         qDebug() << "Testing model:" << modelKey;
         
         int modelId = models[modelKey].toInt();
-        QSharedPointer<AbstractModel> model = CreateModel(modelId, dataClass);
+        QSharedPointer<AbstractModel> model = CreateModel(modelId, &data);
         
         if (!model) {
             qWarning() << "Failed to create model" << modelId;
@@ -1852,7 +1868,16 @@ QVector<QJsonObject> SupraFitCli::ProcessMLPipeline()
     }
     
     fmt::print("✅ Generated {} datasets for ML pipeline\n", simulatedData.size());
-    
+
+    // With Main/ResultSink = "ndjson" the three files of a dataset become one line in each of three
+    // streams, and nothing is collected in the returned vector
+    QScopedPointer<ResultSink> project_stream, model_stream, feature_stream;
+    if (m_stream_results) {
+        project_stream.reset(new ResultSink(MLProjectStreamFile()));
+        model_stream.reset(new ResultSink(MLModelStreamFile()));
+        feature_stream.reset(new ResultSink(MLFeatureStreamFile()));
+    }
+
     // Step 2: Process each dataset with multiple models
     for (int i = 0; i < simulatedData.size(); ++i) {
         const QJsonObject& dataset = simulatedData[i];
@@ -1972,21 +1997,6 @@ QVector<QJsonObject> SupraFitCli::ProcessMLPipeline()
             multiProjectData[projectKey] = projectData;
         }
 
-        // Save the Multi-Project dataset - Claude Generated
-        // Note: For multi-project datasets, save directly as JSON without ProjectManager wrapping
-        QString datasetFilename = m_outfile + "-" + QString::number(i) + ".json";
-
-        // Write multi-project structure directly to JSON file
-        QJsonDocument jsonDoc(multiProjectData);
-        QFile outFile(datasetFilename);
-        if (outFile.open(QIODevice::WriteOnly)) {
-            outFile.write(jsonDoc.toJson());
-            outFile.close();
-            fmt::print("✅ {} successfully written to disk (Multi-Project format)\n", datasetFilename.toStdString());
-        } else {
-            fmt::print("❌ ERROR: Failed to write Multi-Project dataset '{}'\n", datasetFilename.toStdString());
-        }
-
         // Step 4: Create SupraFit project with fitted models (like GUI SaveWorkspace)
         QJsonObject projectFile;
         projectFile["data"] = data->ExportData();  // Use updated data with fitted models in ML RawData
@@ -2012,6 +2022,56 @@ QVector<QJsonObject> SupraFitCli::ProcessMLPipeline()
             // projectFile["post_fit_analysis"] = analysisResults;
         }
 
+        // ========================================================================
+        // ML-optimierte Ausgabedatei generieren - Claude Generated 2025-10-17
+        // ========================================================================
+
+        // Extract compact ML features: remove raw data, keep only statistical metrics
+        // This dramatically reduces file size (14MB → 11KB) while preserving ML features
+        QJsonObject cleanedMultiProjectData;
+        cleanedMultiProjectData["format_version"] = multiProjectData["format_version"];
+        cleanedMultiProjectData["generation_timestamp"] = multiProjectData["generation_timestamp"];
+        cleanedMultiProjectData["ground_truth"] = multiProjectData["ground_truth"];
+
+        int cleanedProjectCount = 0;
+        for (const QString& key : multiProjectData.keys()) {
+            if (key.startsWith("project_")) {
+                QJsonObject cleaned = cleanProjectForML(multiProjectData[key].toObject());
+                if (!cleaned.isEmpty()) {
+                    cleanedMultiProjectData[key] = cleaned;
+                    cleanedProjectCount++;
+                }
+            }
+        }
+
+        // The three per-dataset files become one line in each of the three streams
+        if (m_stream_results) {
+            multiProjectData["dataset_id"] = i;
+            projectFile["dataset_id"] = i;
+            cleanedMultiProjectData["dataset_id"] = i;
+            if (project_stream->Append(multiProjectData) && model_stream->Append(projectFile) && feature_stream->Append(cleanedMultiProjectData))
+                fmt::print("✅ Dataset {} streamed ({} fitted models, {} ML feature projects)\n", i, modelIndex, cleanedProjectCount);
+            else
+                fmt::print("❌ ERROR: Failed to stream dataset {}\n", i);
+            delete data;
+            continue;
+        }
+
+        // Save the Multi-Project dataset - Claude Generated
+        // Note: For multi-project datasets, save directly as JSON without ProjectManager wrapping
+        QString datasetFilename = m_outfile + "-" + QString::number(i) + ".json";
+
+        // Write multi-project structure directly to JSON file
+        QJsonDocument jsonDoc(multiProjectData);
+        QFile outFile(datasetFilename);
+        if (outFile.open(QIODevice::WriteOnly)) {
+            outFile.write(jsonDoc.toJson());
+            outFile.close();
+            fmt::print("✅ {} successfully written to disk (Multi-Project format)\n", datasetFilename.toStdString());
+        } else {
+            fmt::print("❌ ERROR: Failed to write Multi-Project dataset '{}'\n", datasetFilename.toStdString());
+        }
+
         // Also create ML training entry 
         for (const QJsonObject& modelResult : fittedModels) {
             QJsonObject mlEntry;
@@ -2040,28 +2100,6 @@ QVector<QJsonObject> SupraFitCli::ProcessMLPipeline()
             fmt::print("❌ ERROR: Failed to write {}\n", modelsFilename.toStdString());
         }
 
-        // ========================================================================
-        // ML-optimierte Ausgabedatei generieren - Claude Generated 2025-10-17
-        // ========================================================================
-
-        // Extract compact ML features: remove raw data, keep only statistical metrics
-        // This dramatically reduces file size (14MB → 11KB) while preserving ML features
-        QJsonObject cleanedMultiProjectData;
-        cleanedMultiProjectData["format_version"] = multiProjectData["format_version"];
-        cleanedMultiProjectData["generation_timestamp"] = multiProjectData["generation_timestamp"];
-        cleanedMultiProjectData["ground_truth"] = multiProjectData["ground_truth"];
-
-        int cleanedProjectCount = 0;
-        for (const QString& key : multiProjectData.keys()) {
-            if (key.startsWith("project_")) {
-                QJsonObject cleaned = cleanProjectForML(multiProjectData[key].toObject());
-                if (!cleaned.isEmpty()) {
-                    cleanedMultiProjectData[key] = cleaned;
-                    cleanedProjectCount++;
-                }
-            }
-        }
-
         QString mlFilename = m_outfile + "-ml-features-" + QString::number(i) + ".json";
         QJsonDocument mlDoc(cleanedMultiProjectData);
         QFile mlFile(mlFilename);
@@ -2077,7 +2115,11 @@ QVector<QJsonObject> SupraFitCli::ProcessMLPipeline()
         delete data;
     }
     
-    fmt::print("🎉 ML Pipeline completed: {} total model evaluations\n", results.size());
+    if (m_stream_results)
+        fmt::print("🎉 ML Pipeline completed: {} datasets streamed to {}, {} and {}\n", project_stream->Records(),
+            project_stream->FileName().toStdString(), model_stream->FileName().toStdString(), feature_stream->FileName().toStdString());
+    else
+        fmt::print("🎉 ML Pipeline completed: {} total model evaluations\n", results.size());
     return results;
 }
 
@@ -2281,6 +2323,7 @@ QVector<QJsonObject> SupraFitCli::FitModelsToData(QPointer<DataClass> data, cons
                 // Create and configure NonLinearFitThread for optimization
                 NonLinearFitThread* fit_thread = new NonLinearFitThread(false);
                 fit_thread->setModel(model, false);
+                fit_thread->setCached(true);
                 fit_thread->run();
                 
                 // Import fitted parameters and calculate statistics
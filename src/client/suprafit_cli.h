@@ -70,6 +70,8 @@ public:
         m_outfile.remove(".json").remove(".suprafit");
     }
     QVector<QJsonObject> Data() const { return SupraFit::ProjectManager::instance().getAllProjectsAsJson(); }
+    /*! \brief The loaded projects as shared handles, without the json round trip of Data() */
+    QVector<QSharedPointer<DataClass>> Projects() const { return SupraFit::ProjectManager::instance().getAllProjectData(); }
 
     void setDataJson(const QJsonObject& datajson) { m_data_json = datajson; }
 
@@ -82,6 +84,8 @@ public:
     void Work();
 
     QJsonObject PerformeJobs(const QJsonObject& data, const QJsonObject& models, const QJsonObject& job);
+    /*! \brief Fit and analyse \a models on a loaded project; the models share its data copy-on-write */
+    QJsonObject PerformeJobs(QSharedPointer<DataClass> data, const QJsonObject& models, const QJsonObject& job);
     inline bool SimulationData() const { return m_simulate_job; }
 
     inline bool CheckGenerateIndependent() const { return m_generate_independent; }
@@ -182,6 +186,19 @@ public:
 
     inline QString Extension() const { return m_extension; }
     inline QString OutFile() const { return m_outfile; }
+
+    /*! \brief True if results are streamed into one NDJSON file (Main/ResultSink = "ndjson") */
+    inline bool StreamResults() const { return m_stream_results; }
+
+    /*! \brief Result stream written by Work() */
+    inline QString ResultStreamFile() const { return m_outfile + ".ndjson"; }
+
+    /*! \brief Streams written by ProcessMLPipeline(), one line per dataset each: the Multi-Project
+     * records (the "-N.json" files, readable by MLFeatureExtractor), the projects with the fitted
+     * models ("-project-N.suprafit") and the compact ML features ("-ml-features-N.json") */
+    inline QString MLProjectStreamFile() const { return m_outfile + "-projects.ndjson"; }
+    inline QString MLModelStreamFile() const { return m_outfile + "-models.ndjson"; }
+    inline QString MLFeatureStreamFile() const { return m_outfile + "-ml-features.ndjson"; }
 signals:
 
 public slots:
@@ -219,6 +236,7 @@ protected:
     QJsonObject m_independent, m_dependent;
     bool m_use_modular_structure = false;
     bool m_show_post_processing_details = false;
+    bool m_stream_results = false;
 
     /* Stored data structure */
     QJsonObject m_data_json;
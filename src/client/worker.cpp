@@ -0,0 +1,58 @@
+/*
+ * SupraFit worker process - refits resampling batches for JobManager
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "src/capabilities/workerpool.h"
+
+#include "src/global.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include <cstdio>
+
+#ifdef _WIN32
+#include <io.h>
+#define dup _dup
+#define dup2 _dup2
+#define fileno _fileno
+#else
+#include <unistd.h>
+#endif
+
+/* Started by WorkerPool, locally or through a remote shell; speaks WorkerProtocol on stdin/stdout */
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    /* One batch at a time per process - the coordinator starts as many workers as it wants threads */
+    app.setProperty("threads", 1);
+    app.setProperty("FitCache", false);
+
+    /* The protocol keeps the original stdout for itself; everything the fits print goes to stderr */
+    fflush(stdout);
+    const int protocol = dup(fileno(stdout));
+    dup2(fileno(stderr), fileno(stdout));
+
+    QFile input, output;
+    if (!input.open(fileno(stdin), QIODevice::ReadOnly | QIODevice::Unbuffered)
+        || !output.open(protocol, QIODevice::WriteOnly | QIODevice::Unbuffered, QFileDevice::AutoCloseHandle))
+        return 1;
+
+    return WorkerProtocol::Serve(&input, &output);
+}
@@ -634,7 +634,7 @@ QJsonObject ExtractMultiRunStatistics(const QJsonObject& modelExport)
 
                     // Extract entropy if available
                     if (param.contains("entropy")) {
-                        entropy.append(param["entropy"]);
+                        entropy.append(qAbs(param["entropy"].toObject()["value"].toDouble()));
                     }
 
                     // Extract stddev if available
@@ -726,7 +726,7 @@ QJsonObject ExtractMultiRunStatistics(const QJsonObject& modelExport)
                     QJsonObject param = runObj[paramKey].toObject();
 
                     if (param.contains("entropy")) {
-                        entropy.append(param["entropy"]);
+                        entropy.append(qAbs(param["entropy"].toObject()["value"].toDouble()));
                     }
 
                     if (param.contains("stddev")) {
@@ -24,6 +24,7 @@
 
 #include "analysis_manager.h"
 
+#include <QtCore/QCoreApplication>
 #include <QtCore/QFileInfo>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
@@ -549,6 +550,7 @@ QJsonObject AnalysisManager::fitSingleModel(const QJsonObject& modelConfig,
             // `model`, leaving it Calculate()d at the fitted parameters. D4.
             model->setFast(false);
             Minimizer minimizer(false);
+            minimizer.setCached(qApp->instance()->property("FitCache").toBool());
             minimizer.setModel(model);
             minimizer.Minimize();
             model->CalculateStatistics(true);
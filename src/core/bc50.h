@@ -27,6 +27,7 @@
 #include "src/global_config.h"
 
 #include "src/core/equil.h"
+#include "src/core/executioncontext.h"
 #include "src/core/libmath.h"
 #include "src/core/toolset.h"
 
@@ -59,7 +60,19 @@ System Classify(const Eigen::MatrixXi& stoich);
  * \param lgBeta CUMULATIVE lg beta per species, in the column order of \p stoich — the convention
  *        the `*_any` models use for their global parameters. The fixed-stoichiometry entry points
  *        below take STEPWISE constants, so this converts. Claude Generated (2026). */
-qreal FromSpeciation(const Eigen::MatrixXi& stoich, const QVector<qreal>& lgBeta);
+qreal FromSpeciation(const Eigen::MatrixXi& stoich, const QVector<qreal>& lgBeta, qreal tolerance = 0);
+
+/*! \brief FromSpeciation() for many parameter sets at once, e.g. every Monte Carlo sample.
+ *
+ * The samples are split over the thread budget of \a context - the one of the model whose statistics
+ * are evaluated; the integration tolerance is read once. Entries for which no BC50 is defined are
+ * negative, as in the single-sample version. */
+QVector<qreal> FromSpeciationSamples(const Eigen::MatrixXi& stoich, const QVector<QVector<qreal>>& lgBetas, const ExecutionContext& context = ExecutionContext());
+
+/*! \brief Relative tolerance of the adaptive BC50 integration, 10^N for the `BC50Tolerance`
+ *  setting N (default -12, at most 1e-14). A \a tolerance of 0 passed to the functions below means
+ *  this value. */
+qreal IntegrationTolerance();
 
 /*! \brief Formatted BC50 block for a reaction-defined system; empty when unsupported. CG (2026). */
 QString Format_FromSpeciation(const Eigen::MatrixXi& stoich, const QVector<qreal>& lgBeta);
@@ -84,7 +97,7 @@ namespace IItoI {
 
 namespace ItoII {
     qreal BC50_Y(qreal x, const QVector<qreal>& parameter);
-    qreal BC50(const qreal logK11, const qreal logK12);
+    qreal BC50(const qreal logK11, const qreal logK12, qreal tolerance = 0);
     QPair<qreal, qreal> ABPair(qreal x, const QVector<qreal>& parameter);
     qreal BFunction(qreal x, const QVector<qreal>& parameter);
     qreal AFunction(qreal x, const QVector<qreal>& parameter);
@@ -97,7 +110,7 @@ namespace ItoII {
 
 namespace IItoII {
     qreal BC50_A0_X(qreal x, const QVector<qreal>& parameter);
-    qreal BC50_A0(const qreal logK21, const qreal logK11, const qreal logK12);
+    qreal BC50_A0(const qreal logK21, const qreal logK11, const qreal logK12, qreal tolerance = 0);
     qreal BC50_A_X(qreal x, const QVector<qreal>& parameter);
     QPair<qreal, qreal> ABConcentration(qreal x, const QVector<qreal>& parameter);
     qreal BC50_A(const qreal logK21, const qreal logK11, const qreal logK12);
@@ -189,6 +189,13 @@ double ConcentrationSolver::Objective(const Eigen::VectorXd& x, Eigen::VectorXd*
 }
 
 std::vector<double> ConcentrationSolver::solve()
+{
+    std::vector<double> free;
+    solve(free);
+    return free;
+}
+
+void ConcentrationSolver::solve(std::vector<double>& free)
 {
     const auto t_start = std::chrono::steady_clock::now();
     const int n = static_cast<int>(m_totals.size());
@@ -213,7 +220,8 @@ std::vector<double> ConcentrationSolver::solve()
     if (nv == 0) {
         m_converged = true;
         m_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start).count();
-        return m_free;
+        free.assign(m_free.cbegin(), m_free.cend());
+        return;
     }
 
     // Build the log-concentration start. Active components carry over their warm-start value; any that
@@ -361,41 +369,86 @@ std::vector<double> ConcentrationSolver::solve()
     // (implicit-function theorem) without re-solving. Only exact for the Newton method, whose loop
     // refreshes H at the accepted point; the BFGS branch leaves the initial H. Claude Generated.
     m_H = H;
+    m_H_factored = false;
 
     m_has_guess = true; // keep result as warm start for the next solve
     m_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start).count();
-    return m_free;
+    free.assign(m_free.cbegin(), m_free.cend());
+}
+
+const Eigen::LDLT<Eigen::MatrixXd>& ConcentrationSolver::HessianFactor() const
+{
+    // compute() reuses the storage of the previous factorisation when the active dimension is unchanged
+    if (!m_H_factored) {
+        m_H_factor.compute(m_H);
+        m_H_factored = true;
+    }
+    return m_H_factor;
 }
 
 Eigen::MatrixXd ConcentrationSolver::sensitivityMatrix() const
+{
+    Eigen::MatrixXd S;
+    sensitivityMatrix(S);
+    return S;
+}
+
+void ConcentrationSolver::sensitivityMatrix(Eigen::MatrixXd& S) const
 {
     // Sᵢⱼ = ∂x_i/∂ln(β_j) for free component i and species j, from the implicit-function theorem on the
     // converged mass balance g(x,β)=0: H·(∂x/∂lnβ_j) = -∂g/∂lnβ_j, with ∂g/∂lnβ_j = m_j·c_j (the species
     // stoichiometry column scaled by its concentration). Reuses the stored solution Hessian H — one
-    // factorisation, one solve per species, no re-solve of the speciation. Inactive components (total
-    // == 0) do not vary and get a zero row. Claude Generated.
+    // factorisation per solve, one solve per species, no re-solve of the speciation. Inactive components
+    // (total == 0) do not vary and get a zero row. Claude Generated.
     const int n = static_cast<int>(m_totals.size());
     const int m = static_cast<int>(m_M.cols());
     const int nv = static_cast<int>(m_comp_of_var.size());
-    Eigen::MatrixXd S = Eigen::MatrixXd::Zero(n, m);
+    S.resize(n, m);
+    S.setZero();
     if (nv == 0 || m == 0 || m_H.rows() != nv)
-        return S;
+        return;
 
     // Right-hand side over the active variables: RHS(v, j) = M(comp,j) · c_j.
-    Eigen::MatrixXd RHS = Eigen::MatrixXd::Zero(nv, m);
+    m_rhs.resize(nv, m);
+    m_rhs.setZero();
     for (int j = 0; j < m; ++j) {
         const double cj = speciesConcentration(j);
         if (cj == 0.0)
             continue;
         for (int v = 0; v < nv; ++v)
-            RHS(v, j) = static_cast<double>(m_M(m_comp_of_var[v], j)) * cj;
+            m_rhs(v, j) = static_cast<double>(m_M(m_comp_of_var[v], j)) * cj;
     }
 
-    const Eigen::MatrixXd D = m_H.ldlt().solve(RHS); // H⁻¹ RHS
+    HessianFactor().solveInPlace(m_rhs); // H⁻¹ RHS
     for (int v = 0; v < nv; ++v)
         for (int j = 0; j < m; ++j)
-            S(m_comp_of_var[v], j) = -D(v, j);
-    return S;
+            S(m_comp_of_var[v], j) = -m_rhs(v, j);
+}
+
+Eigen::VectorXd ConcentrationSolver::totalsTangent(const std::vector<double>& dtotals) const
+{
+    Eigen::VectorXd dx;
+    totalsTangent(dtotals, dx);
+    return dx;
+}
+
+void ConcentrationSolver::totalsTangent(const std::vector<double>& dtotals, Eigen::VectorXd& dx) const
+{
+    // The mass balance g(x, t) = s + Σ m_j c_j - t = 0 gives H·∂x/∂t = I, so a change Δt of the totals
+    // moves the solution by H⁻¹Δt to first order. Same stored Hessian as sensitivityMatrix(). CG.
+    const int n = static_cast<int>(m_totals.size());
+    const int nv = static_cast<int>(m_comp_of_var.size());
+    dx.resize(n);
+    dx.setZero();
+    if (nv == 0 || m_H.rows() != nv || static_cast<int>(dtotals.size()) != n)
+        return;
+
+    m_rhs_t.resize(nv);
+    for (int v = 0; v < nv; ++v)
+        m_rhs_t(v) = dtotals[m_comp_of_var[v]];
+    HessianFactor().solveInPlace(m_rhs_t);
+    for (int v = 0; v < nv; ++v)
+        dx(m_comp_of_var[v]) = m_rhs_t(v);
 }
 
 double ConcentrationSolver::speciesConcentration(int j) const
@@ -123,6 +123,9 @@ public:
      */
     std::vector<double> solve();
 
+    /** @brief solve() into caller storage @p free, which is only reallocated when its size changes. */
+    void solve(std::vector<double>& free);
+
     /** @brief The free component concentrations of the last solve. */
     inline std::vector<double> currentConcentration() const { return m_free; }
 
@@ -146,6 +149,20 @@ public:
      */
     Eigen::MatrixXd sensitivityMatrix() const;
 
+    /** @brief sensitivityMatrix() into caller storage @p S, which is only reallocated when its shape
+     *        changes. The factorisation of the solution Hessian is kept until the next solve(). */
+    void sensitivityMatrix(Eigen::MatrixXd& S) const;
+
+    /**
+     * @brief Tangent of the free log-concentrations along the totals, @f$\partial x/\partial t\cdot\Delta t
+     *        = H^{-1}\Delta t@f$, at the last solution (length n_components, 0 for inactive components).
+     *        The first-order predictor for the next point of a titration sweep. Claude Generated.
+     */
+    Eigen::VectorXd totalsTangent(const std::vector<double>& dtotals) const;
+
+    /** @brief totalsTangent() into caller storage @p dx (reallocated only when its size changes). */
+    void totalsTangent(const std::vector<double>& dtotals, Eigen::VectorXd& dx) const;
+
     inline int LastIterations() const { return m_lastIter; }
     inline double LastConvergency() const { return m_lastConv; }
     inline bool Converged() const { return m_converged; }
@@ -158,6 +175,9 @@ private:
      * the damped-Newton step. Claude Generated. */
     double Objective(const Eigen::VectorXd& x, Eigen::VectorXd* gradient, Eigen::MatrixXd* hessian = nullptr) const;
 
+    /** @brief LDLT of m_H, factorised on first use after a solve and reused by every sensitivity. */
+    const Eigen::LDLT<Eigen::MatrixXd>& HessianFactor() const;
+
     Eigen::MatrixXi m_M; ///< stoichiometry (components x complexes)
     std::vector<double> m_beta; ///< stability constants per complex
     std::vector<double> m_logbeta; ///< log(beta_j), precomputed (only valid where beta_j > 0)
@@ -167,6 +187,10 @@ private:
     std::vector<int> m_comp_of_var; ///< active-variable index -> component row (per solve)
     std::vector<int> m_var_of_comp; ///< component row -> active-variable index, -1 if inactive
     Eigen::MatrixXd m_H; ///< mass-balance Hessian at the solution (active dims); exact for Newton only
+    mutable Eigen::LDLT<Eigen::MatrixXd> m_H_factor; ///< factorisation of m_H, valid while m_H_factored
+    mutable bool m_H_factored = false;
+    mutable Eigen::MatrixXd m_rhs; ///< sensitivity workspace (active dims x species)
+    mutable Eigen::VectorXd m_rhs_t; ///< totals-tangent workspace (active dims)
 
     Method m_method = Method::LevenbergMarquardt;
     double m_converge = 1e-10;
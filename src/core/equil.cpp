@@ -127,8 +127,8 @@ QPair<double, double> IItoI_ItoI_ItoII_Solver::HostConcentration(double a0, doub
             return MinQuadraticRoot(x1, x2, x3);
         }
     };
-    long double epsilon = m_opt_config["ConcentrationConvergence"].toDouble();
-    int MaxIter = m_opt_config["MaxIterConcentrations"].toInt();
+    long double epsilon = m_convergence;
+    int MaxIter = m_maxiter;
     long double a = qMin(a0, b0) / K11 * 10;
     long double b = 0;
     long double a_1 = 0, b_1 = 0;
@@ -146,7 +146,11 @@ public:
     void RunTest();
     void setInput(double A0, double B0);
     inline void setConstants(const QList<qreal>& parameter) { m_parameter = parameter; }
-    inline void setConfig(QJsonObject opt_config) { m_opt_config = opt_config; }
+    inline void setConfig(qreal convergence, int maxiter)
+    {
+        m_convergence = convergence;
+        m_maxiter = maxiter;
+    }
     inline QPair<double, double> Concentrations() const { return m_concentration; }
     inline QPair<double, double> ConcentrationsLegacy() const { return m_concentration_legacy; }
 
@@ -165,5 +169,6 @@ private:
     QPair<double, double> m_concentration, m_concentration_legacy;
     bool m_ok = true, m_lok = true;
     int m_t = 0, m_lt = 0;
-    QJsonObject m_opt_config;
+    qreal m_convergence = 1e-13;
+    int m_maxiter = 1500;
 };
@@ -0,0 +1,83 @@
+/*
+ * SupraFit - resources of a single job
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
+
+#include "executioncontext.h"
+
+ExecutionContext::ExecutionContext()
+    : m_token(new Token)
+{
+}
+
+ExecutionContext::ExecutionContext(int threads)
+    : m_threads(threads)
+    , m_token(new Token)
+{
+}
+
+int ExecutionContext::Threads() const
+{
+    int threads = m_threads;
+    if (threads < 1 && QCoreApplication::instance())
+        threads = QCoreApplication::instance()->property("threads").toInt();
+    if (threads < 1)
+        threads = QThread::idealThreadCount();
+    return qMax(threads, 1);
+}
+
+ExecutionContext ExecutionContext::Split(int parts) const
+{
+    ExecutionContext share = *this;
+    share.m_threads = qMax(Threads() / qMax(parts, 1), 1);
+    return share;
+}
+
+QThreadPool* ExecutionContext::Executor() const
+{
+    return m_executor ? m_executor.data() : QThreadPool::globalInstance();
+}
+
+ExecutionContext ExecutionContext::Child() const
+{
+    ExecutionContext child = *this;
+    child.m_token = QSharedPointer<Token>(new Token);
+    child.m_token->parent = m_token;
+    return child;
+}
+
+void ExecutionContext::Cancel() const
+{
+    m_token->cancelled = true;
+}
+
+bool ExecutionContext::isCancelled() const
+{
+    for (const Token* token = m_token.data(); token; token = token->parent.data())
+        if (token->cancelled)
+            return true;
+    return false;
+}
+
+void ExecutionContext::setSeed(quint64 seed)
+{
+    m_seed = seed;
+    m_has_seed = true;
+}
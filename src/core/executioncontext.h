@@ -0,0 +1,81 @@
+/*
+ * SupraFit - resources of a single job
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "src/core/randomstream.h"
+
+#include <QtCore/QPointer>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
+
+#include <atomic>
+
+/*! \brief Thread budget, executor, cancellation and random numbers of one job
+ *
+ * JobManager hands a context to every job it runs, the search classes pass their share on to the
+ * models they refit, and the BC50 statistics of a model use the context of the model. Only Threads()
+ * reads the application property "threads": a default constructed context follows it, or the ideal
+ * thread count when it is not set; one with setThreads() has a budget of its own, so two jobs in one
+ * process can share the machine without touching each other. Work that does not belong to a job runs
+ * on a default context - reading data files (FileHandler), loading projects (ProjectManager) and the
+ * legacy OpenMP BC50 integration.
+ *
+ * Copies share the cancellation token; Child() gets a token of its own that is also cancelled with
+ * its parent. The random numbers come from RandomStream, so Seed() is all a job needs to repeat them.
+ */
+class ExecutionContext {
+public:
+    ExecutionContext();
+    explicit ExecutionContext(int threads);
+
+    /*! \brief Budget of this context, the application property "threads" if none was set and the
+     * ideal thread count if neither is; at least 1 */
+    int Threads() const;
+    inline void setThreads(int threads) { m_threads = threads; }
+
+    /*! \brief Context of one of \a parts tasks that run side by side, each with its share of the budget */
+    ExecutionContext Split(int parts) const;
+
+    /*! \brief Pool the threads of the job are started on, the global one if none was set */
+    QThreadPool* Executor() const;
+    inline void setExecutor(QThreadPool* executor) { m_executor = executor; }
+
+    /*! \brief Same budget and executor, with a cancellation token that follows the one of this context */
+    ExecutionContext Child() const;
+    void Cancel() const;
+    bool isCancelled() const;
+
+    inline bool hasSeed() const { return m_has_seed; }
+    inline quint64 Seed() const { return m_seed; }
+    void setSeed(quint64 seed);
+    inline RandomStream Stream(quint32 job, quint64 index) const { return RandomStream(m_seed, job, index); }
+
+private:
+    struct Token {
+        std::atomic<bool> cancelled = false;
+        QSharedPointer<Token> parent;
+    };
+
+    int m_threads = 0;
+    QPointer<QThreadPool> m_executor;
+    QSharedPointer<Token> m_token;
+    quint64 m_seed = 0;
+    bool m_has_seed = false;
+};
@@ -21,6 +21,7 @@
  *
  */
 
+#include "src/core/executioncontext.h"
 #include "src/core/jsonhandler.h"
 #include "src/core/models/dataclass.h"
 #include "src/core/models/models.h"
@@ -29,21 +30,149 @@
 #include "src/core/thermogramhandler.h"
 #include "src/core/toolset.h"
 
+#include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QPointer>
 #include <QtCore/QStringList>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <vector>
 
 #include "filehandler.h"
 
+namespace {
+/* Tables are parsed from the raw bytes: numbers are ASCII, only header names are decoded (UTF-8) */
+
+inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/* End of the line starting at begin ('\r' excluded); *next is the start of the following line */
+inline const char* LineEnd(const char* begin, const char* end, const char** next)
+{
+    const char* line_end = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+    *next = line_end ? line_end + 1 : end;
+    if (!line_end)
+        line_end = end;
+    if (line_end > begin && *(line_end - 1) == '\r')
+        --line_end;
+    return line_end;
+}
+
+inline bool BlankLine(const char* begin, const char* end)
+{
+    return std::all_of(begin, end, isBlank);
+}
+
+/* The former check for a line made of letters only (QRegularExpression "^[a-zA-Z]+$") */
+inline bool LettersOnly(const char* begin, const char* end)
+{
+    if (begin == end)
+        return false;
+    for (; begin < end; ++begin)
+        if (!((*begin >= 'a' && *begin <= 'z') || (*begin >= 'A' && *begin <= 'Z')))
+            return false;
+    return true;
+}
+
+/* Calls field(begin, end) for every field of the line, the way line.simplified().split(seperator)
+ * did: for ' ' fields are runs of non-blank characters, otherwise the line is cut at the separator */
+template <typename Function>
+inline void ForEachField(const char* begin, const char* end, char seperator, const Function& field)
+{
+    while (begin < end && isBlank(*begin))
+        ++begin;
+    while (end > begin && isBlank(*(end - 1)))
+        --end;
+    if (begin == end)
+        return;
+    if (seperator == ' ') {
+        while (begin < end) {
+            const char* field_end = begin;
+            while (field_end < end && !isBlank(*field_end))
+                ++field_end;
+            field(begin, field_end);
+            begin = field_end;
+            while (begin < end && isBlank(*begin))
+                ++begin;
+        }
+        return;
+    }
+    while (true) {
+        const char* field_end = static_cast<const char*>(std::memchr(begin, seperator, end - begin));
+        if (!field_end) {
+            field(begin, end);
+            return;
+        }
+        field(begin, field_end);
+        begin = field_end + 1;
+    }
+}
+
+/* First character of a field, quotes and blanks skipped; a '#' there comments the line out */
+inline char FirstChar(const char* begin, const char* end)
+{
+    for (; begin < end; ++begin)
+        if (*begin != '"' && !isBlank(*begin))
+            return *begin;
+    return 0;
+}
+
+/* Number in a field; quotes are dropped and a decimal comma is read as point */
+inline double ParseField(const char* begin, const char* end, bool* ok)
+{
+    if (!std::memchr(begin, '"', end - begin) && !std::memchr(begin, ',', end - begin))
+        return ToolSet::ParseDouble(begin, end, ok);
+
+    char buffer[64];
+    int length = 0;
+    for (; begin < end; ++begin) {
+        if (*begin == '"')
+            continue;
+        if (length == int(sizeof(buffer))) {
+            *ok = false;
+            return 0;
+        }
+        buffer[length++] = *begin == ',' ? '.' : *begin;
+    }
+    return ToolSet::ParseDouble(buffer, buffer + length, ok);
+}
+
+/* Number of values in a data line, -1 for blank and commented lines */
+inline int CountFields(const char* begin, const char* end, char seperator)
+{
+    int count = 0;
+    bool comment = false;
+    ForEachField(begin, end, seperator, [&count, &comment](const char* field_begin, const char* field_end) {
+        comment = comment || FirstChar(field_begin, field_end) == '#';
+        ++count;
+    });
+    return comment || count == 0 ? -1 : count;
+}
+
+/* A range of whole lines, parsed by one worker */
+struct Chunk {
+    const char* begin;
+    const char* end;
+    std::vector<int> fields; /* CountFields() of every line */
+    qint64 first_line = 0;
+    bool letters_only = false;
+};
+}
+
 FileHandler::FileHandler(const QString& filename, QObject* parent)
     : QObject(parent)
     , m_table(true)
     , m_allint(true)
     , m_file_supported(true)
     , m_filename(filename)
-    , m_lines(0)
     , m_filetype(FileType::Generic)
 {
 }
@@ -53,7 +182,6 @@ FileHandler::FileHandler(QObject* parent)
     , m_table(true)
     , m_allint(true)
     , m_file_supported(true)
-    , m_lines(0)
     , m_filetype(FileType::Generic)
 {
 }
@@ -65,7 +193,7 @@ FileHandler::~FileHandler()
 void FileHandler::LoadFile()
 {
     QFile file(m_filename);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::ReadOnly)) {
         qDebug() << file.errorString();
         return;
     }
@@ -90,102 +218,189 @@ void FileHandler::LoadFile()
     } else
         m_filetype = FileType::Generic;
 
-    m_filecontent = QString(file.readAll()).split("\n");
-    if (Type() == FileType::SupraFit)
+    if (Type() == FileType::SupraFit) {
         ReadJson();
-    else if (m_filetype == FileType::Generic)
-        ReadGeneric();
-    else if (m_filetype == FileType::dH)
+        return;
+    } else if (m_filetype == FileType::dH) {
+        m_filecontent = QString(file.readAll()).remove('\r').split("\n");
         ReaddH();
-    else if (m_filetype == FileType::CSV) {
-        ReadSeperated(",");
-    } else
+        return;
+    } else if (m_filetype != FileType::Generic && m_filetype != FileType::CSV) {
         m_file_supported = false;
+        return;
+    }
+
+    /* Tables are parsed where they lie: map the file, fall back to reading it if that fails */
+    QByteArray buffer;
+    const char* data = nullptr;
+    qint64 size = file.size();
+    if (size > 0)
+        data = reinterpret_cast<const char*>(file.map(0, size));
+    if (!data) {
+        buffer = file.readAll();
+        data = buffer.constData();
+        size = buffer.size();
+    }
+
+    if (m_filetype == FileType::Generic)
+        ReadGeneric(data, size);
+    else
+        ReadSeperated(data, size, ',');
 }
 
-void FileHandler::ReadSeperated(const QString& seperator)
+bool FileHandler::setFileContent(const QString& str)
 {
+    const QByteArray content = str.toUtf8();
+    ReadGeneric(content.constData(), content.size());
+    return m_allint && m_table;
+}
+
+void FileHandler::ReadSeperated(const char* data, qint64 size, char seperator, bool letters_only_lines)
+{
+    const char* const end = data + size;
+    const char* cursor = data;
+
+    /* The first non-empty line holds the column names if none of its fields is a number */
     QStringList header;
-    bool header_added = false;
-    int index = 0;
-    int max_columns = 0;
-    QVector<QVector<double>> rows(m_filecontent.size());
-    for (const QString& line : qAsConst(m_filecontent)) {
-        if (!line.isEmpty()) {
-            bool insert_row = true;
-            bool read_header = false;
-            if (header_added == false) {
-                read_header = true;
-                insert_row = false;
-            }
-            QVector<qreal> row;
-            QStringList items = line.simplified().replace("\"", "").split(seperator);
-            for (const QString& item : qAsConst(items)) {
-                bool convert;
-                QString(item).replace(",", ".").toDouble(&convert);
-                if (convert) {
-                    read_header = false;
-                    insert_row = true;
-                }
-                if (read_header && !convert) {
-                    QString head = QString(item).replace(HashTag, "");
-                    if (!head.isEmpty() && !head.isNull())
-                        header << head;
-                } else if (item[0] != HashTag)
-                    row.append((QString(item).replace(",", ".")).toDouble());
-                else
-                    insert_row = false;
-            }
-            if (!header_added) {
-                header_added = true;
-            }
-            if (!read_header && insert_row) {
-                rows[index] = row;
-                max_columns = qMax(max_columns, row.size());
-            }
+    bool letters_only = false;
+    while (cursor < end) {
+        const char* next;
+        const char* line_end = LineEnd(cursor, end, &next);
+        if (BlankLine(cursor, line_end)) {
+            cursor = next;
+            continue;
+        }
+        letters_only = LettersOnly(cursor, line_end);
+        bool numeric = false;
+        QStringList names;
+        ForEachField(cursor, line_end, seperator, [&numeric, &names](const char* field_begin, const char* field_end) {
+            bool ok = false;
+            ParseField(field_begin, field_end, &ok);
+            numeric = numeric || ok;
+            QString name = QString::fromUtf8(field_begin, int(field_end - field_begin)).remove('"').remove(HashTag).trimmed();
+            if (!name.isEmpty())
+                names << name;
+        });
+        if (!numeric) {
+            header = names;
+            cursor = next;
         }
-        index++;
+        break;
     }
-    GenerateTable(rows, header, max_columns);
-}
 
-void FileHandler::ReadGeneric()
-{
-    int tab = 0, semi = 0, comma = 0;
-    for (const QString& str : qAsConst(m_filecontent)) {
-        tab += str.count("\t");
-        tab += str.count(" ");
-        semi += str.count(";");
-        comma += str.count(",");
+    /* Chunks of at least 1 MB, cut at line ends */
+    const int threads = int(std::max<qint64>(1, std::min<qint64>(ExecutionContext().Threads(), (end - cursor) >> 20)));
+
+    std::vector<Chunk> chunks;
+    const qint64 step = (end - cursor) / threads + 1;
+    while (cursor < end) {
+        const char* chunk_end = cursor + std::min<qint64>(step, end - cursor);
+        if (chunk_end < end) {
+            const char* newline = static_cast<const char*>(std::memchr(chunk_end, '\n', end - chunk_end));
+            chunk_end = newline ? newline + 1 : end;
+        }
+        Chunk chunk;
+        chunk.begin = cursor;
+        chunk.end = chunk_end;
+        chunks.push_back(chunk);
+        cursor = chunk_end;
+    }
+
+    auto run = [&chunks, threads](const std::function<void(Chunk&)>& job) {
+        if (threads == 1 || chunks.size() < 2) {
+            for (Chunk& chunk : chunks)
+                job(chunk);
+            return;
+        }
+        QThreadPool pool;
+        pool.setMaxThreadCount(threads);
+        for (Chunk& chunk : chunks)
+            pool.start([&job, &chunk]() { job(chunk); });
+        pool.waitForDone();
+    };
+
+    /* First pass: the shape of every line */
+    run([seperator](Chunk& chunk) {
+        chunk.fields.reserve((chunk.end - chunk.begin) / 32);
+        for (const char* line = chunk.begin; line < chunk.end;) {
+            const char* next;
+            const char* line_end = LineEnd(line, chunk.end, &next);
+            chunk.fields.push_back(CountFields(line, line_end, seperator));
+            chunk.letters_only = chunk.letters_only || LettersOnly(line, line_end);
+            line = next;
+        }
+    });
+
+    /* Rows run from the first to the last data line, lines in between stay rows of zeros */
+    qint64 lines = 0, first = -1, last = -1;
+    int columns = 0;
+    for (Chunk& chunk : chunks) {
+        chunk.first_line = lines;
+        for (std::size_t i = 0; i < chunk.fields.size(); ++i) {
+            if (chunk.fields[i] < 0)
+                continue;
+            if (first < 0)
+                first = lines + qint64(i);
+            last = lines + qint64(i);
+            columns = std::max(columns, chunk.fields[i]);
+        }
+        lines += qint64(chunk.fields.size());
+        letters_only = letters_only || chunk.letters_only;
     }
-    if (tab > semi)
-        sep = " ";
-    else
-        sep = ";";
-    m_lines = m_filecontent.size();
 
-    if (!CheckForTable())
+    if (letters_only_lines && letters_only) {
+        m_allint = false;
+        m_file_supported = false;
         return;
+    }
+    m_file_supported = m_allint && m_table;
 
-    ReadSeperated(sep);
+    if (first < 0) {
+        m_stored_table = new DataTable;
+        return;
+    }
+
+    /* Second pass: the numbers, written straight into the final matrix */
+    Eigen::MatrixXd table = Eigen::MatrixXd::Zero(last - first + 1, columns);
+    run([seperator, first, last, &table](Chunk& chunk) {
+        qint64 line_number = chunk.first_line;
+        for (const char* line = chunk.begin; line < chunk.end; ++line_number) {
+            const char* next;
+            const char* line_end = LineEnd(line, chunk.end, &next);
+            const qint64 row = line_number - first;
+            if (line_number >= first && line_number <= last && chunk.fields[line_number - chunk.first_line] > 0) {
+                int column = 0;
+                ForEachField(line, line_end, seperator, [&table, row, &column](const char* field_begin, const char* field_end) {
+                    bool ok;
+                    table(row, column++) = ParseField(field_begin, field_end, &ok);
+                });
+            }
+            line = next;
+        }
+    });
+
+    GenerateTable(table, header);
 }
 
-void FileHandler::GenerateTable(QVector<QVector<double>>& table, const QStringList& header, int max_columns)
+void FileHandler::ReadGeneric(const char* data, qint64 size)
 {
-    while (table[table.size() - 1].isEmpty())
-        table.removeLast();
+    /* Separator from a sample of the file: blanks (space or tab) unless semicolons dominate */
+    const qint64 sample = std::min<qint64>(size, 1 << 16);
+    qint64 tab = 0, semi = 0;
+    for (qint64 i = 0; i < sample; ++i) {
+        tab += data[i] == '\t' || data[i] == ' ';
+        semi += data[i] == ';';
+    }
 
-    while (table[0].isEmpty())
-        table.removeFirst();
+    ReadSeperated(data, size, tab > semi ? ' ' : ';', true);
+}
 
-    m_stored_table = new DataTable(table.size(), max_columns, 0);
-    if (header.size() == max_columns)
+void FileHandler::GenerateTable(Eigen::MatrixXd& table, const QStringList& header)
+{
+    const int columns = int(table.cols());
+    m_stored_table = new DataTable(std::move(table));
+    if (header.size() == columns)
         m_stored_table->setHeader(header);
-    for (int i = 0; i < table.size(); ++i) {
-        for (int j = 0; j < table[i].size(); ++j) {
-            m_stored_table->operator()(i, j) = table[i][j];
-        }
-    }
 
     ConvertTable();
 }
@@ -223,38 +438,6 @@ void FileHandler::ConvertTable()
     delete data;
 }
 
-bool FileHandler::CheckForTable()
-{
-    // int size = 0;
-    QRegularExpression rx("\\b^[a-zA-Z]+$\\b", QRegularExpression::CaseInsensitiveOption);
-#pragma message("rethink about it")
-    for (int i = 0; i < m_lines; ++i) {
-        // qDebug() << m_filecontent[i];
-        if (m_filecontent[i].isEmpty())
-            continue;
-        /*
-      if (size)
-        {
-            qDebug() << m_filecontent[i] << m_filecontent[i].split(sep) << m_filecontent[i].split(sep).size();
-            m_table = (size == m_filecontent[i].split(sep).size());
-        }
-        size = m_filecontent[i].split(sep).size();
-
-        if (!m_table)
-            return false;
-         */
-        if (m_table) {
-            QStringList elements = m_filecontent[i].split("\n");
-            for (int j = 0; j < elements.size(); ++j) {
-                if (elements[j].contains(rx))
-                    m_allint = false;
-            }
-        }
-    }
-    m_file_supported = m_allint && m_table;
-    return m_allint && m_table;
-}
-
 void FileHandler::ReaddH()
 {
 
@@ -27,6 +27,8 @@
 #include <QtCore/QObject>
 #include <QtCore/QPointer>
 
+#include <Eigen/Dense>
+
 class DataTable;
 
 class FileHandler : public QObject {
@@ -53,13 +55,8 @@ public:
 
     inline bool FileSupported() const { return m_file_supported; }
 
-    inline bool setFileContent(const QString& str)
-    {
-        m_filecontent = str.split("\n");
-        ReadGeneric();
-        bool read = CheckForTable();
-        return read;
-    }
+    /*! \brief Parse \a str (e.g. pasted text) as a generic table, true if it was one */
+    bool setFileContent(const QString& str);
 
     inline void setFileType(FileType type) { m_filetype = type; }
     inline FileType Type() const { return m_filetype; }
@@ -87,23 +84,24 @@ public:
     }
 
 private:
-    void ReadGeneric();
+    void ReadGeneric(const char* data, qint64 size);
     void ReaddH();
     void ReadJson();
     void ReadITC();
     void ConvertTable();
-    void ReadSeperated(const QString& seperator);
-    bool CheckForTable();
+    /*! \brief Parse the delimited table in [data, data + size) straight into m_stored_table; large
+     * inputs are split into chunks of lines that are parsed in parallel.
+     * \a letters_only_lines makes a line consisting of letters only reject the file */
+    void ReadSeperated(const char* data, qint64 size, char seperator, bool letters_only_lines = false);
 
-    void GenerateTable(QVector<QVector<double>>& table, const QStringList& header, int max_columns);
+    void GenerateTable(Eigen::MatrixXd& table, const QStringList& header);
 
     bool m_table, m_allint, m_file_supported, m_thermogram = false, m_plain_thermogram = false;
     QPointer<DataTable> m_stored_table;
 
     QString m_filename, m_title;
-    QString sep;
     QStringList m_filecontent;
-    int m_lines, m_rows = 2, m_start_point = 0, m_series = 0;
+    int m_rows = 2, m_start_point = 0, m_series = 0;
     FileType m_filetype;
     
     // Range selection parameters - Claude Generated
@@ -0,0 +1,184 @@
+/*
+ * SupraFit - persistent cache of converged fits
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "src/core/models/AbstractModel.h"
+#include "src/core/models/datatable.h"
+
+#include "src/global.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#include "fitcache.h"
+
+FitCache::FitCache(const QString& directory, qint64 max_bytes)
+    : m_directory(directory)
+    , m_max_bytes(max_bytes)
+{
+}
+
+FitCache& FitCache::instance()
+{
+    static FitCache cache(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/fits");
+    /* Follows the setting, a changed limit applies from the next Store() on */
+    const QVariant size = qApp->instance()->property("FitCacheSize");
+    cache.setMaxSize(size.isValid() ? size.toLongLong() * 1024 * 1024 : 256 * 1024 * 1024);
+    return cache;
+}
+
+void FitCache::setMaxSize(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_max_bytes = bytes;
+}
+
+qint64 FitCache::MaxSize() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_max_bytes;
+}
+
+bool FitCache::isEnabled() const
+{
+    if (!qApp->instance()->property("FitCache").toBool() || MaxSize() <= 0 || m_directory.isEmpty())
+        return false;
+    return QDir().mkpath(m_directory);
+}
+
+qint64 FitCache::Size() const
+{
+    qint64 size = 0;
+    for (const QFileInfo& info : QDir(m_directory).entryInfoList(QStringList() << "*.fit", QDir::Files))
+        size += info.size();
+    return size;
+}
+
+QByteArray FitCache::Key(AbstractModel* model)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+
+    auto addJson = [&hash](const QJsonObject& object) {
+        hash.addData(QJsonDocument(object).toJson(QJsonDocument::Compact));
+    };
+    /* The raw doubles, the tables in the exported model are rounded */
+    auto addMatrix = [&hash](const Eigen::MatrixXd& matrix) {
+        const qint64 size[2] = { matrix.rows(), matrix.cols() };
+        hash.addData(QByteArray::fromRawData(reinterpret_cast<const char*>(size), sizeof(size)));
+        hash.addData(QByteArray::fromRawData(reinterpret_cast<const char*>(matrix.data()), matrix.size() * sizeof(double)));
+    };
+
+    hash.addData(QString("SupraFit fit cache 1 %1 %2").arg(qint_version).arg(git_commit_hash).toUtf8());
+
+    /* Model type, definition, options, boundaries and locks - without the results of the last calculation */
+    QJsonObject definition = model->ExportModel(false);
+    for (const QString& key : { "SSE", "SAE", "mean_error", "variance", "standard_error", "converged", "valid", "AIC", "AICc", "name" })
+        definition.remove(key);
+    addJson(definition);
+
+    QJsonObject config = model->getOptimizerConfig();
+    config.remove("FitCache");
+    addJson(config);
+
+    QJsonObject system;
+    for (int index : model->getSystemParameterList())
+        system[QString::number(index)] = QJsonValue::fromVariant(model->getSystemParameter(index).value());
+    addJson(system);
+
+    addMatrix(model->IndependentModel()->Table());
+    addMatrix(model->DependentModel()->Table());
+    addMatrix(model->DependentModel()->CheckedTable());
+    addMatrix(model->GlobalTable()->Table());
+    addMatrix(model->LocalTable()->Table());
+
+    const qint64 range[2] = { model->DataBegin(), model->DataEnd() };
+    hash.addData(QByteArray::fromRawData(reinterpret_cast<const char*>(range), sizeof(range)));
+
+    return hash.result();
+}
+
+QString FitCache::Path(const QByteArray& key) const
+{
+    return m_directory + "/" + QString::fromLatin1(key.toHex()) + ".fit";
+}
+
+QJsonObject FitCache::Lookup(const QByteArray& key) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QFile file(Path(key));
+    if (!file.open(QIODevice::ReadOnly))
+        return QJsonObject();
+
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(qUncompress(file.readAll()), &error);
+    if (error.error != QJsonParseError::NoError || !document.isObject()) {
+        file.close();
+        file.remove();
+        return QJsonObject();
+    }
+    /* The modification time orders the entries for eviction */
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    return document.object();
+}
+
+void FitCache::Store(const QByteArray& key, const QJsonObject& model)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!QDir().mkpath(m_directory))
+        return;
+
+    /* Written to a temporary file and renamed, so concurrent processes never read a partial entry */
+    QSaveFile file(Path(key));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    file.write(qCompress(QJsonDocument(model).toJson(QJsonDocument::Compact)));
+    if (!file.commit())
+        return;
+
+    Evict();
+}
+
+void FitCache::Clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    for (const QFileInfo& info : QDir(m_directory).entryInfoList(QStringList() << "*.fit", QDir::Files))
+        QFile::remove(info.absoluteFilePath());
+}
+
+void FitCache::Evict()
+{
+    const QFileInfoList entries = QDir(m_directory).entryInfoList(QStringList() << "*.fit", QDir::Files, QDir::Time);
+
+    qint64 size = 0;
+    for (const QFileInfo& info : entries) {
+        size += info.size();
+        if (size > m_max_bytes)
+            QFile::remove(info.absoluteFilePath());
+    }
+}
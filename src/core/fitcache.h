@@ -0,0 +1,73 @@
+/*
+ * SupraFit - persistent cache of converged fits
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+class AbstractModel;
+
+/*! \brief Converged fits on local disk, addressed by the content they were fitted from.
+ *
+ * The key is a SHA-256 over the model definition and options, the data tables and system parameters,
+ * the start parameters and the optimizer config, so a hit is exactly the fit that would be repeated.
+ * Every entry is one compressed file; reading an entry touches it, and storing evicts the least
+ * recently used entries once the directory grows beyond the size limit.
+ *
+ * The cache is off unless the application property "FitCache" is set (the GUI and the CLI do so by
+ * default, --no-fit-cache opts out); "FitCacheSize" limits it in MB and is read again whenever
+ * instance() is called. A single fit opts out with the optimizer config key "FitCache" = false, a
+ * Minimizer with setCached(false). Only top level fits use it - resampling refits never repeat.
+ */
+class FitCache {
+public:
+    explicit FitCache(const QString& directory, qint64 max_bytes = 256 * 1024 * 1024);
+
+    /*! \brief Process wide cache below QStandardPaths::CacheLocation, sized from the current "FitCacheSize" */
+    static FitCache& instance();
+
+    /*! \brief Application property "FitCache" is set and the cache directory is usable */
+    bool isEnabled() const;
+
+    inline QString Directory() const { return m_directory; }
+    /*! \brief Size limit in bytes, applied from the next Store() on */
+    void setMaxSize(qint64 bytes);
+    qint64 MaxSize() const;
+    qint64 Size() const;
+
+    /*! \brief Content key of the fit that starts from the current state of \a model */
+    static QByteArray Key(AbstractModel* model);
+
+    /*! \brief Exported model of the converged fit stored under \a key, empty on a miss */
+    QJsonObject Lookup(const QByteArray& key) const;
+
+    void Store(const QByteArray& key, const QJsonObject& model);
+    void Clear();
+
+private:
+    QString Path(const QByteArray& key) const;
+    void Evict();
+
+    QString m_directory;
+    qint64 m_max_bytes;
+    mutable QMutex m_mutex;
+};
@@ -0,0 +1,358 @@
+/*
+ * SupraFit - fixed-size equilibrium speciation solver for small component counts
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace SpeciationDetail {
+
+/** @brief Solve the symmetric positive definite system @f$A\,x = b@f$; false if @p A is not SPD.
+ * The generic version goes through a fixed-size LLT, the 2x2 and 3x3 specialisations are closed form. */
+template <int N>
+inline bool SolveSPD(const Eigen::Matrix<double, N, N>& A, const Eigen::Matrix<double, N, 1>& b, Eigen::Matrix<double, N, 1>& x)
+{
+    const Eigen::LLT<Eigen::Matrix<double, N, N>> llt(A);
+    if (llt.info() != Eigen::Success)
+        return false;
+    x = llt.solve(b);
+    return true;
+}
+
+/** @brief 2x2: Sylvester criterion for definiteness, then Cramer's rule. */
+template <>
+inline bool SolveSPD<2>(const Eigen::Matrix2d& A, const Eigen::Vector2d& b, Eigen::Vector2d& x)
+{
+    const double a = A(0, 0), c = A(0, 1), d = A(1, 1);
+    const double det = a * d - c * c;
+    if (!(a > 0.0) || !(det > 0.0))
+        return false;
+    const double inv = 1.0 / det;
+    x(0) = (d * b(0) - c * b(1)) * inv;
+    x(1) = (a * b(1) - c * b(0)) * inv;
+    return true;
+}
+
+/** @brief 3x3: Sylvester criterion on the leading minors, then the symmetric adjugate. */
+template <>
+inline bool SolveSPD<3>(const Eigen::Matrix3d& A, const Eigen::Vector3d& b, Eigen::Vector3d& x)
+{
+    const double a = A(0, 0), p = A(0, 1), q = A(0, 2);
+    const double d = A(1, 1), e = A(1, 2), f = A(2, 2);
+    const double minor2 = a * d - p * p;
+    const double c00 = d * f - e * e;
+    const double c01 = q * e - p * f;
+    const double c02 = p * e - q * d;
+    const double det = a * c00 + p * c01 + q * c02;
+    if (!(a > 0.0) || !(minor2 > 0.0) || !(det > 0.0))
+        return false;
+    const double c11 = a * f - q * q;
+    const double c12 = p * q - a * e;
+    const double inv = 1.0 / det;
+    x(0) = (c00 * b(0) + c01 * b(1) + c02 * b(2)) * inv;
+    x(1) = (c01 * b(0) + c11 * b(1) + c12 * b(2)) * inv;
+    x(2) = (c02 * b(0) + c12 * b(1) + minor2 * b(2)) * inv;
+    return true;
+}
+
+} // namespace SpeciationDetail
+
+/**
+ * @brief ConcentrationSolver specialised at compile time on the number of components.
+ *
+ * Same potential, same Levenberg-Marquardt damped Newton iteration and the same acceptance rules as
+ * ConcentrationSolver (see there for the method), but on fixed-size Eigen vectors and matrices: the
+ * Hessian assembly unrolls, the 2x2 and 3x3 Newton systems are solved in closed form (SolveSPD) and
+ * a solve allocates nothing. Host/guest titrations are two components, competitive ones three, so
+ * SpeciationEngine dispatches to FixedConcentrationSolver<2> / <3> and keeps the dynamic solver as
+ * the fallback for everything else.
+ *
+ * Restricted to the common case the specialisation pays for: every component is present (total > 0)
+ * and the Newton method is selected. setTotalConcentrations() reports a point it cannot take (an
+ * absent component, e.g. the first point of a titration) so the caller can hand it to the dynamic
+ * solver, which handles the reduced active set.
+ */
+template <int N>
+class FixedConcentrationSolver {
+public:
+    typedef Eigen::Matrix<double, N, 1> Vector;
+    typedef Eigen::Matrix<double, N, N> Matrix;
+
+    FixedConcentrationSolver() = default;
+
+    /** @brief Stoichiometry, rows = components (must be N), columns = complexes. */
+    void setStoichiometry(const Eigen::MatrixXi& M)
+    {
+        m_M = M;
+        m_has_guess = false;
+        Rebuild();
+    }
+
+    /** @brief Linear cumulative stability constants, one per column of the stoichiometry. */
+    void setStabilityConstants(const std::vector<double>& beta)
+    {
+        m_beta = beta;
+        Rebuild();
+    }
+
+    /** @brief Stoichiometry and constants describe an N-component system of matching size. */
+    inline bool isReady() const { return m_M.rows() == N && static_cast<int>(m_beta.size()) == m_M.cols(); }
+
+    /** @brief Set the totals of one point; false (and nothing changed) if a component is absent. */
+    bool setTotalConcentrations(const std::vector<double>& totals)
+    {
+        if (static_cast<int>(totals.size()) != N)
+            return false;
+        for (int i = 0; i < N; ++i)
+            if (!(totals[i] > 0.0))
+                return false;
+        for (int i = 0; i < N; ++i)
+            m_totals(i) = totals[i];
+        return true;
+    }
+
+    /** @brief Seed the next solve from @p free (ignored unless it has N entries). */
+    void setWarmStart(const std::vector<double>& free)
+    {
+        if (static_cast<int>(free.size()) != N)
+            return;
+        for (int i = 0; i < N; ++i)
+            m_free(i) = free[i];
+        m_has_guess = true;
+    }
+
+    inline void setConvergeThreshold(double converge) { m_converge = converge; }
+    inline void setMaxIter(int maxiter) { m_maxiter = maxiter; }
+
+    /** @brief Cold-start magnitude, identical to ConcentrationSolver::GuessStart(). */
+    double GuessStart() const
+    {
+        int max_order = 1;
+        for (int j = 0; j < m_M.cols(); ++j)
+            max_order = std::max(max_order, m_M.col(j).sum());
+        return m_totals.minCoeff() / (10.0 * (max_order + 1));
+    }
+
+    /** @brief Solve for the free component concentrations, warm-started from the previous solve. */
+    const Vector& solve()
+    {
+        const auto t_start = std::chrono::steady_clock::now();
+        m_converged = false;
+        m_lastIter = 0;
+        m_lastConv = 0.0;
+
+        double fallback = 0.0;
+        Vector x;
+        for (int i = 0; i < N; ++i) {
+            double s = m_has_guess ? m_free(i) : 0.0;
+            if (!(s > 0.0)) {
+                if (fallback == 0.0)
+                    fallback = GuessStart();
+                s = fallback > 0.0 ? fallback : 1e-30;
+            }
+            x(i) = std::log(s);
+        }
+
+        Vector g, g_try, d;
+        Matrix H;
+        double f = Objective(x, &g, &H);
+        double lambda = 1e-6;
+        for (m_lastIter = 0; m_lastIter < m_maxiter; ++m_lastIter) {
+            m_lastConv = (g.array().abs() / m_totals.array()).maxCoeff();
+            if (m_lastConv < m_converge) {
+                m_converged = true;
+                break;
+            }
+
+            const double hscale = H.diagonal().maxCoeff() + 1e-300;
+            const double gsq = g.squaredNorm();
+            bool stepTaken = false;
+            for (int tries = 0; tries < 50; ++tries) {
+                Matrix Hr = H;
+                Hr.diagonal().array() += lambda * hscale;
+                if (!SpeciationDetail::SolveSPD<N>(Hr, -g, d))
+                    d = -g / hscale;
+                const double f_new = Objective(x + d, &g_try, nullptr);
+                if (f_new < f || g_try.squaredNorm() < gsq) {
+                    x += d;
+                    f = f_new;
+                    g = g_try;
+                    lambda = std::max(lambda * 0.1, 1e-14);
+                    stepTaken = true;
+                    break;
+                }
+                lambda *= 4.0;
+                if (lambda > 1e12)
+                    break;
+            }
+            if (!stepTaken)
+                break;
+
+            Objective(x, &g, &H);
+        }
+
+        m_free = x.array().exp();
+        m_H = H;
+        m_H_factored = false;
+        m_has_guess = true;
+        m_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start).count();
+        return m_free;
+    }
+
+    inline const Vector& currentConcentration() const { return m_free; }
+
+    /** @brief c_j = β_j ∏_i s_i^{M_ij}, 0 for a disabled complex; matches ConcentrationSolver. */
+    double speciesConcentration(int j) const
+    {
+        if (!(m_beta[j] > 0.0))
+            return 0.0;
+        double c = m_beta[j];
+        for (int i = 0; i < N; ++i) {
+            const int e = m_M(i, j);
+            if (e)
+                c *= std::pow(m_free(i), e);
+        }
+        return c;
+    }
+
+    /** @brief Fill @p species with every complex concentration (column order), reusing its storage. */
+    void SpeciesConcentrations(std::vector<double>& species) const
+    {
+        species.resize(m_M.cols());
+        for (int j = 0; j < m_M.cols(); ++j)
+            species[j] = speciesConcentration(j);
+    }
+
+    /** @brief ∂x_i/∂ln β_j (N × complexes) from the solution Hessian, as ConcentrationSolver::sensitivityMatrix(). */
+    Eigen::MatrixXd sensitivityMatrix() const
+    {
+        Eigen::MatrixXd S;
+        sensitivityMatrix(S);
+        return S;
+    }
+
+    /** @brief sensitivityMatrix() into @p S, reallocated only when its shape changes. */
+    void sensitivityMatrix(Eigen::MatrixXd& S) const
+    {
+        const int m = static_cast<int>(m_M.cols());
+        S.resize(N, m);
+        S.setZero();
+        if (!m_H_factored) {
+            m_H_factor.compute(m_H);
+            m_H_factored = true;
+        }
+        for (int j = 0; j < m; ++j) {
+            const double cj = speciesConcentration(j);
+            if (cj == 0.0)
+                continue;
+            const Vector rhs = m_M.col(j).template cast<double>() * cj;
+            S.col(j) = -m_H_factor.solve(rhs);
+        }
+    }
+
+    /** @brief H⁻¹Δt at the last solution, as ConcentrationSolver::totalsTangent(). */
+    Eigen::VectorXd totalsTangent(const std::vector<double>& dtotals) const
+    {
+        Eigen::VectorXd dx;
+        totalsTangent(dtotals, dx);
+        return dx;
+    }
+
+    /** @brief totalsTangent() into @p dx, reallocated only when its size changes. */
+    void totalsTangent(const std::vector<double>& dtotals, Eigen::VectorXd& dx) const
+    {
+        dx.resize(N);
+        dx.setZero();
+        if (static_cast<int>(dtotals.size()) != N)
+            return;
+        Vector rhs, d;
+        for (int i = 0; i < N; ++i)
+            rhs(i) = dtotals[i];
+        if (SpeciationDetail::SolveSPD<N>(m_H, rhs, d))
+            dx = d;
+    }
+
+    inline int LastIterations() const { return m_lastIter; }
+    inline double LastConvergency() const { return m_lastConv; }
+    inline bool Converged() const { return m_converged; }
+    inline long long Timer() const { return m_time; }
+
+private:
+    /** @brief One formable complex: its stoichiometry column as doubles and log β. */
+    struct Complex {
+        Eigen::Matrix<double, N, 1, Eigen::DontAlign> stoich;
+        double logbeta;
+    };
+
+    /** @brief Refresh the per-complex table after the stoichiometry or the constants changed. */
+    void Rebuild()
+    {
+        m_complexes.clear();
+        if (m_M.rows() != N || static_cast<int>(m_beta.size()) != m_M.cols())
+            return;
+        for (int j = 0; j < m_M.cols(); ++j) {
+            if (!(m_beta[j] > 0.0))
+                continue;
+            m_complexes.push_back({ m_M.col(j).template cast<double>(), std::log(m_beta[j]) });
+        }
+    }
+
+    double Objective(const Vector& x, Vector* gradient, Matrix* hessian) const
+    {
+        const Vector s = x.array().exp();
+        double G = s.sum() - m_totals.dot(x);
+        if (gradient)
+            *gradient = s - m_totals;
+        if (hessian)
+            *hessian = s.asDiagonal();
+
+        for (const Complex& complex : m_complexes) {
+            const Vector m = complex.stoich;
+            const double c = std::exp(complex.logbeta + m.dot(x));
+            G += c;
+            if (gradient)
+                *gradient += c * m;
+            if (hessian)
+                hessian->noalias() += (c * m) * m.transpose();
+        }
+        return G;
+    }
+
+    Eigen::MatrixXi m_M;
+    std::vector<double> m_beta;
+    std::vector<Complex> m_complexes; ///< enabled complexes only (β > 0)
+    Vector m_totals = Vector::Zero();
+    Vector m_free = Vector::Zero();
+    Matrix m_H = Matrix::Identity(); ///< Hessian at the last solution
+    mutable Eigen::LDLT<Matrix> m_H_factor; ///< factorisation of m_H for the sensitivities, valid while m_H_factored
+    mutable bool m_H_factored = false;
+
+    double m_converge = 1e-10;
+    double m_lastConv = 0.0;
+    int m_maxiter = 200;
+    int m_lastIter = 0;
+    long long m_time = 0;
+    bool m_converged = false;
+    bool m_has_guess = false;
+};
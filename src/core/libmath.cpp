@@ -318,8 +318,9 @@ namespace {
 
 /*! \brief Simpson's rule on one panel, falling back to an open rule at an unusable endpoint.
  *
- * Every caller of SimpsonIntegrate integrates over a saturation coordinate x in [0,1], where the
- * binding ratio alpha = x/(1-x) diverges at x = 1 (complete saturation needs infinite titrant).
+ * SimpsonIntegrate was written for integrals over a saturation coordinate x in [0,1] (the BC50
+ * integrals now use GaussKronrodIntegrate), where the binding ratio alpha = x/(1-x) diverges at
+ * x = 1 (complete saturation needs infinite titrant).
  * The integrands are therefore defined on the half-open interval [0,1): some have a finite limit
  * there and merely evaluate to inf/inf = NaN in floating point (BC50_Y -> 0), others carry an
  * integrable (1-x)^(-1/2) singularity whose integral still converges.
@@ -365,11 +366,10 @@ qreal SimpsonIntegrate(qreal lower, qreal upper, std::function<qreal(qreal, cons
 
     qreal integ = 0;
     /* Deliberately serial: the integrand is a std::function call over ~10^4 panels, so a parallel
-     * region costs more in fork/join and reduction than the arithmetic it distributes.
-     * Post-processing calls this once per resampled model (2000x for a Monte-Carlo run), where the
-     * repeated parallel regions dominated the whole results-widget build. Serial summation is also
-     * deterministic, unlike a reduction over a nondeterministic thread order.
-     * Claude Generated (2026, MC results-widget performance fix). */
+     * region costs more in fork/join and reduction than the arithmetic it distributes. Batches of
+     * integrals (one per Monte Carlo sample) are parallelised over the samples instead, see
+     * BC50::FromSpeciationSamples(). Serial summation is also deterministic, unlike a reduction
+     * over a nondeterministic thread order. */
     for (int i = 0; i < panels; ++i) {
         const double a = lower + i * h;
         /* The last panel closes on `upper` exactly rather than on a + h, so rounding cannot leave
@@ -23,6 +23,12 @@
 
 #include <QtCore/QPair>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <vector>
+
 #include <libpeakpick/mathhelper.h>
 #include <libpeakpick/nxlinregress.h>
 #include <libpeakpick/peakpick.h>
@@ -71,6 +77,87 @@ QMap<qreal, PeakPick::MultiRegression> LeastSquares(const QVector<qreal>& x, con
 qreal SimpsonIntegrate(qreal lower, qreal upper, std::function<qreal(qreal, const QVector<qreal>)> function, const QVector<qreal>& parameter, qreal delta = 1e-4);
 std::vector<qreal> SimpsonIntegrate(qreal lower, qreal upper, const std::vector<std::function<qreal(qreal, const QVector<qreal>)>*>& functions, const QVector<qreal>& parameter, qreal delta = 1e-4);
 
+namespace GaussKronrod {
+/* Nodes and weights of the 15-point Kronrod rule and its embedded 7-point Gauss rule (QUADPACK
+ * qk15), for the half interval; the Gauss nodes are the odd ones */
+constexpr double Nodes[8] = { 0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+    0.864864423359769072789712788640926, 0.741531185599394439863864773280788, 0.586087235467691130294144845693013,
+    0.405845151377397166906606412076961, 0.207784955007898467600689403773245, 0.0 };
+constexpr double Kronrod[8] = { 0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+    0.104790010322250183839876322541518, 0.140653259715525918745189590510238, 0.169004726639267902826583426598550,
+    0.190350578064785409913256402421014, 0.204432940075298892414161999234649, 0.209482141084727828012999174891714 };
+constexpr double Gauss[4] = { 0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+    0.381830050505118944950369775488975, 0.417959183673469387755102040816327 };
+
+struct Segment {
+    double lower, upper, value, error;
+};
+
+template <typename Function>
+inline Segment Rule(const Function& function, double lower, double upper)
+{
+    const double centre = 0.5 * (lower + upper);
+    const double half = 0.5 * (upper - lower);
+    const double fc = function(centre);
+    double kronrod = Kronrod[7] * fc;
+    double gauss = Gauss[3] * fc;
+    for (int i = 0; i < 7; ++i) {
+        const double sum = function(centre - half * Nodes[i]) + function(centre + half * Nodes[i]);
+        kronrod += Kronrod[i] * sum;
+        if (i % 2)
+            gauss += Gauss[i / 2] * sum;
+    }
+    return Segment{ lower, upper, kronrod * half, std::abs((kronrod - gauss) * half) };
+}
+}
+
+/*! \brief Adaptive Gauss-Kronrod (G7/K15) integral of \a function over [lower, upper].
+ *
+ * A template, so the integrand - any callable qreal(qreal), usually a lambda capturing its
+ * parameters - is inlined instead of called through a std::function. The segment with the largest
+ * error estimate is bisected until the summed estimate is below \a tolerance relative to the
+ * integral or \a max_segments is reached. Smooth integrands need one or two segments (15 - 45
+ * evaluations). The nodes are interior, so an endpoint where the integrand is not finite is never
+ * evaluated.
+ */
+template <typename Function>
+qreal GaussKronrodIntegrate(const Function& function, qreal lower, qreal upper, qreal tolerance = 1e-10, int max_segments = 200)
+{
+    if (!(upper > lower))
+        return 0;
+
+    auto larger = [](const GaussKronrod::Segment& a, const GaussKronrod::Segment& b) { return a.error < b.error; };
+    std::vector<GaussKronrod::Segment> segments;
+    segments.reserve(max_segments + 1);
+    segments.push_back(GaussKronrod::Rule(function, lower, upper));
+    double value = segments.front().value, error = segments.front().error;
+
+    while (int(segments.size()) < max_segments && error > tolerance * std::abs(value) && std::isfinite(value)) {
+        std::pop_heap(segments.begin(), segments.end(), larger);
+        const GaussKronrod::Segment worst = segments.back();
+        const double centre = 0.5 * (worst.lower + worst.upper);
+        /* Nothing left to bisect in double precision */
+        if (!(centre > worst.lower && centre < worst.upper))
+            break;
+        segments.pop_back();
+
+        const GaussKronrod::Segment left = GaussKronrod::Rule(function, worst.lower, centre);
+        const GaussKronrod::Segment right = GaussKronrod::Rule(function, centre, worst.upper);
+        value += left.value + right.value - worst.value;
+        error += left.error + right.error - worst.error;
+        segments.push_back(left);
+        std::push_heap(segments.begin(), segments.end(), larger);
+        segments.push_back(right);
+        std::push_heap(segments.begin(), segments.end(), larger);
+    }
+
+    /* Re-sum, the running update accumulates rounding over many bisections */
+    value = 0;
+    for (const GaussKronrod::Segment& segment : segments)
+        value += segment.value;
+    return value;
+}
+
 qreal DiscreteIntegrate(const QVector<qreal>& x, const QVector<qreal>& y);
 qreal Stddev(const QVector<qreal>& vector, int end = 0, double average = 0);
 
@@ -86,10 +173,23 @@ qreal f(qreal x, qreal a, qreal b, qreal c, qreal d);
 qreal df(qreal x, qreal a, qreal b, qreal c);
 }
 
-int NonlinearFit(QWeakPointer<AbstractModel> model, QVector<qreal>& param, QVector<double>& rmsd, QVector<QVector<double>>& parameter);
+/*! \brief Progress hook of the fit loops: called once per iteration in the fitting thread, while the
+ * model holds exactly the parameters that gave \a sse, so the callback may export the model. */
+typedef std::function<void(int iteration, qreal sse)> FitProgress;
+
+/*! \brief Classic Levenberg-Marquardt fit over all optimisation parameters. If \a interrupt is set
+ * during the run, the loop stops after the current step and the model keeps the last accepted state. */
+int NonlinearFit(QWeakPointer<AbstractModel> model, QVector<qreal>& param, QVector<double>& rmsd, QVector<QVector<double>>& parameter, const std::atomic<bool>* interrupt = nullptr, const FitProgress& progress = FitProgress());
 
 /*! \brief Opt-in variable-projection (VarPro) fit: a self-contained damped Levenberg-Marquardt over
  * only the non-linear global parameters; the linear local parameters are projected out by masked
  * least-squares (AbstractModel::ProjectLinearParameters()) at each residual evaluation. For models
  * with SupportsVarPro(); selected via the "FitSolver" optimizer-config key. Claude Generated. */
-int VarProFit(QWeakPointer<AbstractModel> model, QVector<double>& rmsd, QVector<QVector<double>>& parameter);
+int VarProFit(QWeakPointer<AbstractModel> model, QVector<double>& rmsd, QVector<QVector<double>>& parameter, const std::atomic<bool>* interrupt = nullptr, const FitProgress& progress = FitProgress());
+
+/*! \brief Opt-in Levenberg-Marquardt over all optimisation parameters that uses the block structure
+ * of the Jacobian (AbstractModel::JacobianBlocks()): the locals of all blocks are differentiated
+ * together and eliminated by a Schur complement, so the cost per iteration grows linearly with the
+ * number of series (or MetaModel sub models). Selected via "FitSolver" = "BlockLevMar". @p blocks
+ * receives the number of blocks the fit eliminated, 0 if it fell back to the dense problem. */
+int BlockLevMarFit(QWeakPointer<AbstractModel> model, QVector<qreal>& param, QVector<double>& rmsd, QVector<QVector<double>>& parameter, const std::atomic<bool>* interrupt = nullptr, const FitProgress& progress = FitProgress(), int* blocks = nullptr);
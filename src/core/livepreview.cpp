@@ -0,0 +1,114 @@
+/*
+ * Latest-wins evaluation of a model on a worker replica while its parameters are edited
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "src/core/models/dataclass.h"
+
+#include "livepreview.h"
+
+LivePreview::LivePreview(QSharedPointer<AbstractModel> model, QObject* parent)
+    : QObject(parent)
+    , m_model(model)
+{
+    m_pool.setMaxThreadCount(1);
+
+    m_settle = new QTimer(this);
+    m_settle->setSingleShot(true);
+    m_settle->setInterval(300);
+    connect(m_settle, &QTimer::timeout, this, [this]() {
+        // A preview still running would land on top of the full calculation, wait for it
+        if (m_busy || m_has_pending)
+            m_settle->start();
+        else
+            emit Settled();
+    });
+
+    /* The replica copies options and data only once, anything but the parameters renews it */
+    connect(m_model.data(), &AbstractModel::OptionChanged, this, &LivePreview::Invalidate);
+    connect(m_model.data(), &DataClass::SystemParameterChanged, this, &LivePreview::Invalidate);
+    connect(m_model.data(), &DataClass::Update, this, &LivePreview::Invalidate);
+}
+
+LivePreview::~LivePreview()
+{
+    ++m_generation;
+    m_pool.waitForDone();
+}
+
+void LivePreview::Request()
+{
+    Snapshot snapshot;
+    snapshot.global = m_model->GlobalTable()->Table();
+    snapshot.local = m_model->LocalTable()->Table();
+    snapshot.active = m_model->ActiveSignals();
+    snapshot.generation = ++m_generation;
+
+    m_settle->start();
+
+    if (m_busy) {
+        m_pending = snapshot;
+        m_has_pending = true;
+        return;
+    }
+    Dispatch(snapshot);
+}
+
+void LivePreview::Invalidate()
+{
+    m_replica.clear();
+}
+
+void LivePreview::Dispatch(const Snapshot& snapshot)
+{
+    if (!m_replica) {
+        m_replica = m_model->Replica();
+        m_replica->setFast(true);
+        m_replica->CalculateStatistics(false);
+    }
+
+    m_busy = true;
+    QSharedPointer<AbstractModel> replica = m_replica;
+    m_pool.start([this, replica, snapshot]() {
+        AbstractModel::Evaluation evaluation;
+        /* Superseded while queued: skip the evaluation, Deliver() starts the newer request */
+        if (snapshot.generation == m_generation) {
+            replica->GlobalTable()->setTable(snapshot.global);
+            replica->LocalTable()->setTable(snapshot.local);
+            if (replica->ActiveSignals() != snapshot.active)
+                replica->setActiveSignals(snapshot.active);
+            replica->Calculate();
+            evaluation = replica->ExportEvaluation();
+        }
+        QMetaObject::invokeMethod(this, [this, evaluation]() { Deliver(evaluation); }, Qt::QueuedConnection);
+    });
+}
+
+void LivePreview::Deliver(const AbstractModel::Evaluation& evaluation)
+{
+    m_busy = false;
+
+    /* Every finished evaluation is newer than the one shown, so it is shown even if a newer request
+     * is waiting - a continuous drag keeps updating instead of waiting for the pointer to stop */
+    if (evaluation.isValid())
+        m_model->ImportEvaluation(evaluation);
+
+    if (m_has_pending) {
+        m_has_pending = false;
+        Dispatch(m_pending);
+    }
+}
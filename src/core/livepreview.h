@@ -0,0 +1,79 @@
+/*
+ * Latest-wins evaluation of a model on a worker replica while its parameters are edited
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
+#include <QtCore/QTimer>
+
+#include <Eigen/Dense>
+
+#include <atomic>
+
+#include "src/core/models/AbstractModel.h"
+
+/*! \brief Live recalculation for interactive parameter editing
+ *
+ * Request() snapshots the parameters of the model and evaluates them on a replica (fast mode,
+ * no statistics) in a single worker thread. At most one evaluation runs; requests arriving in the
+ * meantime overwrite each other, so only the latest is evaluated next. Each finished evaluation is
+ * handed back with AbstractModel::ImportEvaluation(), which emits Recalculated() on the GUI thread.
+ * Once no request came in for the settle interval, Settled() asks the owner for the full
+ * calculation including statistics.
+ */
+class LivePreview : public QObject {
+    Q_OBJECT
+
+public:
+    explicit LivePreview(QSharedPointer<AbstractModel> model, QObject* parent = nullptr);
+    ~LivePreview() override;
+
+    /*! \brief Evaluate the current parameters of the model, superseding any request not yet started */
+    void Request();
+
+    /*! \brief Drop the replica; the next request builds a new one from the model */
+    void Invalidate();
+
+    inline void setSettleInterval(int msecs) { m_settle->setInterval(msecs); }
+    inline bool isBusy() const { return m_busy; }
+
+signals:
+    /*! \brief Editing stopped; the owner should run the full Calculate() now */
+    void Settled();
+
+private:
+    struct Snapshot {
+        Eigen::MatrixXd global, local;
+        QList<int> active;
+        quint64 generation = 0;
+    };
+
+    void Dispatch(const Snapshot& snapshot);
+    void Deliver(const AbstractModel::Evaluation& evaluation);
+
+    QSharedPointer<AbstractModel> m_model, m_replica;
+    QThreadPool m_pool;
+    QPointer<QTimer> m_settle;
+    std::atomic<quint64> m_generation{ 0 };
+    bool m_busy = false, m_has_pending = false;
+    Snapshot m_pending;
+};
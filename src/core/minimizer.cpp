@@ -20,14 +20,19 @@
 #include "src/global.h"
 #include "src/global_config.h"
 
+#include "src/core/fitcache.h"
 #include "src/core/libmath.h"
 #include "src/core/models/AbstractModel.h"
 #include "src/core/toolset.h"
 
-#include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QPromise>
 #include <QtCore/QTimer>
 
+#include <limits>
+
 #include "minimizer.h"
 
 NonLinearFitThread::NonLinearFitThread(bool exchange_statistics)
@@ -49,19 +54,43 @@ void NonLinearFitThread::start()
 
 void NonLinearFitThread::run()
 {
+    QElapsedTimer timer;
+    timer.start();
     m_running = true;
     m_steps = 0;
     m_converged = false;
-    if (!m_model->isSimulation())
-        NonLinearFit();
+    m_from_cache = false;
+    if (!m_model->isSimulation() && !m_interrupt) {
+        FitCache& cache = FitCache::instance();
+        const bool cached = m_cached && m_model->getOptimizerConfig().value("FitCache").toBool(true) && cache.isEnabled();
+        const QByteArray key = cached ? FitCache::Key(m_model.data()) : QByteArray();
+        const QJsonObject stored = cached ? cache.Lookup(key) : QJsonObject();
+        if (!stored.isEmpty() && m_model->ImportModel(stored, false)) {
+            m_model->CollectOptimizationParameters();
+            m_model->Calculate();
+            m_sum_error = m_model->SSE();
+            m_statistic_vector = m_model->StatisticVector();
+            m_last_parameter = m_model->ExportModel(m_exc_statistics);
+            m_best_intermediate = m_last_parameter;
+            m_converged = m_model->isConverged();
+            m_from_cache = true;
+        } else {
+            NonLinearFit();
+            /* Interrupted or failed fits are not worth repeating */
+            if (cached && m_converged && !m_interrupt)
+                cache.Store(key, m_model->ExportModel(false));
+        }
+    }
 
     m_running = false;
+    emit finished(timer.elapsed());
 }
 
 void NonLinearFitThread::setModel(const QSharedPointer<AbstractModel> model, bool clone)
 {
     if (clone) {
-        m_model = model->Clone();
+        /* Without statistics exchange the optimiser only needs something to evaluate */
+        m_model = m_exc_statistics ? model->Clone() : model->Replica();
         m_model->setDescription("Optimiser Model");
     } else
         m_model = model;
@@ -95,11 +124,37 @@ int NonLinearFitThread::NonLinearFit()
     // classic full-vector Levenberg-Marquardt. Selectable via the "FitSolver" optimizer-config key so
     // the two can be benchmarked. Claude Generated.
     const QString solver = m_model->getOptimizerConfig()["FitSolver"].toString();
+
+    /* Throttled progress: the model is exported only when the interval has passed and the SSE is
+     * below the best one reported so far, so the fit itself is not slowed down by the snapshots */
+    FitProgress progress;
+    QElapsedTimer throttle;
+    qreal best_sse = std::numeric_limits<qreal>::max();
+    if (m_progress_interval > 0) {
+        throttle.start();
+        progress = [this, &throttle, &best_sse](int iteration, qreal sse) {
+            if (throttle.elapsed() < m_progress_interval)
+                return;
+            throttle.restart();
+            QJsonObject best;
+            if (sse < best_sse) {
+                best_sse = sse;
+                best = m_model->ExportModel(m_exc_statistics);
+                m_best_intermediate = best;
+            }
+            emit Progress(iteration, best_sse, best);
+        };
+    }
+
+    const qint64 evaluations = m_model->Evaluations();
     int iter;
-    if ((solver == QLatin1String("VarPro") || solver == QLatin1String("VarProAnalytic")) && m_model->SupportsVarPro())
-        iter = VarProFit(m_model, m_history.sse, m_history.parameter);
+    if ((solver == QLatin1String("VarPro") || solver == QLatin1String("VarProAnalytic") || solver == QLatin1String("VarProBroyden")) && m_model->SupportsVarPro())
+        iter = VarProFit(m_model, m_history.sse, m_history.parameter, &m_interrupt, progress);
+    else if (solver == QLatin1String("BlockLevMar") || solver == QLatin1String("BlockLevMarBroyden"))
+        iter = BlockLevMarFit(m_model, parameter, m_history.sse, m_history.parameter, &m_interrupt, progress);
     else
-        iter = NonlinearFit(m_model, parameter, m_history.sse, m_history.parameter);
+        iter = NonlinearFit(m_model, parameter, m_history.sse, m_history.parameter, &m_interrupt, progress);
+    m_history.evaluations = m_model->Evaluations() - evaluations;
     m_sum_error = m_model->SSE();
     m_statistic_vector = m_model->StatisticVector();
     m_last_parameter = m_model->ExportModel(m_exc_statistics);
@@ -135,12 +190,71 @@ int Minimizer::Minimize()
 {
     qint64 t0 = QDateTime::currentMSecsSinceEpoch();
 
-    NonLinearFitThread* thread = new NonLinearFitThread(m_exc_statistics);
+    /* The fit runs in the calling thread - there is nothing to wait for and no event loop to spin.
+     * It is registered as the running fit, so Interrupt() from another thread still reaches it */
+    QSharedPointer<NonLinearFitThread> thread(new NonLinearFitThread(m_exc_statistics));
+    thread->setModel(m_model);
+    thread->setProgressInterval(m_progress_interval);
+    thread->setCached(m_cached);
+    connect(thread.data(), &NonLinearFitThread::Progress, this, &Minimizer::Progress, Qt::DirectConnection);
+    setRunningFit(thread);
+    thread->run();
+    clearRunningFit(thread);
+
+    return CollectResult(thread.data(), t0);
+}
+
+QFuture<int> Minimizer::MinimizeAsync()
+{
+    qint64 t0 = QDateTime::currentMSecsSinceEpoch();
+
+    QSharedPointer<NonLinearFitThread> thread(new NonLinearFitThread(m_exc_statistics));
     thread->setModel(m_model);
-    //thread->run();
-    thread->start();
-    while (thread->Running())
-        QCoreApplication::processEvents();
+    thread->setProgressInterval(m_progress_interval);
+    thread->setCached(m_cached);
+    connect(thread.data(), &NonLinearFitThread::Progress, this, &Minimizer::Progress);
+    setRunningFit(thread);
+
+    QSharedPointer<QPromise<void>> promise(new QPromise<void>);
+    QFuture<void> done = promise->future();
+    promise->start();
+    QThreadPool::globalInstance()->start([thread, promise]() {
+        thread->run();
+        promise->finish();
+    });
+
+    /* The continuation runs in the thread of this Minimizer, so the import into the model never
+     * races with its owner */
+    return done.then(this, [this, thread, t0]() {
+        clearRunningFit(thread);
+        int converged = CollectResult(thread.data(), t0);
+        emit MinimizationFinished(converged);
+        return converged;
+    });
+}
+
+void Minimizer::Interrupt()
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_running_fit)
+        m_running_fit->Interrupt();
+}
+
+void Minimizer::setRunningFit(const QSharedPointer<NonLinearFitThread>& thread)
+{
+    QMutexLocker locker(&m_mutex);
+    m_running_fit = thread;
+}
+
+void Minimizer::clearRunningFit(const QSharedPointer<NonLinearFitThread>& thread)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_running_fit == thread)
+        m_running_fit.clear();
+}
+
+int Minimizer::CollectResult(NonLinearFitThread* thread, qint64 t0)
+{
     bool converged = thread->Converged();
     if (converged)
         m_last_parameter = thread->ConvergedParameter();
@@ -148,7 +262,6 @@ int Minimizer::Minimize()
         m_last_parameter = thread->BestIntermediateParameter();
     m_sum_error = thread->SumOfError();
     m_history = thread->History();
-    delete thread;
 
     m_model->ImportModel(m_last_parameter);
     qint64 t1 = QDateTime::currentMSecsSinceEpoch();
@@ -19,7 +19,9 @@
 
 #pragma once
 
+#include <QtCore/QFuture>
 #include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
@@ -29,9 +31,12 @@
 
 #include "src/core/models/AbstractModel.h"
 
+#include <atomic>
+
 struct OptimisationHistory {
     QVector<double> sse;
     QVector<QVector<double>> parameter;
+    qint64 evaluations = 0; ///< model evaluations the fit took, see AbstractModel::Evaluations()
     QStringList names;
     QStringList colors;
 };
@@ -52,14 +57,25 @@ public:
     inline QJsonObject BestIntermediateParameter() const { return m_best_intermediate; }
     void setParameter(const QJsonObject& json);
     inline void setOptimizerConfig(const QJsonObject& config) { m_opt_config = config; }
+
+    /*! \brief Emit Progress() at most every \a msecs while fitting; 0 (default) keeps the fit silent */
+    inline void setProgressInterval(int msecs) { m_progress_interval = msecs; }
     inline bool Converged() const { return m_converged; }
     inline qreal SumOfError() const { return m_sum_error; }
     inline QVector<qreal> StatisticVector() const { return m_statistic_vector; }
-    inline bool Running() const { return m_running; }
+    inline bool Running() const { return m_running.load(); }
     inline OptimisationHistory History() const { return m_history; }
+
+    /*! \brief Look up and store the fit in the FitCache; off by default, resampling refits never repeat */
+    inline void setCached(bool cached) { m_cached = cached; }
+    /*! \brief The result was taken from the FitCache, History() is empty then */
+    inline bool FromCache() const { return m_from_cache; }
 public slots:
     void start();
 
+    /*! \brief Ask a running fit to stop after its current iteration, safe from any thread */
+    inline void Interrupt() { m_interrupt = true; }
+
 private:
     QSharedPointer<AbstractModel> m_model;
     QJsonObject m_last_parameter, m_best_intermediate;
@@ -67,7 +83,10 @@ private:
     QJsonObject m_opt_config;
     bool m_converged;
     int m_steps;
-    bool m_exc_statistics, m_running = false;
+    int m_progress_interval = 0;
+    bool m_exc_statistics;
+    bool m_cached = false, m_from_cache = false;
+    std::atomic<bool> m_running = false, m_interrupt = false;
     qreal m_sum_error;
     QVector<qreal> m_statistic_vector;
     OptimisationHistory m_history;
@@ -76,6 +95,10 @@ signals:
     void Message(const QString& str, int priority);
     void Warning(const QString& str, int priority);
     void finished(int msecs);
+
+    /*! \brief Throttled fit progress, emitted from the fitting thread. \a best is the exported model
+     * of a new best intermediate, or empty if the SSE did not improve since the last emission. */
+    void Progress(int iteration, qreal sse, const QJsonObject& best);
 };
 
 class Minimizer : public QObject {
@@ -87,6 +110,21 @@ public:
     void setModelCloned(const QSharedPointer<AbstractModel> model);
     int Minimize();
     int Minimize(const QList<int>& locked);
+
+    /*! \brief Fit on the global thread pool and return immediately
+     *
+     * The fit runs on a clone of the model; once it is done, the result is imported into the
+     * model in the thread of this Minimizer, MinimizationFinished is emitted and the returned
+     * future resolves to the converged flag. Interrupt() stops the fit cooperatively, the best
+     * intermediate parameters are imported then.
+     */
+    QFuture<int> MinimizeAsync();
+
+    /*! \brief Throttle interval for Progress(); 0 disables progress reports */
+    inline void setProgressInterval(int msecs) { m_progress_interval = msecs; }
+
+    /*! \brief Use the FitCache for Minimize() and MinimizeAsync() (default), if it is enabled */
+    inline void setCached(bool cached) { m_cached = cached; }
     void setOptimizerConfig(const QJsonObject& config)
     {
         m_opt_config = config;
@@ -101,16 +139,37 @@ public:
     inline QSharedPointer<AbstractModel> Model() const { return m_model; }
     inline OptimisationHistory History() const { return m_history; }
 
+public slots:
+    /*! \brief Stop the running fit after its current iteration, synchronous or asynchronous
+     *
+     * Safe from any thread. A blocking Minimize() never returns to the event loop, so it can only be
+     * interrupted by a direct call or a direct connection from another thread (or from Progress()).
+     */
+    void Interrupt();
+
 private:
+    int CollectResult(NonLinearFitThread* thread, qint64 t0);
+    void setRunningFit(const QSharedPointer<NonLinearFitThread>& thread);
+    void clearRunningFit(const QSharedPointer<NonLinearFitThread>& thread);
+
     QSharedPointer<AbstractModel> m_model;
+    QSharedPointer<NonLinearFitThread> m_running_fit;
+    QMutex m_mutex;
     QJsonObject m_opt_config;
     bool m_inform_config_changed;
+    int m_progress_interval = 0;
     QJsonObject m_last_parameter;
     bool m_exc_statistics;
+    bool m_cached = true;
     qreal m_sum_error;
     OptimisationHistory m_history;
 
 signals:
     void Message(const QString& str, int priority);
     void Warning(const QString& str, int priority);
+    void MinimizationFinished(int converged);
+
+    /*! \brief Progress of a fit; delivered in the thread of this Minimizer for MinimizeAsync(), in the
+     * calling thread for Minimize() */
+    void Progress(int iteration, qreal sse, const QJsonObject& best);
 };
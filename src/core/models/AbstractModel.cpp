@@ -30,6 +30,7 @@
 
 #include <QtCore/QCollator>
 #include <QtCore/QDateTime>
+#include <QtCore/QHashFunctions>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
@@ -54,6 +55,7 @@ AbstractModel::AbstractModel(DataClass* data)
 {
     m_opt_config = OptimConfigBlock;
     connect(this, &DataClass::SystemParameterChanged, this, &AbstractModel::UpdateParameter);
+    connect(this, &DataClass::SystemParameterChanged, this, &AbstractModel::InvalidateSpeciation);
 
     connect(this, &AbstractModel::OptionChanged, this, &AbstractModel::UpdateOption);
     private_d = new AbstractModelPrivate;
@@ -97,6 +99,7 @@ AbstractModel::AbstractModel(DataClass* data, const QJsonObject& model)
 
     m_opt_config = OptimConfigBlock;
     connect(this, &DataClass::SystemParameterChanged, this, &AbstractModel::UpdateParameter);
+    connect(this, &DataClass::SystemParameterChanged, this, &AbstractModel::InvalidateSpeciation);
 
     connect(this, &AbstractModel::OptionChanged, this, &AbstractModel::UpdateOption);
     private_d = new AbstractModelPrivate;
@@ -139,6 +142,7 @@ AbstractModel::AbstractModel(AbstractModel* model)
 {
     m_opt_config = OptimConfigBlock;
     connect(this, &DataClass::SystemParameterChanged, this, &AbstractModel::UpdateParameter);
+    connect(this, &DataClass::SystemParameterChanged, this, &AbstractModel::InvalidateSpeciation);
     connect(this, &AbstractModel::OptionChanged, this, &AbstractModel::UpdateOption);
 
     setActiveSignals(QVector<int>(SeriesCount(), 1).toList());
@@ -146,13 +150,14 @@ AbstractModel::AbstractModel(AbstractModel* model)
     m_model_signal = new DataTable(DataPoints(), SeriesCount(), this);
     m_model_error = new DataTable(DataPoints(), SeriesCount(), this);
 
-    connect(this, &DataClass::Update, this, [this]() {
+    /* Dropped again by finishClone() if this becomes a replica */
+    m_recalculation << connect(this, &DataClass::Update, this, [this]() {
         m_model_signal->clear(SeriesCount(), DataPoints());
         m_model_error->clear(SeriesCount(), DataPoints());
     });
 
-    connect(this, &DataClass::SystemParameterChanged, this, &AbstractModel::Calculate);
-    connect(this, &DataClass::Update, this, &AbstractModel::Calculate);
+    m_recalculation << connect(this, &DataClass::SystemParameterChanged, this, &AbstractModel::Calculate);
+    m_recalculation << connect(this, &DataClass::Update, this, &AbstractModel::Calculate);
 
     // connect(this->Info(), &DataClassPrivateObject::Update, this, &AbstractModel::Calculate);
 
@@ -418,6 +423,7 @@ bool AbstractModel::SetValue(int i, int j, qreal value)
         m_results_list.append(value);
         m_absolute_errors_list.append(m_model_error->data(i, j));
         m_squared_errors_list.append(m_model_error->data(i, j) * m_model_error->data(i, j));
+        m_residual_series.append(j);
     }
     //}
     m_used_series = used_series;
@@ -432,6 +438,7 @@ void AbstractModel::Calculate()
 #endif
     if (!LocalTable() || !m_complete || (DataBegin() == DataEnd() && SFModel() != SupraFit::MetaModel))
         return; // make sure, that PrepareParameter() has been called from subclass
+    ++m_evaluations;
     m_corrupt = false;
     m_mean = 0;
     m_variance = 0;
@@ -447,10 +454,17 @@ void AbstractModel::Calculate()
     m_results_list.clear();
     m_absolute_errors_list.clear();
     m_squared_errors_list.clear();
+    m_residual_series.clear();
 
     for (const QString& str : Charts())
         clearChart(str);
 
+    if (m_options_dirty) {
+        CompileOptions();
+        m_options_dirty = false;
+        InvalidateSpeciation();
+    }
+
     //    DependentModel()->Debug("AbstractModel::Calculate");
     // qint64 t0 = QDateTime::currentMSecsSinceEpoch();
     EvaluateOptions();
@@ -493,7 +507,75 @@ void AbstractModel::Calculate()
     //FIXME sometimes ...
     m_covfit = 0; //CalculateCovarianceFit();
 
-    emit Recalculated();
+    if (!m_replica)
+        emit Recalculated();
+}
+
+size_t AbstractModel::SpeciationKey()
+{
+    /* The raw doubles and the shape, read in place - the tables are not copied */
+    auto addMatrix = [](const Eigen::MatrixXd& matrix, size_t seed) {
+        const qint64 size[2] = { matrix.rows(), matrix.cols() };
+        seed = qHashBits(size, sizeof(size), seed);
+        return qHashBits(matrix.data(), matrix.size() * sizeof(double), seed);
+    };
+    const qint64 range[2] = { DataBegin(), DataEnd() };
+    size_t key = qHashBits(range, sizeof(range));
+    key = addMatrix(GlobalTable()->Table(), key);
+    key = addMatrix(GlobalTable()->CheckedTable(), key);
+    if (DataTable* independent = IndependentModel())
+        key = addMatrix(independent->Table(), key);
+    return key;
+}
+
+bool AbstractModel::SpeciationChanged()
+{
+    const size_t key = SpeciationKey();
+    /* Options not compiled yet may still change the speciation, Calculate() invalidates after compiling */
+    if (m_fast && m_speciation_valid && !m_options_dirty && m_speciation_key == key)
+        return false;
+
+    m_speciation_key = key;
+    m_speciation_valid = !m_options_dirty;
+    ++m_speciations;
+    return true;
+}
+
+void AbstractModel::CompileOptions()
+{
+    int size = 0;
+    for (const int index : getAllOptions())
+        size = qMax(size, index + 1);
+
+    m_compiled_options.value_index = QVector<int>(size, -1);
+    for (auto it = private_d->m_model_options.cbegin(); it != private_d->m_model_options.cend(); ++it) {
+        if (it.key() < 0 || it.value().values.isEmpty())
+            continue;
+        const QStringList& values = it.value().values;
+        const QString value = it.value().value.trimmed();
+        int position = values.indexOf(it.value().value);
+        /* Older projects may store the value with different case or padding */
+        for (int i = 0; i < values.size() && position == -1; ++i) {
+            if (values[i].compare(value, Qt::CaseInsensitive) == 0)
+                position = i;
+        }
+        /* The ITC models offer only "full" and "noncooperative" now, but older projects may store
+         * "additive" or "statistical", which the string comparison used to honour - map them onto
+         * CooperativityValue, whose positions are those of the complete list */
+        if (position == -1 && it.value().name.startsWith("Cooperativity")) {
+            static const QStringList cooperativity = { "full", "noncooperative", "additive", "statistical" };
+            for (int i = 0; i < cooperativity.size() && position == -1; ++i) {
+                if (cooperativity[i].compare(value, Qt::CaseInsensitive) == 0)
+                    position = i;
+            }
+        }
+        /* Anything else is what the string comparison used to do - the first (default) value */
+        m_compiled_options.value_index[it.key()] = qMax(position, 0);
+    }
+
+    m_compiled_options.skip_not_converged = m_opt_config.value("Skip_not_Converged_Concentrations").toBool();
+    m_compiled_options.concentration_convergence = m_opt_config.value("ConcentrationConvergence").toDouble(m_compiled_options.concentration_convergence);
+    m_compiled_options.max_iter_concentrations = m_opt_config.value("MaxIterConcentrations").toInt(m_compiled_options.max_iter_concentrations);
 }
 
 qreal AbstractModel::ModelError() const
@@ -613,6 +695,23 @@ QList<double> AbstractModel::getCalculatedAbsoluteErrors()
     return m_absolute_errors_list;
 }
 
+bool AbstractModel::JacobianBlocks(QVector<int>& parameter, QVector<int>& residual) const
+{
+    /* m_local_index lists the local parameters in the order they were appended to m_opt_para */
+    parameter.clear();
+    int local = 0;
+    for (const QPair<int, int>& index : m_opt_index) {
+        if (index.second == 0)
+            parameter << -1;
+        else if (local < m_local_index.size())
+            parameter << m_local_index[local++].second;
+        else
+            return false;
+    }
+    residual = m_residual_series;
+    return residual.size() == m_absolute_errors_list.size();
+}
+
 QList<double> AbstractModel::getCalculatedSquaredErrors()
 {
 
@@ -802,14 +901,93 @@ bool AbstractModel::RemoveStatistic(SupraFit::Method type, int index)
     return m_stats.remove(type, index);
 }
 
-void AbstractModel::finishClone(const QSharedPointer<AbstractModel>& clone, bool statistics)
+QSharedPointer<AbstractModel> AbstractModel::Replica()
+{
+    /* MetaModels clone their children themselves and simulations rebuild their tables in
+     * ImportModel, both keep the full path */
+    if (SFModel() == SupraFit::MetaModel || isSimulation())
+        return Clone(false);
+
+    return Clone(false, true);
+}
+
+AbstractModel::Evaluation AbstractModel::ExportEvaluation() const
 {
+    Evaluation evaluation;
+    evaluation.model = m_model_signal->Table();
+    evaluation.error = m_model_error->Table();
+    evaluation.sse = m_sum_squares;
+    evaluation.sae = m_sum_absolute;
+    evaluation.points = m_used_variables;
+    evaluation.corrupt = m_corrupt;
+    return evaluation;
+}
+
+void AbstractModel::ImportEvaluation(const Evaluation& evaluation)
+{
+    if (evaluation.model.rows() != m_model_signal->Table().rows() || evaluation.model.cols() != m_model_signal->Table().cols())
+        return;
+
+    m_model_signal->setTable(evaluation.model);
+    m_model_error->setTable(evaluation.error);
+    m_sum_squares = evaluation.sse;
+    m_sum_absolute = evaluation.sae;
+    m_used_variables = evaluation.points;
+    m_corrupt = evaluation.corrupt;
+
+    if (!m_replica)
+        emit Recalculated();
+}
+
+void AbstractModel::finishClone(const QSharedPointer<AbstractModel>& clone, bool statistics, bool replica)
+{
+    if (replica) {
+        /* A replica is driven exclusively by its worker, which calls Calculate() itself - no
+         * automatic recalculation on data or system parameter changes */
+        clone->m_replica = true;
+        for (const QMetaObject::Connection& connection : qAsConst(clone->m_recalculation))
+            disconnect(connection);
+        clone->m_recalculation.clear();
+        finishReplica(clone);
+        return;
+    }
+    clone->setExecutionContext(m_context);
     clone->ImportModel(ExportModel(statistics));
     clone->setActiveSignals(ActiveSignals());
     clone->setLockedParameter(LockedParameters());
     clone->setOptimizerConfig(getOptimizerConfig());
 }
 
+void AbstractModel::finishReplica(const QSharedPointer<AbstractModel>& clone) const
+{
+    clone->setExecutionContext(m_context);
+    for (int index : getAllOptions())
+        clone->setOption(index, getOption(index));
+
+    clone->GlobalTable()->setTable(GlobalTable()->Table());
+    clone->GlobalTable()->setCheckedTable(GlobalTable()->CheckedTable());
+    clone->LocalTable()->setTable(LocalTable()->Table());
+    clone->LocalTable()->setCheckedTable(LocalTable()->CheckedTable());
+
+    if (clone->m_global_boundaries.size() == m_global_boundaries.size())
+        clone->m_global_boundaries = m_global_boundaries;
+    if (clone->m_local_boundaries.size() == m_local_boundaries.size())
+        clone->m_local_boundaries = m_local_boundaries;
+
+    clone->m_converged = m_converged;
+    clone->m_AppliedSeries = m_AppliedSeries;
+    clone->m_name = m_name;
+    clone->m_locked_model = m_locked_model;
+    if (m_locked_model)
+        clone->ModelTable()->setTable(ModelTable()->Table());
+
+    clone->CollectOptimizationParameters();
+    clone->setActiveSignals(ActiveSignals());
+    clone->setLockedParameter(LockedParameters());
+    clone->setOptimizerConfig(getOptimizerConfig());
+    clone->Calculate();
+}
+
 void AbstractModel::ParseFastConfidence(const QJsonObject& data)
 {
     const QString str = "Simplified Model Comparison";
@@ -938,6 +1116,7 @@ void AbstractModel::setOption(int index, const QString& value)
     if (!private_d->m_model_options.contains(index) || value.isEmpty() || value.isNull())
         return;
     private_d->m_model_options[index].value = value;
+    m_options_dirty = true;
     CollectOptimizationParameters();
     emit OptionChanged(index, value);
 }
@@ -979,6 +1158,7 @@ AbstractModel& AbstractModel::operator=(const AbstractModel& other)
 
     m_active_signals = other.m_active_signals;
     private_d = other.private_d;
+    m_options_dirty = true;
 
     m_stats.copyStatisticsFrom(other.m_stats);
 
@@ -1005,6 +1185,7 @@ AbstractModel* AbstractModel::operator=(const AbstractModel* other)
 
     m_active_signals = other->m_active_signals;
     private_d = other->private_d;
+    m_options_dirty = true;
 
     m_stats.copyStatisticsFrom(other->m_stats);
 
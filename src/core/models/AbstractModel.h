@@ -22,6 +22,7 @@
 #include "src/global.h"
 
 #include "src/core/bc50system.h"
+#include "src/core/executioncontext.h"
 
 #include <Eigen/Dense>
 
@@ -46,6 +47,31 @@ struct ModelSeries {
     QList<QPointF> m_values;
 };
 
+/*! \brief Model options and optimizer-config values resolved into plain types
+ * Rebuilt by AbstractModel::CompileOptions() once after an option or the optimizer config changed,
+ * so CalculateVariables() reads ints and bools instead of comparing QStrings and looking up
+ * QJsonObject keys on every evaluation. */
+struct CompiledModelOptions {
+    /* option index -> position of the selected value in ModelOption::values, -1 for free options */
+    QVector<int> value_index;
+
+    /* numeric concentration settings of the optimizer config */
+    bool skip_not_converged = false;
+    qreal concentration_convergence = 1e-13;
+    int max_iter_concentrations = 1500;
+};
+
+/* Positions of the values in the "Cooperativity" option list shared by the 2:1 / 1:2 titration
+ * models ("full", "noncooperative", "additive", "statistical"), compared via OptionValueIndex() */
+namespace CooperativityValue {
+enum {
+    Full = 0,
+    NonCooperative = 1,
+    Additive = 2,
+    Statistical = 3
+};
+}
+
 /* Many things can be plotted, therefore let several series form a chart, where more than one chart can be managed by a model */
 struct ModelChart {
     QVector<ModelSeries> m_series;
@@ -167,9 +193,41 @@ public:
 
     /*
      * function to create a new instance of the model, this way was quite easier than
-     * a copy constructor
+     * a copy constructor; with replica set, the evaluation-only copy of Replica()
+     */
+    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true, bool replica = false) = 0;
+
+    /*! \brief Create an evaluation-only copy for statistics workers
+     *
+     * The replica shares the data tables, gets its parameters, options and boundaries copied
+     * directly (no json round trip), carries no statistics and emits no Recalculated(). It is
+     * meant to be fitted and evaluated by a worker and then discarded.
+     */
+    QSharedPointer<AbstractModel> Replica();
+
+    /*! \brief True if this model was created by Replica()
+     */
+    inline bool isReplica() const { return m_replica; }
+
+    /*! \brief Outcome of one Calculate(): model and error tables plus the error sums - enough to
+     * redraw the model without evaluating it again
+     */
+    struct Evaluation {
+        Eigen::MatrixXd model, error;
+        qreal sse = 0, sae = 0;
+        int points = 0;
+        bool corrupt = false;
+        inline bool isValid() const { return model.size() > 0; }
+    };
+
+    /*! \brief Evaluation of the last Calculate(), usually taken from a replica on a worker thread
+     */
+    Evaluation ExportEvaluation() const;
+
+    /*! \brief Show an evaluation made by a replica of this model as if Calculate() had run here;
+     * statistics beyond the error sums are not touched. Emits Recalculated().
      */
-    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true) = 0;
+    void ImportEvaluation(const Evaluation& evaluation);
 
     /*! \brief Export model to json file
      * 
@@ -323,6 +381,14 @@ public:
         return false;
     }
 
+    /*! \brief Block structure of the Jacobian for the block Levenberg-Marquardt solver ("FitSolver" =
+     * "BlockLevMar"). @p parameter receives the block of every optimisation parameter, -1 for those that
+     * may change every residual (the globals); @p residual the block of every residual in
+     * getCalculatedAbsoluteErrors() order. A parameter of block b must leave the residuals of all other
+     * blocks unchanged. The default puts every local parameter and every residual into its series.
+     * Returns false if the model has no such structure. */
+    virtual bool JacobianBlocks(QVector<int>& parameter, QVector<int>& residual) const;
+
     virtual inline int Color(int i) const { return i; }
 
 
@@ -504,6 +570,14 @@ public:
 
     inline bool isConverged() const { return m_converged; }
     virtual inline void setConverged(bool converged) { m_converged = converged; }
+
+    /*! \brief Number of model evaluations (Calculate() calls on a complete model) since this model
+     *  was created; a clone starts at zero. The cost measure of the fit solvers. */
+    inline qint64 Evaluations() const { return m_evaluations; }
+
+    /*! \brief Number of evaluations that solved the speciation, i.e. those for which
+     *  SpeciationChanged() was true. The rest reused the concentrations of the previous call. */
+    inline qint64 Speciations() const { return m_speciations; }
     /*! \brief Returns the f value for the given p value
      *  Degrees of freedom and number of parameters are taken in account
      */
@@ -585,6 +659,7 @@ public:
     virtual void setOptimizerConfig(const QJsonObject& config)
     {
         m_opt_config = config;
+        m_options_dirty = true;
     }
 
     /*
@@ -597,6 +672,11 @@ public:
      */
     virtual bool PreventThreads() const { return false; }
 
+    /*! \brief Thread budget and cancellation of the job this model is calculated in; copied by Clone()
+     * and Replica(), so the models of a search share the budget of its threads */
+    inline void setExecutionContext(const ExecutionContext& context) { m_context = context; }
+    inline const ExecutionContext& Context() const { return m_context; }
+
     virtual qreal SumOfErrors(int i) const;
 
     virtual qreal ModelError() const;
@@ -697,6 +777,7 @@ public:
             option.value = "legacy";
         option.name = name;
         private_d->m_model_options[index] = option;
+        m_options_dirty = true;
     }
 
     void setOption(int index, const QString& value);
@@ -797,7 +878,11 @@ public:
 
     inline QVector<int> LocalEnabled() const { return private_d->m_enabled_local; }
 
-    inline void RemoveOption(int key) { private_d->m_model_options.remove(key); }
+    inline void RemoveOption(int key)
+    {
+        private_d->m_model_options.remove(key);
+        m_options_dirty = true;
+    }
 
     inline void addSearchResult(const QJsonObject& search) { m_stats.append(SupraFit::Method::GlobalSearch, search); }
 
@@ -925,13 +1010,18 @@ private:
     void ParseFastConfidence(const QJsonObject& object);
 
     QList<double> m_results_list, m_absolute_errors_list, m_squared_errors_list;
+    /* series of each entry of the lists above */
+    QVector<int> m_residual_series;
 
 protected:
     /*! \brief Copy this model's state (data+parameters, active signals, locked parameters,
      * optimizer config) into a freshly constructed \a clone. The shared tail of every model's
      * Clone() (Claude Generated 2026, R4); subclasses only construct the concrete instance and
      * append any model-specific step (e.g. setConcentrations, UpdateParameter). */
-    void finishClone(const QSharedPointer<AbstractModel>& clone, bool statistics);
+    void finishClone(const QSharedPointer<AbstractModel>& clone, bool statistics, bool replica);
+
+    /*! \brief Replica() tail of finishClone: copy the evaluation state into \a clone directly */
+    void finishReplica(const QSharedPointer<AbstractModel>& clone) const;
 
     /*! \brief Prepend the model-specific BC50 line to a post-processing report when detailed output
      * is requested (Claude Generated 2026, R4). Behaviour-preserving factoring of the repeated
@@ -981,6 +1071,35 @@ protected:
 
     void PrepareParameter(int global, int local);
 
+    /*! \brief Resolve the model options and the optimizer config into m_compiled_options
+     * Reimplement to precompute model-specific flags as well, but call the base first.
+     * Invoked lazily from Calculate() after the options or the config changed. */
+    virtual void CompileOptions();
+
+    /*! \brief Position of the currently selected value of option index
+     * Legacy cooperativity values map onto CooperativityValue, other values that are not in the
+     * list fall back to the first (default) one; -1 only for unknown indices and options without a
+     * value list. Reads the compiled table, therefore cheap enough for CalculateVariables() */
+    inline int OptionValueIndex(int index) const
+    {
+        return index >= 0 && index < m_compiled_options.value_index.size() ? m_compiled_options.value_index[index] : -1;
+    }
+
+    inline const CompiledModelOptions& CompiledOptions() const { return m_compiled_options; }
+
+    /*! \brief True if results that depend only on the global parameters (the equilibrium
+     * concentrations of a titration) must be recomputed, false if the ones of the last call are still
+     * valid. Lets CalculateVariables() skip the speciation when only local parameters changed, e.g.
+     * for the local columns of a finite difference Jacobian.
+     *
+     * The key is a hash of the global parameters with their checked state, the independent table and
+     * the data range, taken without copying the tables; changed options or system parameters
+     * invalidate it as well. Outside fast mode it is always true, so concentration tables and charts
+     * are refilled. */
+    bool SpeciationChanged();
+    size_t SpeciationKey();
+    inline void InvalidateSpeciation() { m_speciation_valid = false; }
+
     // #warning to do as well
     //FIXME more must be
     QVector<double*> m_opt_para;
@@ -998,6 +1117,15 @@ protected:
     int m_AppliedSeries = 0;
     bool m_corrupt, m_converged, m_locked_model, m_fast, m_statistics = true, m_guess_failed = true, m_demand_guess = false, m_complete = true, m_demand_inialisation = false;
     QJsonObject m_opt_config;
+    CompiledModelOptions m_compiled_options;
+    bool m_options_dirty = true;
+    bool m_speciation_valid = false;
+    qint64 m_evaluations = 0, m_speciations = 0;
+    size_t m_speciation_key = 0;
+    bool m_replica = false;
+    /* Automatic recalculation on data and system parameter changes, dropped by replicas */
+    QVector<QMetaObject::Connection> m_recalculation;
+    ExecutionContext m_context;
     QVector<QJsonObject> m_pre_input;
     QHash<QString, QJsonObject> m_defined_model;
 
@@ -21,6 +21,7 @@
 #include "src/global_config.h"
 
 #include "src/core/models/datatable.h"
+#include "src/core/randomstream.h"
 #include "src/core/toolset.h"
 
 #include <Eigen/Dense>
@@ -97,13 +98,13 @@ DataTable::DataTable(Eigen::MatrixXd table, Eigen::MatrixXd checked_table, const
 }
 
 DataTable::DataTable(Eigen::MatrixXd table)
-    : m_table(table)
+    : m_table(std::move(table))
     , m_checkable(false)
     , m_editable(false)
 {
     for (int i = 0; i < columnCount(); ++i)
         m_header << QString::number(i + 1);
-    m_checked_table = Eigen::MatrixXd::Ones(table.rows(), table.cols());
+    m_checked_table = Eigen::MatrixXd::Ones(m_table.rows(), m_table.cols());
 }
 
 DataTable::DataTable(const QJsonObject& table)
@@ -687,6 +688,36 @@ QPointer<DataTable> DataTable::PrepareBootStrap(std::uniform_int_distribution<in
     return table;
 }
 
+QPointer<DataTable> DataTable::PrepareMC(QVector<double> stddev, RandomStream& stream, QVector<int> cols)
+{
+    while (stddev.size() < columnCount())
+        stddev << stddev.last();
+
+    if (cols.size() < columnCount()) {
+        cols = QVector<int>(columnCount(), 1);
+    }
+    QPointer<DataTable> table = new DataTable(this);
+    for (int j = 0; j < columnCount(); ++j) {
+        if (!cols[j])
+            continue;
+        for (int i = 0; i < rowCount(); ++i)
+            table->data(i, j) += stream.Normal(0, stddev[j]);
+    }
+    return table;
+}
+
+QPointer<DataTable> DataTable::PrepareBootStrap(RandomStream& stream, const QVector<qreal>& vector)
+{
+    QPointer<DataTable> table = new DataTable(this);
+    if (vector.isEmpty())
+        return table;
+    for (int j = 0; j < columnCount(); ++j) {
+        for (int i = 0; i < rowCount(); ++i)
+            table->data(i, j) += vector[stream.Bounded(vector.size())];
+    }
+    return table;
+}
+
 QString DataTable::ExportAsString() const
 {
     QString str;
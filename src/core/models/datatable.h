@@ -36,6 +36,8 @@
 
 typedef Eigen::VectorXd Vector;
 
+class RandomStream;
+
 class DataTable : public QAbstractTableModel {
     Q_OBJECT
 
@@ -78,7 +80,7 @@ public:
     void EnableAllRows();
     void setCheckedAll(bool checked);
     inline void setCheckedTable(Eigen::MatrixXd checked) { m_checked_table = checked; }
-    inline Eigen::MatrixXd CheckedTable() const { return m_checked_table; }
+    inline const Eigen::MatrixXd& CheckedTable() const { return m_checked_table; }
     inline DataTable* BlockRows(int row_begin, int row_end) const { return Block(row_begin, 1, row_end, columnCount()); }
     inline DataTable* BlockColumns(int column_begin, int column_end) const { return Block(0, column_begin, rowCount(), column_end); }
     QPointer<DataTable> Block(int row_begin, int column_begin, int row_end, int column_end) const;
@@ -127,6 +129,10 @@ public:
     QPointer<DataTable> PrepareMC(QVector<double> stddev, std::mt19937& rng, QVector<int> cols = QVector<int>());
 
     QPointer<DataTable> PrepareBootStrap(std::uniform_int_distribution<int>& Uni, std::mt19937& rng, const QVector<qreal>& vector);
+    /* Counter-based variants: the noise depends only on the key of the stream, so samples can be
+     * drawn in any thread and in any order and still reproduce a run */
+    QPointer<DataTable> PrepareMC(QVector<double> stddev, RandomStream& stream, QVector<int> cols = QVector<int>());
+    QPointer<DataTable> PrepareBootStrap(RandomStream& stream, const QVector<qreal>& vector);
     QString ExportAsString() const;
     QStringList ExportAsStringList() const;
 
@@ -110,10 +110,10 @@ void BiMolecularModel::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> BiMolecularModel::Clone(bool statistics)
+QSharedPointer<AbstractModel> BiMolecularModel::Clone(bool statistics, bool replica)
 {
     QSharedPointer<BiMolecularModel> model = QSharedPointer<BiMolecularModel>(new BiMolecularModel(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     model.data()->UpdateParameter();
     return model;
 }
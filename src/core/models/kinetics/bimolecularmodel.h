@@ -45,7 +45,7 @@ public:
 
     inline int GlobalParameterSize() const override { return 5; }
     virtual void InitialGuess_Private() override;
-    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true) override;
+    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true, bool replica = false) override;
     virtual bool SupportThreads() const override { return false; }
 
     /*! \brief we have only the time as input parameter
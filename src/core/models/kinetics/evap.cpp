@@ -82,11 +82,10 @@ void EvapMonoModel::CollectOptimizationParameters_Private()
 
 void EvapMonoModel::CalculateVariables()
 {
-    UpdateParameter();
     qreal k = GlobalParameter(0);
     qreal m = GlobalParameter(1);
     qreal A = GlobalParameter(2);
-    qreal scale = getSystemParameter(Factor).Double();
+    const qreal scale = m_scale;
     for (int i = DataBegin(); i < DataEnd(); ++i) {
         qreal t = IndependentModel()->data(i);
         // for (int j = 0; j < SeriesCount(); ++j) {
@@ -96,16 +95,17 @@ void EvapMonoModel::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> EvapMonoModel::Clone(bool statistics)
+QSharedPointer<AbstractModel> EvapMonoModel::Clone(bool statistics, bool replica)
 {
     QSharedPointer<EvapMonoModel> model = QSharedPointer<EvapMonoModel>(new EvapMonoModel(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     model.data()->UpdateParameter();
     return model;
 }
 
 void EvapMonoModel::UpdateParameter()
 {
+    m_scale = getSystemParameter(Factor).Double();
 }
 
 #include "evap.moc"
@@ -46,7 +46,7 @@ public:
 
     inline int GlobalParameterSize() const override { return 3; }
     virtual void InitialGuess_Private() override;
-    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true) override;
+    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true, bool replica = false) override;
     virtual bool SupportThreads() const override { return false; }
 
     /*! \brief we have only the time as input parameter
@@ -88,4 +88,5 @@ private:
 protected:
     virtual void CalculateVariables() override;
     qreal m_A0, m_B0;
+    qreal m_scale = 1; ///< system parameter Factor, read in UpdateParameter()
 };
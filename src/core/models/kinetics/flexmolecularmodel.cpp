@@ -96,10 +96,10 @@ void FlexMolecularModel::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> FlexMolecularModel::Clone(bool statistics)
+QSharedPointer<AbstractModel> FlexMolecularModel::Clone(bool statistics, bool replica)
 {
     QSharedPointer<FlexMolecularModel> model = QSharedPointer<FlexMolecularModel>(new FlexMolecularModel(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     model.data()->UpdateParameter();
     return model;
 }
@@ -88,10 +88,10 @@ void Michaelis_Menten_Model::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> Michaelis_Menten_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> Michaelis_Menten_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<Michaelis_Menten_Model> model = QSharedPointer<Michaelis_Menten_Model>(new Michaelis_Menten_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
@@ -94,10 +94,10 @@ void MonoMolecularModel::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> MonoMolecularModel::Clone(bool statistics)
+QSharedPointer<AbstractModel> MonoMolecularModel::Clone(bool statistics, bool replica)
 {
     QSharedPointer<MonoMolecularModel> model = QSharedPointer<MonoMolecularModel>(new MonoMolecularModel(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     model.data()->UpdateParameter();
     return model;
 }
@@ -95,16 +95,9 @@ void TIANModel::CollectOptimizationParameters_Private()
 
 void TIANModel::CalculateVariables()
 {
-    UpdateParameter();
-
     qreal A = GlobalParameter(0);
     qreal k = GlobalParameter(1) / 1e5;
-    double T = getSystemParameter(Temperature).Double();
-    double tau = getSystemParameter(C0).Double()
-        + T * getSystemParameter(C1).Double()
-        + T * T * getSystemParameter(C2).Double()
-        + T * T * T * getSystemParameter(C3).Double()
-        + T * T * T * T * getSystemParameter(C4).Double();
+    const double tau = m_tau;
 
     for (int i = DataBegin(); i < DataEnd(); ++i) {
         qreal t = IndependentModel()->data(i);
@@ -113,16 +106,22 @@ void TIANModel::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> TIANModel::Clone(bool statistics)
+QSharedPointer<AbstractModel> TIANModel::Clone(bool statistics, bool replica)
 {
     QSharedPointer<TIANModel> model = QSharedPointer<TIANModel>(new TIANModel(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     model.data()->UpdateParameter();
     return model;
 }
 
 void TIANModel::UpdateParameter()
 {
+    double T = getSystemParameter(Temperature).Double();
+    m_tau = getSystemParameter(C0).Double()
+        + T * getSystemParameter(C1).Double()
+        + T * T * getSystemParameter(C2).Double()
+        + T * T * T * getSystemParameter(C3).Double()
+        + T * T * T * T * getSystemParameter(C4).Double();
 }
 
 #include "tian.moc"
@@ -51,7 +51,7 @@ public:
 
     inline int GlobalParameterSize() const override { return 2; }
     virtual void InitialGuess_Private() override;
-    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true) override;
+    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true, bool replica = false) override;
     virtual bool SupportThreads() const override { return false; }
 
     /*! \brief we have only the time as input parameter
@@ -92,4 +92,5 @@ private:
 protected:
     virtual void CalculateVariables() override;
     qreal m_A0, m_B0;
+    qreal m_tau = 0; ///< calibration time constant, evaluated in UpdateParameter()
 };
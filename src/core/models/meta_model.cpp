@@ -469,6 +469,25 @@ QList<double> MetaModel::getCalculatedAbsoluteErrors()
     return x;
 }
 
+bool MetaModel::JacobianBlocks(QVector<int>& parameter, QVector<int>& residual) const
+{
+    if (m_models.size() < 2)
+        return false;
+
+    parameter.clear();
+    for (const MMParameter& combined : m_mmparameter) {
+        if (combined.second.size() == 1)
+            parameter << combined.second[0][0];
+        else
+            parameter << -1;
+    }
+
+    residual.clear();
+    for (int index = 0; index < m_models.size(); ++index)
+        residual << QVector<int>(m_models[index]->getCalculatedAbsoluteErrors().size(), index);
+    return true;
+}
+
 QList<double> MetaModel::getCalculatedModel()
 {
     QList<double> x;
@@ -664,8 +683,10 @@ void MetaModel::CalculateVariables()
         PrepareTables();
 }
 
-QSharedPointer<AbstractModel> MetaModel::Clone(bool statistics)
+QSharedPointer<AbstractModel> MetaModel::Clone(bool statistics, bool replica)
 {
+    /* The children are always cloned in full, see AbstractModel::Replica() */
+    Q_UNUSED(replica)
     QSharedPointer<MetaModel> model = QSharedPointer<MetaModel>(new MetaModel(new DataClass()), &QObject::deleteLater);
 
     for (const QSharedPointer<AbstractModel>& m : Models())
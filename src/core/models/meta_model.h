@@ -71,7 +71,7 @@ public:
 
     virtual void InitialGuess_Private() override;
 
-    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true) override;
+    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true, bool replica = false) override;
 
     virtual qreal GlobalParameter(int i) const override;
 
@@ -136,6 +136,9 @@ public:
     virtual QList<qreal> getCalculatedSquaredErrors() override;
     virtual QList<qreal> getCalculatedAbsoluteErrors() override;
 
+    /*! \brief Each sub model is one block: parameters not shared with another model only act on its residuals */
+    virtual bool JacobianBlocks(QVector<int>& parameter, QVector<int>& residual) const override;
+
     virtual qreal ModelError() const override;
 
     virtual qreal SumOfErrors(int i) const override;
@@ -72,10 +72,10 @@ void Dep_Any::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> Dep_Any::Clone(bool statistics)
+QSharedPointer<AbstractModel> Dep_Any::Clone(bool statistics, bool replica)
 {
     QSharedPointer<Dep_Any> model = QSharedPointer<Dep_Any>(new Dep_Any(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
@@ -86,10 +86,10 @@ void Indep_Quadrat::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> Indep_Quadrat::Clone(bool statistics)
+QSharedPointer<AbstractModel> Indep_Quadrat::Clone(bool statistics, bool replica)
 {
     QSharedPointer<Indep_Quadrat> model = QSharedPointer<Indep_Quadrat>(new Indep_Quadrat(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
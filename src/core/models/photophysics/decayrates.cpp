@@ -183,10 +183,10 @@ void DecayRates::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> DecayRates::Clone(bool statistics)
+QSharedPointer<AbstractModel> DecayRates::Clone(bool statistics, bool replica)
 {
     QSharedPointer<DecayRates> model = QSharedPointer<DecayRates>(new DecayRates(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
@@ -180,7 +180,7 @@ QString MonteCarlo2Thermo(int index, qreal T, const QJsonObject& object, bool he
     return result;
 }
 
-QString MonteCarlo2BC50_Speciation(const Eigen::MatrixXi& stoich, const QVector<qreal>& lgBeta, const QJsonObject& object)
+QString MonteCarlo2BC50_Speciation(const Eigen::MatrixXi& stoich, const QVector<qreal>& lgBeta, const QJsonObject& object, const ExecutionContext& context)
 {
     const qreal nominal = BC50::FromSpeciation(stoich, lgBeta);
     if (nominal < 0)
@@ -189,8 +189,7 @@ QString MonteCarlo2BC50_Speciation(const Eigen::MatrixXi& stoich, const QVector<
     const qreal error = 100 - object["0"].toObject()["confidence"].toObject()["error"].toDouble();
 
     QList<qreal> s;
-    for (const QVector<qreal>& global : RawGlobalParameters(object)) {
-        const qreal value = BC50::FromSpeciation(stoich, global);
+    for (const qreal value : BC50::FromSpeciationSamples(stoich, RawGlobalParameters(object), context)) {
         if (value > 0)
             s << value * 1e6;
     }
@@ -207,7 +206,7 @@ QString MonteCarlo2BC50_Speciation(const Eigen::MatrixXi& stoich, const QVector<
     return result;
 }
 
-QString GridSearch2BC50_Speciation(const Eigen::MatrixXi& stoich, const QVector<qreal>& lgBeta, const QJsonObject& object)
+QString GridSearch2BC50_Speciation(const Eigen::MatrixXi& stoich, const QVector<qreal>& lgBeta, const QJsonObject& object, const ExecutionContext& context)
 {
     const qreal nominal = BC50::FromSpeciation(stoich, lgBeta);
     if (nominal < 0)
@@ -215,8 +214,7 @@ QString GridSearch2BC50_Speciation(const Eigen::MatrixXi& stoich, const QVector<
 
     const qreal BC50 = nominal * 1e6;
     qreal lower = BC50, upper = BC50;
-    for (const QVector<qreal>& global : RawGlobalParameters(object)) {
-        const qreal value = BC50::FromSpeciation(stoich, global);
+    for (const qreal value : BC50::FromSpeciationSamples(stoich, RawGlobalParameters(object), context)) {
         if (value <= 0)
             continue;
         lower = qMin(value * 1e6, lower);
@@ -21,6 +21,7 @@
 
 #include <QtCore/QJsonObject>
 
+#include "src/core/executioncontext.h"
 #include "src/core/models/models.h"
 
 namespace Statistic {
@@ -32,13 +33,14 @@ QString MonteCarlo2Thermo(int index, qreal T, const QJsonObject& object = QJsonO
  * model id, so they cannot pick a fixed BC50 formula at compile time. Returns an empty string when
  * the system has no implemented BC50, so the caller reports nothing instead of a wrong number.
  * \param lgBeta CUMULATIVE lg beta per species, in the column order of \p stoich.
+ * \param context budget for the samples, the one of the model.
  * Claude Generated (2026). */
-QString MonteCarlo2BC50_Speciation(const Eigen::MatrixXi& stoich, const QVector<qreal>& lgBeta, const QJsonObject& object);
+QString MonteCarlo2BC50_Speciation(const Eigen::MatrixXi& stoich, const QVector<qreal>& lgBeta, const QJsonObject& object, const ExecutionContext& context = ExecutionContext());
 
 QString GridSearch2Thermo(int index, qreal T, const QJsonObject& object = QJsonObject(), bool heat = false);
 QJsonObject PostGridSearch(const QList<QJsonObject>& models, qreal K, qreal T, int index, qreal H = 0);
 /*! \brief Grid-search BC50 for a reaction-defined system. See MonteCarlo2BC50_Speciation. CG (2026). */
-QString GridSearch2BC50_Speciation(const Eigen::MatrixXi& stoich, const QVector<qreal>& lgBeta, const QJsonObject& object);
+QString GridSearch2BC50_Speciation(const Eigen::MatrixXi& stoich, const QVector<qreal>& lgBeta, const QJsonObject& object, const ExecutionContext& context = ExecutionContext());
 
 QString PseudoANOVA(const QPointer<const AbstractModel>& model);
 }
@@ -645,11 +645,11 @@ void ScriptModel::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> ScriptModel::Clone(bool statistics)
+QSharedPointer<AbstractModel> ScriptModel::Clone(bool statistics, bool replica)
 {
     QSharedPointer<ScriptModel> model = QSharedPointer<ScriptModel>(new ScriptModel(this), &QObject::deleteLater);
     // model.data()->DefineModel(GenerateModelDefinition());
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
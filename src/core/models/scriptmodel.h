@@ -211,7 +211,7 @@ public:
 
     inline int GlobalParameterSize() const override { return m_global_parameter_size; }
     virtual void InitialGuess_Private() override;
-    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true) override;
+    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true, bool replica = false) override;
     virtual bool SupportThreads() const override { return true; }
     virtual bool PreventThreads() const override { return false; }
 
@@ -88,10 +88,10 @@ void ArrheniusFit::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> ArrheniusFit::Clone(bool statistics)
+QSharedPointer<AbstractModel> ArrheniusFit::Clone(bool statistics, bool replica)
 {
     QSharedPointer<ArrheniusFit> model = QSharedPointer<ArrheniusFit>(new ArrheniusFit(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
@@ -104,7 +104,7 @@ void BETModel::CalculateVariables()
 {
     qreal C = GlobalParameter(0);
     qreal vm = GlobalParameter(1);
-    double p0 = getSystemParameter(Pressure).Double();
+    const double p0 = m_p0;
     for (int i = DataBegin(); i < DataEnd(); ++i) {
 
         qreal p = IndependentModel()->data(i);
@@ -113,6 +113,11 @@ void BETModel::CalculateVariables()
     }
 }
 
+void BETModel::UpdateParameter()
+{
+    m_p0 = getSystemParameter(Pressure).Double();
+}
+
 void BETModel::UpdateOption(int index, const QString& str)
 {
     Q_UNUSED(index)
@@ -159,10 +164,11 @@ qreal BETModel::PrintOutIndependent(int i) const
     return m_volume->data(i, 0);
 }
 
-QSharedPointer<AbstractModel> BETModel::Clone(bool statistics)
+QSharedPointer<AbstractModel> BETModel::Clone(bool statistics, bool replica)
 {
     QSharedPointer<BETModel> model = QSharedPointer<BETModel>(new BETModel(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
+    model.data()->UpdateParameter();
     return model;
 }
 
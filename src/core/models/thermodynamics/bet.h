@@ -55,7 +55,7 @@ public:
 
     inline int GlobalParameterSize() const override { return 2; }
     virtual void InitialGuess_Private() override;
-    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true) override;
+    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true, bool replica = false) override;
     virtual bool SupportThreads() const override { return false; }
 
     /*! \brief we have only the time as input parameter
@@ -90,6 +90,9 @@ public:
     virtual qreal PrintOutIndependent(int i) const override;
     void DeclareOptions() override;
 
+public slots:
+    virtual void UpdateParameter() override;
+
 private:
     void CalculateVolume();
 
@@ -98,4 +101,5 @@ protected:
     QPointer<DataTable> m_volume;
 
     qreal m_C, m_vm;
+    qreal m_p0 = 0; ///< saturation pressure, read in UpdateParameter()
 };
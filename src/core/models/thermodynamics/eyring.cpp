@@ -88,10 +88,10 @@ void EyringFit::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> EyringFit::Clone(bool statistics)
+QSharedPointer<AbstractModel> EyringFit::Clone(bool statistics, bool replica)
 {
     QSharedPointer<EyringFit> model = QSharedPointer<EyringFit>(new EyringFit(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
@@ -423,6 +423,12 @@ void AbstractItcModel::UpdateOption(int index, const QString& str)
         Concentration();*/
 }
 
+void AbstractItcModel::CompileOptions()
+{
+    AbstractModel::CompileOptions();
+    m_auto_dilution = getOption(Dilution) == "auto";
+}
+
 QString AbstractItcModel::AnalyseStatistic(bool forceAll) const
 {
     QString result;
@@ -451,7 +457,7 @@ QString AbstractItcModel::AnalyseMonteCarlo(const QJsonObject& object, bool forc
     result += AbstractModel::AnalyseMonteCarlo(object, forceAll);
 
     const BC50::ModelSystem sys = BC50System();
-    return prependBC50(result, forceAll, Statistic::MonteCarlo2BC50_Speciation(sys.stoich, sys.lgBeta, object));
+    return prependBC50(result, forceAll, Statistic::MonteCarlo2BC50_Speciation(sys.stoich, sys.lgBeta, object, Context()));
 }
 
 QString AbstractItcModel::AnalyseGridSearch(const QJsonObject& object, bool forceAll) const
@@ -472,7 +478,7 @@ QString AbstractItcModel::AnalyseGridSearch(const QJsonObject& object, bool forc
     result += AbstractModel::AnalyseGridSearch(object, forceAll);
 
     const BC50::ModelSystem sys = BC50System();
-    return prependBC50(result, forceAll, Statistic::GridSearch2BC50_Speciation(sys.stoich, sys.lgBeta, object));
+    return prependBC50(result, forceAll, Statistic::GridSearch2BC50_Speciation(sys.stoich, sys.lgBeta, object, Context()));
 }
 
 /*
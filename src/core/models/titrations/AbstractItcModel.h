@@ -150,6 +150,7 @@ private slots:
 protected:
     void SetConcentration(int i, const Vector& equilibrium);
     void virtual DeclareOptions() override;
+    virtual void CompileOptions() override;
     QPointer<DataTable> m_c0, m_concentrations;
     inline void Concentration() { CalculateConcentrations(); }
     // Defaults so accessors (getT/getV/…) and the "!m_V"-style unset guards never
@@ -157,6 +158,8 @@ protected:
     // semantics (0 = not yet set); m_T = 298 K matches the NMR/Titration default.
     double m_V = 0, m_cell_concentration = 0, m_syringe_concentration = 0, m_T = 298;
     bool m_reservior = true;
+    /* Dilution option resolved by CompileOptions(): "auto" fits the dilution heat */
+    bool m_auto_dilution = false;
     QString m_plotMode;
     QStringList m_plotmode;
 };
@@ -224,7 +224,7 @@ QString AbstractNMRModel::AnalyseMonteCarlo(const QJsonObject& object, bool forc
     result += AbstractModel::AnalyseMonteCarlo(object, forceAll);
 
     const BC50::ModelSystem sys = BC50System();
-    return prependBC50(result, forceAll, Statistic::MonteCarlo2BC50_Speciation(sys.stoich, sys.lgBeta, object));
+    return prependBC50(result, forceAll, Statistic::MonteCarlo2BC50_Speciation(sys.stoich, sys.lgBeta, object, Context()));
 }
 
 QString AbstractNMRModel::AnalyseGridSearch(const QJsonObject& object, bool forceAll) const
@@ -244,7 +244,7 @@ QString AbstractNMRModel::AnalyseGridSearch(const QJsonObject& object, bool forc
     result += AbstractModel::AnalyseGridSearch(object, forceAll);
 
     const BC50::ModelSystem sys = BC50System();
-    return prependBC50(result, forceAll, Statistic::GridSearch2BC50_Speciation(sys.stoich, sys.lgBeta, object));
+    return prependBC50(result, forceAll, Statistic::GridSearch2BC50_Speciation(sys.stoich, sys.lgBeta, object, Context()));
 }
 
 qreal AbstractNMRModel::InitialGuestConcentration(int i) const
@@ -218,9 +218,46 @@ QString AbstractTitrationModel::AdditionalOutput() const
         result += QString("Series %1 ... Individual contributions done\n\n\n").arg(i);
     }
     result += Statistic::PseudoANOVA(this);
+
+    const SpectralBasis basis = SpectralFitBasis();
+    if (basis.isValid() && basis.Components() == SeriesCount()) {
+        result += QString("\nGlobal spectral fit on %1 abstract spectra of %2 wavelengths (%3 % of the signal energy)\n")
+                      .arg(basis.Components())
+                      .arg(basis.Wavelengths())
+                      .arg(basis.ExplainedVariance() * 100, 0, 'f', 4);
+        result += QString("SSE at full resolution: %1 (compressed %2 + truncated %3)\n")
+                      .arg(SSE() + basis.DiscardedSSE())
+                      .arg(SSE())
+                      .arg(basis.DiscardedSSE());
+        const Eigen::MatrixXd spectra = ReconstructLocalSpectra();
+        result += "Reconstructed spectra\nx";
+        for (int j = 0; j < spectra.rows(); ++j)
+            result += "\t" + LocalParameterName(j);
+        result += "\n";
+        for (int w = 0; w < spectra.cols(); ++w) {
+            result += QString::number(basis.X()[w]);
+            for (int j = 0; j < spectra.rows(); ++j)
+                result += QString("\t%1").arg(spectra(j, w));
+            result += "\n";
+        }
+    }
     return result;
 }
 
+SpectralBasis AbstractTitrationModel::SpectralFitBasis() const
+{
+    return SpectralBasis::fromJson(RawData()["SpectralBasis"].toObject());
+}
+
+Eigen::MatrixXd AbstractTitrationModel::ReconstructLocalSpectra() const
+{
+    const SpectralBasis basis = SpectralFitBasis();
+    if (!basis.isValid() || basis.Components() != SeriesCount())
+        return Eigen::MatrixXd();
+    // LocalTable is series x locals; each local parameter's abstract spectrum is one of its columns.
+    return basis.Reconstruct(LocalParameter()->Table().transpose());
+}
+
 QString AbstractTitrationModel::AnalyseStatistic(bool forceAll) const
 {
     QString result;
@@ -249,7 +286,7 @@ QString AbstractTitrationModel::AnalyseMonteCarlo(const QJsonObject& object, boo
     result += AbstractModel::AnalyseMonteCarlo(object, forceAll);
 
     const BC50::ModelSystem sys = BC50System();
-    return prependBC50(result, forceAll, Statistic::MonteCarlo2BC50_Speciation(sys.stoich, sys.lgBeta, object));
+    return prependBC50(result, forceAll, Statistic::MonteCarlo2BC50_Speciation(sys.stoich, sys.lgBeta, object, Context()));
 }
 
 QString AbstractTitrationModel::AnalyseGridSearch(const QJsonObject& object, bool forceAll) const
@@ -270,7 +307,7 @@ QString AbstractTitrationModel::AnalyseGridSearch(const QJsonObject& object, boo
     result += AbstractModel::AnalyseGridSearch(object, forceAll);
 
     const BC50::ModelSystem sys = BC50System();
-    return prependBC50(result, forceAll, Statistic::GridSearch2BC50_Speciation(sys.stoich, sys.lgBeta, object));
+    return prependBC50(result, forceAll, Statistic::GridSearch2BC50_Speciation(sys.stoich, sys.lgBeta, object, Context()));
 }
 
 /*
@@ -301,6 +338,7 @@ qreal AbstractTitrationModel::InitialConcentration(int i, int component) const
 bool AbstractTitrationModel::BuildSpeciationFromReactions()
 {
     m_reaction_component_mismatch = 0;
+    InvalidateSpeciation();
     const QString text = m_defined_model.value("Reactions")["value"].toString().trimmed();
     if (text.isEmpty())
         return false;
@@ -30,6 +30,7 @@
 #include <QtCore/QtMath>
 
 #include "src/core/models/AbstractModel.h"
+#include "src/core/spectralbasis.h"
 #include "src/core/speciationengine.h"
 
 typedef Eigen::VectorXd Vector;
@@ -197,6 +198,14 @@ public:
 
     virtual QString AdditionalOutput() const override;
 
+    /*! \brief SVD basis of a global spectral fit, i.e. when the series are the abstract spectra
+     * compiled by SpectraHandler::CompileCompressedTable; invalid for ordinary wavelength data. */
+    SpectralBasis SpectralFitBasis() const;
+
+    /*! \brief Full-resolution spectrum of every local (linear) parameter of a global spectral fit:
+     * one row per local parameter, one column per wavelength of SpectralFitBasis(). Empty otherwise. */
+    Eigen::MatrixXd ReconstructLocalSpectra() const;
+
     //  virtual QVector<QJsonObject> PostGridSearch(const QList<QJsonObject> &models) const override;
 
 public slots:
@@ -176,10 +176,10 @@ QVector<qreal> fl_ItoI_Model::DeCompose(int datapoint, int series) const
     return vector;
 }
 
-QSharedPointer<AbstractModel> fl_ItoI_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> fl_ItoI_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<AbstractModel> model = QSharedPointer<fl_ItoI_Model>(new fl_ItoI_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
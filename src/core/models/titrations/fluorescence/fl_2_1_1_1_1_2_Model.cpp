@@ -85,7 +85,7 @@ void fl_IItoI_ItoI_ItoII_Model::DeclareOptions()
 
 void fl_IItoI_ItoI_ItoII_Model::EvaluateOptions()
 {
-    QString coop21 = getOption(Cooperativity2_1);
+    const int coop21 = OptionValueIndex(Cooperativity2_1);
 
     /*
      * Chem. Soc. Rev., 2017, 46, 2622--2637
@@ -107,16 +107,16 @@ void fl_IItoI_ItoI_ItoII_Model::EvaluateOptions()
             this->LocalTable()->data(i, 1) = 2 * (this->LocalTable()->data(i, 2) - this->LocalTable()->data(i, 0)) + this->LocalTable()->data(i, 0);
     };
 
-    if (coop21 == "noncooperative") {
+    if (coop21 == CooperativityValue::NonCooperative) {
         global_coop21();
-    } else if (coop21 == "additive") {
+    } else if (coop21 == CooperativityValue::Additive) {
         local_coop21();
-    } else if (coop21 == "statistical") {
+    } else if (coop21 == CooperativityValue::Statistical) {
         local_coop21();
         global_coop21();
     }
 
-    QString coop12 = getOption(Cooperativity1_2);
+    const int coop12 = OptionValueIndex(Cooperativity1_2);
 
     /*
      * Chem. Soc. Rev., 2017, 46, 2622--2637
@@ -137,11 +137,11 @@ void fl_IItoI_ItoI_ItoII_Model::EvaluateOptions()
             this->LocalTable()->data(i, 3) = 2 * (this->LocalTable()->data(i, 2) - this->LocalTable()->data(i, 0)) + this->LocalTable()->data(i, 0);
     };
 
-    if (coop12 == "noncooperative") {
+    if (coop12 == CooperativityValue::NonCooperative) {
         global_coop12();
-    } else if (coop12 == "additive") {
+    } else if (coop12 == CooperativityValue::Additive) {
         local_coop12();
-    } else if (coop12 == "statistical") {
+    } else if (coop12 == CooperativityValue::Statistical) {
         local_coop12();
         global_coop12();
     }
@@ -187,10 +187,10 @@ void fl_IItoI_ItoI_ItoII_Model::CalculateVariables()
     qreal K12 = qPow(10, GlobalParameter(2));
     m_constants_pow = QList<qreal>() << K21 << K11 << K12;
 
-    int maxthreads = qApp->instance()->property("threads").toInt();
+    int maxthreads = Context().Threads();
     m_threadpool->setMaxThreadCount(maxthreads);
 
-    bool skip = m_opt_config["Skip_not_Converged_Concentrations"].toBool();
+    const bool skip = m_compiled_options.skip_not_converged;
 
     for (int i = DataBegin(); i < DataEnd(); ++i) {
         // for (int i = 0; i < DataPoints(); ++i) {
@@ -198,7 +198,7 @@ void fl_IItoI_ItoI_ItoII_Model::CalculateVariables()
         qreal guest_0 = InitialGuestConcentration(i);
 
         m_solvers[i]->setInput(host_0, guest_0);
-        m_solvers[i]->setConfig(m_opt_config);
+        m_solvers[i]->setConfig(m_compiled_options.concentration_convergence, m_compiled_options.max_iter_concentrations);
         m_solvers[i]->setConstants(m_constants_pow);
         //if(QThreadPool::globalInstance()->activeThreadCount())
         m_solvers[i]->run();
@@ -206,8 +206,7 @@ void fl_IItoI_ItoI_ItoII_Model::CalculateVariables()
         //    m_threadpool->start(m_solvers[i]);
     }
 
-    while (m_threadpool->activeThreadCount()) { /*QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);*/
-    }
+    m_threadpool->waitForDone();
 
     for (int i = 0; i < DataPoints(); ++i) {
         qreal host_0 = InitialHostConcentration(i);
@@ -288,10 +287,10 @@ QVector<qreal> fl_IItoI_ItoI_ItoII_Model::DeCompose(int datapoint, int series) c
     return vector;
 }
 
-QSharedPointer<AbstractModel> fl_IItoI_ItoI_ItoII_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> fl_IItoI_ItoI_ItoII_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<fl_IItoI_ItoI_ItoII_Model> model = QSharedPointer<fl_IItoI_ItoI_ItoII_Model>(new fl_IItoI_ItoI_ItoII_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
@@ -65,7 +65,7 @@ void fl_IItoI_ItoI_Model::DeclareOptions()
 
 void fl_IItoI_ItoI_Model::EvaluateOptions()
 {
-    QString cooperativitiy = getOption(Cooperativity);
+    const int cooperativitiy = OptionValueIndex(Cooperativity);
     /*
      * Chem. Soc. Rev., 2017, 46, 2622--2637
      * K11 = 4*K21 | K21 = 0.25 K11
@@ -85,11 +85,11 @@ void fl_IItoI_ItoI_Model::EvaluateOptions()
             this->LocalTable()->data(i, 1) = 2 * (this->LocalTable()->data(i, 2) - this->LocalTable()->data(i, 0)) + this->LocalTable()->data(i, 0);
     };
 
-    if (cooperativitiy == "noncooperative") {
+    if (cooperativitiy == CooperativityValue::NonCooperative) {
         global_coop();
-    } else if (cooperativitiy == "additive") {
+    } else if (cooperativitiy == CooperativityValue::Additive) {
         local_coop();
-    } else if (cooperativitiy == "statistical") {
+    } else if (cooperativitiy == CooperativityValue::Statistical) {
         local_coop();
         global_coop();
     }
@@ -206,10 +206,10 @@ void fl_IItoI_ItoI_Model::CollectOptimizationParameters_Private()
     addLocalParameter(3);
 }
 
-QSharedPointer<AbstractModel> fl_IItoI_ItoI_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> fl_IItoI_ItoI_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<fl_IItoI_ItoI_Model> model = QSharedPointer<fl_IItoI_ItoI_Model>(new fl_IItoI_ItoI_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
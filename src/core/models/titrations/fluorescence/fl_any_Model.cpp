@@ -135,6 +135,8 @@ void fl_any_Model::CollectOptimizationParameters_Private()
 
 void fl_any_Model::CalculateConcentrations()
 {
+    if (!SpeciationChanged())
+        return;
     const int nComp = m_component_count;
     const int nSpecies = m_speciation.SpeciesCount();
 
@@ -150,13 +152,12 @@ void fl_any_Model::CalculateConcentrations()
     // design matrix: absolute concentrations of free components then species
     m_concentrations = Eigen::MatrixXd(DataPoints(), nComp + nSpecies);
 
-    std::vector<double> totals(nComp);
+    std::vector<double> totals(nComp), freeConc(nComp);
     for (int i = 0; i < DataPoints(); ++i) {
         for (int c = 0; c < nComp; ++c)
             totals[c] = InitialConcentration(i, c);
 
-        m_speciation.solve(totals, i);
-        const std::vector<double>& freeConc = m_speciation.FreeConcentrations();
+        m_speciation.solve(totals, i, freeConc);
         const std::vector<double>& speciesConc = m_speciation.SpeciesConcentrations();
 
         Vector vector(nComp + 1 + nSpecies);
@@ -203,10 +204,10 @@ void fl_any_Model::CalculateVariables()
             SetValue(i, j, m(i, j));
 }
 
-QSharedPointer<AbstractModel> fl_any_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> fl_any_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<AbstractModel> model = QSharedPointer<fl_any_Model>(new fl_any_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
@@ -59,7 +59,7 @@ public:
     inline bool UseDynamicParameterWidget() const override { return true; }
 
     virtual void InitialGuess_Private() override;
-    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true) override;
+    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true, bool replica = false) override;
     virtual bool SupportThreads() const override { return false; }
 
     // The fluorescence signal is linear in the per-species coefficients, so the locals can be projected
@@ -98,10 +98,10 @@ void Blank::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> Blank::Clone(bool statistics)
+QSharedPointer<AbstractModel> Blank::Clone(bool statistics, bool replica)
 {
     QSharedPointer<AbstractItcModel> model = QSharedPointer<Blank>(new Blank(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     model.data()->setConcentrations(ConcentrationTable());
     return std::move(model);
 }
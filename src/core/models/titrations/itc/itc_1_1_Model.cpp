@@ -88,7 +88,6 @@ void itc_ItoI_Model::CalculateVariables()
 {
     //    qDebug() << "from within" << CollectOptimizationParameters();
     QString more_info = QString("Inject\t" + qAB + "\t" + qsolv + "\t" + q + "\n");
-    QString dil = getOption(Dilution);
 
     qreal dH = LocalTable()->data(0, 0);
     qreal dil_heat = LocalTable()->data(0, 1);
@@ -109,7 +108,7 @@ void itc_ItoI_Model::CalculateVariables()
         qreal guest_0 = InitialGuestConcentration(i);
         qreal dilution = 0;
         qreal v = IndependentModel()->data(i);
-        if (dil == "auto") {
+        if (m_auto_dilution) {
             dilution = (guest_0 * dil_heat + dil_inter);
         }
         qreal host = ItoI::HostConcentration(host_0, guest_0, GlobalParameter(0));
@@ -143,10 +142,10 @@ void itc_ItoI_Model::CalculateVariables()
     // qDebug() << SSE();
 }
 
-QSharedPointer<AbstractModel> itc_ItoI_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> itc_ItoI_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<AbstractItcModel> model = QSharedPointer<itc_ItoI_Model>(new itc_ItoI_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     model.data()->setConcentrations(ConcentrationTable());
     return std::move(model);
 }
@@ -41,7 +41,7 @@ public:
     virtual void CollectOptimizationParameters_Private() override;
     inline int GlobalParameterSize() const override { return 1; }
     virtual void InitialGuess_Private() override;
-    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true) override;
+    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true, bool replica = false) override;
     virtual bool SupportThreads() const override { return false; }
 
     virtual inline QString GlobalParameterName(int i = 0) const override
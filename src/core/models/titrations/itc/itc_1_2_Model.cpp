@@ -73,7 +73,7 @@ void itc_ItoII_Model::DeclareOptions()
 
 void itc_ItoII_Model::EvaluateOptions()
 {
-    QString cooperativitiy = getOption(Cooperativity);
+    const int cooperativitiy = OptionValueIndex(Cooperativity);
     /*
      * Chem. Soc. Rev., 2017, 46, 2622--2637
      * K11 = 4*K12 | K12 = 0.25 K11
@@ -94,11 +94,11 @@ void itc_ItoII_Model::EvaluateOptions()
             this->LocalTable()->data(i, 2) = 2 * (this->LocalTable()->data(i, 1) - this->LocalTable()->data(i, 0)) + this->LocalTable()->data(i, 0);
     };
 
-    if (cooperativitiy == "noncooperative") {
+    if (cooperativitiy == CooperativityValue::NonCooperative) {
         global_coop();
-    } else if (cooperativitiy == "additive") {
+    } else if (cooperativitiy == CooperativityValue::Additive) {
         local_coop();
-    } else if (cooperativitiy == "statistical") {
+    } else if (cooperativitiy == CooperativityValue::Statistical) {
         local_coop();
         global_coop();
     }
@@ -146,7 +146,6 @@ void itc_ItoII_Model::CalculateVariables()
     QString more_info = QString("Inject\t" + qAB + "\t" + qAB2 + "\t" + qsolv + "\t" + q + "\n");
     QString more_info_2 = QString("\nInject\t" + qAB_ + "\t" + qAB2_ + "\t" + qsolv + "\t" + q + "\n");
 
-    QString dil = getOption(Dilution);
 
     qreal dil_heat = LocalTable()->data(0, 2);
     qreal dil_inter = LocalTable()->data(0, 3);
@@ -178,7 +177,7 @@ void itc_ItoII_Model::CalculateVariables()
         host_0 *= fx;
 
         qreal dilution = 0;
-        if (dil == "auto") {
+        if (m_auto_dilution) {
             dilution = (guest_0 * dil_heat + dil_inter);
         }
 
@@ -225,10 +224,10 @@ void itc_ItoII_Model::CalculateVariables()
     m_more_info = more_info + "\n" + more_info_2;
 }
 
-QSharedPointer<AbstractModel> itc_ItoII_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> itc_ItoII_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<AbstractItcModel> model = QSharedPointer<itc_ItoII_Model>(new itc_ItoII_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     model.data()->setConcentrations(ConcentrationTable());
     return std::move(model);
 }
@@ -72,7 +72,7 @@ void itc_IItoI_Model::DeclareOptions()
 
 void itc_IItoI_Model::EvaluateOptions()
 {
-    QString cooperativitiy = getOption(Cooperativity);
+    const int cooperativitiy = OptionValueIndex(Cooperativity);
     /*
      * Chem. Soc. Rev., 2017, 46, 2622--2637
      * K11 = 4*K21 | K21 = 0.25 K11
@@ -92,11 +92,11 @@ void itc_IItoI_Model::EvaluateOptions()
             this->LocalTable()->data(i, 1) = 2 * (this->LocalTable()->data(i, 2) - this->LocalTable()->data(i, 0)) + this->LocalTable()->data(i, 0);
     };
 
-    if (cooperativitiy == "noncooperative") {
+    if (cooperativitiy == CooperativityValue::NonCooperative) {
         global_coop();
-    } else if (cooperativitiy == "additive") {
+    } else if (cooperativitiy == CooperativityValue::Additive) {
         local_coop();
-    } else if (cooperativitiy == "statistical") {
+    } else if (cooperativitiy == CooperativityValue::Statistical) {
         local_coop();
         global_coop();
     }
@@ -149,7 +149,6 @@ void itc_IItoI_Model::CalculateVariables()
     QString more_info = QString("Inject\t" + qA2B + "\t" + qAB + "\t" + qsolv + "\t" + q + "\n");
     QString more_info_2 = QString("\nInject\t" + qA2B_ + "\t" + qAB_ + "\t" + qsolv + "\t" + q + "\n");
 
-    QString dil = getOption(Dilution);
 
     qreal dH1 = LocalTable()->data(0, 1);
     qreal dH2 = LocalTable()->data(0, 0) + dH1;
@@ -178,7 +177,7 @@ void itc_IItoI_Model::CalculateVariables()
         host_0 *= fx;
 
         qreal dilution = 0;
-        if (dil == "auto") {
+        if (m_auto_dilution) {
             dilution = (guest_0 * dil_heat + dil_inter);
         }
 
@@ -230,10 +229,10 @@ void itc_IItoI_Model::CalculateVariables()
     m_more_info = more_info + "\n" + more_info_2;
 }
 
-QSharedPointer<AbstractModel> itc_IItoI_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> itc_IItoI_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<AbstractItcModel> model = QSharedPointer<itc_IItoI_Model>(new itc_IItoI_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     model.data()->setConcentrations(ConcentrationTable());
     return std::move(model);
 }
@@ -93,7 +93,7 @@ void itc_IItoII_Model::DeclareOptions()
 
 void itc_IItoII_Model::EvaluateOptions()
 {
-    QString coop21 = getOption(Cooperativity2_1);
+    const int coop21 = OptionValueIndex(Cooperativity2_1);
 
     /*
      * Chem. Soc. Rev., 2017, 46, 2622--2637
@@ -115,16 +115,16 @@ void itc_IItoII_Model::EvaluateOptions()
             this->LocalTable()->data(i, 1) = 2 * (this->LocalTable()->data(i, 2) - this->LocalTable()->data(i, 0)) + this->LocalTable()->data(i, 0);
     };
 
-    if (coop21 == "noncooperative") {
+    if (coop21 == CooperativityValue::NonCooperative) {
         global_coop21();
-    } else if (coop21 == "additive") {
+    } else if (coop21 == CooperativityValue::Additive) {
         local_coop21();
-    } else if (coop21 == "statistical") {
+    } else if (coop21 == CooperativityValue::Statistical) {
         local_coop21();
         global_coop21();
     }
 
-    QString coop12 = getOption(Cooperativity1_2);
+    const int coop12 = OptionValueIndex(Cooperativity1_2);
 
     /*
      * Chem. Soc. Rev., 2017, 46, 2622--2637
@@ -145,11 +145,11 @@ void itc_IItoII_Model::EvaluateOptions()
             this->LocalTable()->data(i, 3) = 2 * (this->LocalTable()->data(i, 2) - this->LocalTable()->data(i, 0)) + this->LocalTable()->data(i, 0);
     };
 
-    if (coop12 == "noncooperative") {
+    if (coop12 == CooperativityValue::NonCooperative) {
         global_coop12();
-    } else if (coop12 == "additive") {
+    } else if (coop12 == CooperativityValue::Additive) {
         local_coop12();
-    } else if (coop12 == "statistical") {
+    } else if (coop12 == CooperativityValue::Statistical) {
         local_coop12();
         global_coop12();
     }
@@ -206,12 +206,11 @@ void itc_IItoII_Model::CalculateVariables()
     if (!m_threadpool)
         return;
 
-    bool skip = m_opt_config["Skip_not_Converged_Concentrations"].toBool();
+    const bool skip = m_compiled_options.skip_not_converged;
 
     QString more_info = QString("Inject\t" + qA2B + "\t" + qAB + "\t" + qAB2 + "\t" + qsolv + "\t" + q + "\n");
     QString more_info_2 = QString("\nInject\t" + qA2B_ + "\t" + qAB_ + "\t" + qAB2_ + "\t" + qsolv + "\t" + q + "\n");
 
-    QString dil = getOption(Dilution);
 
     qreal dH11 = LocalTable()->data(0, 1);
     qreal dH21 = LocalTable()->data(0, 0) + dH11;
@@ -235,7 +234,7 @@ void itc_IItoII_Model::CalculateVariables()
 
     bool reservior = m_reservior;
 
-    int maxthreads = qApp->instance()->property("threads").toInt();
+    int maxthreads = Context().Threads();
     m_threadpool->setMaxThreadCount(maxthreads);
     for (int i = 0; i < DataPoints(); ++i) {
         qreal host_0 = InitialHostConcentration(i);
@@ -243,7 +242,7 @@ void itc_IItoII_Model::CalculateVariables()
 
         qreal guest_0 = InitialGuestConcentration(i);
         m_solvers[i]->setInput(host_0, guest_0);
-        m_solvers[i]->setConfig(m_opt_config);
+        m_solvers[i]->setConfig(m_compiled_options.concentration_convergence, m_compiled_options.max_iter_concentrations);
         m_solvers[i]->setConstants(constants_pow);
         //  if(QThreadPool::globalInstance()->activeThreadCount())
         //      m_solvers[i]->run();
@@ -272,7 +271,7 @@ void itc_IItoII_Model::CalculateVariables()
 
         qreal guest_0 = InitialGuestConcentration(i);
         qreal dilution = 0;
-        if (dil == "auto") {
+        if (m_auto_dilution) {
             dilution = (guest_0 * dil_heat + dil_inter);
         }
 
@@ -337,10 +336,10 @@ void itc_IItoII_Model::CalculateVariables()
     m_more_info = more_info + "\n" + more_info_2;
 }
 
-QSharedPointer<AbstractModel> itc_IItoII_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> itc_IItoII_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<AbstractItcModel> model = QSharedPointer<itc_IItoII_Model>(new itc_IItoII_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     model.data()->setConcentrations(ConcentrationTable());
     return std::move(model);
 }
@@ -170,6 +170,15 @@ void itc_any_Model::CollectOptimizationParameters_Private()
     addLocalParameter(nSpecies + 2);
 }
 
+void itc_any_Model::CompileOptions()
+{
+    AbstractItcModel::CompileOptions();
+    const int nSpecies = m_speciation.SpeciesCount();
+    m_species_active.assign(nSpecies, 0);
+    for (int k = 0; k < nSpecies; ++k)
+        m_species_active[k] = getOption(Dilution + 1 + k) == "yes";
+}
+
 void itc_any_Model::CalculateVariables()
 {
     const int nSpecies = m_speciation.SpeciesCount();
@@ -179,7 +188,7 @@ void itc_any_Model::CalculateVariables()
     std::vector<double> constants(nSpecies);
     Vector heats(nSpecies);
     for (int k = 0; k < nSpecies; ++k) {
-        if (getOption(Dilution + 1 + k) == "yes") {
+        if (k < int(m_species_active.size()) && m_species_active[k]) {
             constants[k] = pow(10, GlobalParameter(k));
             heats(k) = LocalTable()->data(0, k);
         } else {
@@ -190,7 +199,6 @@ void itc_any_Model::CalculateVariables()
     m_speciation.setStabilityConstants(constants);
 
     QString more_info = QString("Inject\t" + qAB + "\t" + qsolv + "\t" + q + "\n");
-    QString dil = getOption(Dilution);
 
     const qreal dil_heat = LocalTable()->data(0, nSpecies);
     const qreal dil_inter = LocalTable()->data(0, nSpecies + 1);
@@ -203,12 +211,14 @@ void itc_any_Model::CalculateVariables()
 
     /* The incremental heat of injection i depends on the concentrations of the previous point, so
      * the loop MUST run over all data points in sequence. */
+    std::vector<double> totals(2), freeConc(2);
     for (int i = 0; i < DataPoints(); ++i) {
         qreal host_0 = InitialHostConcentration(i) * fx;
         qreal guest_0 = InitialGuestConcentration(i);
 
-        m_speciation.solve({ host_0, guest_0 }, i);
-        const std::vector<double>& freeConc = m_speciation.FreeConcentrations();
+        totals[0] = host_0;
+        totals[1] = guest_0;
+        m_speciation.solve(totals, i, freeConc);
         const std::vector<double>& speciesConc = m_speciation.SpeciesConcentrations();
         const double host = freeConc.empty() ? 0.0 : freeConc[0];
         const double guest = freeConc.size() > 1 ? freeConc[1] : 0.0;
@@ -226,7 +236,7 @@ void itc_any_Model::CalculateVariables()
 
         qreal dilution = 0;
         qreal v = IndependentModel()->data(i);
-        if (dil == "auto")
+        if (m_auto_dilution)
             dilution = (guest_0 * dil_heat + dil_inter);
         V += IndependentModel()->data(i) * !reservior;
         qreal dv = (1 - v / V);
@@ -262,10 +272,10 @@ void itc_any_Model::CalculateVariables()
     m_more_info = more_info;
 }
 
-QSharedPointer<AbstractModel> itc_any_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> itc_any_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<AbstractItcModel> model = QSharedPointer<itc_any_Model>(new itc_any_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     model.data()->setConcentrations(ConcentrationTable());
     return std::move(model);
 }
@@ -42,7 +42,7 @@ public:
     virtual void CollectOptimizationParameters_Private() override;
     inline int GlobalParameterSize() const override { return m_global_parametersize; }
     virtual void InitialGuess_Private() override;
-    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true) override;
+    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true, bool replica = false) override;
     virtual bool SupportThreads() const override { return false; }
 
     bool DefineModel() override;
@@ -117,7 +117,9 @@ private:
     int m_global_parametersize = 0;
     QStringList m_global_names, m_species_names, m_local_names;
     SpeciationEngine m_speciation; ///< reaction system + BFGS solver (host + guest totals)
+    std::vector<char> m_species_active; ///< per species: option Dilution + 1 + k is "yes"
 
 protected:
     virtual void CalculateVariables() override;
+    virtual void CompileOptions() override;
 };
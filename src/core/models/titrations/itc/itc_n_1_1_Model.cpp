@@ -80,7 +80,6 @@ void itc_n_ItoI_Model::CollectOptimizationParameters_Private()
 
 void itc_n_ItoI_Model::CalculateVariables()
 {
-    QString dil = getOption(Dilution);
 
     qreal dH = LocalTable()->data(0, 0);
     qreal dil_heat = LocalTable()->data(0, 1);
@@ -99,7 +98,7 @@ void itc_n_ItoI_Model::CalculateVariables()
         qreal guest_0 = InitialGuestConcentration(i);
         qreal dilution = 0;
         qreal v = IndependentModel()->data(i);
-        if (dil == "auto") {
+        if (m_auto_dilution) {
             dilution = (guest_0 * dil_heat + dil_inter);
         }
         qreal host = ItoI::HostConcentration(host_0, guest_0, GlobalParameter(0));
@@ -122,10 +121,10 @@ void itc_n_ItoI_Model::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> itc_n_ItoI_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> itc_n_ItoI_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<AbstractItcModel> model = QSharedPointer<itc_n_ItoI_Model>(new itc_n_ItoI_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     model.data()->setConcentrations(ConcentrationTable());
     return std::move(model);
 }
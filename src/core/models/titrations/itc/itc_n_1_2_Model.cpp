@@ -95,7 +95,6 @@ void itc_n_ItoII_Model::CollectOptimizationParameters_Private()
 
 void itc_n_ItoII_Model::CalculateVariables()
 {
-    QString dil = getOption(Dilution);
 
     qreal dH1 = LocalTable()->data(0, 0);
     qreal n1 = LocalTable()->data(0, 1);
@@ -126,7 +125,7 @@ void itc_n_ItoII_Model::CalculateVariables()
         qreal guest_0 = InitialGuestConcentration(i);
         qreal dilution = 0;
 
-        if (dil == "auto") {
+        if (m_auto_dilution) {
             dilution = (guest_0 * dil_heat + dil_inter);
         }
 
@@ -159,10 +158,10 @@ void itc_n_ItoII_Model::CalculateVariables()
     }
 }
 
-QSharedPointer<AbstractModel> itc_n_ItoII_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> itc_n_ItoII_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<AbstractItcModel> model = QSharedPointer<itc_n_ItoII_Model>(new itc_n_ItoII_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     model.data()->setConcentrations(ConcentrationTable());
     return std::move(model);
 }
@@ -66,7 +66,7 @@ void nmr_ItoI_ItoII_Model::DeclareOptions()
 
 void nmr_ItoI_ItoII_Model::EvaluateOptions()
 {
-    QString cooperativitiy = getOption(Cooperativity);
+    const int cooperativitiy = OptionValueIndex(Cooperativity);
     /*
      * Chem. Soc. Rev., 2017, 46, 2622--2637
      * K11 = 4*K12 | K12 = 0.25 K11
@@ -87,11 +87,11 @@ void nmr_ItoI_ItoII_Model::EvaluateOptions()
             this->LocalTable()->data(i, 2) = 2 * (this->LocalTable()->data(i, 1) - this->LocalTable()->data(i, 0)) + this->LocalTable()->data(i, 0);
     };
 
-    if (cooperativitiy == "noncooperative") {
+    if (cooperativitiy == CooperativityValue::NonCooperative) {
         global_coop();
-    } else if (cooperativitiy == "additive") {
+    } else if (cooperativitiy == CooperativityValue::Additive) {
         local_coop();
-    } else if (cooperativitiy == "statistical") {
+    } else if (cooperativitiy == CooperativityValue::Statistical) {
         local_coop();
         global_coop();
     }
@@ -140,6 +140,8 @@ void nmr_ItoI_ItoII_Model::CollectOptimizationParameters_Private()
 
 void nmr_ItoI_ItoII_Model::FillDesign()
 {
+    if (!SpeciationChanged())
+        return;
     if (m_design.rows() != DataPoints() || m_design.cols() != 3)
         m_design.resize(DataPoints(), 3);
     const qreal K11 = qPow(10, GlobalParameter(0));
@@ -209,10 +211,10 @@ QVector<qreal> nmr_ItoI_ItoII_Model::DeCompose(int datapoint, int series) const
     return vector;
 }
 
-QSharedPointer<AbstractModel> nmr_ItoI_ItoII_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> nmr_ItoI_ItoII_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<nmr_ItoI_ItoII_Model> model = QSharedPointer<nmr_ItoI_ItoII_Model>(new nmr_ItoI_ItoII_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
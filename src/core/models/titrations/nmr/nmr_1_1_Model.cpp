@@ -76,6 +76,8 @@ void nmr_ItoI_Model::CollectOptimizationParameters_Private()
 
 void nmr_ItoI_Model::FillDesign()
 {
+    if (!SpeciationChanged())
+        return;
     if (m_design.rows() != DataPoints() || m_design.cols() != 2)
         m_design.resize(DataPoints(), 2);
     for (int i = DataBegin(); i < DataEnd(); ++i) {
@@ -131,10 +133,10 @@ QVector<qreal> nmr_ItoI_Model::DeCompose(int datapoint, int series) const
     return vector;
 }
 
-QSharedPointer<AbstractModel> nmr_ItoI_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> nmr_ItoI_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<AbstractModel> model = QSharedPointer<nmr_ItoI_Model>(new nmr_ItoI_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
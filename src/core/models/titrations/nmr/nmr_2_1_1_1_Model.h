@@ -46,7 +46,7 @@ public:
     inline int GlobalParameterSize() const override { return 2; }
 
     virtual void InitialGuess_Private() override;
-    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true) override;
+    virtual QSharedPointer<AbstractModel> Clone(bool statistics = true, bool replica = false) override;
     virtual bool SupportThreads() const override { return false; }
 
     // VarPro applies only when all shifts are free and independent: default cooperativity ("full")
@@ -128,6 +128,8 @@ void nmr_any_Model::CollectOptimizationParameters_Private()
 
 void nmr_any_Model::CalculateConcentrations()
 {
+    if (!SpeciationChanged())
+        return;
     const int nComp = m_component_count;
     const int nSpecies = m_speciation.SpeciesCount();
     const ReactionSystem& sys = m_speciation.System();
@@ -145,13 +147,12 @@ void nmr_any_Model::CalculateConcentrations()
     m_concentrations = Eigen::MatrixXd(DataPoints(), nComp + nSpecies);
     m_molar_ratios = Eigen::MatrixXd(DataPoints(), 1 + nSpecies);
 
-    std::vector<double> totals(nComp);
+    std::vector<double> totals(nComp), freeConc(nComp);
     for (int i = DataBegin(); i < DataEnd(); ++i) {
         for (int c = 0; c < nComp; ++c)
             totals[c] = InitialConcentration(i, c);
 
-        m_speciation.solve(totals, i);
-        const std::vector<double>& freeConc = m_speciation.FreeConcentrations();
+        m_speciation.solve(totals, i, freeConc);
         const std::vector<double>& speciesConc = m_speciation.SpeciesConcentrations();
 
         const double obs_total = totals[m_observed];
@@ -235,12 +236,11 @@ bool nmr_any_Model::AnalyticVarProJacobian(const std::vector<int>& gidx, Eigen::
     // FULL (Golub–Pereyra) Jacobian of the projected residual - not the Kaufman (φ-fixed) one, which
     // leaves a rank-deficient Gauss–Newton Hessian and stalls the outer LM. Claude Generated.
     std::vector<Eigen::MatrixXd> dD(nG, Eigen::MatrixXd::Zero(nData, P));
-    std::vector<double> totals(nComp);
+    std::vector<double> totals(nComp), freeConc(nComp);
     for (int i = 0; i < nData; ++i) {
         for (int c = 0; c < nComp; ++c)
             totals[c] = InitialConcentration(i, c);
-        m_speciation.solve(totals, i);
-        const std::vector<double>& freeConc = m_speciation.FreeConcentrations();
+        m_speciation.solve(totals, i, freeConc);
         const std::vector<double>& speciesConc = m_speciation.SpeciesConcentrations();
         const Eigen::MatrixXd S = m_speciation.sensitivityMatrix(); // nComp × nSpecies
         const double obs_total = totals[m_observed];
@@ -318,10 +318,10 @@ void nmr_any_Model::CalculateVariables()
             SetValue(i, j, m(i, j));
 }
 
-QSharedPointer<AbstractModel> nmr_any_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> nmr_any_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<AbstractModel> model = QSharedPointer<nmr_any_Model>(new nmr_any_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
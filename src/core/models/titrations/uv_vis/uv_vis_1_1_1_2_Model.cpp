@@ -66,7 +66,7 @@ void uv_vis_ItoI_ItoII_Model::DeclareOptions()
 
 void uv_vis_ItoI_ItoII_Model::EvaluateOptions()
 {
-    QString cooperativitiy = getOption(Cooperativity);
+    const int cooperativitiy = OptionValueIndex(Cooperativity);
     /*
      * Chem. Soc. Rev., 2017, 46, 2622--2637
      * K11 = 4*K12 | K12 = 0.25 K11
@@ -87,11 +87,11 @@ void uv_vis_ItoI_ItoII_Model::EvaluateOptions()
             this->LocalTable()->data(i, 2) = 2 * (this->LocalTable()->data(i, 1) - this->LocalTable()->data(i, 0)) + this->LocalTable()->data(i, 0);
     };
 
-    if (cooperativitiy == "noncooperative") {
+    if (cooperativitiy == CooperativityValue::NonCooperative) {
         global_coop();
-    } else if (cooperativitiy == "additive") {
+    } else if (cooperativitiy == CooperativityValue::Additive) {
         local_coop();
-    } else if (cooperativitiy == "statistical") {
+    } else if (cooperativitiy == CooperativityValue::Statistical) {
         local_coop();
         global_coop();
     }
@@ -145,6 +145,8 @@ void uv_vis_ItoI_ItoII_Model::CollectOptimizationParameters_Private()
 
 void uv_vis_ItoI_ItoII_Model::FillDesign()
 {
+    if (!SpeciationChanged())
+        return;
     if (m_design.rows() != DataPoints() || m_design.cols() != 4)
         m_design.resize(DataPoints(), 4);
     const auto hostguest = getHostGuestPair();
@@ -212,10 +214,10 @@ QVector<qreal> uv_vis_ItoI_ItoII_Model::DeCompose(int datapoint, int series) con
     return vector;
 }
 
-QSharedPointer<AbstractModel> uv_vis_ItoI_ItoII_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> uv_vis_ItoI_ItoII_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<uv_vis_ItoI_ItoII_Model> model = QSharedPointer<uv_vis_ItoI_ItoII_Model>(new uv_vis_ItoI_ItoII_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
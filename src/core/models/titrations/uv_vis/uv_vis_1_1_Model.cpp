@@ -82,6 +82,8 @@ void uv_vis_ItoI_Model::CollectOptimizationParameters_Private()
 
 void uv_vis_ItoI_Model::FillDesign()
 {
+    if (!SpeciationChanged())
+        return;
     if (m_design.rows() != DataPoints() || m_design.cols() != 3)
         m_design.resize(DataPoints(), 3);
     const auto hostguest = getHostGuestPair();
@@ -144,10 +146,10 @@ QVector<qreal> uv_vis_ItoI_Model::DeCompose(int datapoint, int series) const
     return vector;
 }
 
-QSharedPointer<AbstractModel> uv_vis_ItoI_Model::Clone(bool statistics)
+QSharedPointer<AbstractModel> uv_vis_ItoI_Model::Clone(bool statistics, bool replica)
 {
     QSharedPointer<AbstractModel> model = QSharedPointer<uv_vis_ItoI_Model>(new uv_vis_ItoI_Model(this), &QObject::deleteLater);
-    finishClone(model, statistics);
+    finishClone(model, statistics, replica);
     return model;
 }
 
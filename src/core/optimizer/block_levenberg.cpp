@@ -0,0 +1,413 @@
+/*
+ * SupraFit - opt-in block-structured Levenberg-Marquardt fit solver
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Full-vector Levenberg-Marquardt that uses the structure of the Jacobian. The global parameters
+ * (stability constants, or the parameters a MetaModel shares between its models) may change every
+ * residual, but each local parameter only changes the residuals of its own block - its series, or its
+ * sub model in a MetaModel (AbstractModel::JacobianBlocks()). Therefore
+ *
+ *  - the locals of different blocks are finite-differenced together: the k-th local of every block is
+ *    stepped in the same model evaluation, so a Jacobian costs (globals + largest block) evaluations
+ *    instead of one per parameter,
+ *  - the Jacobian is kept as a dense global part and one small dense matrix per block,
+ *  - the damped normal equations are reduced to the globals with a Schur complement; each block is
+ *    solved on its own.
+ *
+ * Cost and memory per iteration grow linearly with the number of blocks. The block pattern the model
+ * reports is checked against a full finite-difference Jacobian in the first iteration; a model whose
+ * locals leak into other blocks is fitted with the same loop and all parameters treated as global.
+ * Step control and stop criteria are those of the VarPro solver. Selected via "FitSolver" =
+ * "BlockLevMar"; the classic solver stays the default. "BlockLevMarBroyden" additionally replaces most
+ * finite-difference Jacobians by Broyden updates that respect the block pattern.
+ */
+
+#include "src/global_config.h"
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QMap>
+#include <QtCore/QVector>
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "src/core/models/AbstractModel.h"
+
+#include "src/core/libmath.h"
+
+namespace {
+
+struct Block {
+    std::vector<int> rows, columns;
+    Eigen::MatrixXd jacobian; // rows x columns
+};
+
+struct Structure {
+    std::vector<int> globals;
+    std::vector<Block> blocks;
+    int widest = 0;
+
+    /* Every free parameter global, no blocks - the plain dense problem */
+    void MakeDense(const std::vector<int>& free)
+    {
+        globals = free;
+        blocks.clear();
+        widest = 0;
+    }
+};
+
+Structure BuildStructure(const std::vector<int>& free, const QVector<int>& parameter_block, const QVector<int>& residual_block, int points)
+{
+    Structure structure;
+    if (parameter_block.size() <= *std::max_element(free.begin(), free.end()) || residual_block.size() != points) {
+        structure.MakeDense(free);
+        return structure;
+    }
+
+    QMap<int, int> index;
+    for (int k : free) {
+        const int block = parameter_block[k];
+        if (block < 0) {
+            structure.globals.push_back(k);
+            continue;
+        }
+        if (!index.contains(block)) {
+            index.insert(block, int(structure.blocks.size()));
+            structure.blocks.push_back(Block());
+        }
+        structure.blocks[index[block]].columns.push_back(k);
+    }
+    for (int r = 0; r < points; ++r) {
+        auto it = index.constFind(residual_block[r]);
+        if (it != index.constEnd())
+            structure.blocks[it.value()].rows.push_back(r);
+    }
+    for (const Block& block : structure.blocks)
+        structure.widest = std::max(structure.widest, int(block.columns.size()));
+
+    if (structure.blocks.size() < 2)
+        structure.MakeDense(free);
+    return structure;
+}
+
+/* Broyden rank-one update from the accepted step s with residual change y, restricted to the
+ * pattern (Schubert): row i only moves in the columns it depends on, the globals and the locals of
+ * its block, J_i += (y_i - J_i s) s_i' / s_i's_i. Keeps the block structure intact. */
+bool BroydenUpdate(Structure& structure, Eigen::MatrixXd& Jg, const Eigen::VectorXd& step, const Eigen::VectorXd& change)
+{
+    const int g = int(structure.globals.size());
+    Eigen::VectorXd sg(g);
+    for (int i = 0; i < g; ++i)
+        sg(i) = step(structure.globals[i]);
+
+    Eigen::VectorXd error = change - Jg * sg;
+    Eigen::VectorXd norm = Eigen::VectorXd::Constant(change.size(), sg.squaredNorm());
+    std::vector<Eigen::VectorXd> sb(structure.blocks.size());
+    for (int b = 0; b < int(structure.blocks.size()); ++b) {
+        const Block& block = structure.blocks[b];
+        sb[b].resize(block.columns.size());
+        for (int c = 0; c < int(block.columns.size()); ++c)
+            sb[b](c) = step(block.columns[c]);
+        const Eigen::VectorXd predicted = block.jacobian * sb[b];
+        const double local = sb[b].squaredNorm();
+        for (int i = 0; i < int(block.rows.size()); ++i) {
+            error(block.rows[i]) -= predicted(i);
+            norm(block.rows[i]) += local;
+        }
+    }
+
+    bool updated = false;
+    for (int row = 0; row < int(change.size()); ++row) {
+        if (norm(row) > 0) {
+            error(row) /= norm(row);
+            updated = true;
+        } else
+            error(row) = 0;
+    }
+    if (g)
+        Jg.noalias() += error * sg.transpose();
+    for (int b = 0; b < int(structure.blocks.size()); ++b) {
+        Block& block = structure.blocks[b];
+        for (int i = 0; i < int(block.rows.size()); ++i)
+            block.jacobian.row(i) += error(block.rows[i]) * sb[b].transpose();
+    }
+    return updated;
+}
+
+inline double Step(double value)
+{
+    return 1e-6 * std::max(1.0, std::abs(value)); // forward-difference step, as in the VarPro solver
+}
+}
+
+int BlockLevMarFit(QWeakPointer<AbstractModel> weak, QVector<qreal>& param, QVector<double>& sse_history, QVector<QVector<double>>& parameter_history, const std::atomic<bool>* interrupt, const FitProgress& progress, int* blocks)
+{
+    if (blocks)
+        *blocks = 0;
+    QSharedPointer<AbstractModel> model = weak.toStrongRef();
+    if (!model)
+        return -1;
+
+    model->CalculateStatistics(false);
+    model->setFast(true);
+
+    const int n = param.size();
+    const QList<int> locked = model->LockedParameters();
+    std::vector<int> free;
+    for (int k = 0; k < n; ++k)
+        if (locked.size() != n || locked[k])
+            free.push_back(k);
+    if (free.empty())
+        return 0;
+
+    const QJsonObject config = model->getOptimizerConfig();
+    const int MaxIter = config["MaxLevMarInter"].toInt();
+    const double ErrorConvergence = config["ErrorConvergence"].toDouble();
+    const double DeltaParameter = config["DeltaParameter"].toDouble();
+    // "BlockLevMarBroyden" finite-differences the Jacobian only in the first step, after a stalled step
+    // and every BroydenRefresh steps; in between it is carried along by Broyden rank-one updates.
+    const bool useBroyden = config["FitSolver"].toString() == QLatin1String("BlockLevMarBroyden");
+    const int BroydenRefresh = std::max(1, config["BroydenRefresh"].toInt(5));
+
+    auto residualVector = [&](const Eigen::VectorXd& p) -> Eigen::VectorXd {
+        model->setParameter(QVector<qreal>(p.data(), p.data() + n));
+        model->Calculate();
+        const QList<double> err = model->getCalculatedAbsoluteErrors();
+        const QList<double> pen = model->getPenalty();
+        Eigen::VectorXd r(err.size());
+        for (int i = 0; i < err.size(); ++i)
+            r(i) = err[i] + (i < pen.size() ? pen[i] : 0.0);
+        return r;
+    };
+
+    Eigen::VectorXd p(n);
+    for (int k = 0; k < n; ++k)
+        p(k) = param[k];
+
+    Eigen::VectorXd r = residualVector(p);
+    double sse = r.squaredNorm();
+    const int m = int(r.size());
+    if (m == 0 || m < int(free.size()))
+        return -1;
+
+    QVector<int> parameter_block, residual_block;
+    Structure structure;
+    if (model->JacobianBlocks(parameter_block, residual_block))
+        structure = BuildStructure(free, parameter_block, residual_block, m);
+    else
+        structure.MakeDense(free);
+    bool verified = structure.blocks.empty();
+
+    Eigen::MatrixXd Jg;
+    auto differentiate = [&]() {
+        const int g = int(structure.globals.size());
+        Jg.resize(m, g);
+        for (int i = 0; i < g; ++i) {
+            Eigen::VectorXd pp = p;
+            const double h = Step(p(structure.globals[i]));
+            pp(structure.globals[i]) += h;
+            Jg.col(i) = (residualVector(pp) - r) / h;
+        }
+
+        if (!verified) {
+            /* First iteration: one column per local, checked for entries outside of its block */
+            std::vector<char> in_block(m);
+            for (Block& block : structure.blocks) {
+                std::fill(in_block.begin(), in_block.end(), 0);
+                for (int row : block.rows)
+                    in_block[row] = 1;
+                block.jacobian.resize(block.rows.size(), block.columns.size());
+                for (int c = 0; c < int(block.columns.size()); ++c) {
+                    Eigen::VectorXd pp = p;
+                    const double h = Step(p(block.columns[c]));
+                    pp(block.columns[c]) += h;
+                    const Eigen::VectorXd column = (residualVector(pp) - r) / h;
+                    double leak = 0;
+                    for (int row = 0; row < m; ++row)
+                        if (!in_block[row])
+                            leak += column(row) * column(row);
+                    if (std::sqrt(leak) > 1e-6 * column.norm()) {
+                        /* Not the structure the model claims: go on with the dense problem */
+                        structure.MakeDense(free);
+                        verified = true;
+                        Jg.resize(0, 0);
+                        return false;
+                    }
+                    for (int i = 0; i < int(block.rows.size()); ++i)
+                        block.jacobian(i, c) = column(block.rows[i]);
+                }
+            }
+            verified = true;
+            return true;
+        }
+
+        /* The c-th local of all blocks is stepped at once, the blocks do not see each other's steps */
+        for (Block& block : structure.blocks)
+            block.jacobian.resize(block.rows.size(), block.columns.size());
+        for (int c = 0; c < structure.widest; ++c) {
+            Eigen::VectorXd pp = p;
+            for (const Block& block : structure.blocks)
+                if (c < int(block.columns.size()))
+                    pp(block.columns[c]) += Step(p(block.columns[c]));
+            const Eigen::VectorXd shifted = residualVector(pp);
+            for (Block& block : structure.blocks) {
+                if (c >= int(block.columns.size()))
+                    continue;
+                const double h = pp(block.columns[c]) - p(block.columns[c]);
+                for (int i = 0; i < int(block.rows.size()); ++i)
+                    block.jacobian(i, c) = (shifted(block.rows[i]) - r(block.rows[i])) / h;
+            }
+        }
+        return true;
+    };
+
+    double lambda = 1e-3;
+    bool converged = false;
+    int iter = 0;
+    bool stale = true; // "BlockLevMarBroyden": the Jacobian has to be finite-differenced before the next step
+    int updates = 0;
+    for (; iter < MaxIter; ++iter) {
+        if (interrupt && interrupt->load(std::memory_order_relaxed))
+            break;
+        QVector<double> row(p.data(), p.data() + n);
+        parameter_history << row;
+        sse_history << sse;
+        if (progress)
+            progress(iter, sse);
+
+        Eigen::VectorXd trialP = p, trialR = r;
+        double trialSse = sse;
+        bool improved = false, fresh = false;
+        const double lambdaStart = lambda;
+        do {
+            lambda = lambdaStart;
+            fresh = !useBroyden || stale || updates >= BroydenRefresh;
+            if (fresh) {
+                if (!differentiate())
+                    differentiate();
+                stale = false;
+                updates = 0;
+            }
+
+            /* Normal equations: U = Jg'Jg, per block V = Jb'Jb and W = Jg(rows)'Jb */
+            const int g = int(structure.globals.size());
+            const Eigen::MatrixXd U = Jg.transpose() * Jg;
+            const Eigen::VectorXd gg = Jg.transpose() * r;
+            const Eigen::VectorXd scaleU = U.diagonal().cwiseMax(1e-12); // Marquardt diagonal scaling
+
+            const int B = int(structure.blocks.size());
+            std::vector<Eigen::MatrixXd> V(B), W(B);
+            std::vector<Eigen::VectorXd> gb(B), scaleV(B);
+            for (int b = 0; b < B; ++b) {
+                const Block& block = structure.blocks[b];
+                Eigen::MatrixXd Jgb(block.rows.size(), g);
+                Eigen::VectorXd rb(block.rows.size());
+                for (int i = 0; i < int(block.rows.size()); ++i) {
+                    Jgb.row(i) = Jg.row(block.rows[i]);
+                    rb(i) = r(block.rows[i]);
+                }
+                V[b] = block.jacobian.transpose() * block.jacobian;
+                W[b] = Jgb.transpose() * block.jacobian;
+                gb[b] = block.jacobian.transpose() * rb;
+                scaleV[b] = V[b].diagonal().cwiseMax(1e-12);
+            }
+
+            /* Damped step with lambda backtracking: grow lambda until the step reduces the SSE. */
+            for (int tries = 0; tries < 15; ++tries) {
+                /* Schur complement: S dg = rhs with S = U* - sum W V*^-1 W', then every block alone */
+                Eigen::MatrixXd S = U;
+                S.diagonal() += lambda * scaleU;
+                Eigen::VectorXd rhs = -gg;
+                std::vector<Eigen::LDLT<Eigen::MatrixXd>> Vdamped(B);
+                for (int b = 0; b < B; ++b) {
+                    Eigen::MatrixXd Vb = V[b];
+                    Vb.diagonal() += lambda * scaleV[b];
+                    Vdamped[b].compute(Vb);
+                    if (g) {
+                        S.noalias() -= W[b] * Vdamped[b].solve(W[b].transpose());
+                        rhs.noalias() += W[b] * Vdamped[b].solve(gb[b]);
+                    }
+                }
+                const Eigen::VectorXd dg = g ? Eigen::VectorXd(S.ldlt().solve(rhs)) : Eigen::VectorXd();
+
+                Eigen::VectorXd cand = p;
+                for (int i = 0; i < g; ++i)
+                    cand(structure.globals[i]) += dg(i);
+                for (int b = 0; b < B; ++b) {
+                    const Eigen::VectorXd db = Vdamped[b].solve(g ? Eigen::VectorXd(-gb[b] - W[b].transpose() * dg) : Eigen::VectorXd(-gb[b]));
+                    for (int c = 0; c < int(structure.blocks[b].columns.size()); ++c)
+                        cand(structure.blocks[b].columns[c]) += db(c);
+                }
+
+                const Eigen::VectorXd candR = residualVector(cand);
+                const double candSse = candR.squaredNorm();
+                if (std::isfinite(candSse) && candSse < sse) {
+                    trialP = cand;
+                    trialR = candR;
+                    trialSse = candSse;
+                    improved = true;
+                    lambda = std::max(lambda * 0.5, 1e-12);
+                    // An updated Jacobian that needed a larger damping has drifted, refresh it next time
+                    stale = stale || (!fresh && tries > 0);
+                    break;
+                }
+                lambda = std::min(lambda * 3.0, 1e12);
+            }
+            // No downhill step with an updated Jacobian says nothing about the minimum: retry fresh
+            stale = stale || !improved;
+        } while (!improved && !fresh);
+
+        if (!improved) {
+            // As in the VarPro solver: no downhill step left although lambda was escalated, i.e. the
+            // solver sits in a (local) minimum; only a non-finite SSE is a failure.
+            converged = std::isfinite(sse);
+            break;
+        }
+
+        const double sseChange = std::abs(sse - trialSse);
+        const double stepNorm = (trialP - p).cwiseAbs().sum();
+        if (useBroyden && BroydenUpdate(structure, Jg, trialP - p, trialR - r))
+            ++updates;
+        p = trialP;
+        r = trialR;
+        sse = trialSse;
+
+        if (sseChange <= ErrorConvergence && stepNorm <= DeltaParameter) {
+            converged = true;
+            ++iter;
+            break;
+        }
+    }
+
+    for (int k = 0; k < n; ++k)
+        param[k] = p(k);
+    if (blocks)
+        *blocks = int(structure.blocks.size());
+
+    // Leave the model at the final parameters with a full (statistics) calculate.
+    model->setParameter(param);
+    model->CalculateStatistics(true);
+    model->setFast(false);
+    model->Calculate();
+    model->setConverged(converged);
+    return iter;
+}
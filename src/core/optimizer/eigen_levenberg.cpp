@@ -84,7 +84,7 @@ struct MyFunctor : Functor<double> {
     QSharedPointer<AbstractModel> model;
 };
 
-int NonlinearFit(QWeakPointer<AbstractModel> model, QVector<qreal>& param, QVector<double>& sse, QVector<QVector<double>>& parameter_history)
+int NonlinearFit(QWeakPointer<AbstractModel> model, QVector<qreal>& param, QVector<double>& sse, QVector<QVector<double>>& parameter_history, const std::atomic<bool>* interrupt, const FitProgress& progress)
 {
 
 #ifndef extended_f_test
@@ -133,11 +133,15 @@ int NonlinearFit(QWeakPointer<AbstractModel> model, QVector<qreal>& param, QVect
     qreal norm = 1;
     QVector<qreal> globalConstants;
     for (; iter < MaxIter && ((qAbs(error_0 - error_2) > ErrorConvergence) || norm > DeltaParameter); ++iter) {
+        if (interrupt && interrupt->load(std::memory_order_relaxed))
+            break;
         globalConstants.clear();
         globalConstants = model.toStrongRef()->CollectOptimizationParameters();
         error_0 = model.toStrongRef()->SSE();
         sse << error_0;
         parameter_history << globalConstants;
+        if (progress)
+            progress(iter, error_0);
         // Re-apply the locked-parameter mask each iteration: CollectOptimizationParameters()
         // above rebuilds the parameter list and clears it, so it must be restored before the step.
         model.toStrongRef()->setLockedParameter(locked);
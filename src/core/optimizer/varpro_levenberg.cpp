@@ -56,7 +56,7 @@
 
 #include "src/core/libmath.h"
 
-int VarProFit(QWeakPointer<AbstractModel> weak, QVector<double>& sse_history, QVector<QVector<double>>& parameter_history)
+int VarProFit(QWeakPointer<AbstractModel> weak, QVector<double>& sse_history, QVector<QVector<double>>& parameter_history, const std::atomic<bool>* interrupt, const FitProgress& progress)
 {
     QSharedPointer<AbstractModel> model = weak.toStrongRef();
     if (!model)
@@ -78,6 +78,10 @@ int VarProFit(QWeakPointer<AbstractModel> weak, QVector<double>& sse_history, QV
     // "VarProAnalytic" replaces the finite-difference Jacobian with the model's analytic
     // implicit-function Jacobian (Approach B); falls back to FD per column if unavailable. CG.
     const bool useAnalytic = config["FitSolver"].toString() == QLatin1String("VarProAnalytic");
+    // "VarProBroyden" finite-differences the Jacobian only in the first step, after a stalled step and
+    // every BroydenRefresh steps; in between it is carried along by Broyden rank-one updates.
+    const bool useBroyden = config["FitSolver"].toString() == QLatin1String("VarProBroyden");
+    const int BroydenRefresh = std::max(1, config["BroydenRefresh"].toInt(5));
     const int MaxIter = config["MaxLevMarInter"].toInt();
     const double ErrorConvergence = config["ErrorConvergence"].toDouble();
     const double DeltaParameter = config["DeltaParameter"].toDouble();
@@ -108,7 +112,13 @@ int VarProFit(QWeakPointer<AbstractModel> weak, QVector<double>& sse_history, QV
     const double eps = 1e-6; // forward-difference step for the Jacobian
     bool converged = false;
     int iter = 0;
+    const int m = static_cast<int>(r.size());
+    Eigen::MatrixXd J(m, n);
+    bool stale = true; // "VarProBroyden": the Jacobian has to be finite-differenced before the next step
+    int updates = 0;
     for (; iter < MaxIter; ++iter) {
+        if (interrupt && interrupt->load(std::memory_order_relaxed))
+            break;
         // History (globals only) recorded at the start of the step, mirroring the classic solver.
         QVector<double> row;
         row.reserve(n);
@@ -116,52 +126,66 @@ int VarProFit(QWeakPointer<AbstractModel> weak, QVector<double>& sse_history, QV
             row << beta(i);
         parameter_history << row;
         sse_history << sse;
+        if (progress)
+            progress(iter, sse);
 
-        // Jacobian of the projected residual w.r.t. the globals (m × n): the model's analytic
-        // implicit-function Jacobian when requested and available, else a forward-difference column each.
-        const int m = static_cast<int>(r.size());
-        Eigen::MatrixXd J(m, n);
-        bool analytic = false;
-        if (useAnalytic) {
-            Eigen::MatrixXd Ja;
-            if (model->AnalyticVarProJacobian(gidx, Ja) && Ja.rows() == m && Ja.cols() == n) {
-                J = Ja;
-                analytic = true;
-            }
-        }
-        if (!analytic) {
-            for (int i = 0; i < n; ++i) {
-                Eigen::VectorXd bp = beta;
-                const double h = eps * std::max(1.0, std::abs(beta(i)));
-                bp(i) += h;
-                J.col(i) = (residualVector(bp) - r) / h;
-            }
-        }
-        const Eigen::MatrixXd JtJ = J.transpose() * J;
-        const Eigen::VectorXd Jtr = J.transpose() * r;
-        const Eigen::VectorXd scale = JtJ.diagonal().cwiseMax(1e-12); // Marquardt diagonal scaling
-
-        // Damped step with lambda backtracking: grow lambda until the step reduces the SSE.
         Eigen::VectorXd trialBeta = beta, trialR = r;
         double trialSse = sse;
-        bool improved = false;
-        for (int tries = 0; tries < 15; ++tries) {
-            Eigen::MatrixXd A = JtJ;
-            A.diagonal() += lambda * scale;
-            const Eigen::VectorXd delta = A.ldlt().solve(-Jtr);
-            const Eigen::VectorXd cand = beta + delta;
-            const Eigen::VectorXd candR = residualVector(cand);
-            const double candSse = candR.squaredNorm();
-            if (std::isfinite(candSse) && candSse < sse) {
-                trialBeta = cand;
-                trialR = candR;
-                trialSse = candSse;
-                improved = true;
-                lambda = std::max(lambda * 0.5, 1e-12);
-                break;
+        bool improved = false, fresh = false;
+        const double lambdaStart = lambda;
+        do {
+            lambda = lambdaStart;
+            // Jacobian of the projected residual w.r.t. the globals (m × n): the model's analytic
+            // implicit-function Jacobian when requested and available, else a forward-difference column
+            // each. With Broyden updates only when the updated one is stale or every BroydenRefresh steps.
+            fresh = !useBroyden || stale || updates >= BroydenRefresh;
+            if (fresh) {
+                bool analytic = false;
+                if (useAnalytic) {
+                    Eigen::MatrixXd Ja;
+                    if (model->AnalyticVarProJacobian(gidx, Ja) && Ja.rows() == m && Ja.cols() == n) {
+                        J = Ja;
+                        analytic = true;
+                    }
+                }
+                if (!analytic) {
+                    for (int i = 0; i < n; ++i) {
+                        Eigen::VectorXd bp = beta;
+                        const double h = eps * std::max(1.0, std::abs(beta(i)));
+                        bp(i) += h;
+                        J.col(i) = (residualVector(bp) - r) / h;
+                    }
+                }
+                stale = false;
+                updates = 0;
             }
-            lambda = std::min(lambda * 3.0, 1e12);
-        }
+            const Eigen::MatrixXd JtJ = J.transpose() * J;
+            const Eigen::VectorXd Jtr = J.transpose() * r;
+            const Eigen::VectorXd scale = JtJ.diagonal().cwiseMax(1e-12); // Marquardt diagonal scaling
+
+            // Damped step with lambda backtracking: grow lambda until the step reduces the SSE.
+            for (int tries = 0; tries < 15; ++tries) {
+                Eigen::MatrixXd A = JtJ;
+                A.diagonal() += lambda * scale;
+                const Eigen::VectorXd delta = A.ldlt().solve(-Jtr);
+                const Eigen::VectorXd cand = beta + delta;
+                const Eigen::VectorXd candR = residualVector(cand);
+                const double candSse = candR.squaredNorm();
+                if (std::isfinite(candSse) && candSse < sse) {
+                    trialBeta = cand;
+                    trialR = candR;
+                    trialSse = candSse;
+                    improved = true;
+                    lambda = std::max(lambda * 0.5, 1e-12);
+                    // An updated Jacobian that needed a larger damping has drifted, refresh it next time
+                    stale = stale || (!fresh && tries > 0);
+                    break;
+                }
+                lambda = std::min(lambda * 3.0, 1e12);
+            }
+            // No downhill step with an updated Jacobian says nothing about the minimum: retry fresh
+            stale = stale || !improved;
+        } while (!improved && !fresh);
 
         if (!improved) {
             // No step reduced the SSE although lambda was escalated to 1e12, i.e. the solver sits in
@@ -174,6 +198,15 @@ int VarProFit(QWeakPointer<AbstractModel> weak, QVector<double>& sse_history, QV
 
         const double sseChange = std::abs(sse - trialSse);
         const double stepNorm = (trialBeta - beta).cwiseAbs().sum();
+        if (useBroyden) {
+            // Broyden rank-one update from the accepted step: J += (dr - J s) s' / s's
+            const Eigen::VectorXd step = trialBeta - beta;
+            const double norm = step.squaredNorm();
+            if (norm > 0) {
+                J.noalias() += ((trialR - r) - J * step) * (step.transpose() / norm);
+                ++updates;
+            }
+        }
         beta = trialBeta;
         r = trialR;
         sse = trialSse;
@@ -8,12 +8,14 @@
 
 #include "projectmanager.h"
 
+#include "src/core/executioncontext.h"
 #include "src/core/filehandler.h"
 #include "src/core/jsonhandler.h"
 #include "src/core/models/dataclass.h"
 #include "src/core/models/models.h"  // Claude Generated - Required for CreateModel factory function
 #include "src/core/toolset.h"
 
+#include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
 #include <QtCore/QFileInfo>
@@ -21,6 +23,8 @@
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QMutexLocker>
 #include <QtCore/QStandardPaths>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 
 #ifdef DEBUG_ON
 #include "fmt/core.h"
@@ -69,63 +73,45 @@ ProjectManager::~ProjectManager()
 
 bool ProjectManager::loadProject(const QString& filePath)
 {
-    QMutexLocker locker(&m_projectsMutex);
-
-    if (filePath.isEmpty()) {
-        emit errorOccurred("loadProject", "Empty file path provided");
-        return false;
-    }
+    return !loadProjects(QStringList() << filePath).first().isEmpty();
+}
 
-    QFileInfo fileInfo(filePath);
-    if (!fileInfo.exists()) {
-        emit errorOccurred("loadProject", QString("File does not exist: %1").arg(filePath));
-        return false;
+QStringList ProjectManager::loadProjects(const QStringList& filePaths)
+{
+    QVector<QJsonObject> projectData(filePaths.size());
+    QVector<QString> errors(filePaths.size());
+
+    if (filePaths.size() == 1) {
+        errors[0] = readProjectFile(filePaths[0], projectData[0]);
+    } else if (filePaths.size() > 1) {
+        QThreadPool pool;
+        pool.setMaxThreadCount(qBound(1, ExecutionContext().Threads(), int(filePaths.size())));
+        for (int i = 0; i < filePaths.size(); ++i)
+            pool.start([this, &filePaths, &projectData, &errors, i]() { errors[i] = readProjectFile(filePaths[i], projectData[i]); });
+        pool.waitForDone();
     }
 
-#ifdef DEBUG_ON
-    SFDebugPrint("🔍 DEBUG ProjectManager::loadProject: Loading file: {}\n", filePath.toStdString());
-#endif
-
-    try {
-        // Use existing FileHandler infrastructure
-        FileHandler* handler = new FileHandler(filePath, this);
-        handler->LoadFile();
+    QMutexLocker locker(&m_projectsMutex);
 
-        QJsonObject projectData;
-        if (handler->Type() == FileHandler::SupraFit) {
-            // Load SupraFit project file
-            if (!JsonHandler::ReadJsonFile(projectData, filePath)) {
-                delete handler;
-                emit errorOccurred("loadProject", QString("Failed to read SupraFit file: %1").arg(filePath));
-                return false;
-            }
-        } else {
-            // Use handler data for other formats
-            projectData = handler->getJsonData();
+    QStringList projectIds;
+    for (int i = 0; i < filePaths.size(); ++i) {
+        const QString& filePath = filePaths[i];
+        if (!errors[i].isEmpty()) {
+            emit errorOccurred("loadProject", errors[i]);
+            projectIds << QString();
+            continue;
         }
 
-        delete handler;
-
-        // Validate and create project
-        if (!validateProjectJson(projectData)) {
-            emit errorOccurred("loadProject", QString("Invalid project structure in file: %1").arg(filePath));
-            return false;
-        }
+#ifdef DEBUG_ON
+        SFDebugPrint("🔍 DEBUG ProjectManager::loadProjects: Creating project from {} with keys {}\n",
+            filePath.toStdString(), projectData[i].keys().join(", ").toStdString());
+#endif
 
-        // Claude Generated - Debug JSON data structure passed to loadProjectFromJson
-        SFDebugPrint("🔍 DEBUG loadProject: Passing JSON with keys {} to loadProjectFromJson\n", 
-            [&projectData]() {
-                QStringList keys;
-                for (auto it = projectData.begin(); it != projectData.end(); ++it) {
-                    keys << it.key();
-                }
-                return keys.join(", ").toStdString();
-            }());
-        
-        QString projectId = loadProjectFromJson(projectData, filePath);
+        QString projectId = loadProjectFromJson(projectData[i], filePath);
         if (projectId.isEmpty()) {
             emit errorOccurred("loadProject", QString("Failed to create project from file: %1").arg(filePath));
-            return false;
+            projectIds << QString();
+            continue;
         }
 
         // Set as current project if none is active
@@ -133,21 +119,18 @@ bool ProjectManager::loadProject(const QString& filePath)
             m_currentProjectId = projectId;
         }
 
-        updateProjectHash();
-
         emit projectLoaded(projectId, filePath);
+        projectIds << projectId;
 
 #ifdef DEBUG_ON
-        SFDebugPrint("✅ DEBUG ProjectManager::loadProject: Successfully loaded project {} from {}\n",
+        SFDebugPrint("✅ DEBUG ProjectManager::loadProjects: Successfully loaded project {} from {}\n",
             projectId.toStdString(), filePath.toStdString());
 #endif
+    }
 
-        return true;
+    updateProjectHash();
 
-    } catch (const std::exception& e) {
-        emit errorOccurred("loadProject", QString("Exception during project loading: %1").arg(e.what()));
-        return false;
-    }
+    return projectIds;
 }
 
 bool ProjectManager::saveProject(const QString& filePath, const QString& projectId)
@@ -567,6 +550,22 @@ QVector<QJsonObject> ProjectManager::getAllProjectsAsJson() const
     return result;
 }
 
+QVector<QSharedPointer<DataClass>> ProjectManager::getAllProjectData() const
+{
+    QMutexLocker locker(&m_projectsMutex);
+
+    QVector<QSharedPointer<DataClass>> result;
+    result.reserve(m_projects.size());
+
+    for (const auto& project : m_projects) {
+        if (project) {
+            result.append(project);
+        }
+    }
+
+    return result;
+}
+
 // === GUI Compatibility Interface ===
 
 QVector<QWeakPointer<DataClass>> ProjectManager::getAllProjects() const
@@ -988,6 +987,41 @@ QJsonObject ProjectManager::saveProjectAsJson(QSharedPointer<DataClass> project)
 
 // === Current Project Management Implementation - Claude Generated ===
 
+QString ProjectManager::readProjectFile(const QString& filePath, QJsonObject& projectData) const
+{
+    if (filePath.isEmpty()) {
+        return "Empty file path provided";
+    }
+
+    QFileInfo fileInfo(filePath);
+    if (!fileInfo.exists()) {
+        return QString("File does not exist: %1").arg(filePath);
+    }
+
+    try {
+        const QString suffix = fileInfo.suffix().toLower();
+        if (suffix == "suprafit" || suffix == "json") {
+            // SupraFit project file - FileHandler would only parse the same json a second time
+            if (!JsonHandler::ReadJsonFile(projectData, filePath)) {
+                return QString("Failed to read SupraFit file: %1").arg(filePath);
+            }
+        } else {
+            // Use FileHandler for data tables and other formats
+            FileHandler handler(filePath);
+            handler.LoadFile();
+            projectData = handler.getJsonData();
+        }
+    } catch (const std::exception& e) {
+        return QString("Exception during project loading: %1").arg(e.what());
+    }
+
+    if (!validateProjectJson(projectData)) {
+        return QString("Invalid project structure in file: %1").arg(filePath);
+    }
+
+    return QString();
+}
+
 QJsonObject ProjectManager::getProjectDisplayInfo(const QString& projectId) const
 {
     QMutexLocker locker(&m_projectsMutex);
@@ -83,6 +83,16 @@ public:
      */
     bool loadProject(const QString& filePath);
 
+    /**
+     * @brief Load several project files at once
+     * @param filePaths Paths of the project files
+     * @return UUIDs of the loaded projects in the order of \a filePaths, empty for files that failed
+     *
+     * Reading, decompressing and parsing the files runs in parallel and without holding the project
+     * lock; only creating and registering the projects is serialised.
+     */
+    QStringList loadProjects(const QStringList& filePaths);
+
     /**
      * @brief Save project to file path
      * @param filePath Output file path
@@ -185,6 +195,15 @@ public:
      */
     QVector<QJsonObject> getAllProjectsAsJson() const;
 
+    /**
+     * @brief Get all projects as shared handles for CLI batch operations
+     * @return Vector of shared pointers to all managed projects
+     *
+     * Unlike getAllProjectsAsJson() nothing is serialised. Models created on a handle share its
+     * data and detach (copy-on-write) only when they override tables.
+     */
+    QVector<QSharedPointer<DataClass>> getAllProjectData() const;
+
     // === GUI Compatibility Interface ===
 
     /**
@@ -355,6 +374,14 @@ private:
      */
     QJsonObject saveProjectAsJson(QSharedPointer<DataClass> project) const;
 
+    /**
+     * @brief Read and validate a project file, touches no manager state
+     * @param filePath Path to project file
+     * @param projectData Receives the project JSON
+     * @return Empty string on success, the error message otherwise
+     */
+    QString readProjectFile(const QString& filePath, QJsonObject& projectData) const;
+
     /**
      * @brief Update project hash cache after modifications
      */
@@ -0,0 +1,137 @@
+/*
+ * SupraFit - counter-based random number streams for parallel resampling
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QtCore/QtGlobal>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/*! \brief Stream identifiers, so that jobs started with the same seed never share random numbers */
+namespace RandomJob {
+enum : quint32 {
+    MonteCarlo = 1,
+    MonteCarloIndependent = 2,
+    CrossValidation = 3,
+    ModelComparison = 4
+};
+}
+
+/*! \brief Philox4x32-10 block function (Salmon et al., SC'11 "Parallel random numbers: as easy as 1, 2, 3")
+ *
+ * Maps a 128 bit counter and a 64 bit key to 128 random bits without any state, so every sample of a
+ * resampling job can compute its random numbers where and when it is processed.
+ */
+namespace Philox {
+typedef std::array<quint32, 4> Counter;
+typedef std::array<quint32, 2> Key;
+
+inline Counter Block(Counter counter, Key key)
+{
+    constexpr quint64 M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+    constexpr quint32 W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+    for (int round = 0; round < 10; ++round) {
+        const quint64 p0 = M0 * counter[0];
+        const quint64 p1 = M1 * counter[2];
+        counter = { quint32(p1 >> 32) ^ counter[1] ^ key[0], quint32(p1),
+            quint32(p0 >> 32) ^ counter[3] ^ key[1], quint32(p0) };
+        key[0] += W0;
+        key[1] += W1;
+    }
+    return counter;
+}
+}
+
+/*! \brief Random numbers of one sample of one job, keyed by (seed, job, sample index)
+ *
+ * Two streams with the same key produce the same numbers, no matter which thread creates them or in
+ * which order the samples are processed; different keys give independent streams. The class models
+ * UniformRandomBitGenerator, but Uniform(), Normal() and Bounded() should be preferred over the
+ * std distributions: they are defined here and therefore give the same numbers with every standard
+ * library.
+ */
+class RandomStream {
+public:
+    typedef quint32 result_type;
+
+    RandomStream(quint64 seed, quint32 job, quint64 index)
+        : m_key{ { quint32(seed), quint32(seed >> 32) } }
+        , m_counter{ { 0, job, quint32(index), quint32(index >> 32) } }
+    {
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    inline result_type operator()()
+    {
+        if (m_position == 4) {
+            m_block = Philox::Block(m_counter, m_key);
+            ++m_counter[0];
+            m_position = 0;
+        }
+        return m_block[m_position++];
+    }
+
+    /*! \brief Uniform double in [0, 1) with 53 random bits */
+    inline double Uniform()
+    {
+        const quint64 high = operator()() >> 5, low = operator()() >> 6;
+        return double((high << 26) | low) * (1.0 / 9007199254740992.0);
+    }
+
+    /*! \brief Uniform integer in [0, bound), unbiased (Lemire's multiply and reject) */
+    inline quint32 Bounded(quint32 bound)
+    {
+        if (bound < 2)
+            return 0;
+        quint64 product = quint64(operator()()) * bound;
+        if (quint32(product) < bound) {
+            const quint32 threshold = (0u - bound) % bound;
+            while (quint32(product) < threshold)
+                product = quint64(operator()()) * bound;
+        }
+        return quint32(product >> 32);
+    }
+
+    /*! \brief Normally distributed number (Box-Muller, both values of a pair are used) */
+    inline double Normal(double mean = 0, double stddev = 1)
+    {
+        if (m_has_spare) {
+            m_has_spare = false;
+            return mean + stddev * m_spare;
+        }
+        const double radius = std::sqrt(-2.0 * std::log(1.0 - Uniform()));
+        const double angle = 2.0 * M_PI * Uniform();
+        m_spare = radius * std::sin(angle);
+        m_has_spare = true;
+        return mean + stddev * radius * std::cos(angle);
+    }
+
+private:
+    Philox::Key m_key;
+    Philox::Counter m_counter;
+    Philox::Counter m_block{ { 0, 0, 0, 0 } };
+    int m_position = 4;
+    double m_spare = 0;
+    bool m_has_spare = false;
+};
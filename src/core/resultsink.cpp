@@ -0,0 +1,85 @@
+/*
+ * Streaming sink for batch and ML pipeline results
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <QtCore/QDebug>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonParseError>
+#include <QtCore/QMutexLocker>
+
+#include "resultsink.h"
+
+ResultSink::ResultSink(const QString& file, bool append)
+    : m_file(file)
+{
+    QIODevice::OpenMode mode = QIODevice::WriteOnly | (append ? QIODevice::Append : QIODevice::Truncate);
+    if (!m_file.open(mode))
+        qWarning() << "ResultSink: Cannot open" << file << "for writing:" << m_file.errorString();
+}
+
+ResultSink::~ResultSink()
+{
+    if (m_file.isOpen())
+        m_file.close();
+}
+
+bool ResultSink::Append(const QJsonObject& record)
+{
+    QByteArray line = QJsonDocument(record).toJson(QJsonDocument::Compact);
+    line.append('\n');
+
+    QMutexLocker locker(&m_mutex);
+    if (!m_file.isOpen())
+        return false;
+
+    if (m_file.write(line) != line.size()) {
+        qWarning() << "ResultSink: Writing to" << m_file.fileName() << "failed:" << m_file.errorString();
+        return false;
+    }
+    m_file.flush();
+    ++m_records;
+    return true;
+}
+
+qint64 ResultSink::ForEach(const QString& file, const std::function<bool(const QJsonObject&)>& visitor)
+{
+    QFile input(file);
+    if (!input.open(QIODevice::ReadOnly)) {
+        qWarning() << "ResultSink: Cannot open" << file << "for reading:" << input.errorString();
+        return -1;
+    }
+
+    qint64 records = 0, line_number = 0;
+    while (!input.atEnd()) {
+        const QByteArray line = input.readLine().trimmed();
+        ++line_number;
+        if (line.isEmpty())
+            continue;
+
+        QJsonParseError error;
+        const QJsonDocument document = QJsonDocument::fromJson(line, &error);
+        if (error.error != QJsonParseError::NoError || !document.isObject()) {
+            qWarning() << "ResultSink: Skipping invalid record in" << file << "line" << line_number << error.errorString();
+            continue;
+        }
+        ++records;
+        if (!visitor(document.object()))
+            break;
+    }
+    return records;
+}
@@ -0,0 +1,76 @@
+/*
+ * Streaming sink for batch and ML pipeline results
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+#include <functional>
+
+/**
+ * @brief Append-only NDJSON writer for batch results
+ *
+ * Every finished record (dataset, model, training sample ...) is written as one compact JSON
+ * object per line and flushed right away, so a batch run never has to keep its results in
+ * memory and leaves a single file behind instead of one file per dataset. ForEach() reads such
+ * a file back record by record.
+ *
+ * Append() may be called from several threads.
+ */
+class ResultSink {
+public:
+    /**
+     * @brief Open \p file for writing, truncating it unless \p append is set
+     */
+    explicit ResultSink(const QString& file, bool append = false);
+    ~ResultSink();
+
+    inline bool isOpen() const { return m_file.isOpen(); }
+    inline QString FileName() const { return m_file.fileName(); }
+    inline qint64 Records() const { return m_records; }
+
+    /**
+     * @brief Write \p record as one line and flush it
+     * @return false if the sink is not open or the write failed
+     */
+    bool Append(const QJsonObject& record);
+
+    /**
+     * @brief Call \p visitor for every record in \p file, stop early if it returns false
+     *
+     * Only one line is held in memory at a time. Empty lines are skipped, lines that are no
+     * JSON object are reported and skipped.
+     *
+     * @return number of records passed to \p visitor, -1 if the file could not be opened
+     */
+    static qint64 ForEach(const QString& file, const std::function<bool(const QJsonObject&)>& visitor);
+
+    /**
+     * @brief True if \p file names a result stream (*.ndjson)
+     */
+    static inline bool isStream(const QString& file) { return file.endsWith(QLatin1String(".ndjson"), Qt::CaseInsensitive); }
+
+private:
+    QFile m_file;
+    QMutex m_mutex;
+    qint64 m_records = 0;
+};
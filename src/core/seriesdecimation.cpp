@@ -0,0 +1,171 @@
+/*
+ * SupraFit - level-of-detail reduction of dense chart series
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "seriesdecimation.h"
+
+namespace SeriesDecimation {
+
+namespace {
+QVector<QPointF> Copy(const QVector<QPointF>& points, int first, int last)
+{
+    QVector<QPointF> result;
+    result.reserve(last - first);
+    for (int i = first; i < last; ++i)
+        result << points[i];
+    return result;
+}
+
+inline int End(const QVector<QPointF>& points, int last)
+{
+    return (last < 0 || last > points.size()) ? points.size() : last;
+}
+}
+
+QVector<QPointF> MinMax(const QVector<QPointF>& points, int buckets, int first, int last)
+{
+    last = End(points, last);
+    first = std::max(0, first);
+    const int size = last - first;
+    buckets = std::max(1, buckets);
+    if (size <= 2 * buckets + 2)
+        return Copy(points, first, last);
+
+    QVector<QPointF> result;
+    result.reserve(2 * buckets + 2);
+    result << points[first];
+
+    const int inner = size - 2;
+    for (int bucket = 0; bucket < buckets; ++bucket) {
+        const int begin = first + 1 + int(qint64(bucket) * inner / buckets);
+        const int end = first + 1 + int(qint64(bucket + 1) * inner / buckets);
+        if (begin >= end)
+            continue;
+
+        int min = begin, max = begin;
+        for (int i = begin + 1; i < end; ++i) {
+            if (points[i].y() < points[min].y())
+                min = i;
+            else if (points[i].y() > points[max].y())
+                max = i;
+        }
+        result << points[std::min(min, max)];
+        if (min != max)
+            result << points[std::max(min, max)];
+    }
+
+    result << points[last - 1];
+    return result;
+}
+
+QVector<QPointF> LTTB(const QVector<QPointF>& points, int threshold, int first, int last)
+{
+    last = End(points, last);
+    first = std::max(0, first);
+    const int size = last - first;
+    if (threshold >= size || size <= 2)
+        return Copy(points, first, last);
+    if (threshold < 3)
+        return QVector<QPointF>{ points[first], points[last - 1] };
+
+    QVector<QPointF> result;
+    result.reserve(threshold);
+    result << points[first];
+
+    /* Buckets cover the interior; the point of each bucket is the one spanning the largest triangle
+     * with the previously selected point and the mean of the next bucket. */
+    const double every = double(size - 2) / double(threshold - 2);
+    int selected = first;
+    for (int bucket = 0; bucket < threshold - 2; ++bucket) {
+        const int begin = first + 1 + int(std::floor(bucket * every));
+        const int end = std::min(last - 1, first + 1 + int(std::floor((bucket + 1) * every)));
+
+        const int next_begin = end;
+        const int next_end = std::min(last, first + 1 + int(std::floor((bucket + 2) * every)));
+        double mean_x = 0, mean_y = 0;
+        for (int i = next_begin; i < next_end; ++i) {
+            mean_x += points[i].x();
+            mean_y += points[i].y();
+        }
+        const int count = next_end - next_begin;
+        if (count > 0) {
+            mean_x /= count;
+            mean_y /= count;
+        } else {
+            mean_x = points[last - 1].x();
+            mean_y = points[last - 1].y();
+        }
+
+        const double ax = points[selected].x(), ay = points[selected].y();
+        double largest = -1;
+        int candidate = begin;
+        for (int i = begin; i < end; ++i) {
+            const double area = std::abs((ax - mean_x) * (points[i].y() - ay) - (ax - points[i].x()) * (mean_y - ay));
+            if (area > largest) {
+                largest = area;
+                candidate = i;
+            }
+        }
+        result << points[candidate];
+        selected = candidate;
+    }
+
+    result << points[last - 1];
+    return result;
+}
+
+bool isSortedByX(const QVector<QPointF>& points)
+{
+    return std::is_sorted(points.cbegin(), points.cend(), [](const QPointF& a, const QPointF& b) {
+        return a.x() < b.x();
+    });
+}
+
+QVector<QPointF> LevelOfDetail(const QVector<QPointF>& points, double xmin, double xmax, int budget, bool smooth)
+{
+    const int size = points.size();
+    budget = std::max(4, budget);
+    if (size <= budget)
+        return points;
+
+    auto reduce = [&points, smooth](int buckets, int first, int last) {
+        return smooth ? LTTB(points, buckets, first, last) : MinMax(points, buckets / 2, first, last);
+    };
+
+    if (!(xmin < xmax) || !isSortedByX(points))
+        return reduce(budget, 0, size);
+
+    /* One point beyond each edge, so lines still run out of the plot area */
+    auto lower = std::lower_bound(points.cbegin(), points.cend(), xmin, [](const QPointF& p, double x) { return p.x() < x; });
+    auto upper = std::upper_bound(points.cbegin(), points.cend(), xmax, [](double x, const QPointF& p) { return x < p.x(); });
+    const int first = std::max(0, int(lower - points.cbegin()) - 1);
+    const int last = std::min(size, int(upper - points.cbegin()) + 1);
+
+    const int coarse = std::max(1, budget / 16);
+    QVector<QPointF> result;
+    if (first > 0)
+        result << MinMax(points, coarse, 0, first);
+    result << reduce(budget, first, last);
+    if (last < size)
+        result << MinMax(points, coarse, last, size);
+    return result;
+}
+}
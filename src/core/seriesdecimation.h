@@ -0,0 +1,53 @@
+/*
+ * SupraFit - level-of-detail reduction of dense chart series
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QtCore/QPointF>
+#include <QtCore/QVector>
+
+/**
+ * @brief Reduce full-resolution series to roughly as many points as the chart has pixels.
+ *
+ * The full data stays with the caller; these functions only pick which points are drawn. Both
+ * reductions keep the first and the last point, so the extent of a series (and with it the
+ * automatic axis scaling) is unchanged.
+ */
+namespace SeriesDecimation {
+
+/** @brief Min/max per bucket: every peak survives, suited to dense raw signals such as thermograms.
+ * Returns at most 2 * @p buckets points plus the end points, in the original order. */
+QVector<QPointF> MinMax(const QVector<QPointF>& points, int buckets, int first = 0, int last = -1);
+
+/** @brief Largest-Triangle-Three-Buckets: keeps the visual shape of smooth curves with
+ * exactly @p threshold points (if the input is longer). */
+QVector<QPointF> LTTB(const QVector<QPointF>& points, int threshold, int first = 0, int last = -1);
+
+/** @brief True if the x values never decrease, so a viewport can be found by bisection. */
+bool isSortedByX(const QVector<QPointF>& points);
+
+/**
+ * @brief Level-of-detail view of @p points for the x range [@p xmin, @p xmax].
+ *
+ * The visible range gets @p budget points (LTTB if @p smooth, MinMax otherwise), the parts outside
+ * of it only a coarse min/max envelope, so zooming out again never sees a truncated series.
+ * Unsorted data or an empty range fall back to reducing the whole series.
+ */
+QVector<QPointF> LevelOfDetail(const QVector<QPointF>& points, double xmin, double xmax, int budget, bool smooth);
+}
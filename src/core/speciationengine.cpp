@@ -17,12 +17,15 @@
  *
  */
 
+#include <cmath>
+#include <limits>
+
 #include "speciationengine.h"
 
 SpeciationEngine::SpeciationEngine()
 {
-    m_solver.setMaxIter(1000);
-    m_solver.setConvergeThreshold(1e-12);
+    setMaxIter(1000);
+    setConvergeThreshold(1e-12);
 }
 
 bool SpeciationEngine::setReactions(const QString& text)
@@ -36,6 +39,12 @@ void SpeciationEngine::setSystem(const ReactionSystem& system)
     m_system = system;
     // rows = components, cols = species; the solver treats the free components implicitly
     m_solver.setStoichiometry(m_system.stoich);
+    if (m_system.stoich.rows() == 2)
+        m_solver2.setStoichiometry(m_system.stoich);
+    else if (m_system.stoich.rows() == 3)
+        m_solver3.setStoichiometry(m_system.stoich);
+    m_last_fixed = 0;
+    m_last_totals.clear();
     m_point_cache.clear(); // component count may have changed -> old per-point warm starts are invalid
 }
 
@@ -60,17 +69,151 @@ double SpeciationEngine::GuessLgBeta(int j, double logcref) const
 
 void SpeciationEngine::setStabilityConstants(const std::vector<double>& beta)
 {
+    m_logbeta.resize(beta.size());
+    for (std::size_t j = 0; j < beta.size(); ++j)
+        m_logbeta[j] = beta[j] > 0.0 ? std::log(beta[j]) : std::numeric_limits<double>::quiet_NaN();
     m_solver.setStabilityConstants(beta);
+    m_solver2.setStabilityConstants(beta);
+    m_solver3.setStabilityConstants(beta);
 }
 
 void SpeciationEngine::setMaxIter(int maxiter)
 {
     m_solver.setMaxIter(maxiter);
+    m_solver2.setMaxIter(maxiter);
+    m_solver3.setMaxIter(maxiter);
 }
 
 void SpeciationEngine::setConvergeThreshold(double converge)
 {
     m_solver.setConvergeThreshold(converge);
+    m_solver2.setConvergeThreshold(converge);
+    m_solver3.setConvergeThreshold(converge);
+}
+
+bool SpeciationEngine::Converged() const
+{
+    if (m_last_fixed == 2)
+        return m_solver2.Converged();
+    if (m_last_fixed == 3)
+        return m_solver3.Converged();
+    return m_solver.Converged();
+}
+
+int SpeciationEngine::LastIterations() const
+{
+    if (m_last_fixed == 2)
+        return m_solver2.LastIterations();
+    if (m_last_fixed == 3)
+        return m_solver3.LastIterations();
+    return m_solver.LastIterations();
+}
+
+void SpeciationEngine::TotalsTangent(const std::vector<double>& dtotals, Eigen::VectorXd& dx) const
+{
+    if (m_last_fixed == 2)
+        m_solver2.totalsTangent(dtotals, dx);
+    else if (m_last_fixed == 3)
+        m_solver3.totalsTangent(dtotals, dx);
+    else
+        m_solver.totalsTangent(dtotals, dx);
+}
+
+Eigen::MatrixXd SpeciationEngine::sensitivityMatrix() const
+{
+    if (m_last_fixed == 2)
+        return m_solver2.sensitivityMatrix();
+    if (m_last_fixed == 3)
+        return m_solver3.sensitivityMatrix();
+    return m_solver.sensitivityMatrix();
+}
+
+void SpeciationEngine::sensitivityMatrix(Eigen::MatrixXd& S) const
+{
+    if (m_last_fixed == 2)
+        m_solver2.sensitivityMatrix(S);
+    else if (m_last_fixed == 3)
+        m_solver3.sensitivityMatrix(S);
+    else
+        m_solver.sensitivityMatrix(S);
+}
+
+int SpeciationEngine::FixedSizeFor(const std::vector<double>& totals) const
+{
+    // The fixed-size solvers implement the Newton method over the full component set only; BFGS and
+    // points with an absent component (reduced active set) stay on the dynamic solver.
+    if (!m_fixed_enabled || m_solver.method() != ConcentrationSolver::Method::LevenbergMarquardt)
+        return 0;
+    const int n = ComponentCount();
+    if (static_cast<int>(totals.size()) != n || !(n == 2 ? m_solver2.isReady() : n == 3 && m_solver3.isReady()))
+        return 0;
+    for (double total : totals)
+        if (!(total > 0.0))
+            return 0;
+    return n;
+}
+
+void SpeciationEngine::ApplyLogStep(const Eigen::VectorXd& dx)
+{
+    const double max_step = std::log(10.0);
+    const double largest = dx.cwiseAbs().maxCoeff();
+    if (!std::isfinite(largest) || largest == 0.0)
+        return;
+    const double scale = largest > max_step ? max_step / largest : 1.0;
+    for (std::size_t i = 0; i < m_start.size(); ++i)
+        if (m_start[i] > 0.0) // absent at that point: the solver seeds it itself
+            m_start[i] *= std::exp(scale * dx(i));
+}
+
+void SpeciationEngine::PredictFromParameters(const PointState& point)
+{
+    const int m = static_cast<int>(m_logbeta.size());
+    if (point.sensitivity.rows() != static_cast<int>(m_start.size()) || point.sensitivity.cols() != m
+        || static_cast<int>(point.logbeta.size()) != m)
+        return;
+
+    m_dlogbeta.resize(m);
+    for (int j = 0; j < m; ++j) {
+        const bool was = !std::isnan(point.logbeta[j]), is = !std::isnan(m_logbeta[j]);
+        if (was != is)
+            return; // a species was switched on or off: no longer a small perturbation
+        m_dlogbeta(j) = is ? m_logbeta[j] - point.logbeta[j] : 0.0;
+    }
+    m_step.resize(point.sensitivity.rows());
+    m_step.noalias() = point.sensitivity * m_dlogbeta;
+    ApplyLogStep(m_step);
+}
+
+bool SpeciationEngine::PredictAlongTotals(const std::vector<double>& totals)
+{
+    if (m_last_totals.size() != totals.size() || m_free.size() != totals.size() || !Converged())
+        return false;
+
+    m_dtotals.resize(totals.size());
+    for (std::size_t i = 0; i < totals.size(); ++i) {
+        if ((totals[i] > 0.0) != (m_last_totals[i] > 0.0))
+            return false; // the active set changes: the tangent of the previous point does not apply
+        m_dtotals[i] = totals[i] - m_last_totals[i];
+    }
+    m_start = m_free;
+    TotalsTangent(m_dtotals, m_step);
+    ApplyLogStep(m_step);
+    return true;
+}
+
+template <int N>
+void SpeciationEngine::solveFixed(FixedConcentrationSolver<N>& solver, const std::vector<double>& totals, bool seeded)
+{
+    solver.setTotalConcentrations(totals);
+    if (seeded)
+        solver.setWarmStart(m_start);
+    else if (m_last_fixed != N && m_free.size() == totals.size())
+        solver.setWarmStart(m_free); // the previous point was solved elsewhere: continue the sweep from it
+
+    const typename FixedConcentrationSolver<N>::Vector& free = solver.solve();
+    m_free.assign(free.data(), free.data() + N);
+    solver.SpeciesConcentrations(m_species_conc);
+    m_last_fixed = N;
 }
 
 std::vector<double> SpeciationEngine::solve(const std::vector<double>& totals)
@@ -79,34 +222,71 @@ std::vector<double> SpeciationEngine::solve(const std::vector<double>& totals)
 }
 
 std::vector<double> SpeciationEngine::solve(const std::vector<double>& totals, int pointIndex)
+{
+    std::vector<double> free;
+    solve(totals, pointIndex, free);
+    return free;
+}
+
+void SpeciationEngine::solve(const std::vector<double>& totals, int pointIndex, std::vector<double>& free)
 {
     // The per-point cache only helps the convergent Newton (LevenbergMarquardt) method, whose solution
     // is independent of the start (strictly convex): each point then seeds from its own previous
     // converged solution - a nearer start than the neighbouring swept point. The legacy BFGS method does
     // NOT fully converge, so caching a stalled point and reusing it just moves (and can slow) the stall;
     // it keeps the mild point-to-point warm start instead. Claude Generated.
-    const bool cache = pointIndex >= 0
-        && m_solver.method() == ConcentrationSolver::Method::LevenbergMarquardt;
+    const bool newton = m_solver.method() == ConcentrationSolver::Method::LevenbergMarquardt;
+    const bool cache = pointIndex >= 0 && newton;
+    const bool cached = cache && pointIndex < static_cast<int>(m_point_cache.size())
+        && m_point_cache[pointIndex].free.size() == totals.size();
 
-    m_solver.setTotalConcentrations(totals);
-    if (cache && pointIndex < static_cast<int>(m_point_cache.size())
-        && m_point_cache[pointIndex].size() == totals.size())
-        m_solver.setWarmStart(m_point_cache[pointIndex]);
+    // Predictor: the cached point moved along ln β, or the previous point moved along the totals.
+    bool seeded = false;
+    if (cached) {
+        m_start = m_point_cache[pointIndex].free;
+        if (m_continuation)
+            PredictFromParameters(m_point_cache[pointIndex]);
+        seeded = true;
+    } else if (m_continuation && newton)
+        seeded = PredictAlongTotals(totals);
 
-    m_free = m_solver.solve();
+    // Corrector: the Newton iteration of whichever solver takes this point.
+    const int fixed = FixedSizeFor(totals);
+    if (fixed == 2)
+        solveFixed(m_solver2, totals, seeded);
+    else if (fixed == 3)
+        solveFixed(m_solver3, totals, seeded);
+
+    if (!fixed) {
+        m_solver.setTotalConcentrations(totals);
+        if (seeded)
+            m_solver.setWarmStart(m_start);
+        else if (m_last_fixed && m_free.size() == totals.size())
+            m_solver.setWarmStart(m_free);
+
+        m_solver.solve(m_free);
+        m_last_fixed = 0;
+    }
+    m_last_totals = totals;
 
     if (cache) {
         if (static_cast<int>(m_point_cache.size()) <= pointIndex)
             m_point_cache.resize(pointIndex + 1);
-        m_point_cache[pointIndex] = m_free;
+        PointState& point = m_point_cache[pointIndex];
+        point.free = m_free;
+        if (m_continuation) {
+            // written into the point's own storage, which keeps its shape across outer iterations
+            sensitivityMatrix(point.sensitivity);
+            point.logbeta = m_logbeta;
+        }
     }
 
-    // AllConcentrations() returns the free components followed by the species (column order of M).
-    const std::vector<double> all = m_solver.AllConcentrations();
-    const int n = ComponentCount();
-    const int m = SpeciesCount();
-    m_species_conc.assign(m, 0.0);
-    for (int j = 0; j < m; ++j)
-        m_species_conc[j] = all[n + j];
-    return m_free;
+    if (!fixed) {
+        // the species in column order of M, as AllConcentrations() lists them after the components
+        const int m = SpeciesCount();
+        m_species_conc.resize(m);
+        for (int j = 0; j < m; ++j)
+            m_species_conc[j] = m_solver.speciesConcentration(j);
+    }
+    free.assign(m_free.cbegin(), m_free.cend());
 }
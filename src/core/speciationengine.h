@@ -25,6 +25,7 @@
 #include <QtCore/QStringList>
 
 #include "src/core/concentrationsolver.h"
+#include "src/core/fixedconcentrationsolver.h"
 #include "src/core/reactionparser.h"
 
 /**
@@ -35,6 +36,11 @@
  * component concentrations and derives every species concentration
  * @f$c_j = \beta_j \prod_k s_k^{M_{kj}}@f$. Titration and ITC models embed one and add only their
  * observable mapping on top. Claude Generated.
+ *
+ * Two- and three-component systems (host/guest, competitive) are solved by FixedConcentrationSolver<2>
+ * and <3> whenever every component is present and the Newton method is selected; all other points
+ * go to the dynamically sized ConcentrationSolver. The dispatch is per point and transparent: both
+ * converge to the same unique minimum, and the warm start is handed across when a sweep switches.
  */
 class SpeciationEngine {
 public:
@@ -76,6 +82,12 @@ public:
     void setMethod(ConcentrationSolver::Method method) { m_solver.setMethod(method); }
     ConcentrationSolver::Method method() const { return m_solver.method(); }
 
+    /** @brief Allow the fixed-size solvers for 2/3 components (default true); false forces the dynamic one. */
+    void setFixedSizeSolver(bool enabled) { m_fixed_enabled = enabled; }
+    bool FixedSizeSolver() const { return m_fixed_enabled; }
+    /** @brief True if the last solve() went through a fixed-size solver. */
+    bool LastSolveFixedSize() const { return m_last_fixed != 0; }
+
     /**
      * @brief Solve one data point given the total concentration of every component.
      * @param totals length must equal ComponentCount().
@@ -91,21 +103,74 @@ public:
      */
     std::vector<double> solve(const std::vector<double>& totals, int pointIndex);
 
+    /**
+     * @brief solve(totals, pointIndex) into caller storage @p free, which is only reallocated when its
+     *        size changes - the 2/3 component path then allocates nothing per point.
+     */
+    void solve(const std::vector<double>& totals, int pointIndex, std::vector<double>& free);
+
     /** @brief Drop the per-point warm-start cache (e.g. before a fresh, unrelated evaluation). CG. */
     void clearPointCache() { m_point_cache.clear(); }
 
+    /**
+     * @brief Predictor-corrector continuation for the Newton method (default on).
+     *
+     * A point with a cached solution is predicted from it plus its cached sensitivity times the change
+     * of ln β since then; a point without one (first evaluation) from the previous point plus the totals
+     * tangent H⁻¹Δt. The Newton iteration then only corrects the prediction. Both predictors are first
+     * order, so each step is capped at one decade per component to keep far jumps from overshooting.
+     */
+    void setContinuation(bool enabled) { m_continuation = enabled; }
+    bool Continuation() const { return m_continuation; }
+
     const std::vector<double>& FreeConcentrations() const { return m_free; }
     const std::vector<double>& SpeciesConcentrations() const { return m_species_conc; }
-    bool Converged() const { return m_solver.Converged(); }
+    bool Converged() const;
+    /** @brief Newton iterations of the last solved point. */
+    int LastIterations() const;
 
     /** @brief ∂x/∂ln(β) (components × species) of the LAST solved point, for the analytic outer-fit
      * Jacobian. Only exact for the LevenbergMarquardt method. Claude Generated. */
-    Eigen::MatrixXd sensitivityMatrix() const { return m_solver.sensitivityMatrix(); }
+    Eigen::MatrixXd sensitivityMatrix() const;
+    /** @brief sensitivityMatrix() into @p S, reallocated only when its shape changes. */
+    void sensitivityMatrix(Eigen::MatrixXd& S) const;
 
 private:
+    /** @brief Component count of the fixed-size solver that can take @p totals, 0 for the dynamic one. */
+    int FixedSizeFor(const std::vector<double>& totals) const;
+
+    /** @brief Converged state of one data point, kept across outer fit iterations. */
+    struct PointState {
+        std::vector<double> free; ///< free component concentrations
+        Eigen::MatrixXd sensitivity; ///< ∂x/∂ln β at that solution (continuation only)
+        std::vector<double> logbeta; ///< ln β the point was solved with (NaN for disabled species)
+    };
+
+    template <int N>
+    void solveFixed(FixedConcentrationSolver<N>& solver, const std::vector<double>& totals, bool seeded);
+
+    /** @brief m_start += S·Δln β of a cached point; leaves m_start as is if a species was toggled. */
+    void PredictFromParameters(const PointState& point);
+    /** @brief m_start = previous solution + H⁻¹Δt; false if there is no usable previous point. */
+    bool PredictAlongTotals(const std::vector<double>& totals);
+    /** @brief Apply a log-space step to m_start, capped at one decade per component. */
+    void ApplyLogStep(const Eigen::VectorXd& dx);
+    void TotalsTangent(const std::vector<double>& dtotals, Eigen::VectorXd& dx) const;
+
     ReactionSystem m_system;
     ConcentrationSolver m_solver;
+    FixedConcentrationSolver<2> m_solver2;
+    FixedConcentrationSolver<3> m_solver3;
+    bool m_fixed_enabled = true;
+    int m_last_fixed = 0; ///< component count of the fixed solver used for the last point, 0 = dynamic
     std::vector<double> m_free; ///< free component concentrations of the last solve
     std::vector<double> m_species_conc; ///< species concentrations of the last solve
-    std::vector<std::vector<double>> m_point_cache; ///< per-point free-conc warm starts (by data index)
+    std::vector<PointState> m_point_cache; ///< per-point warm starts (by data index)
+    std::vector<double> m_logbeta; ///< ln β of the current constants (NaN for disabled species)
+    std::vector<double> m_last_totals; ///< totals of the last solved point
+    std::vector<double> m_start; ///< predicted start of the point being solved
+    std::vector<double> m_dtotals; ///< predictor workspace: change of the totals to the previous point
+    Eigen::VectorXd m_dlogbeta; ///< predictor workspace: change of ln β since a point was cached
+    Eigen::VectorXd m_step; ///< predictor workspace: log-space step applied to m_start
+    bool m_continuation = true;
 };
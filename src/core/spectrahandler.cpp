@@ -104,6 +104,7 @@ void SpectraHandler::addDirectory(const QString& dir, const QString& suffix)
 
 DataTable* SpectraHandler::CompileSimpleTable()
 {
+    m_basis = SpectralBasis(); // picked wavelengths: no global spectral fit to reconstruct
     std::sort(
         m_x.begin(),
         m_x.end());
@@ -134,6 +135,39 @@ DataTable* SpectraHandler::CompileSimpleTable()
     return table;
 }
 
+DataTable* SpectraHandler::CompileCompressedTable(int components)
+{
+    const Eigen::MatrixXd matrix = PrepareMatrix();
+    QVector<int> columns;
+    QVector<double> x;
+    for (int i = 0; i < m_x_ranges.size() && i < matrix.cols(); ++i) {
+        if (m_x_ranges[i] > m_x_end || m_x_ranges[i] < m_x_start)
+            continue;
+        columns << i;
+        x << m_x_ranges[i];
+    }
+
+    // Same scaling as CompileSimpleTable, so fitted coefficients do not depend on the mode.
+    Eigen::MatrixXd spectra(matrix.rows(), columns.size());
+    for (int j = 0; j < columns.size(); ++j)
+        spectra.col(j) = matrix.col(columns[j]) / 1000.0;
+
+    m_basis = SpectralBasis::Compute(spectra, x, components);
+    if (!m_basis.isValid())
+        return new DataTable(0, 0, this);
+
+    const Eigen::MatrixXd& scores = m_basis.Scores();
+    DataTable* table = new DataTable(scores.rows(), scores.cols(), this);
+    QStringList header;
+    for (int j = 0; j < scores.cols(); ++j) {
+        header << QString("SV%1").arg(j + 1);
+        for (int i = 0; i < scores.rows(); ++i)
+            table->data(i, j) = scores(i, j);
+    }
+    table->setHeader(header);
+    return table;
+}
+
 void SpectraHandler::ParseData()
 {
     double min = -1e27, max = 1e27;
@@ -200,6 +234,7 @@ void SpectraHandler::clearFiles()
 {
     m_order.clear();
     m_spectra.clear();
+    m_basis = SpectralBasis();
 }
 
 void SpectraHandler::PCA()
@@ -248,6 +283,8 @@ QJsonObject SpectraHandler::getSpectraData() const
     spectradata["SupraFit"] = qint_version;
     spectradata["XStart"] = m_x_start;
     spectradata["XEnd"] = m_x_end;
+    if (m_basis.isValid())
+        spectradata["SpectralBasis"] = m_basis.toJson();
 
     return spectradata;
 }
@@ -277,6 +314,7 @@ void SpectraHandler::LoadData(const QJsonObject& data)
         addXValue(d);
 
     ParseData();
+    m_basis = SpectralBasis::fromJson(data["SpectralBasis"].toObject());
     m_x_start = data["XStart"].toDouble(m_x_start);
     m_x_end = data["XStart"].toDouble(m_x_end);
 }
@@ -29,6 +29,8 @@
 #include "libpeakpick/baseline.h"
 #include "libpeakpick/peakpick.h"
 
+#include "spectralbasis.h"
+
 class DataTable;
 
 struct Spectrum {
@@ -61,6 +63,12 @@ public:
     inline QVector<double> XValues() const { return m_x; }
     DataTable* CompileSimpleTable();
 
+    /*! \brief Global spectral mode: compress every wavelength in the selected range into the scores of
+     * a truncated SVD, one column per abstract spectrum (<= 0 picks the count automatically). The basis
+     * is kept and stored with getSpectraData(), so a fitted model can reconstruct full spectra. */
+    DataTable* CompileCompressedTable(int components);
+    inline const SpectralBasis& Basis() const { return m_basis; }
+
     void PCA();
     QVector<double> VarCovarSelect(int max_number, bool do_clustering = true, bool averaged = false);
 
@@ -84,6 +92,7 @@ private:
     QStringList m_order;
     QVector<double> m_x;
     DataTable* m_table;
+    SpectralBasis m_basis;
 
     Eigen::MatrixXd PrepareMatrix() const;
     Spectrum MakeSpectrum(const Vector& x, const Vector& y, const QString& filename = QString());
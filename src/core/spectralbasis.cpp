@@ -0,0 +1,152 @@
+/*
+ * SupraFit - SVD basis for global fitting of full multi-wavelength spectra
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <Eigen/SVD>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QStringList>
+
+#include "spectralbasis.h"
+
+namespace {
+/* Loadings are applied to every reconstructed spectrum, so they are stored at full precision
+ * rather than with ToolSet's 6-digit default. */
+QString Serialise(const double* data, int size)
+{
+    QStringList list;
+    list.reserve(size);
+    for (int i = 0; i < size; ++i)
+        list << QString::number(data[i], 'g', 17);
+    return list.join(" ");
+}
+
+QVector<double> Deserialise(const QString& string)
+{
+    QVector<double> values;
+    const QStringList list = string.split(' ', Qt::SkipEmptyParts);
+    values.reserve(list.size());
+    for (const QString& item : list)
+        values << item.toDouble();
+    return values;
+}
+}
+
+SpectralBasis SpectralBasis::Compute(const Eigen::MatrixXd& spectra, const QVector<double>& x, int components, double variance)
+{
+    SpectralBasis basis;
+    if (spectra.rows() == 0 || spectra.cols() == 0 || spectra.cols() != x.size())
+        return basis;
+
+    /* No centering: the Beer-Lambert model is linear without an offset, and a mean spectrum
+     * subtracted here would have to be modelled as well. */
+    const Eigen::BDCSVD<Eigen::MatrixXd> svd(spectra, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    basis.m_singular = svd.singularValues();
+    const int rank = static_cast<int>(basis.m_singular.size());
+
+    int k = components;
+    if (k <= 0) {
+        const double total = basis.m_singular.squaredNorm();
+        double kept = 0;
+        for (k = 0; k < rank && (total <= 0 || kept < variance * total); ++k)
+            kept += basis.m_singular(k) * basis.m_singular(k);
+        k = std::max(k, 1);
+    }
+    k = std::min(k, rank);
+
+    basis.m_x = x;
+    basis.m_loadings = svd.matrixV().leftCols(k);
+    basis.m_scores = svd.matrixU().leftCols(k) * basis.m_singular.head(k).asDiagonal();
+
+    // Fix the SVD's sign freedom (largest loading positive) so the same spectra give the same series.
+    for (int c = 0; c < k; ++c) {
+        Eigen::Index largest = 0;
+        basis.m_loadings.col(c).cwiseAbs().maxCoeff(&largest);
+        if (basis.m_loadings(largest, c) < 0) {
+            basis.m_loadings.col(c) *= -1;
+            basis.m_scores.col(c) *= -1;
+        }
+    }
+    return basis;
+}
+
+double SpectralBasis::ExplainedVariance() const
+{
+    const double total = m_singular.squaredNorm();
+    if (total <= 0)
+        return 1;
+    return m_singular.head(Components()).squaredNorm() / total;
+}
+
+double SpectralBasis::DiscardedSSE() const
+{
+    return m_singular.tail(m_singular.size() - Components()).squaredNorm();
+}
+
+Eigen::MatrixXd SpectralBasis::Reconstruct(const Eigen::MatrixXd& abstract) const
+{
+    if (abstract.cols() != Components())
+        return Eigen::MatrixXd();
+    return abstract * m_loadings.transpose();
+}
+
+QJsonObject SpectralBasis::toJson() const
+{
+    QJsonObject json;
+    if (!isValid())
+        return json;
+    json["x"] = Serialise(m_x.constData(), m_x.size());
+    json["singular"] = Serialise(m_singular.data(), static_cast<int>(m_singular.size()));
+    QJsonArray loadings;
+    for (int c = 0; c < Components(); ++c) {
+        const Eigen::VectorXd column = m_loadings.col(c);
+        loadings.append(Serialise(column.data(), static_cast<int>(column.size())));
+    }
+    json["loadings"] = loadings;
+    return json;
+}
+
+SpectralBasis SpectralBasis::fromJson(const QJsonObject& json)
+{
+    SpectralBasis basis;
+    const QJsonArray loadings = json["loadings"].toArray();
+    basis.m_x = Deserialise(json["x"].toString());
+    if (loadings.isEmpty() || basis.m_x.isEmpty())
+        return SpectralBasis();
+
+    /* The kept loadings are the leading columns of V, so there are at least as many singular values
+     * as loadings, and at most one per wavelength; anything else is a damaged or foreign basis. */
+    const QVector<double> singular = Deserialise(json["singular"].toString());
+    if (singular.size() < loadings.size() || singular.size() > basis.m_x.size())
+        return SpectralBasis();
+    for (double value : singular)
+        if (!std::isfinite(value) || value < 0)
+            return SpectralBasis();
+    basis.m_singular = Eigen::Map<const Eigen::VectorXd>(singular.constData(), singular.size());
+    basis.m_loadings = Eigen::MatrixXd(basis.m_x.size(), loadings.size());
+    for (int c = 0; c < loadings.size(); ++c) {
+        const QVector<double> column = Deserialise(loadings[c].toString());
+        if (column.size() != basis.m_x.size())
+            return SpectralBasis();
+        basis.m_loadings.col(c) = Eigen::Map<const Eigen::VectorXd>(column.constData(), column.size());
+    }
+    return basis;
+}
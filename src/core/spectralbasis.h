@@ -0,0 +1,78 @@
+/*
+ * SupraFit - SVD basis for global fitting of full multi-wavelength spectra
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <Eigen/Dense>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QVector>
+
+/**
+ * @brief Truncated SVD of a spectra matrix, used to fit all wavelengths at the cost of a few series.
+ *
+ * The titration spectra @f$Y@f$ (points × wavelengths) are factorised as @f$Y \approx U_k\Sigma_k V_k^T@f$.
+ * A Beer-Lambert model @f$Y = C(\beta)\,E@f$ with species spectra @f$E@f$ restricted to the row space
+ * of @f$V_k@f$ fits the scores @f$T = U_k\Sigma_k = Y V_k@f$ exactly as well as the full matrix:
+ * @f[ \lVert Y - C E' V_k^T \rVert^2 = \lVert T - C E' \rVert^2 + \sum_{i>k}\sigma_i^2 , @f]
+ * so the model is fitted to the k abstract spectra (one series each, linear parameters @f$E'@f$ solved
+ * by VarPro) and the full-resolution species spectra @f$E = E' V_k^T@f$ are reconstructed at the end.
+ * The basis travels with the project in the raw spectra data (SpectraHandler::getSpectraData()).
+ */
+class SpectralBasis {
+public:
+    SpectralBasis() = default;
+
+    /**
+     * @brief Factorise @p spectra (rows = titration points, columns = wavelengths at @p x).
+     * @param components number of abstract spectra to keep; <= 0 picks the smallest count that
+     *        explains @p variance of the total signal energy.
+     */
+    static SpectralBasis Compute(const Eigen::MatrixXd& spectra, const QVector<double>& x, int components, double variance = 0.9999);
+
+    inline bool isValid() const { return m_loadings.cols() > 0 && m_loadings.rows() == m_x.size(); }
+    inline int Components() const { return static_cast<int>(m_loadings.cols()); }
+    inline int Wavelengths() const { return static_cast<int>(m_loadings.rows()); }
+    inline const QVector<double>& X() const { return m_x; }
+    inline const Eigen::VectorXd& SingularValues() const { return m_singular; }
+
+    /** @brief Scores @f$U_k\Sigma_k@f$ (points × components): the data the model is fitted to. Only
+     * kept by Compute(); a basis restored from JSON has them in the project's dependent table instead. */
+    inline const Eigen::MatrixXd& Scores() const { return m_scores; }
+    /** @brief Loadings @f$V_k@f$ (wavelengths × components). */
+    inline const Eigen::MatrixXd& Loadings() const { return m_loadings; }
+
+    /** @brief Fraction of the signal energy @f$\sum_{i\le k}\sigma_i^2/\sum_i\sigma_i^2@f$ kept by the basis. */
+    double ExplainedVariance() const;
+    /** @brief Energy @f$\sum_{i>k}\sigma_i^2@f$ discarded by the truncation; add to a compressed SSE for the full one. */
+    double DiscardedSSE() const;
+
+    /** @brief Map abstract spectra (rows × components) back to full resolution (rows × wavelengths). */
+    Eigen::MatrixXd Reconstruct(const Eigen::MatrixXd& abstract) const;
+
+    QJsonObject toJson() const;
+    /** @brief Restore a basis from toJson(); an invalid basis if the stored sizes do not match. */
+    static SpectralBasis fromJson(const QJsonObject& json);
+
+private:
+    QVector<double> m_x;
+    Eigen::VectorXd m_singular; ///< all singular values, not only the kept ones
+    Eigen::MatrixXd m_scores;
+    Eigen::MatrixXd m_loadings;
+};
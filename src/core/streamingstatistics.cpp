@@ -0,0 +1,723 @@
+/*
+ * SupraFit - online (streaming) statistics for resampling methods
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "src/core/libmath.h"
+#include "src/core/models/AbstractModel.h"
+#include "src/core/toolset.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QSemaphore>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "streamingstatistics.h"
+
+void RunningMoments::add(double x)
+{
+    ++m_count;
+    if (m_count == 1) {
+        m_min = x;
+        m_max = x;
+    } else {
+        m_min = std::min(m_min, x);
+        m_max = std::max(m_max, x);
+    }
+    const double delta = x - m_mean;
+    m_mean += delta / double(m_count);
+    m_m2 += delta * (x - m_mean);
+}
+
+void RunningMoments::merge(const RunningMoments& other)
+{
+    if (other.m_count == 0)
+        return;
+    if (m_count == 0) {
+        *this = other;
+        return;
+    }
+    const double count = double(m_count + other.m_count);
+    const double delta = other.m_mean - m_mean;
+    m_mean += delta * double(other.m_count) / count;
+    m_m2 += other.m_m2 + delta * delta * double(m_count) * double(other.m_count) / count;
+    m_count += other.m_count;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
+
+double RunningMoments::Stddev() const
+{
+    return std::sqrt(Variance());
+}
+
+RunningCovariance::RunningCovariance(int dimension)
+    : m_mean(Eigen::VectorXd::Zero(dimension))
+    , m_comoment(Eigen::MatrixXd::Zero(dimension, dimension))
+{
+}
+
+void RunningCovariance::add(const Eigen::VectorXd& x)
+{
+    if (m_count == 0 && x.size() != m_mean.size()) {
+        m_mean = Eigen::VectorXd::Zero(x.size());
+        m_comoment = Eigen::MatrixXd::Zero(x.size(), x.size());
+    }
+    if (x.size() != m_mean.size())
+        return;
+
+    ++m_count;
+    const Eigen::VectorXd delta = x - m_mean;
+    m_mean += delta / double(m_count);
+    m_comoment.noalias() += delta * (x - m_mean).transpose();
+}
+
+void RunningCovariance::merge(const RunningCovariance& other)
+{
+    if (other.m_count == 0)
+        return;
+    if (m_count == 0) {
+        *this = other;
+        return;
+    }
+    if (other.m_mean.size() != m_mean.size())
+        return;
+
+    const double count = double(m_count + other.m_count);
+    const Eigen::VectorXd delta = other.m_mean - m_mean;
+    m_comoment += other.m_comoment + delta * delta.transpose() * (double(m_count) * double(other.m_count) / count);
+    m_mean += delta * (double(other.m_count) / count);
+    m_count += other.m_count;
+}
+
+Eigen::MatrixXd RunningCovariance::Covariance() const
+{
+    if (m_count < 2)
+        return Eigen::MatrixXd::Zero(m_mean.size(), m_mean.size());
+    return m_comoment / double(m_count - 1);
+}
+
+Eigen::MatrixXd RunningCovariance::Correlation() const
+{
+    const Eigen::MatrixXd covariance = Covariance();
+    Eigen::MatrixXd correlation = Eigen::MatrixXd::Zero(covariance.rows(), covariance.cols());
+    for (int i = 0; i < covariance.rows(); ++i) {
+        for (int j = 0; j < covariance.cols(); ++j) {
+            const double scale = std::sqrt(covariance(i, i) * covariance(j, j));
+            if (scale > 0)
+                correlation(i, j) = covariance(i, j) / scale;
+        }
+    }
+    return correlation;
+}
+
+QuantileDigest::QuantileDigest(double compression)
+    : m_compression(compression)
+{
+}
+
+void QuantileDigest::add(double x, double weight)
+{
+    if (m_total == 0) {
+        m_min = x;
+        m_max = x;
+    } else {
+        m_min = std::min(m_min, x);
+        m_max = std::max(m_max, x);
+    }
+    m_total += weight;
+    m_buffer.push_back({ x, weight });
+    if (m_buffer.size() > 5 * size_t(m_compression))
+        Compress();
+}
+
+void QuantileDigest::merge(const QuantileDigest& other)
+{
+    if (other.m_total == 0)
+        return;
+    if (m_total == 0) {
+        m_min = other.m_min;
+        m_max = other.m_max;
+    } else {
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+    m_total += other.m_total;
+    m_buffer.insert(m_buffer.end(), other.m_clusters.cbegin(), other.m_clusters.cend());
+    m_buffer.insert(m_buffer.end(), other.m_buffer.cbegin(), other.m_buffer.cend());
+    Compress();
+}
+
+int QuantileDigest::Clusters() const
+{
+    Compress();
+    return int(m_clusters.size());
+}
+
+void QuantileDigest::Compress() const
+{
+    if (m_buffer.empty())
+        return;
+
+    std::vector<Cluster> all;
+    all.reserve(m_clusters.size() + m_buffer.size());
+    all.insert(all.end(), m_clusters.cbegin(), m_clusters.cend());
+    all.insert(all.end(), m_buffer.cbegin(), m_buffer.cend());
+    m_buffer.clear();
+    std::sort(all.begin(), all.end(), [](const Cluster& a, const Cluster& b) { return a.mean < b.mean; });
+
+    double total = 0;
+    for (const Cluster& cluster : all)
+        total += cluster.weight;
+
+    /* A cluster may hold at most 4 n q (1 - q) / compression values: large in the centre,
+     * single values in the tails where the confidence limits are read */
+    m_clusters.clear();
+    m_clusters.push_back(all.front());
+    double before = 0;
+    for (size_t i = 1; i < all.size(); ++i) {
+        Cluster& last = m_clusters.back();
+        const double proposed = last.weight + all[i].weight;
+        const double q = (before + proposed / 2.0) / total;
+        const double limit = std::max(1.0, 4.0 * total * q * (1.0 - q) / m_compression);
+        if (proposed <= limit) {
+            last.mean += (all[i].mean - last.mean) * all[i].weight / proposed;
+            last.weight = proposed;
+        } else {
+            before += last.weight;
+            m_clusters.push_back(all[i]);
+        }
+    }
+}
+
+double QuantileDigest::Quantile(double q) const
+{
+    Compress();
+    if (m_clusters.empty())
+        return 0;
+    if (q <= 0)
+        return m_min;
+    if (q >= 1)
+        return m_max;
+
+    double total = 0;
+    for (const Cluster& cluster : m_clusters)
+        total += cluster.weight;
+    const double target = q * total;
+
+    /* Piecewise linear between the cluster centres, anchored at min (0) and max (total) */
+    double position = m_clusters.front().weight / 2.0;
+    if (target < position)
+        return m_min + (m_clusters.front().mean - m_min) * target / position;
+
+    for (size_t i = 0; i + 1 < m_clusters.size(); ++i) {
+        const double next = position + (m_clusters[i].weight + m_clusters[i + 1].weight) / 2.0;
+        if (target < next)
+            return m_clusters[i].mean + (m_clusters[i + 1].mean - m_clusters[i].mean) * (target - position) / (next - position);
+        position = next;
+    }
+
+    const double rest = total - position;
+    if (rest <= 0)
+        return m_max;
+    return m_clusters.back().mean + (m_max - m_clusters.back().mean) * (target - position) / rest;
+}
+
+double QuantileDigest::CDF(double x) const
+{
+    Compress();
+    if (m_clusters.empty() || x < m_min)
+        return 0;
+    if (x >= m_max)
+        return 1;
+
+    double total = 0;
+    for (const Cluster& cluster : m_clusters)
+        total += cluster.weight;
+
+    double position = m_clusters.front().weight / 2.0;
+    if (x < m_clusters.front().mean) {
+        const double span = m_clusters.front().mean - m_min;
+        return span > 0 ? position * (x - m_min) / span / total : 0;
+    }
+
+    for (size_t i = 0; i + 1 < m_clusters.size(); ++i) {
+        const double next = position + (m_clusters[i].weight + m_clusters[i + 1].weight) / 2.0;
+        if (x < m_clusters[i + 1].mean) {
+            const double span = m_clusters[i + 1].mean - m_clusters[i].mean;
+            return (position + (span > 0 ? (next - position) * (x - m_clusters[i].mean) / span : 0)) / total;
+        }
+        position = next;
+    }
+
+    const double span = m_max - m_clusters.back().mean;
+    return (position + (span > 0 ? (total - position) * (x - m_clusters.back().mean) / span : 0)) / total;
+}
+
+FixedHistogram::FixedHistogram(double min, double max, int bins)
+    : m_min(min)
+    , m_counts(std::max(1, bins), 0)
+{
+    m_width = (max - min) / double(m_counts.size());
+    if (!(m_width > 0))
+        m_width = 1;
+}
+
+void FixedHistogram::add(double x, double weight)
+{
+    if (m_counts.isEmpty())
+        return;
+    int bin = int(std::floor((x - m_min) / m_width));
+    /* The upper edge belongs to the last bin */
+    if (bin == m_counts.size() && x <= m_min + m_width * m_counts.size())
+        bin--;
+    if (bin < 0 || bin >= m_counts.size())
+        return;
+    m_counts[bin] += weight;
+}
+
+bool FixedHistogram::merge(const FixedHistogram& other)
+{
+    if (other.m_counts.size() != m_counts.size() || other.m_min != m_min || other.m_width != m_width)
+        return false;
+    for (int i = 0; i < m_counts.size(); ++i)
+        m_counts[i] += other.m_counts[i];
+    return true;
+}
+
+QVector<QPair<qreal, qreal>> FixedHistogram::Bins() const
+{
+    QVector<QPair<qreal, qreal>> bins;
+    bins.reserve(m_counts.size());
+    for (int i = 0; i < m_counts.size(); ++i)
+        bins << QPair<qreal, qreal>(m_min + m_width / 2.0 + i * m_width, m_counts[i]);
+    return bins;
+}
+
+FixedHistogram FixedHistogram::FromDigest(const QuantileDigest& digest, double min, double max, int bins)
+{
+    FixedHistogram histogram(min, max, bins);
+    const double total = digest.Count();
+    double lower = digest.CDF(histogram.m_min);
+    for (int i = 0; i < histogram.m_counts.size(); ++i) {
+        const double upper = i + 1 == histogram.m_counts.size() ? 1.0 : digest.CDF(histogram.m_min + (i + 1) * histogram.m_width);
+        histogram.m_counts[i] = total * (upper - lower);
+        lower = upper;
+    }
+    return histogram;
+}
+
+namespace SampleStatistics {
+
+/* Put the order statistics at \a positions into place, each nth_element only works on the range
+ * between its neighbours - linear in the size of the column for a handful of positions */
+static void Select(QVector<qreal>& column, QVector<int> positions)
+{
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+    auto select = [&column, &positions](auto&& self, int lo, int hi, int first, int last) -> void {
+        if (first >= last || lo >= hi)
+            return;
+        const int mid = (first + last) / 2;
+        const int k = positions[mid];
+        std::nth_element(column.begin() + lo, column.begin() + k, column.begin() + hi);
+        self(self, lo, k, first, mid);
+        self(self, k + 1, hi, mid + 1, last);
+    };
+    select(select, 0, column.size(), 0, positions.size());
+}
+
+ParameterStatistics FromSorted(const QList<qreal>& sorted, qreal error, int bins, int entropy_bins)
+{
+    ParameterStatistics statistics;
+    /* Both only index into the list if it is sorted already */
+    statistics.box = ToolSet::BoxWhiskerPlot(sorted);
+    statistics.confidence = ToolSet::Confidence(sorted, error);
+    const bool shared = entropy_bins == bins;
+    statistics.histogram = SortedHistogram(sorted, bins);
+    statistics.entropy_bins = shared ? bins : entropy_bins;
+    statistics.entropy = Entropy(shared ? statistics.histogram : SortedHistogram(sorted, statistics.entropy_bins));
+    return statistics;
+}
+
+QPair<qreal, qreal> Entropy(QVector<QPair<qreal, qreal>> histogram)
+{
+    if (histogram.isEmpty())
+        return QPair<qreal, qreal>(0, 0);
+    ToolSet::Normalise(histogram);
+    return ToolSet::Entropy(histogram);
+}
+
+QVector<QPair<qreal, qreal>> SortedHistogram(const QList<qreal>& sorted, int& bins)
+{
+    if (sorted.isEmpty())
+        return QVector<QPair<qreal, qreal>>() << QPair<qreal, qreal>(0, 0);
+
+    const qreal min = sorted.first();
+    const qreal max = sorted.last();
+    if (bins == 0) {
+        if (sorted.size() > 1e5)
+            bins = sorted.size() / 1e4;
+        else if (sorted.size() < 1e2)
+            bins = sorted.size() / 1e2;
+        else
+            bins = 10;
+    }
+
+    /* The bin of a value grows with the value, so the values of bin j end where the bin index of
+     * List2Histogram() first exceeds j; values in no bin (the maximum itself) are dropped as there */
+    const double h = (max - min) / bins;
+    auto bin = [min, h](qreal x) { return std::floor((x - min) / h); };
+
+    QVector<QPair<qreal, qreal>> histogram;
+    histogram.reserve(bins);
+    auto begin = std::partition_point(sorted.cbegin(), sorted.cend(), [&bin](qreal x) { return bin(x) < 0; });
+    for (int j = 0; j < bins; ++j) {
+        const auto end = std::partition_point(begin, sorted.cend(), [&bin, j](qreal x) { return bin(x) <= j; });
+        histogram << QPair<qreal, qreal>(min + h / 2. + j * h, qreal(end - begin));
+        begin = end;
+    }
+    return histogram;
+}
+
+BoxWhisker Box(QVector<qreal>& column)
+{
+    BoxWhisker bw;
+    const int count = column.size();
+    if (count == 0)
+        return bw;
+
+    /* The medians of BoxWhiskerPlot(): of all values, the lower and the upper half */
+    auto positions = [](int begin, int end) {
+        const int size = end - begin;
+        return size % 2 ? QVector<int>{ size / 2 + begin } : QVector<int>{ size / 2 - 1 + begin, size / 2 + begin };
+    };
+    auto median = [&column](const QVector<int>& at) {
+        return at.size() == 1 ? column[at[0]] : (column[at[1]] + column[at[0]]) / 2.0;
+    };
+    const QVector<int> middle = positions(0, count);
+    const QVector<int> lower = count > 1 ? positions(0, count / 2) : middle;
+    const QVector<int> upper = count > 1 ? positions(count / 2 + (count % 2), count) : middle;
+    Select(column, QVector<int>() << middle << lower << upper);
+
+    bw.median = median(middle);
+    bw.lower_quantile = median(lower);
+    bw.upper_quantile = median(upper);
+    bw.lower_whisker = bw.lower_quantile;
+    bw.upper_whisker = bw.upper_quantile;
+    bw.count = count;
+
+    const qreal iqd = bw.upper_quantile - bw.lower_quantile;
+    for (qreal x : qAsConst(column)) {
+        bw.mean += x;
+        if (x < bw.median - 3 * iqd || x > bw.median + 3 * iqd)
+            bw.extreme_outliers << x;
+        else if (x < bw.median - 1.5 * iqd || x > bw.median + 1.5 * iqd)
+            bw.mild_outliers << x;
+        else {
+            bw.lower_whisker = qMin(x, bw.lower_whisker);
+            bw.upper_whisker = qMax(x, bw.upper_whisker);
+        }
+    }
+    bw.mean /= double(count);
+    bw.stddev = Stddev(column);
+    /* Few values, listed in ascending order like from the sorted list */
+    std::sort(bw.extreme_outliers.begin(), bw.extreme_outliers.end());
+    std::sort(bw.mild_outliers.begin(), bw.mild_outliers.end());
+    return bw;
+}
+
+SupraFit::ConfidenceBar Confidence(QVector<qreal>& column, qreal error)
+{
+    SupraFit::ConfidenceBar result;
+    const int max = column.size();
+    if (max == 0)
+        return result;
+    error /= 2;
+
+    /* The positions ToolSet::Confidence() reads from the sorted list, each bound the mean of two */
+    int lower[2], upper[2];
+    if (qFuzzyCompare(error, 0)) {
+        lower[0] = lower[1] = 0;
+        upper[0] = upper[1] = max - 1;
+    } else if (qFuzzyCompare(error, 100)) {
+        const int pos = max / 2;
+        lower[0] = lower[1] = pos;
+        upper[0] = upper[1] = max % 2 == 1 ? pos + 1 : pos;
+    } else {
+        int pos_upper = round(max * (1 - error / 100));
+        int pos_lower = round(max * (error / 100));
+        if (pos_lower == 0)
+            pos_lower = 1;
+        if (pos_upper == 0)
+            pos_upper = 1;
+        lower[0] = pos_lower - 1;
+        upper[0] = pos_upper - 1;
+        lower[1] = max >= 1000 ? pos_lower : lower[0];
+        upper[1] = max >= 1000 ? pos_upper : upper[0];
+    }
+    for (int* at : { lower, lower + 1, upper, upper + 1 })
+        *at = qBound(0, *at, max - 1);
+
+    Select(column, { lower[0], lower[1], upper[0], upper[1] });
+    result.lower = lower[0] == lower[1] ? column[lower[0]] : (column[lower[0]] + column[lower[1]]) / 2.0;
+    result.upper = upper[0] == upper[1] ? column[upper[0]] : (column[upper[0]] + column[upper[1]]) / 2.0;
+    return result;
+}
+}
+
+SampleSummary::SampleSummary(bool keep_raw)
+    : m_keep_raw(keep_raw)
+{
+}
+
+void SampleSummary::add(double x)
+{
+    m_moments.add(x);
+    m_digest.add(x);
+    if (m_keep_raw)
+        m_raw << x;
+}
+
+void SampleSummary::merge(const SampleSummary& other)
+{
+    m_moments.merge(other.m_moments);
+    m_digest.merge(other.m_digest);
+    if (m_keep_raw)
+        m_raw << other.m_raw;
+}
+
+QList<qreal> SampleSummary::SortedRaw() const
+{
+    QList<qreal> sorted(m_raw.cbegin(), m_raw.cend());
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+}
+
+BoxWhisker SampleSummary::Box() const
+{
+    if (m_keep_raw) {
+        QVector<qreal> column = m_raw;
+        return SampleStatistics::Box(column);
+    }
+
+    BoxWhisker bw;
+    if (Count() == 0)
+        return bw;
+
+    bw.count = Count();
+    bw.mean = m_moments.Mean();
+    bw.stddev = m_moments.Stddev();
+    bw.median = m_digest.Quantile(0.5);
+    bw.lower_quantile = m_digest.Quantile(0.25);
+    bw.upper_quantile = m_digest.Quantile(0.75);
+
+    /* Whiskers end at the most extreme values inside the same fences BoxWhiskerPlot() uses; the
+     * outliers beyond them can only be listed with the raw values */
+    const qreal iqd = bw.upper_quantile - bw.lower_quantile;
+    const qreal lower_fence = bw.median - 1.5 * iqd;
+    const qreal upper_fence = bw.median + 1.5 * iqd;
+    const qreal lower = m_moments.Min() >= lower_fence ? m_moments.Min() : m_digest.Quantile(m_digest.CDF(lower_fence));
+    const qreal upper = m_moments.Max() <= upper_fence ? m_moments.Max() : m_digest.Quantile(m_digest.CDF(upper_fence));
+    bw.lower_whisker = std::min(bw.lower_quantile, lower);
+    bw.upper_whisker = std::max(bw.upper_quantile, upper);
+    return bw;
+}
+
+SupraFit::ConfidenceBar SampleSummary::Confidence(qreal error) const
+{
+    if (m_keep_raw) {
+        QVector<qreal> column = m_raw;
+        return SampleStatistics::Confidence(column, error);
+    }
+
+    SupraFit::ConfidenceBar bar;
+    if (Count() == 0)
+        return bar;
+    const qreal tail = error / 200.0;
+    bar.lower = m_digest.Quantile(tail);
+    bar.upper = m_digest.Quantile(1 - tail);
+    return bar;
+}
+
+QVector<QPair<qreal, qreal>> SampleSummary::Histogram(int& bins) const
+{
+    if (m_keep_raw)
+        return ToolSet::List2Histogram(m_raw, bins);
+
+    if (Count() == 0)
+        return QVector<QPair<qreal, qreal>>() << QPair<qreal, qreal>(0, 0);
+
+    if (bins == 0) {
+        const qint64 count = Count();
+        if (count > 1e5)
+            bins = count / 1e4;
+        else
+            bins = 10;
+    }
+    return FixedHistogram::FromDigest(m_digest, m_moments.Min(), m_moments.Max(), bins).Bins();
+}
+
+void ParameterAccumulator::setModel(const AbstractModel* model, bool keep_raw)
+{
+    m_slots.clear();
+    m_summaries.clear();
+
+    const QStringList global_names = model->GlobalTable()->header();
+    const int global = model->GlobalTable()->columnCount();
+    for (int i = 0; i < global; ++i)
+        m_slots << Slot{ global_names.value(i), QString::number(i), true, 0, i };
+
+    const QStringList local_names = model->LocalTable()->header();
+    const int series = model->LocalTable()->rowCount();
+    const int each_local = model->LocalTable()->columnCount();
+    for (int i = 0; i < series; ++i)
+        for (int j = 0; j < each_local; ++j)
+            m_slots << Slot{ local_names.value(j), QString::number(j) + "|" + QString::number(i), false, i, j };
+
+    m_summaries = QVector<SampleSummary>(m_slots.size(), SampleSummary(keep_raw));
+    m_global = RunningCovariance(global);
+}
+
+void ParameterAccumulator::add(const AbstractModel* model)
+{
+    const QList<int> active = model->ActiveSignals();
+    Eigen::VectorXd global(m_global.Dimension());
+
+    for (int i = 0; i < m_slots.size(); ++i) {
+        const Slot& slot = m_slots[i];
+        if (slot.global) {
+            global(slot.column) = model->GlobalTable()->data(0, slot.column);
+            m_summaries[i].add(global(slot.column));
+            continue;
+        }
+        /* Model2Parameter(): series missing from active_series count as active */
+        if (slot.row < active.size() && active[slot.row] == 0)
+            continue;
+        if (model->LocalTable()->isChecked(slot.row, slot.column))
+            m_summaries[i].add(model->LocalTable()->data(slot.row, slot.column));
+    }
+    m_global.add(global);
+}
+
+void ParameterAccumulator::merge(const ParameterAccumulator& other)
+{
+    if (other.m_summaries.size() != m_summaries.size())
+        return;
+    for (int i = 0; i < m_summaries.size(); ++i)
+        m_summaries[i].merge(other.m_summaries[i]);
+    m_global.merge(other.m_global);
+}
+
+QVector<int> ParameterAccumulator::Reported() const
+{
+    QVector<int> reported;
+    for (int i = 0; i < m_summaries.size(); ++i)
+        if (m_summaries[i].Count())
+            reported << i;
+    return reported;
+}
+
+QVector<ParameterStatistics> ParameterAccumulator::Evaluate(qreal error, int bins, int entropy_bins, const ExecutionContext& context) const
+{
+    const QVector<int> reported = Reported();
+    QVector<ParameterStatistics> statistics(reported.size());
+    ParameterStatistics* result = statistics.data();
+
+    auto evaluate = [&](int i) {
+        const SampleSummary& summary = m_summaries[reported[i]];
+        if (summary.hasRaw()) {
+            result[i] = SampleStatistics::FromSorted(summary.SortedRaw(), error, bins, entropy_bins);
+        } else {
+            int parameter_bins = bins;
+            result[i].box = summary.Box();
+            result[i].confidence = summary.Confidence(error);
+            result[i].histogram = summary.Histogram(parameter_bins);
+            result[i].entropy_bins = entropy_bins == bins ? parameter_bins : entropy_bins;
+            if (entropy_bins == bins)
+                result[i].entropy = SampleStatistics::Entropy(result[i].histogram);
+            else
+                result[i].entropy = SampleStatistics::Entropy(summary.Histogram(result[i].entropy_bins));
+        }
+    };
+
+    /* The parameters are independent; this thread takes them one by one together with as many
+     * helpers as the pool has room for, so it never waits for a helper that can not start */
+    std::atomic<int> next = 0;
+    auto work = [&]() {
+        for (int i = next++; i < statistics.size(); i = next++)
+            evaluate(i);
+    };
+    QSemaphore finished;
+    int helpers = 0;
+    for (int i = 1; i < qMin(context.Threads(), int(statistics.size())); ++i) {
+        if (!context.Executor()->tryStart([&work, &finished]() {
+                work();
+                finished.release();
+            }))
+            break;
+        ++helpers;
+    }
+    work();
+    finished.acquire(helpers);
+    return statistics;
+}
+
+QList<QJsonObject> ParameterAccumulator::Parameter(const AbstractModel* model) const
+{
+    QVector<ParameterStatistics> statistics;
+    for (int i : Reported()) {
+        ParameterStatistics parameter;
+        parameter.box = m_summaries[i].Box();
+        statistics << parameter;
+    }
+    return Parameter(model, statistics);
+}
+
+QList<QJsonObject> ParameterAccumulator::Parameter(const AbstractModel* model, const QVector<ParameterStatistics>& statistics) const
+{
+    QList<QJsonObject> parameter;
+    const QVector<int> reported = Reported();
+    for (int k = 0; k < reported.size() && k < statistics.size(); ++k) {
+        const Slot& slot = m_slots[reported[k]];
+        const SampleSummary& summary = m_summaries[reported[k]];
+
+        QJsonObject object;
+        QJsonObject data;
+        if (summary.hasRaw())
+            data["raw"] = ToolSet::DoubleList2String(summary.SortedRaw());
+        object["data"] = data;
+        object["name"] = slot.name;
+        object["type"] = slot.global ? "Global Parameter" : "Local Parameter";
+        object["index"] = slot.index;
+        object["value"] = slot.global ? model->GlobalParameter(slot.column) : model->LocalParameter(slot.column, slot.row);
+        object["boxplot"] = ToolSet::Box2Object(statistics[k].box);
+        if (statistics[k].entropy_bins > 0) {
+            QJsonObject entropy;
+            entropy["bins"] = statistics[k].entropy_bins;
+            entropy["value"] = statistics[k].entropy.first;
+            entropy["offset"] = statistics[k].entropy.second;
+            entropy["FullShannon"] = qApp->instance()->property("FullShannon").toBool();
+            object["entropy"] = entropy;
+        }
+        parameter << object;
+    }
+    return parameter;
+}
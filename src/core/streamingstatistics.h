@@ -0,0 +1,247 @@
+/*
+ * SupraFit - online (streaming) statistics for resampling methods
+ * Copyright (C) 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <boxwhisker.h>
+
+#include "src/core/executioncontext.h"
+#include "src/global.h"
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include <Eigen/Dense>
+
+#include <vector>
+
+class AbstractModel;
+
+/*! \brief Count, mean and variance (Welford) plus range of a stream of values.
+ *
+ * merge() combines accumulators of disjoint streams exactly (Chan et al.), so every worker
+ * thread can keep its own and they are summed up at the end.
+ */
+class RunningMoments {
+public:
+    void add(double x);
+    void merge(const RunningMoments& other);
+
+    inline qint64 Count() const { return m_count; }
+    inline double Mean() const { return m_mean; }
+    /*! \brief Sample variance (n - 1), the same as Stddev() from libmath squared */
+    inline double Variance() const { return m_count > 1 ? m_m2 / double(m_count - 1) : 0; }
+    double Stddev() const;
+    inline double Min() const { return m_min; }
+    inline double Max() const { return m_max; }
+
+private:
+    qint64 m_count = 0;
+    double m_mean = 0, m_m2 = 0;
+    double m_min = 0, m_max = 0;
+};
+
+/*! \brief Mean vector and covariance matrix of a stream of parameter vectors, mergeable */
+class RunningCovariance {
+public:
+    explicit RunningCovariance(int dimension = 0);
+
+    void add(const Eigen::VectorXd& x);
+    void merge(const RunningCovariance& other);
+
+    inline qint64 Count() const { return m_count; }
+    inline int Dimension() const { return int(m_mean.size()); }
+    inline const Eigen::VectorXd& Mean() const { return m_mean; }
+    Eigen::MatrixXd Covariance() const;
+    Eigen::MatrixXd Correlation() const;
+
+private:
+    qint64 m_count = 0;
+    Eigen::VectorXd m_mean;
+    Eigen::MatrixXd m_comoment;
+};
+
+/*! \brief Mergeable quantile sketch (merging t-digest, Dunning 2019).
+ *
+ * Values are collected in clusters whose size shrinks towards the tails, so the quantiles used for
+ * confidence intervals stay accurate with a memory of O(compression). Up to roughly
+ * compression / 4 values every value is its own cluster and the quantiles are exact.
+ */
+class QuantileDigest {
+public:
+    explicit QuantileDigest(double compression = 200);
+
+    void add(double x, double weight = 1);
+    void merge(const QuantileDigest& other);
+
+    /*! \brief Fold the buffered values into the clusters
+     *
+     * Quantile(), CDF() and Clusters() call it themselves, so these const accessors modify the
+     * digest and must not run concurrently on the same digest - unless Compress() was called after
+     * the last add() or merge(), which leaves nothing for them to fold.
+     */
+    void Compress() const;
+
+    double Quantile(double q) const;
+    double CDF(double x) const;
+    inline double Count() const { return m_total; }
+    inline double Min() const { return m_min; }
+    inline double Max() const { return m_max; }
+    int Clusters() const;
+
+private:
+    struct Cluster {
+        double mean, weight;
+    };
+
+    double m_compression;
+    double m_min = 0, m_max = 0;
+    double m_total = 0; ///< weight of all values, buffered or clustered
+    mutable std::vector<Cluster> m_clusters, m_buffer;
+};
+
+/*! \brief Histogram with fixed bins over [min, max]; mergeable if the binning agrees.
+ * Bins() has the layout of ToolSet::List2Histogram (bin centre, count).
+ */
+class FixedHistogram {
+public:
+    FixedHistogram() = default;
+    FixedHistogram(double min, double max, int bins);
+
+    void add(double x, double weight = 1);
+    bool merge(const FixedHistogram& other);
+
+    inline int Size() const { return m_counts.size(); }
+    QVector<QPair<qreal, qreal>> Bins() const;
+
+    /*! \brief Histogram estimated from the distribution held in a digest */
+    static FixedHistogram FromDigest(const QuantileDigest& digest, double min, double max, int bins);
+
+private:
+    double m_min = 0, m_width = 1;
+    QVector<qreal> m_counts;
+};
+
+/*! \brief Everything the resampling methods report about one parameter.
+ *
+ * Moments and the digest are always kept. The raw values are an opt-in (keep_raw); with them the
+ * box plot, confidence interval and histogram are computed exactly as from a full list, without
+ * them they are estimated from the digest in constant memory.
+ */
+class SampleSummary {
+public:
+    explicit SampleSummary(bool keep_raw = false);
+
+    void add(double x);
+    void merge(const SampleSummary& other);
+
+    inline qint64 Count() const { return m_moments.Count(); }
+    inline bool hasRaw() const { return m_keep_raw; }
+    inline const RunningMoments& Moments() const { return m_moments; }
+    inline const QuantileDigest& Digest() const { return m_digest; }
+    QList<qreal> SortedRaw() const;
+
+    BoxWhisker Box() const;
+    SupraFit::ConfidenceBar Confidence(qreal error) const;
+    /*! \brief Same bin rule as ToolSet::List2Histogram(): 0 \a bins picks a count from the sample size */
+    QVector<QPair<qreal, qreal>> Histogram(int& bins) const;
+
+private:
+    bool m_keep_raw;
+    RunningMoments m_moments;
+    QuantileDigest m_digest;
+    QVector<qreal> m_raw;
+};
+
+/*! \brief Box plot, confidence interval and histogram of one parameter */
+struct ParameterStatistics {
+    BoxWhisker box;
+    SupraFit::ConfidenceBar confidence;
+    QVector<QPair<qreal, qreal>> histogram;
+    /* H(X) as ToolSet::Entropy() gives it, from a histogram of entropy_bins bins */
+    QPair<qreal, qreal> entropy = QPair<qreal, qreal>(0, 0);
+    int entropy_bins = 0;
+};
+
+/*! \brief Order statistics of a sample without the copies and repeated sorts of the ToolSet functions
+ *
+ * FromSorted() reads everything from one sorted column: the results are those of
+ * ToolSet::BoxWhiskerPlot(), Confidence(), List2Histogram() and Entropy() on it, the histograms
+ * are counted by bisecting the bin edges instead of binning every value. Box() and Confidence() only place the few
+ * order statistics they need by selection (nth_element), in linear time; the column is reordered.
+ */
+namespace SampleStatistics {
+ParameterStatistics FromSorted(const QList<qreal>& sorted, qreal error, int bins, int entropy_bins);
+
+/*! \brief ToolSet::Entropy() of the normalised \a histogram, (0, 0) if it has no bins */
+QPair<qreal, qreal> Entropy(QVector<QPair<qreal, qreal>> histogram);
+
+/*! \brief Histogram of an ascending column, List2Histogram() with the same bins and edges */
+QVector<QPair<qreal, qreal>> SortedHistogram(const QList<qreal>& sorted, int& bins);
+
+BoxWhisker Box(QVector<qreal>& column);
+SupraFit::ConfidenceBar Confidence(QVector<qreal>& column, qreal error);
+}
+
+/*! \brief Per-parameter summaries of many refits of one model.
+ *
+ * Replaces collecting every refit as model json and converting the list afterwards with
+ * ToolSet::Model2Parameter() / ToolSet::Parameter2Statistic(): add() reads the parameters straight
+ * from the refitted model, Parameter() produces the same result objects (including "raw" if the
+ * raw values were kept, in ascending order as ToolSet::Confidence() expects them).
+ */
+class ParameterAccumulator {
+public:
+    /*! \brief Take the parameter layout (names, series, checked local parameters) from \a model */
+    void setModel(const AbstractModel* model, bool keep_raw);
+
+    void add(const AbstractModel* model);
+    void merge(const ParameterAccumulator& other);
+
+    inline int Size() const { return m_summaries.size(); }
+    inline qint64 Count() const { return m_global.Count(); }
+    inline const SampleSummary& Summary(int i) const { return m_summaries[i]; }
+    inline const RunningCovariance& GlobalCovariance() const { return m_global; }
+    /*! \brief Indices of the summaries that received values, in the order Parameter() lists them */
+    QVector<int> Reported() const;
+
+    /*! \brief Statistics of every parameter in Reported(), the parameters are evaluated side by side on
+     * the threads of \a context. The raw values are sorted once per parameter, \a error and \a bins are
+     * those of ToolSet::Confidence() and List2Histogram(), the entropy is taken over \a entropy_bins. */
+    QVector<ParameterStatistics> Evaluate(qreal error, int bins, int entropy_bins, const ExecutionContext& context = ExecutionContext()) const;
+
+    /*! \brief Result objects in the layout of Model2Parameter + Parameter2Statistic with the box
+     * plots only; "value" is taken from \a model, usually the one the resampling started from */
+    QList<QJsonObject> Parameter(const AbstractModel* model) const;
+    /*! \brief The same from the statistics of Evaluate(), including the entropy */
+    QList<QJsonObject> Parameter(const AbstractModel* model, const QVector<ParameterStatistics>& statistics) const;
+
+private:
+    struct Slot {
+        QString name, index;
+        bool global;
+        int row, column;
+    };
+    QVector<Slot> m_slots;
+    QVector<SampleSummary> m_summaries;
+    RunningCovariance m_global;
+};
@@ -54,10 +54,7 @@ void ThermogramHandler::Initialise()
         qWarning() << "No Thermogram found. ThermogramHandler is not initialised!";
         return;
     } else {
-        m_thermogram_series.resize(m_spectrum.x().size());
-        for (unsigned int i = 0; i < m_spectrum.x().size(); i++) {
-            m_thermogram_series[i] = (QPointF(m_spectrum.X(i), m_spectrum.Y(i)));
-        }
+        InvalidateSpectrumCache();
 
         if (qFuzzyCompare(m_ThermogramEnd, 0))
             m_ThermogramEnd = m_spectrum.XMax();
@@ -92,6 +89,22 @@ void ThermogramHandler::Initialise()
     emit ThermogramInitialised();
 }
 
+void ThermogramHandler::InvalidateSpectrumCache()
+{
+    m_thermogram_series.clear();
+    m_integration_cache.clear();
+}
+
+QList<QPointF> ThermogramHandler::ThermogramSeries() const
+{
+    if (m_thermogram_series.size() != qsizetype(m_spectrum.x().size())) {
+        m_thermogram_series.resize(m_spectrum.x().size());
+        for (unsigned int i = 0; i < m_spectrum.x().size(); i++)
+            m_thermogram_series[i] = QPointF(m_spectrum.X(i), m_spectrum.Y(i));
+    }
+    return m_thermogram_series;
+}
+
 void ThermogramHandler::LoadParameter()
 {
     if (!m_thermogram_parameter.isEmpty()) {
@@ -100,6 +113,7 @@ void ThermogramHandler::LoadParameter()
             x = ToolSet::String2DoubleEigVec(m_thermogram_parameter["Thermogram"].toObject()["x"].toString());
             y = ToolSet::String2DoubleEigVec(m_thermogram_parameter["Thermogram"].toObject()["y"].toString());
             m_spectrum.setSpectrum(x, y);
+            InvalidateSpectrumCache();
 
             m_frequency = m_spectrum.Step();
             m_ThermogramBegin = m_spectrum.XMax();
@@ -183,6 +197,7 @@ void ThermogramHandler::LegacyLoad()
         x = ToolSet::String2DoubleEigVec(m_thermogram_parameter["thermogram"].toObject()["x"].toString());
         y = ToolSet::String2DoubleEigVec(m_thermogram_parameter["thermogram"].toObject()["y"].toString());
         m_spectrum.setSpectrum(x, y);
+        InvalidateSpectrumCache();
 
         m_frequency = m_spectrum.Step();
 
@@ -350,20 +365,39 @@ void ThermogramHandler::ApplyThermogramIntegration()
     if (m_baseline.baselines.size() > 0)
         baseline = m_baseline.baselines[0];
 
+    /* The threshold iterations of AdjustIntegrationRange re-integrate all peaks after every step,
+     * although most ranges and baselines have settled already - only changed peaks are rescanned */
+    if (m_integration_cache.size() != m_peak_list.size())
+        m_integration_cache = QVector<PeakIntegration>(m_peak_list.size());
+
     for (std::size_t i = 0; i < m_peak_list.size(); ++i) {
-        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
         if (m_peak_list.size() == m_baseline.baselines.size()) // && m_baseline.x_grid_points.size() > 0)
         {
             baseline = m_baseline.baselines[i];
         }
-        PeakPick::IntegrateNumerical(&m_spectrum, m_peak_list[i], baseline);
+        PeakIntegration& cached = m_integration_cache[i];
+        if (cached.matches(m_peak_list[i], baseline)) {
+            m_peak_list[i].integ_num = cached.integral;
+        } else {
+            PeakPick::IntegrateNumerical(&m_spectrum, m_peak_list[i], baseline);
+
+            cached.start = m_peak_list[i].start;
+            cached.end = m_peak_list[i].end;
+            cached.int_start = m_peak_list[i].int_start;
+            cached.int_end = m_peak_list[i].int_end;
+            cached.baseline = baseline;
+            cached.integral = m_peak_list[i].integ_num;
+            cached.residuals.clear();
+            for (int j = m_peak_list[i].int_start; j < m_peak_list[i].int_end - 1; j++)
+                cached.residuals.push_back(qAbs(PeakPick::Polynomial(m_spectrum.X(j), baseline) - (m_spectrum.Y(j))));
+        }
 
         m_integrals_raw << m_peak_list[i].integ_num;
         m_integrals_scaled << m_peak_list[i].integ_num;
 
-        for (int j = m_peak_list[i].int_start; j < m_peak_list[i].int_end - 1; j++) {
-            sum_difference_signal_baseline += qAbs(PeakPick::Polynomial(m_spectrum.X(j), baseline) - (m_spectrum.Y(j)));
-            difference_signal_baseline << qAbs(PeakPick::Polynomial(m_spectrum.X(j), baseline) - (m_spectrum.Y(j)));
+        for (qreal residual : cached.residuals) {
+            sum_difference_signal_baseline += residual;
+            difference_signal_baseline << residual;
         }
     }
     qreal stdev = Stddev(difference_signal_baseline, 0, sum_difference_signal_baseline / double(difference_signal_baseline.size()));
@@ -397,7 +431,6 @@ void ThermogramHandler::UpdateBaseLine()
         baseline = m_baseline.baselines[0];
 
     for (int i = 0; i < int(m_peak_list.size()); ++i) {
-        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
         if (m_peak_list.size() == m_baseline.baselines.size() && m_baseline.x_grid_points.size() > 0) {
             baseline = m_baseline.baselines[i];
             for (int j = 0; j < int(m_baseline.x_grid_points[i].size()); ++j) {
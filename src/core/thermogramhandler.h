@@ -26,6 +26,8 @@
 #include <QtCore/QPointF>
 #include <QtCore/QVector>
 
+#include <vector>
+
 #include "libpeakpick/analyse.h"
 #include "libpeakpick/baseline.h"
 #include "libpeakpick/peakpick.h"
@@ -35,7 +37,11 @@ class ThermogramHandler : public QObject {
 public:
     ThermogramHandler();
 
-    inline void setThermogram(const PeakPick::spectrum& spectrum) { m_spectrum = spectrum; }
+    inline void setThermogram(const PeakPick::spectrum& spectrum)
+    {
+        m_spectrum = spectrum;
+        InvalidateSpectrumCache();
+    }
     inline void setPeakList(const std::vector<PeakPick::Peak>& peak_list) { m_peak_list = QVector<PeakPick::Peak>(peak_list.begin(), peak_list.end()); }
     inline void setPeakList(const QVector<PeakPick::Peak>& peak_list) { m_peak_list = peak_list; }
 
@@ -90,7 +96,8 @@ public:
 
     qreal Calibration() const { return m_calibration_peak.integ_num; }
 
-    inline QList<QPointF> ThermogramSeries() const { return m_thermogram_series; }
+    /*! \brief Thermogram as chart points, built on first use - batch integration never needs them */
+    QList<QPointF> ThermogramSeries() const;
     inline QList<QPointF> BaselineSeries() const { return m_baseline_series; }
     inline QList<QPointF> BaselineGrid() const { return m_baseline_grid; }
     inline QList<QPointF> BaselineIgnored() const { return m_baseline_ignored_series; }
@@ -110,8 +117,24 @@ public:
     void ApplyScaling();
 
 private:
+    /* Integral and baseline residuals of one peak, valid as long as its ranges and baseline are unchanged */
+    struct PeakIntegration {
+        double start = -1, end = -1, int_start = -1, int_end = -1;
+        Vector baseline;
+        double integral = 0;
+        std::vector<qreal> residuals;
+
+        inline bool matches(const PeakPick::Peak& peak, const Vector& polynom) const
+        {
+            return start == peak.start && end == peak.end && int_start == peak.int_start && int_end == peak.int_end
+                && baseline.size() == polynom.size() && (baseline.size() == 0 || baseline == polynom);
+        }
+    };
+
     /* Chart Series use QList */
-    QList<QPointF> m_thermogram_series, m_baseline_series, m_baseline_grid, m_baseline_ignored_series;
+    mutable QList<QPointF> m_thermogram_series;
+    QList<QPointF> m_baseline_series, m_baseline_grid, m_baseline_ignored_series;
+    QVector<PeakIntegration> m_integration_cache;
     QVector<QPointF> m_peak_rules;
     QVector<qreal> m_integrals_raw, m_integrals_scaled;
     QVector<PeakPick::Peak> m_peak_list;
@@ -132,6 +155,7 @@ private:
 
     void LegacyLoad();
     void LoadParameter();
+    void InvalidateSpectrumCache();
     void LoadBlock();
     double ResizeIntegrationRange(double threshold, int direction);
     void ApplyThermogramIntegration();
@@ -41,6 +41,10 @@ typedef Eigen::VectorXd Vector;
 namespace ToolSet {
 double String2Double(QString str);
 
+/*! \brief Parse the number in [begin, end) without allocating. Surrounding whitespace and a
+ * leading '+' are accepted; like QString::toDouble, anything else yields 0 and \a ok = false. */
+double ParseDouble(const char* begin, const char* end, bool* ok = nullptr);
+
 QString DoubleVec2String(const QVector<qreal>& vector, const QString& str = " ");
 QString IntVec2String(const QVector<int>& vector, const QString& str = " ");
 QString IntList2String(const QList<int>& vector, const QString& str = " ");
@@ -27,6 +27,7 @@
 #include "jsonhandler.h"
 #include "libmath.h"
 
+#include <QtCore/QByteArray>
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
@@ -38,6 +39,13 @@
 
 #include <Eigen/Dense>
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <iterator>
+#include <string>
+
 #include <functional>
 
 #include "toolset.h"
@@ -208,6 +216,56 @@ QPair<Vector, Vector> LoadXYFile(const QString& filename)
     return QPair<Vector, Vector>(x, y);
 }
 
+double ParseDouble(const char* begin, const char* end, bool* ok)
+{
+    while (begin < end && std::isspace(static_cast<unsigned char>(*begin)))
+        ++begin;
+    while (end > begin && std::isspace(static_cast<unsigned char>(*(end - 1))))
+        --end;
+    if (begin < end && *begin == '+')
+        ++begin;
+
+    double value = 0;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const std::from_chars_result result = std::from_chars(begin, end, value);
+    const bool valid = begin < end && result.ec == std::errc() && result.ptr == end;
+#else
+    /* No floating point from_chars in this standard library; QByteArray::toDouble is locale
+     * independent as well, unlike strtod */
+    bool valid = false;
+    value = QByteArray::fromRawData(begin, int(end - begin)).toDouble(&valid);
+#endif
+    if (ok)
+        *ok = valid;
+    return valid ? value : 0;
+}
+
+namespace {
+/* Fields of one line of an .itc file, without copying it into a QString */
+struct ItcLine {
+    const char* begin;
+    const char* end;
+
+    inline bool contains(char c) const { return std::memchr(begin, c, end - begin) != nullptr; }
+
+    /* The n-th comma separated field, empty if the line has less fields */
+    inline std::pair<const char*, const char*> field(int n) const
+    {
+        const char* first = begin;
+        for (; n > 0; --n) {
+            const char* comma = static_cast<const char*>(std::memchr(first, ',', end - first));
+            if (!comma)
+                return { end, end };
+            first = comma + 1;
+        }
+        const char* comma = static_cast<const char*>(std::memchr(first, ',', end - first));
+        return { first, comma ? comma : end };
+    }
+
+    inline int fields() const { return int(std::count(begin, end, ',')) + 1; }
+};
+}
+
 QPair<PeakPick::spectrum, QJsonObject> LoadITCFile(QString& filename, std::vector<PeakPick::Peak>* peaks, qreal& offset, qreal& freq, QVector<qreal>& inject)
 {
     QJsonObject systemparameter;
@@ -235,31 +293,58 @@ QPair<PeakPick::spectrum, QJsonObject> LoadITCFile(QString& filename, std::vecto
         }
     }
     QFile file(filename);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::ReadOnly)) {
         qDebug() << file.errorString();
         throw 404;
     }
 
-    QStringList filecontent = QString(file.readAll()).split("\n");
+    /* Long high-frequency runs have millions of lines: map the file and parse the numbers in
+     * place instead of building a QString per line. Falls back to reading if mapping fails. */
+    QByteArray buffer;
+    const char* data = nullptr;
+    qint64 size = file.size();
+    if (size > 0)
+        data = reinterpret_cast<const char*>(file.map(0, size));
+    if (!data) {
+        buffer = file.readAll();
+        data = buffer.constData();
+        size = buffer.size();
+    }
 
     std::vector<double> entries_x, entries_y;
+    entries_x.reserve(size / 16);
+    entries_y.reserve(size / 16);
     bool start_peak = false, skip = false;
     qreal last_x = 0;
     offset = 0;
     PeakPick::Peak floating_peak;
     int i_offset = 0, sytemcounter = 0, index = -1;
-    for (const QString& str : filecontent) {
-        if (str.contains("$") || str.contains("#") || str.contains("?") || str.contains("%")) {
-            if (str.contains("%")) {
-            }
-            if (str.contains("$")) {
-                if (str.simplified().split(" ").size() == 8) {
-                    double val = str.simplified().split(" ").last().toDouble();
+
+    const char* const data_end = data + size;
+    for (const char* line_begin = data; line_begin < data_end;) {
+        const char* line_end = static_cast<const char*>(std::memchr(line_begin, '\n', data_end - line_begin));
+        if (!line_end)
+            line_end = data_end;
+        /* A last line without a newline ends the scan at data_end, never behind it */
+        const char* next = line_end < data_end ? line_end + 1 : data_end;
+        if (line_end > line_begin && *(line_end - 1) == '\r')
+            --line_end;
+        const ItcLine str{ line_begin, line_end };
+        line_begin = next;
+
+        if (str.contains('$') || str.contains('#') || str.contains('?') || str.contains('%')) {
+            if (str.contains('$')) {
+                QList<QByteArray> tokens = QByteArray(str.begin, str.end - str.begin).simplified().split(' ');
+                if (tokens.size() == 8) {
+                    double val = ParseDouble(tokens.last().constBegin(), tokens.last().constEnd());
                     freq = val;
                 }
             }
-            if (str.contains("#")) {
-                double val = QString(str).remove("#").toDouble();
+            if (str.contains('#')) {
+                std::string number;
+                number.reserve(str.end - str.begin);
+                std::remove_copy(str.begin, str.end, std::back_inserter(number), '#');
+                double val = ParseDouble(number.data(), number.data() + number.size());
                 if (qFuzzyCompare(val, 0)) {
                     sytemcounter++;
                     continue;
@@ -275,33 +360,41 @@ QPair<PeakPick::spectrum, QJsonObject> LoadITCFile(QString& filename, std::vecto
 
                 sytemcounter++;
             }
-        } else if (str.contains("@")) {
-            skip = (str.contains("@0"));
+        } else if (str.contains('@')) {
+            const char* at = static_cast<const char*>(std::memchr(str.begin, '@', str.end - str.begin));
+            skip = false;
+            for (; at; at = static_cast<const char*>(std::memchr(at + 1, '@', str.end - at - 1))) {
+                if (at + 1 < str.end && *(at + 1) == '0') {
+                    skip = true;
+                    break;
+                }
+            }
             if (skip)
                 continue;
             start_peak = true;
             floating_peak.setPeakEnd(index);
             if (last_x && floating_peak.start)
                 peaks->push_back(floating_peak);
-            inject << str.split(",")[1].toDouble();
-        } else {
-            QStringList elements = str.simplified().split(",");
-            if (elements.size() > 2) {
-                if (skip) {
-                    offset += elements[1].toDouble();
-                    i_offset++;
-                    last_x = elements[0].toDouble() / freq;
-                }
-                entries_x.push_back(elements[0].toDouble());
-                entries_y.push_back(elements[1].toDouble());
-                index++;
-                if (start_peak) {
-                    // floating_peak.setPeakStart(elements[0].toDouble() / freq);
-                    floating_peak.setPeakStart(index);
-                    start_peak = false;
-                }
-                last_x = elements[0].toDouble() / freq;
+            const auto volume = str.field(1);
+            inject << ParseDouble(volume.first, volume.second);
+        } else if (str.fields() > 2) {
+            const auto time = str.field(0);
+            const auto heat = str.field(1);
+            const double x_value = ParseDouble(time.first, time.second);
+            const double y_value = ParseDouble(heat.first, heat.second);
+            if (skip) {
+                offset += y_value;
+                i_offset++;
+                last_x = x_value / freq;
+            }
+            entries_x.push_back(x_value);
+            entries_y.push_back(y_value);
+            index++;
+            if (start_peak) {
+                floating_peak.setPeakStart(index);
+                start_peak = false;
             }
+            last_x = x_value / freq;
         }
     }
 
@@ -104,16 +104,26 @@ QString TextFromConfidence(const QJsonObject& result, const QJsonObject& control
                 text += QString("<p>Bootstrapping has been used.</p>");
         }
         text += QString("<tr><td>Inter-percentile range for %1</td><td>%2</td></tr>").arg(result["name"].toString()).arg(Print::printDouble(upper - lower, 4));
-        QVector<qreal> list = ToolSet::String2DoubleVec(result["data"].toObject()["raw"].toString());
-        QVector<QPair<qreal, qreal>> histogram = ToolSet::List2Histogram(list, bins);
-        ToolSet::Normalise(histogram);
-        QPair<qreal, qreal> pair = ToolSet::Entropy(histogram);
-        QJsonObject entropy = ToolSet::CalculateShannonEntropy(histogram);
-        // qDebug() << entropy;
-        BoxWhisker box;
+        /* The entropy is stored with the statistics, if it was taken over the same bins; old results,
+         * and results with stddev missing in their box-plot, are recalculated from the raw values */
+        const QJsonObject entropy = result["entropy"].toObject();
+        const bool stored_entropy = entropy["bins"].toInt() == bins && entropy["FullShannon"].toBool() == qApp->instance()->property("FullShannon").toBool();
+        const bool stored_box = result["boxplot"].toObject().contains("stddev");
+        QVector<qreal> list;
+        if (!stored_entropy || !stored_box)
+            list = ToolSet::String2DoubleVec(result["data"].toObject()["raw"].toString());
+
+        QPair<qreal, qreal> pair;
+        if (stored_entropy)
+            pair = QPair<qreal, qreal>(entropy["value"].toDouble(), entropy["offset"].toDouble());
+        else {
+            QVector<QPair<qreal, qreal>> histogram = ToolSet::List2Histogram(list, bins);
+            ToolSet::Normalise(histogram);
+            pair = ToolSet::Entropy(histogram);
+        }
 
-        /* If old results are used, that don't contain stddev in their json object, recalculate box-plot */
-        if (result["boxplot"].toObject().contains("stddev"))
+        BoxWhisker box;
+        if (stored_box)
             box = ToolSet::Object2Whisker(result["boxplot"].toObject());
         else
             box = ToolSet::BoxWhiskerPlot(list.toList());
@@ -483,8 +483,17 @@ const QJsonObject OptimConfigBlock{
        only the non-linear global parameters and projects the linear locals (finite-difference Jacobian);
        "VarProAnalytic" = VarPro with the analytic implicit-function Jacobian (no speciation re-solve per
        Jacobian column; falls back to finite differences where a model has none or the data is masked).
-       Both VarPro modes fall back to LevMar for models without SupportsVarPro(). Claude Generated. */
+       Both VarPro modes fall back to LevMar for models without SupportsVarPro(). Claude Generated.
+       "BlockLevMar" = full-vector LM that differentiates the locals of all series together and eliminates
+       them by a Schur complement (AbstractModel::JacobianBlocks()). "VarProBroyden" / "BlockLevMarBroyden"
+       finite-difference the Jacobian only in the first step, after a stalled step and every BroydenRefresh
+       steps, and use Broyden rank-one updates in between. */
     { "FitSolver", "LevMar" },
+    { "BroydenRefresh", 5 },
+
+    /* Take converged fits from the FitCache and store new ones there, if the application enabled the
+       cache ("FitCache" property); false opts a single fit out. Not part of the cache key. */
+    { "FitCache", true },
 
     /* Speciation (equilibrium concentration) solver for the reaction-driven *_any models: "LevMar" =
        damped Newton with the analytic Hessian (default: fast + reaches 1e-12 uniformly); "BFGS" = the
@@ -84,6 +84,22 @@ public:
         }
         return result;
     }
+
+    /**
+     * @brief Batched forward pass, one sample per column
+     * @param input Pre-activations [neurons × samples]
+     * @return Activations of the same shape
+     */
+    virtual Eigen::MatrixXd forwardMatrix(const Eigen::MatrixXd& input) const {
+        return input.unaryExpr([this](double x) { return forward(x); });
+    }
+
+    /**
+     * @brief Element-wise derivative of a batch of pre-activations [neurons × samples]
+     */
+    virtual Eigen::MatrixXd backwardMatrix(const Eigen::MatrixXd& input) const {
+        return input.unaryExpr([this](double x) { return backward(x); });
+    }
 };
 
 /**
@@ -105,6 +121,14 @@ public:
     double backward(double x) const override {
         return x > 0.0 ? 1.0 : 0.0;
     }
+
+    Eigen::MatrixXd forwardMatrix(const Eigen::MatrixXd& input) const override {
+        return input.cwiseMax(0.0);
+    }
+
+    Eigen::MatrixXd backwardMatrix(const Eigen::MatrixXd& input) const override {
+        return (input.array() > 0.0).cast<double>().matrix();
+    }
     
     QString name() const override {
         return "ReLU";
@@ -226,6 +250,20 @@ public:
         
         return exp_x / sum_exp;
     }
+
+    /**
+     * @brief Column-wise softmax: every column of @p x is one sample
+     */
+    Eigen::MatrixXd forwardMatrix(const Eigen::MatrixXd& x) const override {
+        Eigen::MatrixXd result(x.rows(), x.cols());
+        for (Eigen::Index j = 0; j < x.cols(); ++j)
+            result.col(j) = forwardVector(x.col(j));
+        return result;
+    }
+
+    Eigen::MatrixXd backwardMatrix(const Eigen::MatrixXd& x) const override {
+        return Eigen::MatrixXd::Ones(x.rows(), x.cols()); // see backward()
+    }
     
     // Individual element functions (not typically used for softmax)
     double forward(double x) const override {
@@ -264,6 +302,14 @@ public:
     double backward(double /*x*/) const override {
         return 1.0;
     }
+
+    Eigen::MatrixXd forwardMatrix(const Eigen::MatrixXd& input) const override {
+        return input;
+    }
+
+    Eigen::MatrixXd backwardMatrix(const Eigen::MatrixXd& input) const override {
+        return Eigen::MatrixXd::Ones(input.rows(), input.cols());
+    }
     
     QString name() const override {
         return "Linear";
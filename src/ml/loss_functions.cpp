@@ -54,4 +54,25 @@ TrainingData::createMiniBatches(size_t batch_size) const
     }
     
     return batches;
-}
\ No newline at end of file
+}
+
+static Eigen::MatrixXd stackColumns(const std::vector<Eigen::VectorXd>& vectors)
+{
+    if (vectors.empty())
+        return Eigen::MatrixXd();
+
+    Eigen::MatrixXd matrix(vectors.front().size(), static_cast<Eigen::Index>(vectors.size()));
+    for (size_t i = 0; i < vectors.size(); ++i)
+        matrix.col(static_cast<Eigen::Index>(i)) = vectors[i];
+    return matrix;
+}
+
+Eigen::MatrixXd TrainingData::inputMatrix() const
+{
+    return stackColumns(inputs);
+}
+
+Eigen::MatrixXd TrainingData::targetMatrix() const
+{
+    return stackColumns(targets);
+}
@@ -54,6 +54,30 @@ public:
      * @return Gradient vector for backpropagation
      */
     virtual Eigen::VectorXd backward(const Eigen::VectorXd& predictions, const Eigen::VectorXd& targets) const = 0;
+
+    /**
+     * @brief Mean loss over a batch, one sample per column
+     * @param predictions Network outputs [outputs × samples]
+     * @param targets Expected outputs [outputs × samples]
+     */
+    virtual double forwardBatch(const Eigen::MatrixXd& predictions, const Eigen::MatrixXd& targets) const {
+        if (predictions.cols() == 0)
+            return 0.0;
+        double loss = 0.0;
+        for (Eigen::Index j = 0; j < predictions.cols(); ++j)
+            loss += forward(predictions.col(j), targets.col(j));
+        return loss / predictions.cols();
+    }
+
+    /**
+     * @brief Per-sample gradients for a batch, one sample per column
+     */
+    virtual Eigen::MatrixXd backwardBatch(const Eigen::MatrixXd& predictions, const Eigen::MatrixXd& targets) const {
+        Eigen::MatrixXd gradients(predictions.rows(), predictions.cols());
+        for (Eigen::Index j = 0; j < predictions.cols(); ++j)
+            gradients.col(j) = backward(predictions.col(j), targets.col(j));
+        return gradients;
+    }
     
     /**
      * @brief Human-readable name of loss function
@@ -233,4 +257,10 @@ struct TrainingData {
      */
     std::vector<std::pair<std::vector<Eigen::VectorXd>, std::vector<Eigen::VectorXd>>> 
     createMiniBatches(size_t batch_size) const;
+
+    /**
+     * @brief Stack inputs/targets as columns of a matrix for the batched (GEMM) training path
+     */
+    Eigen::MatrixXd inputMatrix() const;
+    Eigen::MatrixXd targetMatrix() const;
 };
\ No newline at end of file
@@ -18,6 +18,7 @@
  */
 
 #include "neural_layer.h"
+#include "optimizer.h"
 #include "tutorial/tutorial_manager.h"
 
 #include <QtCore/QJsonArray>
@@ -142,6 +143,55 @@ void NeuralLayer::backward(const Eigen::VectorXd& layer_input,
     input_gradient = weights_.transpose() * pre_activation_gradient;
 }
 
+Eigen::MatrixXd NeuralLayer::forwardBatch(const Eigen::MatrixXd& inputs,
+                                          Eigen::MatrixXd* pre_activation) const
+{
+    if (inputs.rows() != input_size_) {
+        qDebug() << "Neural Layer Error: Input size mismatch. Expected:" << input_size_
+                 << "Got:" << inputs.rows();
+        return Eigen::MatrixXd::Zero(output_size_, inputs.cols());
+    }
+
+    Eigen::MatrixXd z = weights_ * inputs;
+    z.colwise() += biases_;
+
+    Eigen::MatrixXd output = activateBatch(z);
+    if (pre_activation)
+        *pre_activation = std::move(z);
+    return output;
+}
+
+Eigen::MatrixXd NeuralLayer::activateBatch(const Eigen::MatrixXd& pre_activation) const
+{
+    if (!activation_)
+        return pre_activation;
+    return activation_->forwardMatrix(pre_activation);
+}
+
+void NeuralLayer::backwardBatch(const Eigen::MatrixXd& layer_inputs,
+                                const Eigen::MatrixXd& pre_activation,
+                                const Eigen::MatrixXd& output_gradients,
+                                Eigen::MatrixXd& weight_gradients,
+                                Eigen::VectorXd& bias_gradients,
+                                Eigen::MatrixXd& input_gradients) const
+{
+    // Same simplification as backward(): the softmax derivative is folded into the loss gradient
+    Eigen::MatrixXd delta = output_gradients;
+    if (activation_)
+        delta.array() *= activation_->backwardMatrix(pre_activation).array();
+
+    weight_gradients.noalias() = delta * layer_inputs.transpose();
+    bias_gradients = delta.rowwise().sum();
+    input_gradients.noalias() = weights_.transpose() * delta;
+}
+
+void NeuralLayer::applyGradients(Optimizer& optimizer,
+                                 const Eigen::MatrixXd& weight_gradients,
+                                 const Eigen::VectorXd& bias_gradients)
+{
+    optimizer.update(weights_, weight_gradients, biases_, bias_gradients);
+}
+
 Eigen::VectorXd NeuralLayer::applyActivation(const Eigen::VectorXd& pre_activation)
 {
     if (!activation_) {
@@ -31,6 +31,7 @@
  * @brief Forward declaration for tutorial support
  */
 class TutorialManager;
+class Optimizer;
 
 /**
  * @brief Neural Network Layer with Educational Focus
@@ -112,6 +113,48 @@ public:
                   Eigen::VectorXd& bias_gradients,
                   Eigen::VectorXd& input_gradient);
 
+    /**
+     * @brief Batched forward propagation, one sample per column
+     *
+     * Evaluates weights × inputs + biases for the whole batch as a single GEMM.
+     * Unlike forward(), nothing is recorded and no tutorial output is produced,
+     * so concurrent calls on the same layer are safe.
+     *
+     * @param inputs Input matrix [input_size × samples]
+     * @param pre_activation Optional output: values before activation (needed by backwardBatch)
+     * @return Output matrix [output_size × samples]
+     */
+    Eigen::MatrixXd forwardBatch(const Eigen::MatrixXd& inputs,
+                                 Eigen::MatrixXd* pre_activation = nullptr) const;
+
+    /**
+     * @brief Apply the activation function to a batch of pre-activations [output_size × samples]
+     */
+    Eigen::MatrixXd activateBatch(const Eigen::MatrixXd& pre_activation) const;
+
+    /**
+     * @brief Batched backpropagation, one sample per column
+     * @param layer_inputs Inputs used in forwardBatch [input_size × samples]
+     * @param pre_activation Pre-activations returned by forwardBatch [output_size × samples]
+     * @param output_gradients Gradients from the next layer [output_size × samples]
+     * @param weight_gradients Output: weight gradients summed over the batch
+     * @param bias_gradients Output: bias gradients summed over the batch
+     * @param input_gradients Output: per-sample gradients w.r.t. the inputs [input_size × samples]
+     */
+    void backwardBatch(const Eigen::MatrixXd& layer_inputs,
+                       const Eigen::MatrixXd& pre_activation,
+                       const Eigen::MatrixXd& output_gradients,
+                       Eigen::MatrixXd& weight_gradients,
+                       Eigen::VectorXd& bias_gradients,
+                       Eigen::MatrixXd& input_gradients) const;
+
+    /**
+     * @brief Update weights and biases in place with the given optimizer
+     */
+    void applyGradients(Optimizer& optimizer,
+                        const Eigen::MatrixXd& weight_gradients,
+                        const Eigen::VectorXd& bias_gradients);
+
     /**
      * @brief Get layer dimensions
      */
@@ -24,11 +24,15 @@
 #include <QtCore/QFile>
 #include <QtCore/QDebug>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QThreadPool>
 #include <fmt/format.h>
 #include <algorithm>
+#include <numeric>
+#include <random>
 
 NeuralNetwork::NeuralNetwork()
-    : tutorial_manager_(nullptr)
+    : precision_(Precision::Double)
+    , tutorial_manager_(nullptr)
     , last_error_(ErrorCode::Success)
 {
     clearError();
@@ -65,7 +69,8 @@ NeuralNetwork::NeuralNetwork(const std::vector<int>& layer_sizes,
 }
 
 NeuralNetwork::NeuralNetwork(const NeuralNetwork& other)
-    : tutorial_manager_(nullptr)  // Don't copy tutorial manager
+    : precision_(other.precision_)
+    , tutorial_manager_(nullptr)  // Don't copy tutorial manager
     , metrics_(other.metrics_)
     , last_error_(other.last_error_)
     , last_error_message_(other.last_error_message_)
@@ -93,6 +98,7 @@ NeuralNetwork& NeuralNetwork::operator=(const NeuralNetwork& other)
         }
         
         // Copy other members
+        precision_ = other.precision_;
         metrics_ = other.metrics_;
         last_error_ = other.last_error_;
         last_error_message_ = other.last_error_message_;
@@ -137,6 +143,14 @@ const NeuralLayer& NeuralNetwork::getLayer(size_t index) const
     return *layers_[index];
 }
 
+void NeuralNetwork::initializeWeights(unsigned int seed, NeuralLayer::InitializationMethod method)
+{
+    for (size_t i = 0; i < layers_.size(); ++i) {
+        layers_[i]->initializeWeights(method, seed == 0 ? 0 : seed + static_cast<unsigned int>(i));
+    }
+    clearError();
+}
+
 Eigen::VectorXd NeuralNetwork::predict(const Eigen::VectorXd& input)
 {
     QElapsedTimer timer;
@@ -209,6 +223,75 @@ NeuralNetwork::PredictionResult NeuralNetwork::predictWithDetails(const Eigen::V
     return result;
 }
 
+Eigen::MatrixXd NeuralNetwork::predictBatch(const Eigen::MatrixXd& inputs, int threads) const
+{
+    if (layers_.empty()) {
+        setError(ErrorCode::EmptyNetwork, "Cannot predict with empty network");
+        return Eigen::MatrixXd();
+    }
+
+    if (inputs.rows() != layers_[0]->inputSize()) {
+        setError(ErrorCode::DimensionMismatch,
+                QString("Input dimension mismatch. Expected: %1, Got: %2")
+                .arg(layers_[0]->inputSize()).arg(inputs.rows()));
+        return Eigen::MatrixXd();
+    }
+
+    // Single precision parameters are converted once and shared by all workers
+    std::vector<Eigen::MatrixXf> weights_f;
+    std::vector<Eigen::VectorXf> biases_f;
+    if (precision_ == Precision::Single) {
+        for (const auto& layer : layers_) {
+            weights_f.push_back(layer->weights().cast<float>());
+            biases_f.push_back(layer->biases().cast<float>());
+        }
+    }
+
+    const Eigen::Index samples = inputs.cols();
+    threads = static_cast<int>(std::min<Eigen::Index>(std::max(threads, 1), std::max<Eigen::Index>(samples, 1)));
+    if (threads == 1) {
+        clearError();
+        return forwardBatch(inputs, weights_f, biases_f);
+    }
+
+    Eigen::MatrixXd outputs(layers_.back()->outputSize(), samples);
+    const Eigen::Index block = (samples + threads - 1) / threads;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    for (Eigen::Index start = 0; start < samples; start += block) {
+        const Eigen::Index count = std::min(block, samples - start);
+        pool.start([&, start, count]() {
+            outputs.middleCols(start, count) = forwardBatch(inputs.middleCols(start, count), weights_f, biases_f);
+        });
+    }
+    pool.waitForDone();
+
+    clearError();
+    return outputs;
+}
+
+Eigen::MatrixXd NeuralNetwork::forwardBatch(const Eigen::MatrixXd& inputs,
+                                            const std::vector<Eigen::MatrixXf>& weights_f,
+                                            const std::vector<Eigen::VectorXf>& biases_f) const
+{
+    if (weights_f.empty()) {
+        Eigen::MatrixXd current = inputs;
+        for (const auto& layer : layers_) {
+            current = layer->forwardBatch(current);
+        }
+        return current;
+    }
+
+    Eigen::MatrixXf current = inputs.cast<float>();
+    for (size_t i = 0; i < layers_.size(); ++i) {
+        Eigen::MatrixXf z = weights_f[i] * current;
+        z.colwise() += biases_f[i];
+        current = layers_[i]->activateBatch(z.cast<double>()).cast<float>();
+    }
+    return current.cast<double>();
+}
+
 QJsonObject NeuralNetwork::saveModel() const
 {
     QJsonObject model;
@@ -621,9 +704,12 @@ NeuralNetwork::TrainingHistory NeuralNetwork::train(const TrainingData& training
         return history;
     }
     
-    // Create optimizer and loss function
-    auto optimizer = createOptimizer(config.optimizer_name, config.learning_rate);
+    // Create loss function and one optimizer per layer (momentum and Adam keep per-layer state)
     auto loss_function = createLossFunction(config.loss_function);
+    std::vector<std::unique_ptr<Optimizer>> optimizers;
+    for (size_t i = 0; i < layers_.size(); ++i) {
+        optimizers.push_back(createOptimizer(config.optimizer_name, config.learning_rate));
+    }
     
     // Split data into training and validation sets
     size_t total_size = training_data.size();
@@ -647,41 +733,68 @@ NeuralNetwork::TrainingHistory NeuralNetwork::train(const TrainingData& training
     fmt::print("Epochs: {}, Batch size: {}\n", config.epochs, config.batch_size);
     fmt::print("Optimizer: {}, Loss: {}\n", config.optimizer_name.toStdString(), config.loss_function.toStdString());
     fmt::print("\n");
-    
+
+    // Samples as columns, so every mini-batch is a GEMM per layer
+    const Eigen::MatrixXd train_inputs = train_set.inputMatrix();
+    const Eigen::MatrixXd train_targets = train_set.targetMatrix();
+    const Eigen::MatrixXd validation_inputs = validation_set.inputMatrix();
+    const Eigen::MatrixXd validation_targets = validation_set.targetMatrix();
+    const Eigen::Index batch_size = std::max(1, config.batch_size);
+
+    std::vector<Eigen::Index> order(train_set.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::mt19937 rng(std::random_device{}());
+
     // Training loop
     for (int epoch = 0; epoch < config.epochs; ++epoch) {
         double total_train_loss = 0.0;
         int batch_count = 0;
-        
-        // Create mini-batches
-        auto batches = train_set.createMiniBatches(config.batch_size);
-        
-        for (const auto& batch : batches) {
-            const auto& batch_inputs = batch.first;
-            const auto& batch_targets = batch.second;
-            
-            double batch_loss = 0.0;
-            
-            // Process each sample in the batch
-            for (size_t i = 0; i < batch_inputs.size(); ++i) {
-                batch_loss += backpropagate(batch_inputs[i], batch_targets[i], *loss_function);
+
+        if (tutorial_manager_) {
+            // Tutorial mode: per-sample updates so each step can be narrated
+            auto batches = train_set.createMiniBatches(config.batch_size);
+
+            for (const auto& batch : batches) {
+                const auto& batch_inputs = batch.first;
+                const auto& batch_targets = batch.second;
+
+                double batch_loss = 0.0;
+
+                // Process each sample in the batch
+                for (size_t i = 0; i < batch_inputs.size(); ++i) {
+                    batch_loss += backpropagate(batch_inputs[i], batch_targets[i], *loss_function);
+                }
+
+                batch_loss /= batch_inputs.size();
+                total_train_loss += batch_loss;
+                batch_count++;
+            }
+        } else {
+            if (config.shuffle_data) {
+                std::shuffle(order.begin(), order.end(), rng);
+            }
+
+            const Eigen::Index samples = static_cast<Eigen::Index>(order.size());
+            for (Eigen::Index start = 0; start < samples; start += batch_size) {
+                const Eigen::Index count = std::min(batch_size, samples - start);
+                Eigen::MatrixXd batch_inputs(train_inputs.rows(), count);
+                Eigen::MatrixXd batch_targets(train_targets.rows(), count);
+                for (Eigen::Index k = 0; k < count; ++k) {
+                    batch_inputs.col(k) = train_inputs.col(order[start + k]);
+                    batch_targets.col(k) = train_targets.col(order[start + k]);
+                }
+
+                total_train_loss += trainBatch(batch_inputs, batch_targets, *loss_function, optimizers);
+                batch_count++;
             }
-            
-            batch_loss /= batch_inputs.size();
-            total_train_loss += batch_loss;
-            batch_count++;
         }
-        
+
         total_train_loss /= batch_count;
-        
+
         // Calculate validation loss
         double validation_loss = 0.0;
         if (validation_set.size() > 0) {
-            for (size_t i = 0; i < validation_set.size(); ++i) {
-                Eigen::VectorXd pred = predict(validation_set.inputs[i]);
-                validation_loss += loss_function->forward(pred, validation_set.targets[i]);
-            }
-            validation_loss /= validation_set.size();
+            validation_loss = loss_function->forwardBatch(predictBatch(validation_inputs), validation_targets);
         }
         
         // Calculate accuracies
@@ -771,14 +884,50 @@ double NeuralNetwork::backpropagate(const Eigen::VectorXd& input, const Eigen::V
     return loss;
 }
 
+double NeuralNetwork::trainBatch(const Eigen::MatrixXd& inputs, const Eigen::MatrixXd& targets,
+                                 const LossFunction& loss_function,
+                                 std::vector<std::unique_ptr<Optimizer>>& optimizers)
+{
+    const size_t layer_count = layers_.size();
+
+    // Forward pass - keep layer inputs and pre-activations for the backward pass
+    std::vector<Eigen::MatrixXd> activations(layer_count + 1);
+    std::vector<Eigen::MatrixXd> pre_activations(layer_count);
+    activations[0] = inputs;
+    for (size_t i = 0; i < layer_count; ++i) {
+        activations[i + 1] = layers_[i]->forwardBatch(activations[i], &pre_activations[i]);
+    }
+
+    const double loss = loss_function.forwardBatch(activations[layer_count], targets);
+
+    // Gradient of the mean batch loss
+    Eigen::MatrixXd gradient = loss_function.backwardBatch(activations[layer_count], targets)
+        / static_cast<double>(inputs.cols());
+
+    Eigen::MatrixXd weight_gradients;
+    Eigen::VectorXd bias_gradients;
+    Eigen::MatrixXd input_gradients;
+    for (size_t i = layer_count; i-- > 0;) {
+        layers_[i]->backwardBatch(activations[i], pre_activations[i], gradient,
+                                  weight_gradients, bias_gradients, input_gradients);
+        layers_[i]->applyGradients(*optimizers[i], weight_gradients, bias_gradients);
+        gradient.swap(input_gradients);
+    }
+
+    return loss;
+}
+
 double NeuralNetwork::calculateAccuracy(const TrainingData& data, double threshold) const
 {
     if (data.size() == 0) return 0.0;
     
+    const Eigen::MatrixXd predictions = predictBatch(data.inputMatrix());
+    if (predictions.cols() != static_cast<Eigen::Index>(data.size())) return 0.0;
+
     int correct = 0;
     for (size_t i = 0; i < data.size(); ++i) {
-        Eigen::VectorXd prediction = const_cast<NeuralNetwork*>(this)->predict(data.inputs[i]);
-        Eigen::VectorXd target = data.targets[i];
+        const Eigen::VectorXd prediction = predictions.col(static_cast<Eigen::Index>(i));
+        const Eigen::VectorXd& target = data.targets[i];
         
         // For binary classification
         if (prediction.size() == 1 && target.size() == 1) {
@@ -55,6 +55,18 @@
  */
 class NeuralNetwork {
 public:
+    /**
+     * @brief Arithmetic precision of the batched inference path
+     *
+     * Single runs the layer GEMMs in float32, which halves the memory traffic
+     * and doubles the SIMD width; activations are still evaluated in double.
+     * Training and predict() always use double precision.
+     */
+    enum class Precision {
+        Double,
+        Single
+    };
+
     /**
      * @brief Network performance metrics
      */
@@ -113,6 +125,14 @@ public:
     size_t layerCount() const { return layers_.size(); }
     const NeuralLayer& getLayer(size_t index) const;
 
+    /**
+     * @brief Re-initialize the weights of all layers reproducibly
+     * @param seed Layer i is initialized with seed + i; 0 draws a random seed per layer
+     * @param method Initialization method applied to every layer
+     */
+    void initializeWeights(unsigned int seed,
+                           NeuralLayer::InitializationMethod method = NeuralLayer::InitializationMethod::Xavier);
+
     /**
      * @brief Forward Propagation (Main Inference)
      * @param input Input feature vector
@@ -127,6 +147,23 @@ public:
      */
     PredictionResult predictWithDetails(const Eigen::VectorXd& input);
 
+    /**
+     * @brief Batched inference, one sample per column
+     *
+     * Runs every layer as one matrix-matrix product over the batch. The columns are
+     * split into contiguous blocks evaluated on up to @p threads threads. No tutorial
+     * output or per-layer bookkeeping is produced, so this is the path to use when
+     * classifying many feature vectors (e.g. model selection over a whole data set).
+     *
+     * @param inputs Input matrix [input_size × samples]
+     * @param threads Number of worker threads (<= 1 evaluates on the calling thread)
+     * @return Output matrix [output_size × samples], empty on error
+     */
+    Eigen::MatrixXd predictBatch(const Eigen::MatrixXd& inputs, int threads = 1) const;
+
+    void setPrecision(Precision precision) { precision_ = precision; }
+    Precision precision() const { return precision_; }
+
     /**
      * @brief Neural Network Training (Claude Generated - 2025)
      */
@@ -142,6 +179,12 @@ public:
     
     /**
      * @brief Train the neural network on data
+     *
+     * Each mini-batch is propagated as a matrix (one sample per column) and the
+     * batch-averaged gradients are applied with the configured optimizer, one
+     * optimizer instance per layer. With tutorial mode enabled the original
+     * per-sample backpropagate() loop is used instead, so every step can be shown.
+     *
      * @param training_data Input/target pairs for training
      * @param config Training configuration (epochs, learning rate, etc.)
      * @return Training history with loss and accuracy curves
@@ -233,6 +276,7 @@ public:
 private:
     // Network architecture
     std::vector<std::unique_ptr<NeuralLayer>> layers_;
+    Precision precision_;
     
     // Tutorial support
     std::unique_ptr<TutorialManager> tutorial_manager_;
@@ -252,6 +296,12 @@ private:
      * @brief Internal helper functions
      */
     void updatePerformanceMetrics(double inference_time_ms);
+    Eigen::MatrixXd forwardBatch(const Eigen::MatrixXd& inputs,
+                                 const std::vector<Eigen::MatrixXf>& weights_f,
+                                 const std::vector<Eigen::VectorXf>& biases_f) const;
+    double trainBatch(const Eigen::MatrixXd& inputs, const Eigen::MatrixXd& targets,
+                      const LossFunction& loss_function,
+                      std::vector<std::unique_ptr<Optimizer>>& optimizers);
     void validateInputDimensions(const Eigen::VectorXd& input) const;
     void setError(ErrorCode code, const QString& message) const;
     void clearError() const;
@@ -30,6 +30,7 @@
 
 #include "src/core/concentrationsolver.h"
 #include "src/core/equil.h"
+#include "src/core/fixedconcentrationsolver.h"
 
 namespace {
 
@@ -56,8 +57,8 @@ std::vector<std::vector<double>> sweep(int components, int points)
 
 double g_threshold = 1e-12;
 
-// Return {ns per solve, avg iterations per solve, max mass-balance residual}.
-void benchScenario(const Scenario& s, int points, int reps, ConcentrationSolver::Method method)
+// Prints ns per solve, avg iterations per solve, max mass-balance residual; returns ns per solve.
+double benchScenario(const Scenario& s, int points, int reps, ConcentrationSolver::Method method)
 {
     ConcentrationSolver solver;
     solver.setMethod(method);
@@ -99,6 +100,51 @@ void benchScenario(const Scenario& s, int points, int reps, ConcentrationSolver:
     const long long solves = (long long)reps * points;
     std::printf("  %-22s  %8.0f ns/solve  %6.2f iter/solve  %6.1f M solves/s  resid=%.1e\n",
         s.name.c_str(), ns / solves, double(totalIter) / solves, solves / (ns / 1e9) / 1e6, worstResidual);
+    return ns / solves;
+}
+
+// Same sweep through the compile-time sized solver SpeciationEngine dispatches 2/3-component systems to.
+template <int N>
+double benchFixed(const Scenario& s, int points, int reps)
+{
+    FixedConcentrationSolver<N> solver;
+    solver.setStoichiometry(s.stoich);
+    solver.setStabilityConstants(s.beta);
+    solver.setMaxIter(1000);
+    solver.setConvergeThreshold(g_threshold);
+
+    const auto totals = sweep(s.components, points);
+    for (int i = 0; i < points; ++i) {
+        solver.setTotalConcentrations(totals[i]);
+        solver.solve();
+    }
+
+    long long totalIter = 0;
+    double worstResidual = 0.0;
+    std::vector<double> species;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) {
+        for (int i = 0; i < points; ++i) {
+            solver.setTotalConcentrations(totals[i]);
+            const typename FixedConcentrationSolver<N>::Vector& free = solver.solve();
+            totalIter += solver.LastIterations();
+            if (r == reps - 1) {
+                solver.SpeciesConcentrations(species);
+                for (int c = 0; c < N; ++c) {
+                    double bal = free(c);
+                    for (int j = 0; j < (int)s.beta.size(); ++j)
+                        bal += s.stoich(c, j) * species[j];
+                    worstResidual = std::max(worstResidual, std::abs(bal - totals[i][c]) / totals[i][c]);
+                }
+            }
+        }
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    const long long solves = (long long)reps * points;
+    std::printf("  %-22s  %8.0f ns/solve  %6.2f iter/solve  %6.1f M solves/s  resid=%.1e\n",
+        s.name.c_str(), ns / solves, double(totalIter) / solves, solves / (ns / 1e9) / 1e6, worstResidual);
+    return ns / solves;
 }
 
 Eigen::MatrixXi M(std::initializer_list<std::initializer_list<int>> rows)
@@ -143,14 +189,29 @@ int main(int argc, char** argv)
     if (argc > 3)
         methods = { ConcentrationSolver::MethodFromString(QString::fromLatin1(argv[3])) };
 
+    std::vector<double> dynamic_ns(scenarios.size(), 0.0);
     for (ConcentrationSolver::Method method : methods) {
         std::printf("--- method: %s ---\n", ConcentrationSolver::MethodToString(method).toLatin1().constData());
-        for (const Scenario& s : scenarios) {
+        for (std::size_t k = 0; k < scenarios.size(); ++k) {
+            const Scenario& s = scenarios[k];
             std::printf("  running %-20s ...\r", s.name.c_str());
-            benchScenario(s, points, reps, method);
+            const double ns = benchScenario(s, points, reps, method);
+            if (method == ConcentrationSolver::Method::LevenbergMarquardt)
+                dynamic_ns[k] = ns;
         }
     }
 
+    // Fixed-size Newton solver (what SpeciationEngine uses for 2/3 components), with the speedup over
+    // the dynamically sized LevMar run above when that was part of this invocation.
+    std::printf("--- fixed-size solver (LevMar) ---\n");
+    for (std::size_t k = 0; k < scenarios.size(); ++k) {
+        const Scenario& s = scenarios[k];
+        std::printf("  running %-20s ...\r", s.name.c_str());
+        const double ns = s.components == 2 ? benchFixed<2>(s, points, reps) : benchFixed<3>(s, points, reps);
+        if (dynamic_ns[k] > 0)
+            std::printf("  %-22s  speedup x%.2f over the dynamic solver\n", "", dynamic_ns[k] / ns);
+    }
+
     // Reference: closed-form analytic 1:1 root (the hard-coded model path).
     {
         const auto totals = sweep(2, points);
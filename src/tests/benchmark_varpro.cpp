@@ -19,16 +19,20 @@
 /*
  * Manual perf tool (not a ctest). Fits nmr_any / uvvis_any on synthetic multi-series data with the
  * classic full-vector Levenberg-Marquardt (FitSolver=LevMar) and the variable-projection solver
- * (FitSolver=VarPro), and prints wall-time and the reached SSE. VarPro removes the linear locals from
+ * (FitSolver=VarPro), and prints wall-time, model evaluations and the reached SSE. VarPro removes the linear locals from
  * the numerically-differentiated Jacobian, so its advantage grows with the number of series (each
  * series adds locals the classic solver perturbs one-by-one, re-running the speciation solve each
  * time). Build target: benchmark_varpro. Claude Generated.
+ *
+ * Other FitSolver values can be compared by naming them on the command line, e.g.
+ * "benchmark_varpro VarPro VarProBroyden BlockLevMar BlockLevMarBroyden".
  */
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QJsonObject>
 #include <QtCore/QString>
+#include <QtCore/QStringList>
 
 #include <cstdio>
 
@@ -83,11 +87,13 @@ static DataClass* makeData(int N, int series, int modelId, const QString& reacti
     return data;
 }
 
-// Median wall-time (ms) of @p reps fresh fits with the given solver; also returns the reached SSE.
-static double timeFit(int modelId, const QString& solver, const QString& reactions, QPointer<DataClass> data, int reps, double& sse)
+// Best wall-time (ms) of @p reps fresh fits with the given solver; also returns the reached SSE and
+// the model evaluations of one fit.
+static double timeFit(int modelId, const QString& solver, const QString& reactions, QPointer<DataClass> data, int reps, double& sse, qint64& evaluations)
 {
     double best = 1e300;
     sse = 0;
+    evaluations = 0;
     for (int r = 0; r < reps; ++r) {
         QSharedPointer<AbstractModel> model = CreateModel(static_cast<SupraFit::Model>(modelId), data);
         QJsonObject def;
@@ -100,11 +106,13 @@ static double timeFit(int modelId, const QString& solver, const QString& reactio
         QElapsedTimer timer;
         timer.start();
         Minimizer m(false);
+        m.setCached(false);
         m.setModel(model);
         m.Minimize();
         const double ms = timer.nsecsElapsed() / 1e6;
         best = std::min(best, ms); // best-of to suppress scheduling noise
         sse = model->SSE();
+        evaluations = m.History().evaluations;
     }
     return best;
 }
@@ -129,17 +137,38 @@ int main(int argc, char** argv)
     const QVector<int> seriesCounts = { 3, 10, 30, 60 };
     const int N = 24, reps = 5;
 
-    std::printf("\nVarPro vs classic LevMar - best of %d fits, %d points, single-threaded\n", reps, N);
-    std::printf("%-16s %7s %11s %11s %9s   %-10s\n", "case", "series", "LevMar/ms", "VarPro/ms", "speedup", "SSE(Lev|Var)");
-    std::printf("%s\n", QString(78, '-').toLocal8Bit().constData());
+    // Solvers to compare (FitSolver values), the first is the reference for the speedup:
+    //   benchmark_varpro VarPro VarProBroyden BlockLevMar BlockLevMarBroyden
+    QStringList solvers = app.arguments().mid(1);
+    if (solvers.size() < 2)
+        solvers = QStringList{ QStringLiteral("LevMar"), QStringLiteral("VarPro") };
+
+    std::printf("\n%s - best of %d fits, %d points, single-threaded\n", qPrintable(solvers.join(" vs ")), reps, N);
+    std::printf("%-16s %7s", "case", "series");
+    for (const QString& solver : solvers)
+        std::printf(" %18s", qPrintable(solver + "/ms"));
+    std::printf("   speedup vs %s, evaluations, SSE\n", qPrintable(solvers.first()));
+    std::printf("%s\n", QString(26 + 19 * solvers.size() + 9 * solvers.size() + 30, '-').toLocal8Bit().constData());
     for (const Case& c : cases) {
         for (int series : seriesCounts) {
             QPointer<DataClass> data = makeData(N, series, c.model, c.reactions, c.betas, c.localScale);
-            double sseLev = 0, sseVar = 0;
-            const double lev = timeFit(c.model, QStringLiteral("LevMar"), c.reactions, data, reps, sseLev);
-            const double var = timeFit(c.model, QStringLiteral("VarPro"), c.reactions, data, reps, sseVar);
-            std::printf("%-16s %7d %11.2f %11.2f %8.2fx   %.1e | %.1e\n",
-                c.name, series, lev, var, lev / var, sseLev, sseVar);
+            QVector<double> ms, sse(solvers.size());
+            QVector<qint64> evaluations(solvers.size());
+            for (int i = 0; i < solvers.size(); ++i)
+                ms << timeFit(c.model, solvers[i], c.reactions, data, reps, sse[i], evaluations[i]);
+            std::printf("%-16s %7d", c.name, series);
+            for (double time : ms)
+                std::printf(" %18.2f", time);
+            std::printf("  ");
+            for (int i = 1; i < solvers.size(); ++i)
+                std::printf(" %.2fx", ms[0] / ms[i]);
+            std::printf("  ");
+            for (qint64 count : evaluations)
+                std::printf(" %8lld", static_cast<long long>(count));
+            std::printf("  ");
+            for (double value : sse)
+                std::printf(" %.1e", value);
+            std::printf("\n");
             delete data;
         }
         std::printf("\n");
@@ -17,7 +17,7 @@
  *
  */
 
-/* The `BC50IntegrationPoints` setting lets the operator trade BC50 accuracy for Monte-Carlo speed.
+/* The `BC50Tolerance` setting lets the operator trade BC50 accuracy for Monte-Carlo speed.
  * A setting like that is only safe if the accuracy it buys is pinned somewhere, so this test
  * measures it against an independent high-accuracy reference rather than against stored numbers.
  *
@@ -52,28 +52,28 @@ private:
         return 1.0 / (2.0 * sum * h / 3.0);
     }
 
-    static void setPoints(int points) { qApp->setProperty("BC50IntegrationPoints", points); }
+    static void setExponent(int exponent) { qApp->setProperty("BC50Tolerance", exponent); }
 
 private slots:
 
-    void cleanup() { setPoints(10000); }
+    void cleanup() { setExponent(-12); }
 
-    /*! Accuracy actually delivered at each density the tooltip advertises. Tolerances are one
-     *  order of magnitude looser than measured, so this fails on a real regression, not on noise. */
-    void accuracyPerDensity_data()
+    /*! Accuracy actually delivered at each requested tolerance. The bounds are one order of
+     *  magnitude looser than measured, so this fails on a real regression, not on noise. */
+    void accuracyPerTolerance_data()
     {
-        QTest::addColumn<int>("points");
+        QTest::addColumn<int>("exponent");
         QTest::addColumn<double>("tolerance");
-        QTest::newRow("100 points") << 100 << 1e-6;
-        QTest::newRow("1000 points") << 1000 << 1e-9;
-        QTest::newRow("10000 points (default)") << 10000 << 1e-11;
+        QTest::newRow("1e-6") << -6 << 1e-6;
+        QTest::newRow("1e-9") << -9 << 1e-9;
+        QTest::newRow("1e-12 (default)") << -12 << 1e-11;
     }
 
-    void accuracyPerDensity()
+    void accuracyPerTolerance()
     {
-        QFETCH(int, points);
+        QFETCH(int, exponent);
         QFETCH(double, tolerance);
-        setPoints(points);
+        setExponent(exponent);
 
         struct Case { double lgK11, lgK12; };
         const Case cases[] = { { 4.0, 3.0 }, { 2.0, 1.5 }, { 6.0, 2.0 }, { 3.5, 4.2 } };
@@ -82,41 +82,45 @@ private slots:
             const double ref = reference(c.lgK11, c.lgK12);
             const double got = BC50::ItoII::BC50(c.lgK11, c.lgK12);
             const double error = std::abs(got - ref) / ref;
-            qInfo().noquote() << QString("  %1 pts, lgK11=%2 lgK12=%3: rel. error %4")
-                                     .arg(points).arg(c.lgK11).arg(c.lgK12).arg(error, 0, 'e', 2);
+            qInfo().noquote() << QString("  1e%1, lgK11=%2 lgK12=%3: rel. error %4")
+                                     .arg(exponent).arg(c.lgK11).arg(c.lgK12).arg(error, 0, 'e', 2);
             QVERIFY2(error < tolerance,
-                qPrintable(QString("BC50 at %1 points: relative error %2 exceeds %3")
-                        .arg(points).arg(error, 0, 'e', 2).arg(tolerance, 0, 'e', 1)));
+                qPrintable(QString("BC50 at 1e%1: relative error %2 exceeds %3")
+                        .arg(exponent).arg(error, 0, 'e', 2).arg(tolerance, 0, 'e', 1)));
         }
     }
 
     /*! The setting must actually reach the integration - a silently ignored control is worse than
-     *  no control. 20 panels is coarse enough that the result has to differ from the default. */
+     *  no control. The adaptive rule often meets a loose tolerance with its first estimate already,
+     *  so the result itself cannot show it; the tolerance it is asked for must, and the coarse
+     *  result has to stay within that tolerance. */
     void settingIsHonoured()
     {
-        setPoints(10000);
-        const double fine = BC50::ItoII::BC50(2.0, 1.5);
-        setPoints(20);
-        const double coarse = BC50::ItoII::BC50(2.0, 1.5);
-        QVERIFY2(std::abs(coarse - fine) / fine > 1e-9,
-            "BC50IntegrationPoints had no effect on the result");
+        setExponent(-12);
+        const double fine = BC50::IntegrationTolerance();
+        setExponent(-4);
+        const double coarse = BC50::IntegrationTolerance();
+        QVERIFY2(coarse > fine * 1e3, "BC50Tolerance had no effect on the tolerance");
+
+        const double ref = reference(2.0, 1.5);
+        QVERIFY(std::abs(BC50::ItoII::BC50(2.0, 1.5) - ref) / ref < coarse);
     }
 
     /*! An unset or absurd value must fall back to the default rather than divide by zero - the CLI
      *  and these tests run without the settings registry ever being applied. */
     void fallsBackWhenUnset()
     {
-        const double expected = BC50::ItoII::BC50(2.0, 1.5); // at the default 10000
+        const double expected = BC50::ItoII::BC50(2.0, 1.5); // at the default 1e-12
 
-        qApp->setProperty("BC50IntegrationPoints", QVariant());
+        qApp->setProperty("BC50Tolerance", QVariant());
         const double unset = BC50::ItoII::BC50(2.0, 1.5);
         QVERIFY(std::isfinite(unset));
         QCOMPARE(unset, expected);
 
-        setPoints(0);
-        const double zero = BC50::ItoII::BC50(2.0, 1.5);
-        QVERIFY2(std::isfinite(zero), "a zero point count must not produce an infinite step");
-        QCOMPARE(zero, expected);
+        setExponent(3);
+        const double positive = BC50::ItoII::BC50(2.0, 1.5);
+        QVERIFY2(std::isfinite(positive), "a tolerance above 1 must not be used");
+        QCOMPARE(positive, expected);
     }
 };
 
@@ -171,6 +171,26 @@ private slots:
         QVERIFY(BC50::FromSpeciation(s, { 4.0 }) < 0);
         QVERIFY(BC50::FromSpeciation(s, { 4.0, 6.0, 7.0 }) < 0);
     }
+
+    /*! The batched Monte Carlo path splits the samples over the threads of its context; every
+     *  sample must come back in its own slot with the value of the single-sample call, invalid ones
+     *  negative. */
+    void samplesMatchSingleEvaluation()
+    {
+        const Eigen::MatrixXi s = stoich({ { 1, 1 }, { 2, 1 }, { 1, 2 } });
+        QVector<QVector<qreal>> samples;
+        for (int i = 0; i < 200; ++i)
+            samples << QVector<qreal>{ 4.0 + 0.01 * i, 6.5 - 0.005 * i, 7.0 + 0.002 * i };
+        samples[17] = { 4.0, 6.0 };
+
+        const QVector<qreal> values = BC50::FromSpeciationSamples(s, samples, ExecutionContext(4));
+        QCOMPARE(values.size(), samples.size());
+        QVERIFY(values[17] < 0);
+        for (int i = 0; i < samples.size(); ++i) {
+            if (i != 17)
+                QCOMPARE(values[i], BC50::FromSpeciation(s, samples[i]));
+        }
+    }
 };
 
 QTEST_MAIN(BC50SpeciationTest)
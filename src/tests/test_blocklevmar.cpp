@@ -0,0 +1,187 @@
+/*
+ * SupraFit - Levenberg-Marquardt with the block structure of the Jacobian
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * BlockLevMar eliminates the locals of every series by a Schur complement. A model that reports its
+ * series structure has to be fitted along that structure - not through the dense fallback - and
+ * has to reach the optimum of the classic solver.
+ */
+
+#include <cmath>
+
+#include <QtTest/QtTest>
+#include <QtCore/QJsonObject>
+
+#include <Eigen/Dense>
+
+#include "src/core/libmath.h"
+#include "src/core/minimizer.h"
+#include "src/core/models/AbstractModel.h"
+#include "src/core/models/dataclass.h"
+#include "src/core/models/datatable.h"
+#include "src/core/models/models.h"
+#include "src/global.h"
+
+class TestBlockLevMar : public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr int N = 16;
+    static constexpr double A0 = 1e-3;
+    static constexpr int Series = 8;
+
+    static QJsonObject strOption(const QString& value)
+    {
+        QJsonObject o;
+        o["value"] = value;
+        return o;
+    }
+
+    static QSharedPointer<AbstractModel> createModel(DataClass* data, const QString& solver)
+    {
+        QSharedPointer<AbstractModel> model = CreateModel(SupraFit::nmr_any, data);
+        QJsonObject def;
+        def["Reactions"] = strOption(QStringLiteral("A + B <=> AB\nA + 2 B <=> AB2"));
+        model->DefineModel(def);
+        QJsonObject config = model->getOptimizerConfig();
+        config["FitSolver"] = solver;
+        model->setOptimizerConfig(config);
+        return model;
+    }
+
+    // Host-constant / guest-titrated nmr_any 1:1/1:2 data with Series signals, at known constants.
+    static DataClass* makeData(const QList<double>& betas)
+    {
+        Eigen::MatrixXd indep(N, 2);
+        Eigen::MatrixXd dep = Eigen::MatrixXd::Zero(N, Series);
+        for (int i = 0; i < N; ++i) {
+            indep(i, 0) = A0;
+            indep(i, 1) = 3.0 * A0 * i / (N - 1);
+        }
+        DataClass* data = new DataClass();
+        data->setIndependentTable(new DataTable(indep));
+        data->setDataType(DataClassPrivate::Table);
+        data->setSimulateDependent(Series);
+        data->setDependentTable(new DataTable(dep));
+        data->setDataBegin(0);
+        data->setDataEnd(N);
+
+        QSharedPointer<AbstractModel> truth = createModel(data, QStringLiteral("LevMar"));
+        truth->InitialGuess();
+        for (int k = 0; k < betas.size(); ++k)
+            truth->setGlobalParameter(betas[k], k);
+        for (int s = 0; s < Series; ++s)
+            for (int p = 0; p < truth->LocalParameterSize(); ++p)
+                truth->setLocalParameter(9.0 * (1.0 - 0.1 * p - 0.07 * s), p, s);
+        truth->Calculate();
+        data->setDependentTable(new DataTable(truth->ModelTable()->Table()));
+        return data;
+    }
+
+private slots:
+    // nmr_any reports one block per series, each holding the locals of the series and its N residuals.
+    void reportsSeriesBlocks()
+    {
+        const QList<double> betas{ 3.8, 5.9 };
+        DataClass* data = makeData(betas);
+        QSharedPointer<AbstractModel> model = createModel(data, QStringLiteral("BlockLevMar"));
+        model->InitialGuess();
+        model->Calculate();
+
+        model->CollectOptimizationParameters();
+        QVector<int> parameterBlock, residualBlock;
+        QVERIFY(model->JacobianBlocks(parameterBlock, residualBlock));
+        QCOMPARE(parameterBlock.size(), model->Parameter());
+        QCOMPARE(residualBlock.size(), model->getCalculatedAbsoluteErrors().size());
+        QCOMPARE(parameterBlock.count(-1), betas.size());
+        for (int s = 0; s < Series; ++s)
+            QCOMPARE(residualBlock.count(s), N);
+        delete data;
+    }
+
+    void sameOptimumAsLevMar_data()
+    {
+        QTest::addColumn<QString>("solver");
+        QTest::newRow("BlockLevMar") << QStringLiteral("BlockLevMar");
+        QTest::newRow("BlockLevMarBroyden") << QStringLiteral("BlockLevMarBroyden");
+    }
+
+    // The fit eliminates all Series blocks - it must not have fallen back to the dense problem - and
+    // ends at the optimum of the classic solver.
+    void sameOptimumAsLevMar()
+    {
+        QFETCH(QString, solver);
+        const QList<double> betas{ 3.8, 5.9 };
+        DataClass* data = makeData(betas);
+
+        QSharedPointer<AbstractModel> reference = createModel(data, QStringLiteral("LevMar"));
+        reference->InitialGuess();
+        Minimizer minimizer(false);
+        minimizer.setCached(false);
+        minimizer.setModel(reference);
+        minimizer.Minimize();
+        const double sseLev = reference->SSE();
+
+        QSharedPointer<AbstractModel> model = createModel(data, solver);
+        model->InitialGuess();
+        model->Calculate();
+        QVector<qreal> parameter = model->CollectOptimizationParameters();
+        QVector<double> sse;
+        QVector<QVector<double>> history;
+        int blocks = -1;
+        BlockLevMarFit(model, parameter, sse, history, nullptr, FitProgress(), &blocks);
+        QCOMPARE(blocks, Series);
+
+        const double sseBlock = model->SSE();
+        const double floor = 1e-10 * data->DependentModel()->Table().squaredNorm();
+        qInfo().noquote() << QString("[%1] SSE LevMar=%2 block=%3 blocks=%4").arg(solver).arg(sseLev, 0, 'g', 4).arg(sseBlock, 0, 'g', 4).arg(blocks);
+        QVERIFY(std::isfinite(sseBlock));
+        QVERIFY2(sseBlock <= qMax(sseLev, floor) * 1.05 + 1e-12,
+            qPrintable(QString("%1 SSE %2 worse than LevMar %3").arg(solver).arg(sseBlock).arg(sseLev)));
+        for (int k = 0; k < betas.size() && sseBlock < floor; ++k)
+            QVERIFY2(std::abs(model->GlobalParameter(k) - betas[k]) < 1e-2,
+                qPrintable(QString("global %1: %2 %3 did not recover truth %4").arg(k).arg(solver).arg(model->GlobalParameter(k)).arg(betas[k])));
+        delete data;
+    }
+
+    // The Broyden updates replace most finite-difference Jacobians, each of which costs one evaluation
+    // per global and one per local of the widest block: the fit needs about half the evaluations.
+    void broydenHalvesEvaluations()
+    {
+        DataClass* data = makeData({ 3.8, 5.9 });
+        qint64 counts[2] = { 0, 0 };
+        const QString solvers[2] = { QStringLiteral("BlockLevMar"), QStringLiteral("BlockLevMarBroyden") };
+        for (int i = 0; i < 2; ++i) {
+            QSharedPointer<AbstractModel> model = createModel(data, solvers[i]);
+            model->InitialGuess();
+            Minimizer minimizer(false);
+            minimizer.setCached(false);
+            minimizer.setModel(model);
+            minimizer.Minimize();
+            counts[i] = minimizer.History().evaluations;
+        }
+        qInfo().noquote() << QString("[broyden] evaluations BlockLevMar=%1 BlockLevMarBroyden=%2").arg(counts[0]).arg(counts[1]);
+        QVERIFY(counts[0] > 0);
+        QVERIFY2(counts[1] < 0.75 * counts[0],
+            qPrintable(QString("BlockLevMarBroyden took %1 evaluations, BlockLevMar %2").arg(counts[1]).arg(counts[0])));
+        delete data;
+    }
+};
+
+QTEST_MAIN(TestBlockLevMar)
+#include "test_blocklevmar.moc"
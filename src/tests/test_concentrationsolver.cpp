@@ -31,6 +31,7 @@
 
 #include "src/core/concentrationsolver.h"
 #include "src/core/equil.h"
+#include "src/core/speciationengine.h"
 
 class TestBFGSSolver : public QObject {
     Q_OBJECT
@@ -204,6 +205,80 @@ private slots:
             }
         }
     }
+
+    /** SpeciationEngine dispatches 2- and 3-component points to FixedConcentrationSolver<N>. Over a
+     *  sweep that starts with an absent component (dynamic fallback) it must reproduce the dynamic
+     *  solver's free and species concentrations and sensitivities, and report which path it took. Both
+     *  write into the caller's buffers, which keep their storage from point to point. */
+    void test_fixed_size_dispatch_matches_dynamic()
+    {
+        const QStringList reactions = { "A + B <=> AB\n2 A + B <=> A2B", "A + B <=> AB\nA + C <=> AC" };
+        for (const QString& text : reactions) {
+            SpeciationEngine fixed, dynamic;
+            QVERIFY(fixed.setReactions(text));
+            QVERIFY(dynamic.setReactions(text));
+            dynamic.setFixedSizeSolver(false);
+
+            std::vector<double> beta(fixed.SpeciesCount());
+            for (int j = 0; j < fixed.SpeciesCount(); ++j)
+                beta[j] = std::pow(10.0, 4.0 + 2.5 * j);
+            fixed.setStabilityConstants(beta);
+            dynamic.setStabilityConstants(beta);
+
+            const int n = fixed.ComponentCount();
+            std::vector<double> a(n), b(n);
+            const double* a_storage = a.data();
+            const double* b_storage = b.data();
+            for (int point = 0; point < 12; ++point) {
+                std::vector<double> totals(n, 1e-3);
+                for (int c = 1; c < n; ++c)
+                    totals[c] = 2.5e-4 * point / c; // point 0: only the host is present
+                fixed.solve(totals, point, a);
+                dynamic.solve(totals, point, b);
+                QVERIFY(a.data() == a_storage && b.data() == b_storage);
+                QVERIFY(a == fixed.FreeConcentrations());
+                QCOMPARE(fixed.LastSolveFixedSize(), point > 0);
+                QVERIFY(!dynamic.LastSolveFixedSize());
+                QVERIFY(fixed.Converged());
+                for (int c = 0; c < n; ++c)
+                    QVERIFY2(relError(a[c], b[c]) < 1e-9, qPrintable(QString("%1: free[%2] at point %3").arg(text).arg(c).arg(point)));
+                for (int j = 0; j < fixed.SpeciesCount(); ++j)
+                    QVERIFY(std::abs(fixed.SpeciesConcentrations()[j] - dynamic.SpeciesConcentrations()[j])
+                        <= 1e-9 * std::abs(dynamic.SpeciesConcentrations()[j]) + 1e-300);
+                QVERIFY((fixed.sensitivityMatrix() - dynamic.sensitivityMatrix()).cwiseAbs().maxCoeff() < 1e-8);
+            }
+        }
+    }
+
+    /** Continuation (totals tangent on the first sweep, ln β sensitivity on later ones) must land on the
+     *  same solution as the plain warm start, in fewer Newton iterations over a fit-like sequence of
+     *  parameter sets. */
+    void test_continuation_saves_iterations()
+    {
+        const QString text = "A + B <=> AB\n2 A + B <=> A2B";
+        SpeciationEngine predicted, plain;
+        QVERIFY(predicted.setReactions(text));
+        QVERIFY(plain.setReactions(text));
+        plain.setContinuation(false);
+
+        long long iter_predicted = 0, iter_plain = 0;
+        for (int evaluation = 0; evaluation < 5; ++evaluation) {
+            const std::vector<double> beta = { std::pow(10.0, 4.0 + 0.3 * evaluation), std::pow(10.0, 7.0 - 0.2 * evaluation) };
+            predicted.setStabilityConstants(beta);
+            plain.setStabilityConstants(beta);
+            for (int point = 0; point < 32; ++point) {
+                const std::vector<double> totals = { 1e-3, 2e-3 * point / 32.0 };
+                const std::vector<double> a = predicted.solve(totals, point);
+                iter_predicted += predicted.LastIterations();
+                const std::vector<double> b = plain.solve(totals, point);
+                iter_plain += plain.LastIterations();
+                QVERIFY(predicted.Converged());
+                for (int c = 0; c < 2; ++c)
+                    QVERIFY2(relError(a[c], b[c]) < 1e-9, qPrintable(QString("free[%1] at point %2, evaluation %3").arg(c).arg(point).arg(evaluation)));
+            }
+        }
+        QVERIFY2(iter_predicted < iter_plain, qPrintable(QString("continuation %1 vs plain %2 iterations").arg(iter_predicted).arg(iter_plain)));
+    }
 };
 
 QTEST_MAIN(TestBFGSSolver)
@@ -16,6 +16,7 @@
 #include <QtCore/QDebug>
 
 #include "src/core/models/datatable.h"
+#include "src/core/randomstream.h"
 
 class TestDataTable : public QObject
 {
@@ -60,6 +61,11 @@ private slots:
     void testInvalidJsonHandling();
     void testMemoryManagement();
 
+    // Counter-based random streams for resampling
+    void testPhiloxKnownAnswer();
+    void testRandomStreamReproducible();
+    void testPrepareMCWithStream();
+
 private:
     DataTable* createTestTable(int rows, int cols);
     void fillTestData(DataTable* table);
@@ -511,6 +517,90 @@ void TestDataTable::testMemoryManagement()
     QVERIFY(true);
 }
 
+void TestDataTable::testPhiloxKnownAnswer()
+{
+    // Known-answer vectors of the Random123 reference implementation
+    Philox::Counter result = Philox::Block({ { 0, 0, 0, 0 } }, { { 0, 0 } });
+    QCOMPARE(result[0], quint32(0x6627e8d5));
+    QCOMPARE(result[1], quint32(0xe169c58d));
+    QCOMPARE(result[2], quint32(0xbc57ac4c));
+    QCOMPARE(result[3], quint32(0x9b00dbd8));
+
+    result = Philox::Block({ { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 } }, { { 0xa4093822, 0x299f31d0 } });
+    QCOMPARE(result[0], quint32(0xd16cfe09));
+    QCOMPARE(result[1], quint32(0x94fdcceb));
+    QCOMPARE(result[2], quint32(0x5001e420));
+    QCOMPARE(result[3], quint32(0x24126ea1));
+}
+
+void TestDataTable::testRandomStreamReproducible()
+{
+    // Same key -> same numbers, whatever was drawn elsewhere in between
+    RandomStream first(4711, RandomJob::MonteCarlo, 12);
+    QVector<double> reference;
+    for (int i = 0; i < 9; ++i)
+        reference << first.Normal();
+
+    RandomStream other(4711, RandomJob::MonteCarlo, 13);
+    other.Normal();
+    RandomStream again(4711, RandomJob::MonteCarlo, 12);
+    for (int i = 0; i < 9; ++i)
+        QCOMPARE(again.Normal(), reference[i]);
+
+    // Neighbouring samples and jobs are different streams
+    RandomStream job(4711, RandomJob::CrossValidation, 12);
+    RandomStream sample(4711, RandomJob::MonteCarlo, 13);
+    QVERIFY(job.Normal() != reference[0]);
+    QVERIFY(sample.Normal() != reference[0]);
+
+    // Moments of the normal draws and range of the bounded integers
+    RandomStream stream(1, RandomJob::MonteCarlo, 0);
+    double sum = 0, squares = 0;
+    const int n = 100000;
+    for (int i = 0; i < n; ++i) {
+        const double x = stream.Normal(1, 2);
+        sum += x;
+        squares += x * x;
+    }
+    const double mean = sum / n;
+    QVERIFY(qAbs(mean - 1) < 0.05);
+    QVERIFY(qAbs(squares / n - mean * mean - 4) < 0.1);
+
+    QVector<int> counts(7, 0);
+    for (int i = 0; i < 7000; ++i)
+        counts[stream.Bounded(7)]++;
+    for (int count : counts)
+        QVERIFY(count > 800 && count < 1200);
+}
+
+void TestDataTable::testPrepareMCWithStream()
+{
+    DataTable* table = createTestTable(6, 3);
+    fillTestData(table);
+
+    RandomStream stream(99, RandomJob::MonteCarlo, 5);
+    QPointer<DataTable> noisy = table->PrepareMC(QVector<double>() << 0.5, stream, QVector<int>() << 1 << 0 << 1);
+    RandomStream repeated(99, RandomJob::MonteCarlo, 5);
+    QPointer<DataTable> again = table->PrepareMC(QVector<double>() << 0.5, repeated, QVector<int>() << 1 << 0 << 1);
+
+    QVERIFY(compareDataTables(noisy, again));
+    for (int i = 0; i < table->rowCount(); ++i) {
+        QCOMPARE(noisy->data(i, 1), table->data(i, 1));
+        QVERIFY(noisy->data(i, 0) != table->data(i, 0));
+    }
+
+    RandomStream bootstrap(99, RandomJob::MonteCarlo, 6);
+    const QVector<qreal> residuals = { -1, 1 };
+    QPointer<DataTable> resampled = table->PrepareBootStrap(bootstrap, residuals);
+    for (int i = 0; i < table->rowCount(); ++i)
+        QCOMPARE(qAbs(resampled->data(i, 2) - table->data(i, 2)), 1.0);
+
+    delete noisy;
+    delete again;
+    delete resampled;
+    delete table;
+}
+
 // Helper methods implementation
 DataTable* TestDataTable::createTestTable(int rows, int cols)
 {
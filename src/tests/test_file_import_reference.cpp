@@ -14,6 +14,7 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryDir>
 #include <QtCore/QDebug>
 
 #include "src/core/filehandler.h"
@@ -33,6 +34,8 @@ private slots:
     void testReferenceFileExists();
     void testFileLoading();
     void testDataDimensions();
+    void testSeparatedParsing();
+    void testChunkedImport();
 
     // Phase 2-3: DataClass and Structure
     void testDataClassCreation();
@@ -153,6 +156,68 @@ void TestFileImportReference::testDataDimensions()
     qDebug() << "✓ Sample data value validated: chemical shift =" << firstShift;
 }
 
+void TestFileImportReference::testSeparatedParsing()
+{
+    // Test 2.4: header, comment lines, quotes and decimal commas
+    FileHandler semicolon;
+    QVERIFY(semicolon.setFileContent("\"conc\";\"shift\"\n1,5; 2,25\n# comment\n3;\"4\"\n"));
+    QPointer<DataTable> data = semicolon.getData();
+    QVERIFY(data);
+    QCOMPARE(data->rowCount(), 3);
+    QCOMPARE(data->columnCount(), 2);
+    QCOMPARE(data->header(), QStringList() << "conc"
+                                           << "shift");
+    QCOMPARE(data->data(0, 0), 1.5);
+    QCOMPARE(data->data(0, 1), 2.25);
+    // The comment line in between stays a row of zeros, as it always did
+    QCOMPARE(data->data(1, 0), 0.0);
+    QCOMPARE(data->data(2, 1), 4.0);
+
+    FileHandler blanks;
+    QVERIFY(blanks.setFileContent("\n1\t2  3\r\n4 5\n\n"));
+    data = blanks.getData();
+    QCOMPARE(data->rowCount(), 2);
+    QCOMPARE(data->columnCount(), 3);
+    QCOMPARE(data->data(0, 2), 3.0);
+    QCOMPARE(data->data(1, 2), 0.0);
+
+    // A line of letters only is no table
+    FileHandler text;
+    QVERIFY(!text.setFileContent("1 2\nabc\n3 4\n"));
+}
+
+void TestFileImportReference::testChunkedImport()
+{
+    // Test 2.5: files above 1 MB are parsed in chunks; the result must not depend on the cut
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString name = dir.filePath("large.dat");
+    QFile file(name);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    const int rows = 120000;
+    file.write("x y1 y2\n");
+    for (int i = 0; i < rows; ++i)
+        file.write(QByteArray::number(i) + "\t" + QByteArray::number(i * 0.5) + "\t" + QByteArray::number(-i * 1e-3, 'g', 12) + "\n");
+    file.close();
+    QVERIFY(QFileInfo(name).size() > 2 * 1024 * 1024);
+
+    FileHandler handler(name);
+    handler.LoadFile();
+    QVERIFY(handler.FileSupported());
+    QPointer<DataTable> data = handler.getData();
+    QVERIFY(data);
+    QCOMPARE(data->rowCount(), rows);
+    QCOMPARE(data->columnCount(), 3);
+    QCOMPARE(data->header(), QStringList() << "x"
+                                           << "y1"
+                                           << "y2");
+    for (int i = 0; i < rows; i += 997) {
+        QCOMPARE(data->data(i, 0), double(i));
+        QCOMPARE(data->data(i, 1), i * 0.5);
+        QCOMPARE(data->data(i, 2), -i * 1e-3);
+    }
+}
+
 // ============================================================================
 // Phase 2-3: DataClass Creation and Structure Setup
 // ============================================================================
@@ -24,6 +24,8 @@
 #include <QtCore/QFileInfo>
 #include <QtCore/QElapsedTimer>
 
+#include "src/core/resultsink.h"
+
 #include "test_utils.h"
 
 class TestFileOperations : public QObject
@@ -89,6 +91,9 @@ private slots:
     void testFileRecoveryAfterInterruption();
     void testMemoryMappedFileOperations();
 
+    // Result stream round trip
+    void testResultSinkStreaming();
+
 private:
     QTemporaryDir* m_tempDir;
     
@@ -1031,6 +1036,46 @@ QString TestFileOperations::createComplexStructureFile()
     return filePath;
 }
 
+void TestFileOperations::testResultSinkStreaming()
+{
+    const QString file = m_tempDir->filePath("results.ndjson");
+    QVERIFY(ResultSink::isStream(file));
+    QVERIFY(!ResultSink::isStream(m_tempDir->filePath("results.json")));
+
+    {
+        ResultSink sink(file);
+        QVERIFY(sink.isOpen());
+        for (int i = 0; i < 100; ++i)
+            QVERIFY(sink.Append(QJsonObject{ { "dataset", i }, { "result", QJsonObject{ { "SSE", 0.5 * i } } } }));
+        QCOMPARE(sink.Records(), qint64(100));
+    }
+    {
+        ResultSink sink(file, true);
+        QVERIFY(sink.Append(QJsonObject{ { "dataset", 100 } }));
+    }
+
+    // A damaged line is skipped, the rest stays readable
+    QFile damaged(file);
+    QVERIFY(damaged.open(QIODevice::Append));
+    damaged.write("{\"dataset\": 101,\n");
+    damaged.close();
+
+    int expected = 0;
+    qint64 read = ResultSink::ForEach(file, [&expected](const QJsonObject& record) {
+        if (record["dataset"].toInt() != expected)
+            return false;
+        ++expected;
+        return true;
+    });
+    QCOMPARE(read, qint64(101));
+    QCOMPARE(expected, 101);
+
+    read = ResultSink::ForEach(file, [](const QJsonObject& record) { return record["dataset"].toInt() < 9; });
+    QCOMPARE(read, qint64(10));
+
+    QCOMPARE(ResultSink::ForEach(m_tempDir->filePath("missing.ndjson"), [](const QJsonObject&) { return true; }), qint64(-1));
+}
+
 #include "test_file_operations.moc"
 
 QTEST_MAIN(TestFileOperations)
\ No newline at end of file
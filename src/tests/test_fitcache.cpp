@@ -0,0 +1,163 @@
+/*
+ * SupraFit - persistent cache of converged fits
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The FitCache is used once the application enables it with "FitCache", by every Minimizer that does
+ * not opt out with setCached(false). A repeated fit of the same model, data and start parameters is
+ * then taken from disk; any change of the inputs fits again.
+ */
+
+#include <cmath>
+
+#include <QtTest/QtTest>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStandardPaths>
+
+#include <Eigen/Dense>
+
+#include "src/core/fitcache.h"
+#include "src/core/minimizer.h"
+#include "src/core/models/AbstractModel.h"
+#include "src/core/models/dataclass.h"
+#include "src/core/models/datatable.h"
+#include "src/core/models/models.h"
+#include "src/global.h"
+
+class TestFitCache : public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr int N = 16;
+    static constexpr double A0 = 1e-3;
+
+    // Host-constant / guest-titrated nmr_ItoI data with two series, synthesised at known constants.
+    static DataClass* makeData()
+    {
+        const int series = 2;
+        Eigen::MatrixXd indep(N, 2);
+        Eigen::MatrixXd dep = Eigen::MatrixXd::Zero(N, series);
+        for (int i = 0; i < N; ++i) {
+            indep(i, 0) = A0;
+            indep(i, 1) = 3.0 * A0 * i / (N - 1);
+        }
+        DataClass* data = new DataClass();
+        data->setIndependentTable(new DataTable(indep));
+        data->setDataType(DataClassPrivate::Table);
+        data->setSimulateDependent(series);
+        data->setDependentTable(new DataTable(dep));
+        data->setDataBegin(0);
+        data->setDataEnd(N);
+
+        QSharedPointer<AbstractModel> truth = CreateModel(SupraFit::nmr_ItoI, data);
+        truth->InitialGuess();
+        truth->setGlobalParameter(4.0, 0);
+        for (int s = 0; s < series; ++s)
+            for (int p = 0; p < truth->LocalParameterSize(); ++p)
+                truth->setLocalParameter(9.0 * (1.0 - 0.2 * p - 0.1 * s), p, s);
+        truth->Calculate();
+        data->setDependentTable(new DataTable(truth->ModelTable()->Table()));
+        return data;
+    }
+
+    // Fits a fresh model and returns the number of iterations, 0 if the result came from the cache.
+    // A Minimizer that is not told otherwise keeps its default.
+    static int minimize(DataClass* data, bool minimizerCached, bool configCached, qreal& sse)
+    {
+        QSharedPointer<AbstractModel> model = CreateModel(SupraFit::nmr_ItoI, data);
+        QJsonObject config = model->getOptimizerConfig();
+        config["FitCache"] = configCached;
+        model->setOptimizerConfig(config);
+        model->InitialGuess();
+        Minimizer minimizer(false);
+        if (!minimizerCached)
+            minimizer.setCached(false);
+        minimizer.setModel(model);
+        minimizer.Minimize();
+        sse = model->SSE();
+        return minimizer.History().sse.size();
+    }
+
+private slots:
+    void initTestCase()
+    {
+        QStandardPaths::setTestModeEnabled(true);
+    }
+
+    void cleanup()
+    {
+        FitCache::instance().Clear();
+        qApp->setProperty("FitCache", QVariant());
+        qApp->setProperty("FitCacheSize", QVariant());
+    }
+
+    // Nothing is cached before the application enables the cache, and a Minimizer can opt out.
+    void optOut()
+    {
+        FitCache& cache = FitCache::instance();
+        cache.Clear();
+        QVERIFY(!cache.isEnabled());
+
+        DataClass* data = makeData();
+        qreal sse = 0;
+        QVERIFY(minimize(data, true, true, sse) > 0);
+        QCOMPARE(cache.Size(), 0);
+
+        qApp->setProperty("FitCache", true);
+        QVERIFY(minimize(data, false, true, sse) > 0);
+        QCOMPARE(cache.Size(), 0);
+        QVERIFY(minimize(data, false, true, sse) > 0);
+        delete data;
+    }
+
+    // A repeated fit is taken from the cache; "FitCache" = false in the optimizer config or changed
+    // data fit again.
+    void repeatedFitIsCached()
+    {
+        FitCache& cache = FitCache::instance();
+        cache.Clear();
+        qApp->setProperty("FitCache", true);
+        QVERIFY(cache.isEnabled());
+
+        DataClass* data = makeData();
+        qreal fitted = 0, cached = 0, refitted = 0;
+        QVERIFY(minimize(data, true, true, fitted) > 0);
+        QVERIFY(cache.Size() > 0);
+        QCOMPARE(minimize(data, true, true, cached), 0);
+        QVERIFY(qAbs(cached - fitted) <= 1e-12 * (1 + fitted));
+        QVERIFY(minimize(data, true, false, refitted) > 0);
+
+        data->DependentModel()->data(3, 1) += 1e-3;
+        QVERIFY(minimize(data, true, true, refitted) > 0);
+
+        cache.Clear();
+        QCOMPARE(cache.Size(), 0);
+        delete data;
+    }
+
+    // The size limit follows "FitCacheSize" after the cache was first created.
+    void sizeFollowsSetting()
+    {
+        qApp->setProperty("FitCacheSize", 16);
+        QCOMPARE(FitCache::instance().MaxSize(), qint64(16) * 1024 * 1024);
+        qApp->setProperty("FitCacheSize", 1);
+        QCOMPARE(FitCache::instance().MaxSize(), qint64(1) * 1024 * 1024);
+    }
+};
+
+QTEST_MAIN(TestFitCache)
+#include "test_fitcache.moc"
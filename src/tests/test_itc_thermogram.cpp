@@ -23,6 +23,7 @@
 #include <cmath>
 
 #include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
 #include <QtTest/QSignalSpy>
 #include <QtTest/QtTest>
 
@@ -31,6 +32,7 @@
 #include "libpeakpick/peakpick.h"
 
 #include "src/core/itcprocessor.h"
+#include "src/core/seriesdecimation.h"
 #include "src/core/models/datatable.h"
 #include "src/core/thermogramhandler.h"
 #include "src/core/toolset.h"
@@ -228,6 +230,67 @@ private slots:
         QCOMPARE(static_cast<int>(peaks.size()), peak_count);
     }
 
+    /*! \brief The mapped, from_chars based loader reads the same trace the line-wise QString parser did.
+     *
+     * The reference is rebuilt here the slow way - one QString::split per line - so any drift in
+     * the byte-level tokenizer (CRLF, a trailing field, the '@' markers) shows up as a mismatch. */
+    void testLoadItcFileMatchesLineParser()
+    {
+        QString file = QString(SAMPLE_DIR) + "/synthetic.itc";
+        std::vector<PeakPick::Peak> peaks;
+        QVector<qreal> inject;
+        qreal offset = 0, freq = 0;
+        auto loaded = ToolSet::LoadITCFile(file, &peaks, offset, freq, inject);
+
+        QFile reference(file);
+        QVERIFY(reference.open(QIODevice::ReadOnly | QIODevice::Text));
+        QVector<double> x, y;
+        while (!reference.atEnd()) {
+            const QString line = reference.readLine().trimmed();
+            if (line.contains("$") || line.contains("#") || line.contains("?") || line.contains("%") || line.contains("@"))
+                continue;
+            const QStringList fields = line.split(",");
+            if (fields.size() <= 2)
+                continue;
+            x << fields[0].toDouble();
+            y << fields[1].toDouble();
+        }
+
+        QCOMPARE(static_cast<int>(loaded.first.size()), x.size());
+        for (int i = 0; i < x.size(); ++i) {
+            QCOMPARE(loaded.first.X(i), x[i]);
+            QCOMPARE(loaded.first.Y(i), y[i]);
+        }
+
+        // Without the final newline the last line is still read, and the scan stops at the end.
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        QVERIFY(reference.seek(0));
+        QByteArray content = reference.readAll();
+        while (content.endsWith('\n') || content.endsWith('\r'))
+            content.chop(1);
+        QFile truncated(directory.filePath("no_newline.itc"));
+        QVERIFY(truncated.open(QIODevice::WriteOnly));
+        truncated.write(content);
+        truncated.close();
+        std::vector<PeakPick::Peak> truncated_peaks;
+        QVector<qreal> truncated_inject;
+        qreal truncated_offset = 0, truncated_freq = 0;
+        QString truncated_name = truncated.fileName();
+        auto unterminated = ToolSet::LoadITCFile(truncated_name, &truncated_peaks, truncated_offset, truncated_freq, truncated_inject);
+        QCOMPARE(static_cast<int>(unterminated.first.size()), x.size());
+        QCOMPARE(unterminated.first.X(x.size() - 1), x.last());
+        QCOMPARE(unterminated.first.Y(x.size() - 1), y.last());
+
+        bool ok = false;
+        const char text[] = " +2.50\r";
+        QCOMPARE(ToolSet::ParseDouble(text, text + sizeof(text) - 1, &ok), 2.5);
+        QVERIFY(ok);
+        const char bad[] = "n/a";
+        QCOMPARE(ToolSet::ParseDouble(bad, bad + sizeof(bad) - 1, &ok), 0.0);
+        QVERIFY(!ok);
+    }
+
     // One volume for every injection, sized to the peak list, and it reaches the result table.
     void testUniformInjectionVolume()
     {
@@ -471,6 +534,40 @@ private slots:
         QVERIFY2(qAbs(restored.dilution()->ScalingFactor() - cal2joule) < 1e-9,
             "the dilution's scaling factor did not round-trip");
     }
+
+    // The chart only draws a level-of-detail view of the trace: the reduction must keep the end
+    // points and every extremum, and zooming in must bring back full resolution in the viewport.
+    void testThermogramDecimationKeepsPeaks()
+    {
+        const PeakPick::spectrum spectrum = loadSample("reaction.dat");
+        QVector<QPointF> points;
+        for (int i = 0; i < int(spectrum.x().size()); ++i)
+            points << QPointF(spectrum.X(i), spectrum.Y(i));
+        QVERIFY(points.size() > 1000);
+
+        const int budget = 200;
+        const QVector<QPointF> minmax = SeriesDecimation::LevelOfDetail(points, 0, 0, budget, false);
+        QVERIFY(minmax.size() <= budget + 2);
+        QCOMPARE(minmax.first(), points.first());
+        QCOMPARE(minmax.last(), points.last());
+
+        auto y_less = [](const QPointF& a, const QPointF& b) { return a.y() < b.y(); };
+        QCOMPARE(std::min_element(minmax.cbegin(), minmax.cend(), y_less)->y(), std::min_element(points.cbegin(), points.cend(), y_less)->y());
+        QCOMPARE(std::max_element(minmax.cbegin(), minmax.cend(), y_less)->y(), std::max_element(points.cbegin(), points.cend(), y_less)->y());
+
+        const QVector<QPointF> lttb = SeriesDecimation::LTTB(points, budget);
+        QCOMPARE(lttb.size(), budget);
+        QVERIFY(SeriesDecimation::isSortedByX(lttb));
+
+        // A viewport narrower than the budget is drawn at full resolution, the rest stays coarse.
+        const int from = points.size() / 2, to = from + budget / 4;
+        const QVector<QPointF> zoomed = SeriesDecimation::LevelOfDetail(points, points[from].x(), points[to].x(), budget, true);
+        QVERIFY(zoomed.size() < points.size());
+        for (int i = from; i <= to; ++i)
+            QVERIFY2(zoomed.contains(points[i]), qPrintable(QString("point %1 missing from the zoomed view").arg(i)));
+        QCOMPARE(zoomed.first(), points.first());
+        QCOMPARE(zoomed.last(), points.last());
+    }
 };
 
 QTEST_MAIN(TestItcThermogram)
@@ -0,0 +1,293 @@
+/*
+ * SupraFit - checkpoints of long running statistics jobs
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * A checkpoint holds the finished batches of a Monte Carlo or cross validation run. Batches recorded
+ * from many threads must all reach the file, a resumed run must end exactly where the uninterrupted
+ * one does, and neither finished nor forgotten checkpoints may stay on disk.
+ */
+
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMap>
+#include <QtCore/QScopeGuard>
+#include <QtCore/QString>
+#include <QtCore/QTemporaryDir>
+
+#include <Eigen/Dense>
+
+#include "src/capabilities/jobcheckpoint.h"
+#include "src/capabilities/jobmanager.h"
+
+#include "src/core/minimizer.h"
+#include "src/core/models/AbstractModel.h"
+#include "src/core/models/dataclass.h"
+#include "src/core/models/datatable.h"
+#include "src/core/models/models.h"
+#include "src/global.h"
+
+class TestJobCheckpoint : public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr int N = 24;
+    static constexpr double A0 = 1e-3;
+
+    static QJsonObject strOption(const QString& value)
+    {
+        QJsonObject o;
+        o["value"] = value;
+        return o;
+    }
+
+    static QSharedPointer<AbstractModel> createModel(DataClass* data)
+    {
+        QSharedPointer<AbstractModel> model = CreateModel(SupraFit::nmr_any, data);
+        QJsonObject def;
+        def["Reactions"] = strOption(QStringLiteral("A + B <=> AB\nA + 2 B <=> AB2"));
+        model->DefineModel(def);
+        return model;
+    }
+
+    // Noisy host-constant / guest-titrated nmr_any 1:1/1:2 data, so Monte Carlo has a spread.
+    static DataClass* makeData()
+    {
+        const int series = 2;
+        Eigen::MatrixXd indep(N, 2);
+        Eigen::MatrixXd dep = Eigen::MatrixXd::Zero(N, series);
+        for (int i = 0; i < N; ++i) {
+            indep(i, 0) = A0;
+            indep(i, 1) = 3e-3 * i / (N - 1);
+        }
+        DataClass* data = new DataClass();
+        data->setIndependentTable(new DataTable(indep));
+        data->setDataType(DataClassPrivate::Table);
+        data->setSimulateDependent(series);
+        data->setDependentTable(new DataTable(dep));
+        data->setDataBegin(0);
+        data->setDataEnd(N);
+
+        QSharedPointer<AbstractModel> truth = createModel(data);
+        truth->InitialGuess();
+        truth->setGlobalParameter(3.8, 0);
+        truth->setGlobalParameter(5.9, 1);
+        for (int s = 0; s < series; ++s)
+            for (int p = 0; p < truth->LocalParameterSize(); ++p)
+                truth->setLocalParameter(9.0 * (1.0 - 0.1 * p - 0.07 * s), p, s);
+        truth->Calculate();
+        Eigen::MatrixXd signal = truth->ModelTable()->Table();
+        std::mt19937 gen(1234);
+        std::normal_distribution<double> noise(0.0, 0.01);
+        for (int r = 0; r < signal.rows(); ++r)
+            for (int c = 0; c < signal.cols(); ++c)
+                signal(r, c) += noise(gen);
+        data->setDependentTable(new DataTable(signal));
+        return data;
+    }
+
+    static QSharedPointer<AbstractModel> fittedModel(DataClass* data)
+    {
+        QSharedPointer<AbstractModel> model = createModel(data);
+        model->InitialGuess();
+        Minimizer minimizer(false);
+        minimizer.setCached(false);
+        minimizer.setModel(model);
+        minimizer.Minimize();
+        model->Calculate();
+        return model;
+    }
+
+    // Global-parameter (mean, stddev) of the newest Monte Carlo block of @p model.
+    static QMap<int, QPair<double, double>> globalBox(const QSharedPointer<AbstractModel>& model)
+    {
+        QMap<int, QPair<double, double>> out;
+        const QJsonObject methods = model->ExportModel().value("data").toObject().value("methods").toObject();
+        int newest = -1;
+        for (const QString& key : methods.keys())
+            newest = qMax(newest, key.toInt());
+        const QJsonObject block = methods.value(QString::number(newest)).toObject();
+        for (const QString& key : block.keys()) {
+            const QJsonObject parameter = block.value(key).toObject();
+            if (parameter.value("type").toString() != QLatin1String("Global Parameter") || !parameter.contains("boxplot"))
+                continue;
+            const QJsonObject box = parameter.value("boxplot").toObject();
+            out.insert(parameter.value("index").toString().toInt(), qMakePair(box.value("mean").toDouble(), box.value("stddev").toDouble()));
+        }
+        return out;
+    }
+
+    static QJsonObject monteCarlo()
+    {
+        QJsonObject job = MonteCarloConfigBlock;
+        job["MaxSteps"] = 64;
+        job["RandomSeed"] = 815;
+        job["VarianceSource"] = 2;
+        job["Method"] = static_cast<int>(SupraFit::Method::MonteCarlo);
+        job.remove("timestamp");
+        return job;
+    }
+
+    static QMap<int, QPair<double, double>> runMC(const QSharedPointer<AbstractModel>& model)
+    {
+        model->Calculate();
+        JobManager manager;
+        manager.setExecutionContext(ExecutionContext(2));
+        manager.setModel(model);
+        manager.AddSingleJob(monteCarlo());
+        manager.RunJobs();
+        return globalBox(model);
+    }
+
+    // One batch of a single step with recognisable parameters.
+    static BatchResults batch(int step)
+    {
+        BatchResults results;
+        results.parameters.insert(step, qMakePair(Eigen::MatrixXd::Constant(2, 1, step), Eigen::MatrixXd::Constant(3, 2, -step)));
+        results.addBlock({ step });
+        return results;
+    }
+
+private slots:
+    // Batches recorded from several threads while others write all end up in the file.
+    void concurrentRecordsReachTheFile()
+    {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        const QString path = directory.filePath(QStringLiteral("concurrent.checkpoint"));
+
+        const int threads = 4, steps = 50;
+        {
+            JobCheckpoint checkpoint(path, 0);
+            checkpoint.setSeed(815);
+            std::vector<std::thread> recorders;
+            for (int t = 0; t < threads; ++t)
+                recorders.emplace_back([&checkpoint, t]() {
+                    for (int i = 0; i < steps; ++i)
+                        checkpoint.Record(batch(t * steps + i));
+                });
+            for (std::thread& recorder : recorders)
+                recorder.join();
+            checkpoint.Flush();
+        }
+
+        JobCheckpoint resumed(path);
+        QVERIFY(resumed.Load());
+        QVERIFY(resumed.hasSeed());
+        QCOMPARE(resumed.Seed(), qint64(815));
+        QCOMPARE(resumed.Restored().Count(), threads * steps);
+        QCOMPARE(resumed.Restored().blocks.size(), threads * steps);
+        for (int step = 0; step < threads * steps; ++step)
+            QVERIFY(resumed.Restored().parameters.value(step).first == Eigen::MatrixXd::Constant(2, 1, step));
+
+        /* Removed is removed, a late flush does not bring it back */
+        resumed.Record(batch(threads * steps));
+        resumed.Remove();
+        resumed.Flush();
+        QVERIFY(!QFile::exists(path));
+    }
+
+    // Only checkpoints older than the limit are removed.
+    void staleCheckpointsAreRemoved()
+    {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+        for (const QString& name : { QStringLiteral("old.checkpoint"), QStringLiteral("new.checkpoint"), QStringLiteral("old.other") }) {
+            QFile file(directory.filePath(name));
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            file.write("x");
+            file.flush();
+            if (name.startsWith(QLatin1String("old")))
+                QVERIFY(file.setFileTime(QDateTime::currentDateTime().addDays(-30), QFileDevice::FileModificationTime));
+        }
+
+        QCOMPARE(JobCheckpoint::RemoveStale(directory.path(), qint64(14) * 24 * 3600), 1);
+        QVERIFY(!QFile::exists(directory.filePath(QStringLiteral("old.checkpoint"))));
+        QVERIFY(QFile::exists(directory.filePath(QStringLiteral("new.checkpoint"))));
+        QVERIFY(QFile::exists(directory.filePath(QStringLiteral("old.other"))));
+    }
+
+    // A run that is interrupted and resumed from its checkpoint ends with exactly the statistics of the
+    // run that went through: the finished blocks are restored bit for bit, the rest draws the same data.
+    void resumedMonteCarloMatchesUninterrupted()
+    {
+        QTemporaryDir directory;
+        QVERIFY(directory.isValid());
+
+        DataClass* data = makeData();
+        QSharedPointer<AbstractModel> model = fittedModel(data);
+
+        const QMap<int, QPair<double, double>> complete = runMC(model);
+
+        const QStringList keys{ "Checkpoint", "CheckpointDir", "CheckpointInterval", "Resume" };
+        QVariantList previous;
+        for (const QString& key : keys)
+            previous << qApp->property(qPrintable(key));
+        const auto restore = qScopeGuard([&keys, &previous]() {
+            for (int i = 0; i < keys.size(); ++i)
+                qApp->setProperty(qPrintable(keys[i]), previous[i]);
+        });
+
+        qApp->setProperty("Checkpoint", true);
+        qApp->setProperty("CheckpointDir", directory.path());
+        qApp->setProperty("CheckpointInterval", 0);
+        {
+            JobManager manager;
+            manager.setExecutionContext(ExecutionContext(2));
+            std::atomic<int> blocks = 0;
+            connect(&manager, &JobManager::incremented, &manager, [&manager, &blocks]() {
+                if (++blocks == 8)
+                    emit manager.Interrupt();
+            }, Qt::DirectConnection);
+            manager.setModel(model);
+            manager.AddSingleJob(monteCarlo());
+            manager.RunJobs();
+        }
+        QCOMPARE(QDir(directory.path()).entryList({ "*.checkpoint" }).size(), 1);
+
+        qApp->setProperty("Resume", true);
+        const QMap<int, QPair<double, double>> resumed = runMC(model);
+        /* The completed run does not leave its checkpoint behind */
+        QVERIFY(QDir(directory.path()).entryList({ "*.checkpoint" }).isEmpty());
+
+        QCOMPARE(resumed.size(), complete.size());
+        QVERIFY(!resumed.isEmpty());
+        for (auto it = complete.constBegin(); it != complete.constEnd(); ++it) {
+            const QPair<double, double> other = resumed.value(it.key());
+            QVERIFY2(other.first == it.value().first && other.second == it.value().second,
+                qPrintable(QString("mean %1 / stddev %2 (resumed) vs %3 / %4")
+                               .arg(other.first, 0, 'g', 17)
+                               .arg(other.second, 0, 'g', 17)
+                               .arg(it.value().first, 0, 'g', 17)
+                               .arg(it.value().second, 0, 'g', 17)));
+        }
+        delete data;
+    }
+};
+
+QTEST_MAIN(TestJobCheckpoint)
+#include "test_jobcheckpoint.moc"
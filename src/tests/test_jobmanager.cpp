@@ -0,0 +1,187 @@
+/*
+ * SupraFit - JobManager: jobs running in the background
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * RunJobsAsync() works on a snapshot of the model in a thread of its own. Jobs added while it runs
+ * join the running queue, AllFinished() comes once when the queue is drained, and Interrupt() stops
+ * the running job and drops the rest - the GUI relies on all three for its busy cursor.
+ */
+
+#include <cmath>
+#include <random>
+
+#include <QtTest/QtTest>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+#include <Eigen/Dense>
+
+#include "src/capabilities/jobmanager.h"
+
+#include "src/core/minimizer.h"
+#include "src/core/models/AbstractModel.h"
+#include "src/core/models/dataclass.h"
+#include "src/core/models/datatable.h"
+#include "src/core/models/models.h"
+#include "src/global.h"
+
+class TestJobManager : public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr int N = 24;
+    static constexpr double A0 = 1e-3;
+
+    static QJsonObject strOption(const QString& value)
+    {
+        QJsonObject o;
+        o["value"] = value;
+        return o;
+    }
+
+    // Noisy host-constant / guest-titrated nmr_any 1:1/1:2 data, so Monte Carlo has a spread.
+    static DataClass* makeData()
+    {
+        const int series = 2;
+        Eigen::MatrixXd indep(N, 2);
+        Eigen::MatrixXd dep = Eigen::MatrixXd::Zero(N, series);
+        for (int i = 0; i < N; ++i) {
+            indep(i, 0) = A0;
+            indep(i, 1) = 3e-3 * i / (N - 1);
+        }
+        DataClass* data = new DataClass();
+        data->setIndependentTable(new DataTable(indep));
+        data->setDataType(DataClassPrivate::Table);
+        data->setSimulateDependent(series);
+        data->setDependentTable(new DataTable(dep));
+        data->setDataBegin(0);
+        data->setDataEnd(N);
+
+        QSharedPointer<AbstractModel> truth = createModel(data);
+        truth->InitialGuess();
+        truth->setGlobalParameter(3.8, 0);
+        truth->setGlobalParameter(5.9, 1);
+        for (int s = 0; s < series; ++s)
+            for (int p = 0; p < truth->LocalParameterSize(); ++p)
+                truth->setLocalParameter(9.0 * (1.0 - 0.1 * p - 0.07 * s), p, s);
+        truth->Calculate();
+        Eigen::MatrixXd signal = truth->ModelTable()->Table();
+        std::mt19937 gen(1234);
+        std::normal_distribution<double> noise(0.0, 0.01);
+        for (int r = 0; r < signal.rows(); ++r)
+            for (int c = 0; c < signal.cols(); ++c)
+                signal(r, c) += noise(gen);
+        data->setDependentTable(new DataTable(signal));
+        return data;
+    }
+
+    static QSharedPointer<AbstractModel> createModel(DataClass* data)
+    {
+        QSharedPointer<AbstractModel> model = CreateModel(SupraFit::nmr_any, data);
+        QJsonObject def;
+        def["Reactions"] = strOption(QStringLiteral("A + B <=> AB\nA + 2 B <=> AB2"));
+        model->DefineModel(def);
+        return model;
+    }
+
+    static QSharedPointer<AbstractModel> fittedModel(DataClass* data)
+    {
+        QSharedPointer<AbstractModel> model = createModel(data);
+        model->InitialGuess();
+        Minimizer minimizer(false);
+        minimizer.setCached(false);
+        minimizer.setModel(model);
+        minimizer.Minimize();
+        model->Calculate();
+        return model;
+    }
+
+    static QJsonObject monteCarlo(int steps)
+    {
+        QJsonObject job = MonteCarloConfigBlock;
+        job["MaxSteps"] = steps;
+        job["RandomSeed"] = 42;
+        job["VarianceSource"] = 2;
+        job["Method"] = static_cast<int>(SupraFit::Method::MonteCarlo);
+        job.remove("timestamp");
+        return job;
+    }
+
+private slots:
+    // A job added while the first one runs is stored as well, and AllFinished() comes once, after
+    // both results.
+    void overlappingJobsFinishOnce()
+    {
+        DataClass* data = makeData();
+        QSharedPointer<AbstractModel> model = fittedModel(data);
+
+        JobManager manager;
+        manager.setExecutionContext(ExecutionContext(2));
+        manager.setModel(model);
+        QSignalSpy finished(&manager, &JobManager::finished);
+        QSignalSpy all(&manager, &JobManager::AllFinished);
+
+        manager.AddSingleJob(monteCarlo(40));
+        manager.RunJobsAsync();
+        QVERIFY(manager.Working());
+        manager.AddSingleJob(monteCarlo(20));
+        manager.RunJobsAsync(); // already running: joins the queue
+
+        QVERIFY(all.wait(120000));
+        QCOMPARE(finished.size(), 2);
+        QVERIFY(!manager.Working());
+
+        /* nothing else arrives once the queue was reported as done */
+        QTest::qWait(200);
+        QCOMPARE(all.size(), 1);
+        delete data;
+    }
+
+    // Interrupt() during the first of two jobs ends the queue: the running job stops early, the
+    // queued one never starts, and AllFinished() still comes exactly once.
+    void interruptDropsQueue()
+    {
+        DataClass* data = makeData();
+        QSharedPointer<AbstractModel> model = fittedModel(data);
+
+        JobManager manager;
+        manager.setExecutionContext(ExecutionContext(2));
+        manager.setModel(model);
+        QSignalSpy started(&manager, &JobManager::started);
+        QSignalSpy finished(&manager, &JobManager::finished);
+        QSignalSpy all(&manager, &JobManager::AllFinished);
+        connect(&manager, &JobManager::incremented, &manager, &JobManager::Interrupt, Qt::SingleShotConnection);
+
+        manager.AddSingleJob(monteCarlo(100000));
+        manager.AddSingleJob(monteCarlo(100000));
+        manager.RunJobsAsync();
+
+        QVERIFY(all.wait(120000));
+        QCOMPARE(started.size(), 1);
+        QVERIFY(finished.size() <= 1);
+        QVERIFY(!manager.Working());
+
+        QTest::qWait(200);
+        QCOMPARE(all.size(), 1);
+        delete data;
+    }
+};
+
+QTEST_MAIN(TestJobManager)
+#include "test_jobmanager.moc"
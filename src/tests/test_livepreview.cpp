@@ -0,0 +1,130 @@
+/*
+ * SupraFit - LivePreview: coalesced model evaluation while parameters are edited
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Live parameter editing evaluates on a worker replica of the model and imports the result on the
+ * thread of the model. However many edits arrive while a calculation runs, only the latest one has
+ * to be shown in the end.
+ */
+
+#include <cmath>
+
+#include <QtTest/QtTest>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+#include <Eigen/Dense>
+
+#include "src/core/livepreview.h"
+#include "src/core/minimizer.h"
+#include "src/core/models/AbstractModel.h"
+#include "src/core/models/dataclass.h"
+#include "src/core/models/datatable.h"
+#include "src/core/models/models.h"
+#include "src/global.h"
+
+class TestLivePreview : public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr int N = 24;
+    static constexpr double A0 = 1e-3;
+
+    static QJsonObject strOption(const QString& value)
+    {
+        QJsonObject o;
+        o["value"] = value;
+        return o;
+    }
+
+    static QSharedPointer<AbstractModel> createModel(DataClass* data)
+    {
+        QSharedPointer<AbstractModel> model = CreateModel(SupraFit::nmr_any, data);
+        QJsonObject def;
+        def["Reactions"] = strOption(QStringLiteral("A + B <=> AB\nA + 2 B <=> AB2"));
+        model->DefineModel(def);
+        return model;
+    }
+
+    // Host-constant / guest-titrated nmr_any 1:1/1:2 data, synthesised at known constants.
+    static DataClass* makeData()
+    {
+        const int series = 2;
+        Eigen::MatrixXd indep(N, 2);
+        Eigen::MatrixXd dep = Eigen::MatrixXd::Zero(N, series);
+        for (int i = 0; i < N; ++i) {
+            indep(i, 0) = A0;
+            indep(i, 1) = 3e-3 * i / (N - 1);
+        }
+        DataClass* data = new DataClass();
+        data->setIndependentTable(new DataTable(indep));
+        data->setDataType(DataClassPrivate::Table);
+        data->setSimulateDependent(series);
+        data->setDependentTable(new DataTable(dep));
+        data->setDataBegin(0);
+        data->setDataEnd(N);
+
+        QSharedPointer<AbstractModel> truth = createModel(data);
+        truth->InitialGuess();
+        truth->setGlobalParameter(3.8, 0);
+        truth->setGlobalParameter(5.9, 1);
+        for (int s = 0; s < series; ++s)
+            for (int p = 0; p < truth->LocalParameterSize(); ++p)
+                truth->setLocalParameter(9.0 * (1.0 - 0.1 * p - 0.07 * s), p, s);
+        truth->Calculate();
+        data->setDependentTable(new DataTable(truth->ModelTable()->Table()));
+        return data;
+    }
+
+private slots:
+    // A burst of edits must end with the model showing exactly what a direct Calculate() of the
+    // last values gives, and Settled() must follow once the edits stop.
+    void showsLatestEdit()
+    {
+        DataClass* data = makeData();
+        QSharedPointer<AbstractModel> model = createModel(data);
+        model->InitialGuess();
+        Minimizer minimizer(false);
+        minimizer.setModel(model);
+        minimizer.Minimize();
+        model->Calculate();
+        const double start = model->GlobalParameter(0);
+
+        LivePreview preview(model);
+        preview.setSettleInterval(50);
+        QSignalSpy settled(&preview, &LivePreview::Settled);
+
+        for (int step = 1; step <= 10; ++step) {
+            model->setGlobalParameter(start + 0.05 * step, 0);
+            preview.Request();
+        }
+        QVERIFY(settled.wait(10000));
+        QVERIFY(!preview.isBusy());
+        const Eigen::MatrixXd previewed = model->ModelTable()->Table();
+        const qreal previewed_sse = model->SSE();
+
+        model->Calculate();
+        QVERIFY2((previewed - model->ModelTable()->Table()).cwiseAbs().maxCoeff() < 1e-10, "preview does not show the latest edit");
+        QVERIFY(qAbs(previewed_sse - model->SSE()) <= 1e-10 * qMax(1.0, model->SSE()));
+        delete data;
+    }
+};
+
+QTEST_MAIN(TestLivePreview)
+#include "test_livepreview.moc"
@@ -0,0 +1,204 @@
+/*
+ * SupraFit - Minimizer: asynchronous fits and interruption
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Minimize() fits in the calling thread, MinimizeAsync() on the pool with the import back in the
+ * thread of the Minimizer. Both must give the same result, and both must stop on Interrupt().
+ */
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+#include <QtTest/QtTest>
+
+#include <QtCore/QFuture>
+#include <QtCore/QJsonObject>
+#include <QtCore/QThread>
+
+#include <Eigen/Dense>
+
+#include "src/core/minimizer.h"
+#include "src/core/models/AbstractModel.h"
+#include "src/core/models/dataclass.h"
+#include "src/core/models/datatable.h"
+#include "src/core/models/models.h"
+#include "src/global.h"
+
+class TestMinimizer : public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr int N = 24;
+    static constexpr double A0 = 1e-3;
+    static constexpr int Endless = 1000000;
+
+    static QJsonObject strOption(const QString& value)
+    {
+        QJsonObject o;
+        o["value"] = value;
+        return o;
+    }
+
+    // Host-constant / guest-titrated nmr_any 1:1/1:2 data, synthesised at known constants.
+    static DataClass* makeData()
+    {
+        const int series = 2;
+        Eigen::MatrixXd indep(N, 2);
+        Eigen::MatrixXd dep = Eigen::MatrixXd::Zero(N, series);
+        for (int i = 0; i < N; ++i) {
+            indep(i, 0) = A0;
+            indep(i, 1) = 3e-3 * i / (N - 1);
+        }
+        DataClass* data = new DataClass();
+        data->setIndependentTable(new DataTable(indep));
+        data->setDataType(DataClassPrivate::Table);
+        data->setSimulateDependent(series);
+        data->setDependentTable(new DataTable(dep));
+        data->setDataBegin(0);
+        data->setDataEnd(N);
+
+        QSharedPointer<AbstractModel> truth = createModel(data);
+        truth->InitialGuess();
+        truth->setGlobalParameter(3.8, 0);
+        truth->setGlobalParameter(5.9, 1);
+        for (int s = 0; s < series; ++s)
+            for (int p = 0; p < truth->LocalParameterSize(); ++p)
+                truth->setLocalParameter(9.0 * (1.0 - 0.1 * p - 0.07 * s), p, s);
+        truth->Calculate();
+        data->setDependentTable(new DataTable(truth->ModelTable()->Table()));
+        return data;
+    }
+
+    static QSharedPointer<AbstractModel> createModel(DataClass* data)
+    {
+        QSharedPointer<AbstractModel> model = CreateModel(SupraFit::nmr_any, data);
+        QJsonObject def;
+        def["Reactions"] = strOption(QStringLiteral("A + B <=> AB\nA + 2 B <=> AB2"));
+        model->DefineModel(def);
+        return model;
+    }
+
+    // A fit that never meets its stop criteria - it only ends when it is interrupted.
+    static QSharedPointer<AbstractModel> endlessModel(DataClass* data)
+    {
+        QSharedPointer<AbstractModel> model = createModel(data);
+        QJsonObject config = model->getOptimizerConfig();
+        config["MaxLevMarInter"] = Endless;
+        config["ErrorConvergence"] = 0.0;
+        config["DeltaParameter"] = -1.0;
+        config["FitSolver"] = QStringLiteral("LevMar");
+        model->setOptimizerConfig(config);
+        model->InitialGuess();
+        return model;
+    }
+
+private slots:
+    // The asynchronous fit reaches exactly the result of the blocking one and reports it through
+    // both the future and MinimizationFinished().
+    void asyncMatchesBlocking()
+    {
+        DataClass* data = makeData();
+
+        QSharedPointer<AbstractModel> blocking = createModel(data);
+        blocking->InitialGuess();
+        Minimizer reference(false);
+        reference.setCached(false);
+        reference.setModel(blocking);
+        const int converged = reference.Minimize();
+
+        QSharedPointer<AbstractModel> model = createModel(data);
+        model->InitialGuess();
+        Minimizer minimizer(false);
+        minimizer.setCached(false);
+        minimizer.setModel(model);
+        QSignalSpy finished(&minimizer, &Minimizer::MinimizationFinished);
+
+        QFuture<int> future = minimizer.MinimizeAsync();
+        QVERIFY(finished.wait(60000));
+        QVERIFY(future.isFinished());
+        QCOMPARE(future.result(), converged);
+        QCOMPARE(finished.first().first().toInt(), converged);
+
+        QCOMPARE(model->SSE(), blocking->SSE());
+        for (int k = 0; k < model->GlobalParameterSize(); ++k)
+            QCOMPARE(model->GlobalParameter(k), blocking->GlobalParameter(k));
+        QCOMPARE(minimizer.History().sse, reference.History().sse);
+        delete data;
+    }
+
+    // A blocking Minimize() stops when another thread interrupts it, and leaves the model at the
+    // best parameters it had reached.
+    void interruptBlocking()
+    {
+        DataClass* data = makeData();
+        QSharedPointer<AbstractModel> model = endlessModel(data);
+        model->Calculate();
+        const qreal start = model->SSE();
+
+        Minimizer minimizer(false);
+        minimizer.setCached(false);
+        minimizer.setModel(model);
+
+        /* Keeps interrupting until the fit has returned, so it does not matter when it started */
+        std::atomic<bool> done = false;
+        std::thread interrupter([&minimizer, &done]() {
+            QThread::msleep(50);
+            while (!done) {
+                minimizer.Interrupt();
+                QThread::msleep(10);
+            }
+        });
+        const int converged = minimizer.Minimize();
+        done = true;
+        interrupter.join();
+
+        QCOMPARE(converged, 0);
+        QVERIFY(!minimizer.History().sse.isEmpty());
+        QVERIFY(minimizer.History().sse.size() < Endless);
+        QVERIFY(std::isfinite(model->SSE()));
+        QVERIFY(model->SSE() <= start);
+        delete data;
+    }
+
+    // An asynchronous fit stops on Interrupt() from the thread of the Minimizer - here the first
+    // progress report - and still resolves its future.
+    void interruptAsync()
+    {
+        DataClass* data = makeData();
+        QSharedPointer<AbstractModel> model = endlessModel(data);
+
+        Minimizer minimizer(false);
+        minimizer.setCached(false);
+        minimizer.setModel(model);
+        minimizer.setProgressInterval(1);
+        connect(&minimizer, &Minimizer::Progress, &minimizer, &Minimizer::Interrupt);
+        QSignalSpy finished(&minimizer, &Minimizer::MinimizationFinished);
+
+        QFuture<int> future = minimizer.MinimizeAsync();
+        QVERIFY(finished.wait(60000));
+        QVERIFY(future.isFinished());
+        QCOMPARE(future.result(), 0);
+        QVERIFY(minimizer.History().sse.size() < Endless);
+        QVERIFY(std::isfinite(model->SSE()));
+        delete data;
+    }
+};
+
+QTEST_MAIN(TestMinimizer)
+#include "test_minimizer.moc"
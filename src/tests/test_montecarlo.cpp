@@ -0,0 +1,174 @@
+/*
+ * SupraFit - Monte Carlo statistics: reproducible resampling
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Every Monte Carlo step draws its data from a counter-based stream keyed by the seed and the step,
+ * refits from the start parameters of the model and lands in the block of its step. Which thread
+ * fitted a step must therefore not show in the result, not even in the last bit.
+ */
+
+#include <cmath>
+#include <random>
+
+#include <QtTest/QtTest>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+
+#include <Eigen/Dense>
+
+#include "src/capabilities/jobmanager.h"
+
+#include "src/core/minimizer.h"
+#include "src/core/models/AbstractModel.h"
+#include "src/core/models/dataclass.h"
+#include "src/core/models/datatable.h"
+#include "src/core/models/models.h"
+#include "src/global.h"
+
+class TestMonteCarlo : public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr int N = 24;
+    static constexpr double A0 = 1e-3;
+
+    static QJsonObject strOption(const QString& value)
+    {
+        QJsonObject o;
+        o["value"] = value;
+        return o;
+    }
+
+    static QSharedPointer<AbstractModel> createModel(DataClass* data)
+    {
+        QSharedPointer<AbstractModel> model = CreateModel(SupraFit::nmr_any, data);
+        QJsonObject def;
+        def["Reactions"] = strOption(QStringLiteral("A + B <=> AB\nA + 2 B <=> AB2"));
+        model->DefineModel(def);
+        return model;
+    }
+
+    // Noisy host-constant / guest-titrated nmr_any 1:1/1:2 data, so Monte Carlo has a spread.
+    static DataClass* makeData()
+    {
+        const int series = 2;
+        Eigen::MatrixXd indep(N, 2);
+        Eigen::MatrixXd dep = Eigen::MatrixXd::Zero(N, series);
+        for (int i = 0; i < N; ++i) {
+            indep(i, 0) = A0;
+            indep(i, 1) = 3e-3 * i / (N - 1);
+        }
+        DataClass* data = new DataClass();
+        data->setIndependentTable(new DataTable(indep));
+        data->setDataType(DataClassPrivate::Table);
+        data->setSimulateDependent(series);
+        data->setDependentTable(new DataTable(dep));
+        data->setDataBegin(0);
+        data->setDataEnd(N);
+
+        QSharedPointer<AbstractModel> truth = createModel(data);
+        truth->InitialGuess();
+        truth->setGlobalParameter(3.8, 0);
+        truth->setGlobalParameter(5.9, 1);
+        for (int s = 0; s < series; ++s)
+            for (int p = 0; p < truth->LocalParameterSize(); ++p)
+                truth->setLocalParameter(9.0 * (1.0 - 0.1 * p - 0.07 * s), p, s);
+        truth->Calculate();
+        Eigen::MatrixXd signal = truth->ModelTable()->Table();
+        std::mt19937 gen(1234);
+        std::normal_distribution<double> noise(0.0, 0.01);
+        for (int r = 0; r < signal.rows(); ++r)
+            for (int c = 0; c < signal.cols(); ++c)
+                signal(r, c) += noise(gen);
+        data->setDependentTable(new DataTable(signal));
+        return data;
+    }
+
+    // Global-parameter (mean, stddev) of the newest Monte Carlo block of @p model.
+    static QMap<int, QPair<double, double>> globalBox(const QSharedPointer<AbstractModel>& model)
+    {
+        QMap<int, QPair<double, double>> out;
+        const QJsonObject methods = model->ExportModel().value("data").toObject().value("methods").toObject();
+        int newest = -1;
+        for (const QString& key : methods.keys())
+            newest = qMax(newest, key.toInt());
+        const QJsonObject block = methods.value(QString::number(newest)).toObject();
+        for (const QString& key : block.keys()) {
+            const QJsonObject parameter = block.value(key).toObject();
+            if (parameter.value("type").toString() != QLatin1String("Global Parameter") || !parameter.contains("boxplot"))
+                continue;
+            const QJsonObject box = parameter.value("boxplot").toObject();
+            out.insert(parameter.value("index").toString().toInt(), qMakePair(box.value("mean").toDouble(), box.value("stddev").toDouble()));
+        }
+        return out;
+    }
+
+    static QMap<int, QPair<double, double>> runMC(const QSharedPointer<AbstractModel>& model, int threads)
+    {
+        QJsonObject job = MonteCarloConfigBlock;
+        job["MaxSteps"] = 96;
+        job["RandomSeed"] = 2718;
+        job["VarianceSource"] = 2;
+        job["Method"] = static_cast<int>(SupraFit::Method::MonteCarlo);
+        job.remove("timestamp");
+        model->Calculate();
+
+        JobManager manager;
+        manager.setExecutionContext(ExecutionContext(threads));
+        manager.setModel(model);
+        manager.AddSingleJob(job);
+        manager.RunJobs();
+        return globalBox(model);
+    }
+
+private slots:
+    // The same seed gives bit-identical statistics on one, two and four threads.
+    void independentOfThreadCount()
+    {
+        DataClass* data = makeData();
+        QSharedPointer<AbstractModel> model = createModel(data);
+        model->InitialGuess();
+        Minimizer minimizer(false);
+        minimizer.setCached(false);
+        minimizer.setModel(model);
+        minimizer.Minimize();
+
+        const QMap<int, QPair<double, double>> serial = runMC(model, 1);
+        QCOMPARE(serial.size(), model->GlobalParameterSize());
+        for (int threads : { 2, 4 }) {
+            const QMap<int, QPair<double, double>> parallel = runMC(model, threads);
+            QCOMPARE(parallel.size(), serial.size());
+            for (auto it = serial.constBegin(); it != serial.constEnd(); ++it) {
+                const QPair<double, double> other = parallel.value(it.key());
+                QVERIFY2(other.first == it.value().first && other.second == it.value().second,
+                    qPrintable(QString("%1 threads: mean %2 / stddev %3 vs %4 / %5 on one thread")
+                                   .arg(threads)
+                                   .arg(other.first, 0, 'g', 17)
+                                   .arg(other.second, 0, 'g', 17)
+                                   .arg(it.value().first, 0, 'g', 17)
+                                   .arg(it.value().second, 0, 'g', 17)));
+            }
+        }
+        delete data;
+    }
+};
+
+QTEST_MAIN(TestMonteCarlo)
+#include "test_montecarlo.moc"
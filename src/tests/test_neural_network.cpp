@@ -54,6 +54,8 @@ private slots:
     void testPerformanceMetrics();
     void testActivationFunctions();
     void testLayerOperations();
+    void testBatchPrediction();
+    void testBatchedTraining();
 
 private:
     // Helper functions
@@ -302,6 +304,66 @@ void TestNeuralNetwork::testLayerOperations()
     QCOMPARE(network.layerCount(), static_cast<size_t>(0));
 }
 
+void TestNeuralNetwork::testBatchPrediction()
+{
+    NeuralNetwork network({6, 8, 4, 4}, {"relu", "tanh", "softmax"});
+
+    Eigen::MatrixXd inputs = Eigen::MatrixXd::Random(6, 37);
+    Eigen::MatrixXd outputs = network.predictBatch(inputs, 4);
+    QCOMPARE(network.getLastError(), NeuralNetwork::ErrorCode::Success);
+    QCOMPARE(outputs.rows(), 4);
+    QCOMPARE(outputs.cols(), 37);
+
+    for (int j = 0; j < inputs.cols(); ++j) {
+        QVERIFY(isVectorEqual(outputs.col(j), network.predict(inputs.col(j)), 1e-12));
+    }
+
+    // float32 GEMMs stay within single precision of the double result
+    network.setPrecision(NeuralNetwork::Precision::Single);
+    Eigen::MatrixXd outputs_f = network.predictBatch(inputs, 2);
+    QVERIFY((outputs_f - outputs).cwiseAbs().maxCoeff() < 1e-5);
+
+    // Wrong input dimension is reported, not evaluated
+    Eigen::MatrixXd wrong = Eigen::MatrixXd::Random(5, 3);
+    QCOMPARE(network.predictBatch(wrong).size(), 0);
+    QCOMPARE(network.getLastError(), NeuralNetwork::ErrorCode::DimensionMismatch);
+}
+
+void TestNeuralNetwork::testBatchedTraining()
+{
+    // Fixed weights and sample order, so the convergence check does not depend on the draw
+    NeuralNetwork network({2, 8, 1}, {"tanh", "sigmoid"});
+    network.initializeWeights(42);
+
+    TrainingData data;
+    for (int a = 0; a < 2; ++a) {
+        for (int b = 0; b < 2; ++b) {
+            Eigen::VectorXd input(2);
+            input << a, b;
+            Eigen::VectorXd target(1);
+            target << (a != b ? 1.0 : 0.0);
+            data.inputs.push_back(input);
+            data.targets.push_back(target);
+        }
+    }
+
+    TrainingConfig config;
+    config.epochs = 1000;
+    config.batch_size = 4;
+    config.learning_rate = 0.05;
+    config.optimizer_name = "adam";
+    config.loss_function = "binarycrossentropy";
+    config.validation_split = 0.0;
+    config.shuffle_data = false;
+    config.print_every = config.epochs;
+
+    auto history = network.train(data, config);
+    QCOMPARE(history.epochs_completed, config.epochs);
+    QVERIFY(history.train_loss.back() < history.train_loss.front());
+    QVERIFY(history.train_loss.back() < 0.1);
+    QCOMPARE(network.calculateAccuracy(data), 1.0);
+}
+
 bool TestNeuralNetwork::isApproximatelyEqual(double a, double b, double tolerance)
 {
     return std::abs(a - b) < tolerance;
@@ -25,6 +25,12 @@
 
 #include "test_utils.h"
 
+#include "src/core/libmath.h"
+#include "src/core/streamingstatistics.h"
+#include "src/core/toolset.h"
+
+#include <random>
+
 class TestPostProcessing : public QObject
 {
     Q_OBJECT
@@ -58,6 +64,8 @@ private slots:
     void testConfidenceIntervals();
     void testParameterDistributions();
     void testStatisticalSummaries();
+    void testStreamingSummaries();
+    void testSampleStatistics();
 
     // CLI Integration Tests
     void testShowPostProcessingFlag();
@@ -433,6 +441,113 @@ void TestPostProcessing::testStatisticalSummaries()
     QVERIFY(verifyStatisticalResults(result[1]));
 }
 
+void TestPostProcessing::testStreamingSummaries()
+{
+    // Two merged accumulators have to agree with the full list, as two MonteCarloBatch threads do
+    std::mt19937 rng(42);
+    std::normal_distribution<double> normal(3.0, 2.0);
+
+    QList<qreal> values;
+    SampleSummary first, second, exact(true);
+    for (int i = 0; i < 50000; ++i) {
+        const double x = normal(rng);
+        values << x;
+        exact.add(x);
+        (i % 3 ? first : second).add(x);
+    }
+    first.merge(second);
+    std::sort(values.begin(), values.end());
+
+    QCOMPARE(first.Count(), qint64(values.size()));
+    QVERIFY(qAbs(first.Moments().Mean() - ToolSet::BoxWhiskerPlot(values).mean) < 1e-9);
+    QVERIFY(qAbs(first.Moments().Stddev() - Stddev(values.toVector())) < 1e-9);
+
+    // Kept raw values reproduce the list based statistics exactly
+    const BoxWhisker box = exact.Box();
+    QCOMPARE(box.median, ToolSet::BoxWhiskerPlot(values).median);
+    QCOMPARE(exact.Confidence(5).lower, ToolSet::Confidence(values, 5).lower);
+
+    // The digest estimates are within a small fraction of the spread
+    const SupraFit::ConfidenceBar reference = ToolSet::Confidence(values, 5);
+    const SupraFit::ConfidenceBar estimated = first.Confidence(5);
+    QVERIFY2(qAbs(estimated.lower - reference.lower) < 0.02, qPrintable(QString::number(estimated.lower) + " vs " + QString::number(reference.lower)));
+    QVERIFY2(qAbs(estimated.upper - reference.upper) < 0.02, qPrintable(QString::number(estimated.upper) + " vs " + QString::number(reference.upper)));
+    QVERIFY(qAbs(first.Box().median - box.median) < 0.02);
+    QVERIFY(first.Digest().Clusters() < 5000);
+    QCOMPARE(first.Digest().Count(), double(values.size()));
+
+    // Once compressed, the const accessors leave the digest alone and the count is kept on the side
+    const QuantileDigest& digest = first.Digest();
+    digest.Compress();
+    const int clusters = digest.Clusters();
+    digest.Quantile(0.5);
+    digest.CDF(3.0);
+    QCOMPARE(digest.Clusters(), clusters);
+    QCOMPARE(digest.Count(), double(values.size()));
+
+    int bins = 20;
+    const auto histogram = first.Histogram(bins);
+    qreal total = 0;
+    for (const QPair<qreal, qreal>& bin : histogram)
+        total += bin.second;
+    QCOMPARE(histogram.size(), 20);
+    QVERIFY(qAbs(total - values.size()) < 1e-6 * values.size());
+}
+
+void TestPostProcessing::testSampleStatistics()
+{
+    // One sort (or a selection) per column has to give exactly what the list based functions give
+    std::mt19937 rng(7);
+    std::lognormal_distribution<double> skewed(0.0, 0.8);
+
+    for (int size : { 1, 2, 7, 500, 20001 }) {
+        QVector<qreal> column;
+        for (int i = 0; i < size; ++i)
+            column << skewed(rng);
+        QList<qreal> sorted = column;
+        std::sort(sorted.begin(), sorted.end());
+
+        for (int bins : { 0, 10, 37 }) {
+            int expected_bins = bins, sorted_bins = bins;
+            const auto expected = ToolSet::List2Histogram(column, expected_bins);
+            QCOMPARE(SampleStatistics::SortedHistogram(sorted, sorted_bins), expected);
+            QCOMPARE(sorted_bins, expected_bins);
+        }
+        if (size < 3)
+            continue;
+
+        const BoxWhisker reference = ToolSet::BoxWhiskerPlot(sorted);
+        QVector<qreal> shuffled = column;
+        const BoxWhisker box = SampleStatistics::Box(shuffled);
+        QCOMPARE(box.median, reference.median);
+        QCOMPARE(box.lower_quantile, reference.lower_quantile);
+        QCOMPARE(box.upper_quantile, reference.upper_quantile);
+        QCOMPARE(box.lower_whisker, reference.lower_whisker);
+        QCOMPARE(box.upper_whisker, reference.upper_whisker);
+        QCOMPARE(box.mild_outliers, reference.mild_outliers);
+        QCOMPARE(box.extreme_outliers, reference.extreme_outliers);
+        QVERIFY(qAbs(box.mean - reference.mean) < 1e-12 * qMax(1.0, qAbs(reference.mean)));
+
+        for (qreal error : { 0.0, 5.0, 31.7 }) {
+            QVector<qreal> selected = column;
+            const SupraFit::ConfidenceBar bar = SampleStatistics::Confidence(selected, error);
+            QCOMPARE(bar.lower, ToolSet::Confidence(sorted, error).lower);
+            QCOMPARE(bar.upper, ToolSet::Confidence(sorted, error).upper);
+        }
+
+        const ParameterStatistics statistics = SampleStatistics::FromSorted(sorted, 5, 0, 30);
+        QCOMPARE(statistics.box.median, reference.median);
+        QCOMPARE(statistics.confidence.lower, ToolSet::Confidence(sorted, 5).lower);
+
+        /* The entropy the print path used to rebuild from the raw values */
+        int entropy_bins = 30;
+        QVector<QPair<qreal, qreal>> histogram = ToolSet::List2Histogram(column, entropy_bins);
+        ToolSet::Normalise(histogram);
+        QCOMPARE(statistics.entropy_bins, 30);
+        QCOMPARE(statistics.entropy, ToolSet::Entropy(histogram));
+    }
+}
+
 void TestPostProcessing::testShowPostProcessingFlag()
 {
     // Create a file with existing post-processing results
@@ -43,9 +43,11 @@ private slots:
     void testCreateProjectFromJson();
     void testGetProjectAsJson();
     void testGetAllProjectsAsJson();
+    void testGetAllProjectData();
 
     // File operations
     void testLoadProjectFromFile();
+    void testLoadMultipleProjects();
     void testSaveProjectToFile();
     void testProjectRoundTrip();
 
@@ -291,6 +293,58 @@ void TestProjectManager::testGetAllProjectsAsJson()
     QVERIFY(found2);
 }
 
+void TestProjectManager::testGetAllProjectData()
+{
+    SupraFit::ProjectManager& pm = SupraFit::ProjectManager::instance();
+
+    QString id = pm.createProjectFromJson(createTestProjectJson("Handle Test"), "Handle Test");
+    m_createdProjectIds.append(id);
+
+    // The handles are the managed projects themselves, not copies
+    QSharedPointer<DataClass> handle;
+    for (const QSharedPointer<DataClass>& project : pm.getAllProjectData()) {
+        if (project->UUID() == id)
+            handle = project;
+    }
+    QVERIFY(!handle.isNull());
+    QCOMPARE(handle.data(), pm.getProjectData(id).data());
+    QCOMPARE(pm.getAllProjectData().size(), pm.getAllProjectsAsJson().size());
+}
+
+void TestProjectManager::testLoadMultipleProjects()
+{
+    SupraFit::ProjectManager& pm = SupraFit::ProjectManager::instance();
+
+    QStringList files;
+    for (int i = 0; i < 4; ++i) {
+        QJsonObject data = createTestProjectJson(QString("Batch Load %1").arg(i));
+        QString filename = m_tempDir->filePath(QString("batch_project_%1.json").arg(i));
+        QFile file(filename);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(QJsonDocument(data).toJson());
+        file.close();
+        files << filename;
+    }
+    files.insert(2, m_tempDir->filePath("missing_project.json"));
+
+    QSignalSpy errorSpy(&pm, &SupraFit::ProjectManager::errorOccurred);
+    QStringList ids = pm.loadProjects(files);
+
+    // Results follow the order of the input, a failed file leaves an empty id
+    QCOMPARE(ids.size(), files.size());
+    QVERIFY(ids[2].isEmpty());
+    QCOMPARE(errorSpy.count(), 1);
+
+    int title = 0;
+    for (int i = 0; i < ids.size(); ++i) {
+        if (i == 2)
+            continue;
+        QVERIFY(!ids[i].isEmpty());
+        m_createdProjectIds.append(ids[i]);
+        QCOMPARE(pm.getProjectData(ids[i])->ProjectTitle(), QString("Batch Load %1").arg(title++));
+    }
+}
+
 void TestProjectManager::testLoadProjectFromFile()
 {
     SupraFit::ProjectManager& pm = SupraFit::ProjectManager::instance();
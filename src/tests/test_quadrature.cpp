@@ -131,6 +131,36 @@ private slots:
         // int_0^1 x dx = 0.5, Simpson is exact for it even on a single panel
         QVERIFY(std::abs(integrate(f, 0, 1, 10.0) - 0.5) < 1e-12);
     }
+
+    /* The adaptive Gauss-Kronrod rule the BC50 integrals use: a smooth integrand must reach the
+     * tolerance with a handful of segments, a peaked one by refining where the peak is. */
+    void gaussKronrodConverges()
+    {
+        int evaluations = 0;
+        auto smooth = [&evaluations](qreal x) { ++evaluations; return std::sin(M_PI * x); };
+        const double value = GaussKronrodIntegrate(smooth, 0, 1, 1e-12);
+        QVERIFY2(std::abs(value - 2.0 / M_PI) < 1e-14, qPrintable(QString::number(value, 'g', 17)));
+        QVERIFY2(evaluations <= 45, qPrintable(QString("%1 evaluations for sin(pi x)").arg(evaluations)));
+
+        // int_-1^1 1/(1e-4 + x^2) dx = 2/sqrt(1e-4) atan(1/sqrt(1e-4))
+        auto peaked = [](qreal x) { return 1.0 / (1e-4 + x * x); };
+        const double exact = 2.0 / 1e-2 * std::atan(1.0 / 1e-2);
+        const double result = GaussKronrodIntegrate(peaked, -1, 1, 1e-10);
+        QVERIFY2(std::abs(result - exact) / exact < 1e-9, qPrintable(QString::number(result, 'g', 17)));
+    }
+
+    /* Nodes are interior: the endpoint singularities that needed the Simpson fallback are never
+     * evaluated, and degenerate ranges integrate to zero. */
+    void gaussKronrodAvoidsEndpoints()
+    {
+        auto f = [](qreal x) { return 1.0 / std::sqrt(1.0 - x); };
+        const double value = GaussKronrodIntegrate(f, 0, 1, 1e-8, 400);
+        QVERIFY(std::isfinite(value));
+        QVERIFY2(std::abs(value - 2.0) < 1e-4, qPrintable(QString::number(value, 'g', 10)));
+
+        QCOMPARE(GaussKronrodIntegrate(f, 1, 1), 0.0);
+        QCOMPARE(GaussKronrodIntegrate(f, 1, 0), 0.0);
+    }
 };
 
 QTEST_MAIN(QuadratureTest)
@@ -0,0 +1,140 @@
+/*
+ * SupraFit - speciation reuse between model evaluations in fast mode
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * In fast mode a model keeps its equilibrium concentrations while the global parameters, the
+ * independent table and the data range stay the same. The local columns of a finite difference
+ * Jacobian must therefore not solve the speciation again, and whatever is reused must give exactly
+ * what a fresh solve gives.
+ */
+
+#include <cmath>
+
+#include <QtTest/QtTest>
+#include <QtCore/QJsonObject>
+
+#include <Eigen/Dense>
+
+#include "src/core/models/AbstractModel.h"
+#include "src/core/models/dataclass.h"
+#include "src/core/models/datatable.h"
+#include "src/core/models/models.h"
+#include "src/global.h"
+
+class TestSpeciationCache : public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr int N = 16;
+    static constexpr double A0 = 1e-3;
+
+    static QJsonObject strOption(const QString& value)
+    {
+        QJsonObject o;
+        o["value"] = value;
+        return o;
+    }
+
+    // Host-constant / guest-titrated 2-component data with @p series (simulated) dependent columns.
+    static DataClass* makeData(int series)
+    {
+        Eigen::MatrixXd indep(N, 2);
+        Eigen::MatrixXd dep = Eigen::MatrixXd::Zero(N, series);
+        for (int i = 0; i < N; ++i) {
+            indep(i, 0) = A0;
+            indep(i, 1) = 3.0 * A0 * i / (N - 1);
+        }
+        DataClass* data = new DataClass();
+        data->setIndependentTable(new DataTable(indep));
+        data->setDataType(DataClassPrivate::Table);
+        data->setSimulateDependent(series);
+        data->setDependentTable(new DataTable(dep));
+        data->setDataBegin(0);
+        data->setDataEnd(N);
+        return data;
+    }
+
+private slots:
+    void reusesConcentrations_data()
+    {
+        QTest::addColumn<int>("modelId");
+        QTest::addColumn<QString>("reactions");
+        QTest::newRow("nmr_ItoI_ItoII") << static_cast<int>(SupraFit::nmr_ItoI_ItoII) << QString();
+        QTest::newRow("nmr_any 1:1/1:2") << static_cast<int>(SupraFit::nmr_any) << QStringLiteral("A + B <=> AB\nA + 2 B <=> AB2");
+        QTest::newRow("uvvis_any 1:1") << static_cast<int>(SupraFit::uvvis_any) << QStringLiteral("A + B <=> AB");
+    }
+
+    // Unchanged inputs and changed locals skip the solve, changed globals or independent values
+    // solve again; every result equals a fresh clone that solves from scratch.
+    void reusesConcentrations()
+    {
+        QFETCH(int, modelId);
+        QFETCH(QString, reactions);
+
+        DataClass* data = makeData(2);
+        QSharedPointer<AbstractModel> model = CreateModel(static_cast<SupraFit::Model>(modelId), data);
+        QJsonObject def;
+        def["Reactions"] = strOption(reactions);
+        model->DefineModel(def);
+        model->InitialGuess();
+        model->setFast(true);
+        model->Calculate();
+
+        auto compareFresh = [&model](const char* step) {
+            QSharedPointer<AbstractModel> fresh = model->Clone();
+            fresh->setFast(true);
+            fresh->Calculate();
+            const QList<double> cached = model->getCalculatedAbsoluteErrors();
+            const QList<double> expected = fresh->getCalculatedAbsoluteErrors();
+            QCOMPARE(cached.size(), expected.size());
+            for (int i = 0; i < cached.size(); ++i)
+                QVERIFY2(std::abs(cached[i] - expected[i]) <= 1e-12 * (1 + std::abs(expected[i])),
+                    qPrintable(QString("%1: residual %2 is %3, expected %4").arg(step).arg(i).arg(cached[i]).arg(expected[i])));
+        };
+        /* Calculate() and the number of speciation solves it added */
+        auto solves = [&model]() {
+            const qint64 before = model->Speciations();
+            model->Calculate();
+            return model->Speciations() - before;
+        };
+
+        QCOMPARE(solves(), qint64(0));
+        compareFresh("unchanged");
+
+        model->setLocalParameter(model->LocalParameter(1, 0) + 0.5, 1, 0);
+        QCOMPARE(solves(), qint64(0));
+        compareFresh("local changed");
+
+        model->setGlobalParameter(model->GlobalParameter(0) + 0.3, 0);
+        QCOMPARE(solves(), qint64(1));
+        compareFresh("global changed");
+
+        model->IndependentModel()->data(N / 2, 1) *= 1.5;
+        QCOMPARE(solves(), qint64(1));
+        compareFresh("independent changed");
+
+        /* Outside fast mode every evaluation solves, so tables and charts are refilled */
+        model->setFast(false);
+        QCOMPARE(solves(), qint64(1));
+
+        delete data;
+    }
+};
+
+QTEST_MAIN(TestSpeciationCache)
+#include "test_speciationcache.moc"
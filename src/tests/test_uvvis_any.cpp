@@ -23,6 +23,7 @@
 #include <cmath>
 
 #include <QtCore/QJsonObject>
+#include <QtCore/QStringList>
 #include <QtTest/QtTest>
 
 #include <Eigen/Dense>
@@ -33,6 +34,7 @@
 #include "src/core/models/datatable.h"
 #include "src/core/models/models.h"
 #include "src/core/models/titrations/AbstractTitrationModel.h"
+#include "src/core/spectralbasis.h"
 #include "src/global.h"
 
 class TestUvVisAny : public QObject {
@@ -125,6 +127,113 @@ private slots:
         }
         delete data;
     }
+
+    /*! \brief Global spectral fit: fitting the SVD scores of full spectra and reconstructing at the end
+     * recovers the species spectra at every wavelength, and the compressed SSE plus the truncated
+     * energy is the full-resolution SSE. */
+    void testSvdCompressedSpectra()
+    {
+        const int W = 120;
+        const double logK = 4.0;
+        QVector<double> x(W);
+        Eigen::MatrixXd E(3, W); // eps A, eps B, eps AB per wavelength
+        for (int w = 0; w < W; ++w) {
+            x[w] = 250.0 + 2.0 * w;
+            E(0, w) = 800.0 * std::exp(-std::pow((x[w] - 300.0) / 25.0, 2));
+            E(1, w) = 150.0 * std::exp(-std::pow((x[w] - 350.0) / 30.0, 2));
+            E(2, w) = 5000.0 * std::exp(-std::pow((x[w] - 420.0) / 35.0, 2));
+        }
+        Eigen::MatrixXd C(N, 3);
+        for (int i = 0; i < N; ++i) {
+            const double B0 = 2e-3 * i / (N - 1);
+            const double freeA = ItoI::HostConcentration(A0, B0, logK);
+            C(i, 0) = freeA;
+            C(i, 1) = B0 - (A0 - freeA);
+            C(i, 2) = A0 - freeA;
+        }
+        Eigen::MatrixXd Y = C * E;
+        for (int i = 0; i < N; ++i)
+            for (int w = 0; w < W; ++w)
+                Y(i, w) += 1e-4 * std::sin(0.7 * i + 1.3 * w); // deterministic "noise" beyond the rank
+
+        const SpectralBasis basis = SpectralBasis::Compute(Y, x, 3);
+        QCOMPARE(basis.Components(), 3);
+        QVERIFY(basis.ExplainedVariance() > 0.999999);
+
+        DataClass* data = makeData();
+        data->setDependentTable(new DataTable(basis.Scores()));
+        QJsonObject raw;
+        raw["SpectralBasis"] = basis.toJson(); // what SpectraHandler stores with the spectra
+        data->setRawData(raw);
+
+        QSharedPointer<AbstractModel> model = CreateModel(SupraFit::uvvis_any, data);
+        QJsonObject def;
+        def["Reactions"] = strOption("A + B <=> AB");
+        QVERIFY(model->DefineModel(def));
+        QCOMPARE(model->SeriesCount(), 3);
+        model->InitialGuess();
+        model->setGlobalParameter(logK, 0);
+        model->ProjectLinearParameters(); // the VarPro linear step: abstract spectra for this constant
+        model->Calculate();
+
+        AbstractTitrationModel* tm = qobject_cast<AbstractTitrationModel*>(model.data());
+        QVERIFY(tm);
+        const Eigen::MatrixXd spectra = tm->ReconstructLocalSpectra();
+        QCOMPARE(int(spectra.rows()), 3);
+        QCOMPARE(int(spectra.cols()), W);
+        for (int j = 0; j < 3; ++j)
+            QVERIFY2((spectra.row(j) - E.row(j)).cwiseAbs().maxCoeff() < 1e-2 * E.row(j).cwiseAbs().maxCoeff(),
+                qPrintable(QString("species spectrum %1 not recovered").arg(j)));
+
+        Eigen::MatrixXd modelC(N, 3); // the solver's concentrations, which the fit actually used
+        for (int i = 0; i < N; ++i)
+            modelC.row(i) = tm->getConcentration(i).segment(1, 3).transpose();
+        const double full = (Y - modelC * spectra).squaredNorm();
+        const double compressed = model->SSE() + tm->SpectralFitBasis().DiscardedSSE();
+        QVERIFY2(relError(compressed, full) < 1e-6,
+            qPrintable(QString("full SSE %1 vs compressed + truncated %2").arg(full).arg(compressed)));
+        delete data;
+    }
+
+    // A stored basis survives the round trip, and one whose vectors do not match its rank is refused
+    // instead of being used with out-of-range singular values.
+    void testSpectralBasisJson()
+    {
+        const int N = 12, W = 20;
+        QVector<double> x(W);
+        Eigen::MatrixXd Y(N, W);
+        for (int w = 0; w < W; ++w) {
+            x[w] = 300.0 + 5.0 * w;
+            for (int i = 0; i < N; ++i)
+                Y(i, w) = std::exp(-std::pow((x[w] - 350.0) / 30.0, 2)) * i + 0.1 * std::sin(0.3 * i * w);
+        }
+        const SpectralBasis basis = SpectralBasis::Compute(Y, x, 2);
+        const QJsonObject json = basis.toJson();
+
+        const SpectralBasis restored = SpectralBasis::fromJson(json);
+        QVERIFY(restored.isValid());
+        QCOMPARE(restored.Components(), 2);
+        QVERIFY(restored.SingularValues() == basis.SingularValues());
+        QVERIFY(restored.Loadings() == basis.Loadings());
+        QCOMPARE(restored.DiscardedSSE(), basis.DiscardedSSE());
+
+        QJsonObject fewer = json;
+        fewer["singular"] = QString::number(basis.SingularValues()(0), 'g', 17); // one value, two loadings
+        QVERIFY(!SpectralBasis::fromJson(fewer).isValid());
+
+        QJsonObject more = json;
+        QStringList values;
+        for (int i = 0; i <= W; ++i)
+            values << QString::number(1.0);
+        more["singular"] = values.join(" "); // more singular values than wavelengths
+        QVERIFY(!SpectralBasis::fromJson(more).isValid());
+
+        QJsonObject shortX = json;
+        QStringList xs = json["x"].toString().split(' ');
+        xs.removeLast();
+        shortX["x"] = xs.join(" ");
+        QVERIFY(!SpectralBasis::fromJson(shortX).isValid());
+    }
 };
 
 QTEST_MAIN(TestUvVisAny)
@@ -76,6 +76,24 @@ private:
         return data;
     }
 
+    // Model evaluations of a fresh nmr_any fit with the given solver.
+    static qint64 evaluations(const QString& solver, const QString& reactions, DataClass* data)
+    {
+        QSharedPointer<AbstractModel> model = CreateModel(SupraFit::nmr_any, data);
+        QJsonObject def;
+        def["Reactions"] = strOption(reactions);
+        model->DefineModel(def);
+        QJsonObject cfg = model->getOptimizerConfig();
+        cfg["FitSolver"] = solver;
+        model->setOptimizerConfig(cfg);
+        model->InitialGuess();
+        Minimizer m(false);
+        m.setCached(false);
+        m.setModel(model);
+        m.Minimize();
+        return m.History().evaluations;
+    }
+
     // Fit a fresh model of @p modelId with the given solver; return SSE and fitted global betas.
     static double fit(int modelId, const QString& solver, const QString& reactions, DataClass* data, QVector<double>& betas)
     {
@@ -209,6 +227,53 @@ private slots:
         delete data;
     }
 
+    // VarProBroyden only replaces most finite-difference Jacobians by rank-one updates; it must reach
+    // the optimum of the classic solver.
+    void varProBroyden()
+    {
+        const int series = 4;
+        const QString reactions = QStringLiteral("A + B <=> AB\nA + 2 B <=> AB2");
+        const QList<double> betas{ 3.8, 5.9 };
+
+        DataClass* data = makeData(series);
+        {
+            QSharedPointer<AbstractModel> truth = CreateModel(SupraFit::nmr_any, data);
+            QJsonObject def;
+            def["Reactions"] = strOption(reactions);
+            truth->DefineModel(def);
+            truth->InitialGuess();
+            for (int k = 0; k < betas.size(); ++k)
+                truth->setGlobalParameter(betas[k], k);
+            for (int s = 0; s < series; ++s)
+                for (int p = 0; p < truth->LocalParameterSize(); ++p)
+                    truth->setLocalParameter(9.0 * (1.0 - 0.1 * p - 0.07 * s), p, s);
+            truth->Calculate();
+            data->setDependentTable(new DataTable(truth->ModelTable()->Table()));
+        }
+
+        QVector<double> betaLev, betaBroyden;
+        const double sseLev = fit(SupraFit::nmr_any, QStringLiteral("LevMar"), reactions, data, betaLev);
+        const double sseBroyden = fit(SupraFit::nmr_any, QStringLiteral("VarProBroyden"), reactions, data, betaBroyden);
+        const double floor = 1e-10 * data->DependentModel()->Table().squaredNorm();
+        qInfo().noquote() << QString("[varProBroyden] SSE LevMar=%1 VarProBroyden=%2").arg(sseLev, 0, 'g', 4).arg(sseBroyden, 0, 'g', 4);
+
+        QVERIFY(std::isfinite(sseBroyden));
+        QVERIFY2(sseBroyden <= qMax(sseLev, floor) * 1.05 + 1e-12,
+            qPrintable(QString("VarProBroyden SSE %1 worse than LevMar %2").arg(sseBroyden).arg(sseLev)));
+        for (int k = 0; k < betas.size() && sseBroyden < floor; ++k)
+            QVERIFY2(std::abs(betaBroyden[k] - betas[k]) < 1e-2,
+                qPrintable(QString("global %1: VarProBroyden %2 did not recover truth %3").arg(k).arg(betaBroyden[k]).arg(betas[k])));
+
+        // The point of the updates: fewer model evaluations than the finite-difference VarPro. Only
+        // the two constants are differentiated, so the saving is smaller than for BlockLevMar.
+        const qint64 plain = evaluations(QStringLiteral("VarPro"), reactions, data);
+        const qint64 broyden = evaluations(QStringLiteral("VarProBroyden"), reactions, data);
+        qInfo().noquote() << QString("[varProBroyden] evaluations VarPro=%1 VarProBroyden=%2").arg(plain).arg(broyden);
+        QVERIFY(plain > 0);
+        QVERIFY2(broyden < plain, qPrintable(QString("VarProBroyden took %1 evaluations, VarPro %2").arg(broyden).arg(plain)));
+        delete data;
+    }
+
     // Approach B: the analytic outer-fit Jacobian d(residual)/d(log10 beta) (implicit-function
     // sensitivities of the speciation) must match central finite differences of the residual at the
     // SAME (fixed) linear locals - the Kaufman VarPro Jacobian. Claude Generated.
@@ -0,0 +1,366 @@
+/*
+ * SupraFit - WorkerPool: resampling batches on worker processes
+ * Copyright (C) 2016 - 2026 Conrad Hübler <Conrad.Huebler@gmx.net>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The workers refit the same steps from the same start parameters as the threads, so a sharded Monte
+ * Carlo must give bit for bit the threaded result. Workers that report an error or hang are stopped
+ * without taking the coordinator down: the test starts itself as such a worker (--fake-worker).
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+
+#include <QtTest/QtTest>
+
+#include <QtCore/QBuffer>
+#include <QtCore/QCborMap>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMap>
+#include <QtCore/QScopeGuard>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+
+#include <Eigen/Dense>
+
+#include "src/capabilities/abstractsearchclass.h"
+#include "src/capabilities/jobmanager.h"
+#include "src/capabilities/workerpool.h"
+
+#include "src/core/minimizer.h"
+#include "src/core/models/AbstractModel.h"
+#include "src/core/models/dataclass.h"
+#include "src/core/models/datatable.h"
+#include "src/core/models/models.h"
+#include "src/global.h"
+
+namespace {
+/* A queue of batches for WorkerPool::Process(), nothing is fitted in this process */
+class BatchQueue : public AbstractSearchClass {
+public:
+    inline void Enqueue(const QHash<int, Pair>& batch) { m_batch.enqueue(batch); }
+    inline bool Run() override { return true; }
+};
+
+/* Greets like suprafit_worker, then answers every batch with an error ("error") or never ("silent") */
+int FakeWorker(const QByteArray& mode)
+{
+    QFile input, output;
+    if (!input.open(stdin, QIODevice::ReadOnly | QIODevice::Unbuffered) || !output.open(stdout, QIODevice::WriteOnly | QIODevice::Unbuffered))
+        return 1;
+
+    QCborMap hello;
+    hello[QStringLiteral("type")] = QStringLiteral("hello");
+    hello[QStringLiteral("protocol")] = WorkerProtocol::Version;
+    WorkerProtocol::WriteFrame(&output, hello);
+
+    QCborMap message;
+    while (WorkerProtocol::ReadFrame(&input, message)) {
+        const QString type = message[QStringLiteral("type")].toString();
+        if (type == QLatin1String("quit"))
+            break;
+        if (type == QLatin1String("batch") && mode == "error") {
+            QCborMap error;
+            error[QStringLiteral("type")] = QStringLiteral("error");
+            error[QStringLiteral("message")] = QStringLiteral("refused");
+            WorkerProtocol::WriteFrame(&output, error);
+        }
+    }
+    return 0;
+}
+}
+
+class TestWorkerPool : public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr int N = 24;
+    static constexpr double A0 = 1e-3;
+
+    static QJsonObject strOption(const QString& value)
+    {
+        QJsonObject o;
+        o["value"] = value;
+        return o;
+    }
+
+    static QSharedPointer<AbstractModel> createModel(DataClass* data)
+    {
+        QSharedPointer<AbstractModel> model = CreateModel(SupraFit::nmr_any, data);
+        QJsonObject def;
+        def["Reactions"] = strOption(QStringLiteral("A + B <=> AB\nA + 2 B <=> AB2"));
+        model->DefineModel(def);
+        return model;
+    }
+
+    // Noisy host-constant / guest-titrated nmr_any 1:1/1:2 data, so Monte Carlo has a spread.
+    static DataClass* makeData()
+    {
+        const int series = 2;
+        Eigen::MatrixXd indep(N, 2);
+        Eigen::MatrixXd dep = Eigen::MatrixXd::Zero(N, series);
+        for (int i = 0; i < N; ++i) {
+            indep(i, 0) = A0;
+            indep(i, 1) = 3e-3 * i / (N - 1);
+        }
+        DataClass* data = new DataClass();
+        data->setIndependentTable(new DataTable(indep));
+        data->setDataType(DataClassPrivate::Table);
+        data->setSimulateDependent(series);
+        data->setDependentTable(new DataTable(dep));
+        data->setDataBegin(0);
+        data->setDataEnd(N);
+
+        QSharedPointer<AbstractModel> truth = createModel(data);
+        truth->InitialGuess();
+        truth->setGlobalParameter(3.8, 0);
+        truth->setGlobalParameter(5.9, 1);
+        for (int s = 0; s < series; ++s)
+            for (int p = 0; p < truth->LocalParameterSize(); ++p)
+                truth->setLocalParameter(9.0 * (1.0 - 0.1 * p - 0.07 * s), p, s);
+        truth->Calculate();
+        Eigen::MatrixXd signal = truth->ModelTable()->Table();
+        std::mt19937 gen(1234);
+        std::normal_distribution<double> noise(0.0, 0.01);
+        for (int r = 0; r < signal.rows(); ++r)
+            for (int c = 0; c < signal.cols(); ++c)
+                signal(r, c) += noise(gen);
+        data->setDependentTable(new DataTable(signal));
+        return data;
+    }
+
+    static QSharedPointer<AbstractModel> fittedModel(DataClass* data)
+    {
+        QSharedPointer<AbstractModel> model = createModel(data);
+        model->InitialGuess();
+        Minimizer minimizer(false);
+        minimizer.setCached(false);
+        minimizer.setModel(model);
+        minimizer.Minimize();
+        model->Calculate();
+        return model;
+    }
+
+    // Global-parameter (mean, stddev) of the newest Monte Carlo block of @p model.
+    static QMap<int, QPair<double, double>> globalBox(const QSharedPointer<AbstractModel>& model)
+    {
+        QMap<int, QPair<double, double>> out;
+        const QJsonObject methods = model->ExportModel().value("data").toObject().value("methods").toObject();
+        int newest = -1;
+        for (const QString& key : methods.keys())
+            newest = qMax(newest, key.toInt());
+        const QJsonObject block = methods.value(QString::number(newest)).toObject();
+        for (const QString& key : block.keys()) {
+            const QJsonObject parameter = block.value(key).toObject();
+            if (parameter.value("type").toString() != QLatin1String("Global Parameter") || !parameter.contains("boxplot"))
+                continue;
+            const QJsonObject box = parameter.value("boxplot").toObject();
+            out.insert(parameter.value("index").toString().toInt(), qMakePair(box.value("mean").toDouble(), box.value("stddev").toDouble()));
+        }
+        return out;
+    }
+
+    static QMap<int, QPair<double, double>> runMC(const QSharedPointer<AbstractModel>& model)
+    {
+        QJsonObject job = MonteCarloConfigBlock;
+        job["MaxSteps"] = 64;
+        job["RandomSeed"] = 4711;
+        job["VarianceSource"] = 2;
+        job["Method"] = static_cast<int>(SupraFit::Method::MonteCarlo);
+        job.remove("timestamp");
+        model->Calculate();
+
+        JobManager manager;
+        manager.setExecutionContext(ExecutionContext(2));
+        manager.setModel(model);
+        manager.AddSingleJob(job);
+        manager.RunJobs();
+        return globalBox(model);
+    }
+
+    // A pool of @p count copies of this test running as --fake-worker @p mode.
+    static void fakeWorkers(WorkerPool& pool, const QString& mode, int count)
+    {
+        QStringList commands;
+        for (int i = 0; i < count; ++i)
+            commands << QString("\"%1\" --fake-worker %2").arg(QCoreApplication::applicationFilePath(), mode);
+        pool.setWorkers(0);
+        pool.setCommands(commands);
+    }
+
+private slots:
+    // Frames may arrive in pieces; the matrices inside must come out bit for bit, NaN included.
+    void protocolRoundTrip()
+    {
+        Eigen::MatrixXd matrix = Eigen::MatrixXd::Random(7, 3);
+        matrix(2, 1) = std::numeric_limits<double>::quiet_NaN();
+        matrix(4, 0) = 1.0 / 3.0;
+        QCborMap message;
+        message[QStringLiteral("type")] = QStringLiteral("batch");
+        message[QStringLiteral("global")] = WorkerProtocol::FromMatrix(matrix);
+        const QByteArray frame = WorkerProtocol::Frame(message);
+
+        QByteArray buffer = frame.left(frame.size() / 2);
+        QCborMap received;
+        QVERIFY(!WorkerProtocol::TakeFrame(buffer, received));
+        buffer += frame.mid(frame.size() / 2) + frame;
+        QVERIFY(WorkerProtocol::TakeFrame(buffer, received));
+        QCOMPARE(buffer, frame);
+
+        const Eigen::MatrixXd copy = WorkerProtocol::ToMatrix(received[QStringLiteral("global")]);
+        QCOMPARE(copy.rows(), matrix.rows());
+        QCOMPARE(copy.cols(), matrix.cols());
+        QVERIFY(std::memcmp(copy.data(), matrix.data(), matrix.size() * sizeof(double)) == 0);
+    }
+
+    // Sharding the Monte Carlo batches over worker processes reproduces the threaded run exactly: the
+    // workers refit the same steps from the same start parameters and the blocks merge in step order.
+    void shardedMonteCarloMatchesThreads()
+    {
+        const QString worker = QStringLiteral(SUPRAFIT_WORKER);
+        if (!QFileInfo(worker).isExecutable())
+            QSKIP("suprafit_worker was not built");
+
+        DataClass* data = makeData();
+        QSharedPointer<AbstractModel> model = fittedModel(data);
+
+        const QMap<int, QPair<double, double>> threaded = runMC(model);
+
+        const QVariant workers = qApp->property("workers");
+        const QVariant program = qApp->property("WorkerProgram");
+        const auto restore = qScopeGuard([&workers, &program]() {
+            qApp->setProperty("workers", workers);
+            qApp->setProperty("WorkerProgram", program);
+        });
+        qApp->setProperty("workers", 2);
+        qApp->setProperty("WorkerProgram", worker);
+        const QMap<int, QPair<double, double>> sharded = runMC(model);
+
+        QCOMPARE(sharded.size(), threaded.size());
+        QVERIFY(!sharded.isEmpty());
+        for (auto it = threaded.constBegin(); it != threaded.constEnd(); ++it) {
+            const QPair<double, double> other = sharded.value(it.key());
+            QVERIFY2(other.first == it.value().first && other.second == it.value().second,
+                qPrintable(QString("mean %1 / stddev %2 (workers) vs %3 / %4 (threads)")
+                               .arg(other.first, 0, 'g', 17)
+                               .arg(other.second, 0, 'g', 17)
+                               .arg(it.value().first, 0, 'g', 17)
+                               .arg(it.value().second, 0, 'g', 17)));
+        }
+        delete data;
+    }
+
+    // A batch answered by an "error" frame moves to the other worker and goes back to the queue of the
+    // threads after its second failure - once, each worker having seen it.
+    void errorFrameFailsOverOnce()
+    {
+        DataClass* data = makeData();
+        QSharedPointer<AbstractModel> model = createModel(data);
+        model->InitialGuess();
+
+        WorkerPool pool;
+        fakeWorkers(pool, QStringLiteral("error"), 2);
+        QStringList messages;
+        connect(&pool, &WorkerPool::Message, this, [&messages](const QString& message) { messages << message; });
+
+        BatchQueue queue;
+        queue.Enqueue({ { 0, Pair() } });
+        QVERIFY(!pool.Process(&queue, model, WorkerPool::Task()));
+
+        QCOMPARE(messages.filter(QStringLiteral("Worker error")).size(), 2);
+        QCOMPARE(messages.filter(QStringLiteral("left to the threads")).size(), 1);
+        QCOMPARE(queue.Queued(), 1);
+        QCOMPARE(pool.Results().Count(), 0);
+        delete data;
+    }
+
+    // A setup without its data tables is answered with an error frame instead of taking the worker
+    // down, and so is every batch until a complete setup arrives.
+    void incompleteSetupAnswersError()
+    {
+        DataClass* data = makeData();
+        QSharedPointer<AbstractModel> model = createModel(data);
+        model->InitialGuess();
+
+        QCborMap setup;
+        setup[QStringLiteral("type")] = QStringLiteral("setup");
+        setup[QStringLiteral("model")] = QCborValue::fromJsonValue(model->ExportModel(false, false));
+        setup[QStringLiteral("data")] = QCborValue::fromJsonValue(model->ExportData());
+        setup[QStringLiteral("independent")] = WorkerProtocol::FromTable(model->IndependentModel());
+        QCborMap batch;
+        batch[QStringLiteral("type")] = QStringLiteral("batch");
+        QCborMap quit;
+        quit[QStringLiteral("type")] = QStringLiteral("quit");
+
+        QBuffer input, output;
+        input.setData(WorkerProtocol::Frame(setup) + WorkerProtocol::Frame(batch) + WorkerProtocol::Frame(quit));
+        QVERIFY(input.open(QIODevice::ReadOnly));
+        QVERIFY(output.open(QIODevice::WriteOnly));
+        QCOMPARE(WorkerProtocol::Serve(&input, &output), 0);
+
+        QByteArray answers = output.data();
+        QStringList types;
+        QCborMap message;
+        while (WorkerProtocol::TakeFrame(answers, message))
+            types << message[QStringLiteral("type")].toString();
+        QCOMPARE(types, QStringList({ QStringLiteral("hello"), QStringLiteral("error"), QStringLiteral("error") }));
+        delete data;
+    }
+
+    // Interrupt() stops workers that are busy with a batch they never finish, and Process() returns.
+    void interruptBusyPool()
+    {
+        DataClass* data = makeData();
+        QSharedPointer<AbstractModel> model = createModel(data);
+        model->InitialGuess();
+
+        WorkerPool pool;
+        fakeWorkers(pool, QStringLiteral("silent"), 2);
+
+        BatchQueue queue;
+        queue.Enqueue({ { 0, Pair() } });
+        queue.Enqueue({ { 1, Pair() } });
+        QTimer::singleShot(300, &pool, &WorkerPool::Interrupt);
+
+        QElapsedTimer timer;
+        timer.start();
+        QVERIFY(!pool.Process(&queue, model, WorkerPool::Task()));
+        QVERIFY(pool.Interrupted());
+        QVERIFY(timer.elapsed() < 20000);
+        delete data;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    if (argc > 2 && std::strcmp(argv[1], "--fake-worker") == 0)
+        return FakeWorker(argv[2]);
+
+    QCoreApplication app(argc, argv);
+    TestWorkerPool test;
+    QTEST_SET_MAIN_SOURCE_PATH
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "test_workerpool.moc"
@@ -21,6 +21,7 @@
 
 #include "src/core/models/AbstractModel.h"
 #include "src/core/models/dataclass.h"
+#include "src/core/seriesdecimation.h"
 #include "src/core/toolset.h"
 
 #include <QtCharts/QAbstractSeries>
@@ -40,6 +41,11 @@ ChartWrapper::ChartWrapper(QObject* parent)
     , m_blocked(false)
     , m_transformed(false)
 {
+    m_update_timer = new QTimer(this);
+    m_update_timer->setSingleShot(true);
+    m_update_timer->setInterval(0);
+    connect(m_update_timer, &QTimer::timeout, this, &ChartWrapper::ApplyScheduledUpdate);
+
 #ifdef DEBUG_ON
     qDebug() << "🆕 NEW ChartWrapper: Simplified drop-in replacement created";
 #endif
@@ -99,9 +105,9 @@ void ChartWrapper::setData(QSharedPointer<DataClass> model)
     // Claude Generated: Safe signal connections with null checking
     if (auto strongData = m_stored_data.toStrongRef()) {
         if (qobject_cast<AbstractModel*>(strongData.data())) {
-            connect(qobject_cast<AbstractModel*>(strongData.data()), &AbstractModel::Recalculated, this, &ChartWrapper::UpdateModel);
+            connect(qobject_cast<AbstractModel*>(strongData.data()), &AbstractModel::Recalculated, this, &ChartWrapper::ScheduleUpdate);
         }
-        connect(strongData.data()->Info(), &DataClassPrivateObject::Update, this, &ChartWrapper::UpdateModel);
+        connect(strongData.data()->Info(), &DataClassPrivateObject::Update, this, &ChartWrapper::ScheduleUpdate);
         
         // Claude Generated: Connect to model destruction for cleanup
         connect(strongData.data(), &QObject::destroyed, this, [this]() {
@@ -136,12 +142,83 @@ void ChartWrapper::UpdateModel()
     if (QCoreApplication::closingDown()) {
         return;  // Don't update during application shutdown
     }
-    
+
+    m_rebuild_pending = false;
     CheckWorking();
     MakeSeries();
     emit ModelChanged();
 }
 
+void ChartWrapper::ScheduleUpdate()
+{
+    m_rebuild_pending = true;
+    m_update_timer->start();
+}
+
+void ChartWrapper::setViewport(qreal xmin, qreal xmax, int pixels)
+{
+    if (xmin == m_view_min && xmax == m_view_max && pixels == m_view_pixels)
+        return;
+
+    m_view_min = xmin;
+    m_view_max = xmax;
+    m_view_pixels = pixels;
+    m_update_timer->start();
+}
+
+void ChartWrapper::ApplyScheduledUpdate()
+{
+    if (QCoreApplication::closingDown())
+        return;
+
+    if (m_rebuild_pending) {
+        UpdateModel();
+        return;
+    }
+
+    // Only the viewport changed: the full-resolution data is still valid, redraw its level of detail
+    for (int i = 0; i < m_stored_series.size(); ++i)
+        updateSeriesDisplay(i);
+}
+
+void ChartWrapper::TrackViewport()
+{
+    if (m_view_axis)
+        return;
+
+    for (const QPointer<QXYSeries>& series : qAsConst(m_stored_series)) {
+        if (!series)
+            continue;
+        const QList<QAbstractAxis*> axes = series->attachedAxes();
+        for (QAbstractAxis* axis : axes) {
+            QValueAxis* value_axis = qobject_cast<QValueAxis*>(axis);
+            if (!value_axis || value_axis->orientation() != Qt::Horizontal)
+                continue;
+
+            m_view_axis = value_axis;
+            QPointer<QXYSeries> tracked = series;
+            connect(value_axis, &QValueAxis::rangeChanged, this, [this, tracked](qreal min, qreal max) {
+                const int pixels = (tracked && tracked->chart()) ? int(tracked->chart()->plotArea().width()) : m_view_pixels;
+                setViewport(min, max, pixels);
+            });
+            m_view_min = value_axis->min();
+            m_view_max = value_axis->max();
+            if (series->chart())
+                m_view_pixels = int(series->chart()->plotArea().width());
+            return;
+        }
+    }
+}
+
+int ChartWrapper::PointBudget() const
+{
+    // MaxSeriesPoints caps the points drawn inside the viewport; 0 means two per horizontal pixel
+    const int maxdata = qApp->instance()->property("MaxSeriesPoints").toInt();
+    if (maxdata > 0)
+        return maxdata;
+    return m_view_pixels > 0 ? 2 * m_view_pixels : 2000;
+}
+
 void ChartWrapper::MakeSeries()
 {
     // Claude Generated: Safety check during shutdown
@@ -161,18 +238,14 @@ void ChartWrapper::MakeSeries()
         return;
     }
 
-    QVector<QList<QPointF>> series(m_stored_series.size());
+    /* The series keep every point; what is drawn is reduced to the viewport in updateSeriesDisplay() */
+    QVector<QVector<QPointF>> series(m_stored_series.size());
     int rows = workingData->DataPoints();
     int cols = workingData->SeriesCount();
-    int maxdata = qApp->instance()->property("MaxSeriesPoints").toInt();
-
-    if (maxdata == 0)
-        maxdata = 100000;
-
-    int start = 0;
-    int step = qMax(1, int(rows / maxdata));
+    for (auto& points : series)
+        points.reserve(rows);
 
-    for (int i = start; i < rows; i += step) {
+    for (int i = 0; i < rows; ++i) {
         // Claude Generated: Use PrintOutIndependent for x-coordinate like legacy code
         double x = workingData->PrintOutIndependent(i);
         if (!workingData->IndependentModel()->isChecked(i))
@@ -192,16 +265,18 @@ void ChartWrapper::MakeSeries()
         if (m_stored_series[j]) {
             QXYSeries* xySeries = qobject_cast<QXYSeries*>(m_stored_series[j]);
             if (xySeries) {
-                xySeries->replace(series[j]);
-
                 // Update point data for selective hiding feature
                 if (j >= m_pointData.size()) {
                     m_pointData.resize(j + 1);
                 }
+                // Hidden points survive a recalculation as long as the series keeps its length
+                if (m_pointData[j].pointVisible.size() != series[j].size()) {
+                    m_pointData[j].pointVisible.resize(series[j].size());
+                    m_pointData[j].pointVisible.fill(true); // All points visible by default
+                }
                 m_pointData[j].originalData = series[j];
-                m_pointData[j].pointVisible.resize(series[j].size());
-                m_pointData[j].pointVisible.fill(true); // All points visible by default
                 m_pointData[j].invalidateCache();
+                updateSeriesDisplay(j);
 
 #ifdef DEBUG_ON
                 qDebug() << "🔧 NEW ChartWrapper: Updated series" << j << "with" << series[j].size() << "points, all visible by default";
@@ -473,8 +548,15 @@ void ChartWrapper::updateSeriesDisplay(int seriesIndex)
     if (!series)
         return;
 
-    // Rebuild series with visible points only
-    QVector<QPointF> visiblePoints = m_pointData[seriesIndex].getVisiblePoints();
+    // Rebuild series with visible points only, reduced to the level of detail of the viewport
+    TrackViewport();
+    const QVector<QPointF> visiblePoints = SeriesDecimation::LevelOfDetail(m_pointData[seriesIndex].getVisiblePoints(),
+        m_view_min, m_view_max, PointBudget(), qobject_cast<LineSeries*>(series) != nullptr);
+
+    // A parameter change that leaves this series untouched (or a pan within the same detail) costs no redraw
+    if (visiblePoints == m_pointData[seriesIndex].displayed)
+        return;
+    m_pointData[seriesIndex].displayed = visiblePoints;
     series->replace(visiblePoints);
 
 #ifdef DEBUG_ON
@@ -29,10 +29,12 @@
 #include <QtCore/QObject>
 #include <QtCore/QPointer>
 #include <QtCore/QThread>
+#include <QtCore/QTimer>
 
 #include <QtCharts/QBoxPlotSeries>
 #include <QtCharts/QLineSeries>
 #include <QtCharts/QScatterSeries>
+#include <QtCharts/QValueAxis>
 #include <QtCharts/QVXYModelMapper>
 #include <QtCharts/QXYSeries>
 
@@ -138,6 +140,14 @@ public slots:
     void showSeries(int i);
     void SetBlocked(int blocked);
 
+    /*! \brief Coalescing variant of UpdateModel(): any number of calls within one event loop turn
+     * rebuild the series once. Connected to Recalculated and ModelChanged. */
+    void ScheduleUpdate();
+
+    /*! \brief Visible x range and plot width in pixels; the series are redrawn at the matching
+     * level of detail. Normally tracked from the attached x axis, see TrackViewport(). */
+    void setViewport(qreal xmin, qreal xmax, int pixels);
+
 private:
     // === CORE DATA STORAGE - Claude Generated ===
     // All model references are WEAK to prevent circular dependencies and enable proper cleanup
@@ -149,8 +159,9 @@ private:
 
     // === POINT HIDING STORAGE - Claude Generated ===
     struct SeriesPointData {
-        QVector<QPointF> originalData; // All original points
+        QVector<QPointF> originalData; // All original points, full resolution
         QVector<bool> pointVisible; // Visibility per point
+        QVector<QPointF> displayed; // Level-of-detail points last handed to the series
         bool cacheValid = false;
         mutable QVector<QPointF> visibleCache;
 
@@ -164,10 +175,20 @@ private:
     bool m_transformed = false;
     bool m_flipable = false;
 
+    // === LEVEL OF DETAIL ===
+    QTimer* m_update_timer = nullptr;
+    bool m_rebuild_pending = false;
+    qreal m_view_min = 0, m_view_max = 0;
+    int m_view_pixels = 0;
+    QPointer<QValueAxis> m_view_axis;
+
     // === PRIVATE METHODS - Claude Generated ===
     void InitaliseSeries();
     void CheckWorking();
     void updateSeriesDisplay(int seriesIndex); // Rebuild series with visible points only
+    void TrackViewport();
+    void ApplyScheduledUpdate();
+    int PointBudget() const;
 
 signals:
     void ModelChanged();
@@ -135,6 +135,12 @@ void ChartDockTitleBar::ThemeChange(QAction* action)
 ChartWidget::ChartWidget()
     : m_TitleBarWidget(new ChartDockTitleBar)
 {
+    // Bursts of Recalculated (spin boxes, live fits) are drawn once per frame
+    m_repaint_timer = new QTimer(this);
+    m_repaint_timer->setSingleShot(true);
+    m_repaint_timer->setInterval(16);
+    connect(m_repaint_timer, &QTimer::timeout, this, &ChartWidget::Repaint);
+
     m_signalview = new ChartView;
     m_signalview->setName("signalview");
     connect(m_signalview, &ChartView::lastDirChanged, this, [](const QString& str) {
@@ -324,7 +330,6 @@ Charts ChartWidget::addModel(QSharedPointer<AbstractModel> model, QObject* wrapp
 
     double lineWidth = qApp->instance()->property("lineWidth").toDouble() / 10.0;
     m_empty = false;
-    connect(model.data(), SIGNAL(Recalculated()), this, SLOT(Repaint()));
 
     // Claude Generated: Use provided parent (ModelWidget) instead of ChartWidget for proper cleanup
     QObject* parent = wrapperParent ? wrapperParent : this;
@@ -334,7 +339,7 @@ Charts ChartWidget::addModel(QSharedPointer<AbstractModel> model, QObject* wrapp
     qDebug() << "🔧 ChartWidget::addModel: Created ChartWrapper with parent:" << parent->metaObject()->className();
 #endif
 
-    connect(m_data_mapper.data(), SIGNAL(ModelChanged()), signal_wrapper.data(), SLOT(UpdateModel()));
+    connect(m_data_mapper.data(), SIGNAL(ModelChanged()), signal_wrapper.data(), SLOT(ScheduleUpdate()));
     connect(m_data_mapper.data(), SIGNAL(ShowSeries(int)), signal_wrapper.data(), SLOT(showSeries(int)));
 
     DataTable* modelTable = model->ModelTable();
@@ -346,7 +351,7 @@ Charts ChartWidget::addModel(QSharedPointer<AbstractModel> model, QObject* wrapp
 
     QSharedPointer<ChartWrapper> error_wrapper = QSharedPointer<ChartWrapper>(new ChartWrapper(parent), &QObject::deleteLater);
 
-    connect(m_data_mapper.data(), SIGNAL(ModelChanged()), error_wrapper.data(), SLOT(UpdateModel()));
+    connect(m_data_mapper.data(), SIGNAL(ModelChanged()), error_wrapper.data(), SLOT(ScheduleUpdate()));
     connect(m_data_mapper.data(), SIGNAL(ShowSeries(int)), error_wrapper.data(), SLOT(showSeries(int)));
 
     DataTable* errorTable = model->ErrorTable();
@@ -445,7 +450,7 @@ Charts ChartWidget::addModel(QSharedPointer<AbstractModel> model, QObject* wrapp
         m_signal_y = model->YLabel();
         m_error_x = model->XLabel();
         m_error_y = tr("%1 (y<sub>calc</sub> - y<sub>exp</sub>)").arg(model->YLabel());
-        Repaint();
+        m_repaint_timer->start();
     });
 
     m_signal_x = model->XLabel();
@@ -30,6 +30,7 @@
 #include <QtCharts/QValueAxis>
 
 #include <QtCore/QPointer>
+#include <QtCore/QTimer>
 #include <QtCore/QVector>
 
 #include <QtWidgets/QWidget>
@@ -106,6 +107,7 @@ private:
     QString m_signal_x, m_signal_y, m_error_x, m_error_y;
 
     QColor m_recent_color;
+    QPointer<QTimer> m_repaint_timer;
 private slots:
     void formatAxis();
     void Repaint();
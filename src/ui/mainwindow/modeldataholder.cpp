@@ -60,6 +60,9 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QFile>
 #include <QtCore/QJsonObject>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
 
 #include <QtGui/QColor>
 
@@ -1255,21 +1258,27 @@ QJsonObject ModelDataHolder::SaveModel(int index)
 void ModelDataHolder::AddToWorkspace(const QJsonObject& object)
 {
     QStringList keys = object.keys();
+    keys.removeAll("data");
     setEnabled(false);
     m_wrapper.toStrongRef()->stopAnimiation();
 
-    for (const QString& key : qAsConst(keys)) {
-        if (key == "data")
-            continue;
+    AddModelsDeferred(object, keys);
+}
 
-        QApplication::processEvents();
-        QJsonObject model = object[key].toObject();
-        Json2Model(model);
+void ModelDataHolder::AddModelsDeferred(const QJsonObject& object, QStringList keys)
+{
+    /* One model per event loop turn, so the window repaints between them without processEvents() */
+    if (keys.isEmpty()) {
+        setEnabled(true);
+        m_wrapper.toStrongRef()->restartAnimation();
+        emit ModelAdded();
+        return;
     }
 
-    setEnabled(true);
-    m_wrapper.toStrongRef()->restartAnimation();
-    emit ModelAdded();
+    Json2Model(object[keys.takeFirst()].toObject());
+    QTimer::singleShot(0, this, [this, object, keys]() {
+        AddModelsDeferred(object, keys);
+    });
 }
 
 void ModelDataHolder::LoadCurrentProject(const QJsonObject& object)
@@ -1311,36 +1320,58 @@ void ModelDataHolder::CloseAllForced()
 
 void ModelDataHolder::RunJobs(const QJsonObject& job)
 {
-    Waiter wait;
-
-    int run = 0;
+    m_job_queue.clear();
     for (int i = 0; i < m_model_widgets.size(); ++i) {
         if (!m_model_widgets[i])
             continue;
         if (m_statistic_dialog->UseChecked() && !m_model_widgets[i]->isChecked())
             continue;
-        run++;
+        m_job_queue << m_model_widgets[i];
     }
-    m_statistic_dialog->MaximumMainSteps(run);
+    m_statistic_dialog->MaximumMainSteps(m_job_queue.size());
 
+    m_queued_job = job;
     m_allow_loop = true;
-    for (int i = 0; i < m_model_widgets.size(); ++i) {
-        if (!m_model_widgets[i])
-            continue;
+    RunNextJob();
+}
 
-        if (m_statistic_dialog->UseChecked() && !m_model_widgets[i]->isChecked())
-            continue;
+void ModelDataHolder::RunNextJob()
+{
+    /* The models are processed one after another; each JobManager runs in the background and the
+     * next model is started once the previous one reports AllFinished or its thread ends, so a
+     * manager that never reports AllFinished does not stall the models behind it */
+    while (!m_job_queue.isEmpty() && !m_job_queue.first())
+        m_job_queue.removeFirst();
+
+    if (m_job_queue.isEmpty() || !m_allow_loop) {
+        m_job_queue.clear();
+        m_statistic_dialog->HideWidget();
+        return;
+    }
 
-        if (i < m_modelsWidget->count())
-            m_modelsWidget->setCurrentIndex(i + 1);
+    QPointer<ModelWidget> widget = m_job_queue.takeFirst();
+    int index = m_model_widgets.indexOf(widget);
+    if (index < m_modelsWidget->count())
+        m_modelsWidget->setCurrentIndex(index + 1);
 
-        m_statistic_dialog->ShowWidget();
-        m_model_widgets[i]->setJob(job);
+    m_statistic_dialog->ShowWidget();
+    /* Whichever comes first moves the queue on, once */
+    auto connections = QSharedPointer<QList<QMetaObject::Connection>>::create();
+    auto advance = [this, connections]() {
+        if (connections->isEmpty())
+            return;
+        for (const QMetaObject::Connection& connection : std::as_const(*connections))
+            disconnect(connection);
+        connections->clear();
         m_statistic_dialog->IncrementMainProgress();
-        if (!m_allow_loop)
-            break;
-    }
-    m_statistic_dialog->HideWidget();
+        RunNextJob();
+    };
+    connections->append(connect(widget->Jobs(), &JobManager::AllFinished, this, advance));
+    widget->setJob(m_queued_job);
+    if (QThread* worker = widget->Jobs()->Worker())
+        connections->append(connect(worker, &QThread::finished, this, advance));
+    else
+        QMetaObject::invokeMethod(this, advance, Qt::QueuedConnection);
 }
 
 void ModelDataHolder::OptimizeAll()
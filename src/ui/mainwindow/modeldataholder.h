@@ -252,6 +252,8 @@ private:
     QPointer<StatisticDialog> m_statistic_dialog;
     QPointer<CompareDialog> m_compare_dialog;
     QVector<QPointer<ModelWidget>> m_model_widgets;
+    QList<QPointer<ModelWidget>> m_job_queue;
+    QJsonObject m_queued_job;
     void AddModel(int model, const QString& presetReactions = QString());
     void ActiveBatch();
 
@@ -285,6 +287,8 @@ private slots:
 
     void SetProjectTabName();
     void RunJobs(const QJsonObject& job);
+    void RunNextJob();
+    void AddModelsDeferred(const QJsonObject& object, QStringList keys);
 
     void OptimizeAll();
 
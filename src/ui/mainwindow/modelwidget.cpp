@@ -178,6 +178,15 @@ ModelWidget::ModelWidget(QSharedPointer<AbstractModel> model, Charts charts, boo
 
     Data2Text();
     m_minimizer->setModel(m_model);
+    m_minimizer->setProgressInterval(500);
+    connect(m_minimizer.data(), &Minimizer::Progress, this, &ModelWidget::PreviewMinimize);
+    connect(m_minimizer.data(), &Minimizer::MinimizationFinished, this, &ModelWidget::FinishMinimize);
+
+    // Spin box edits are previewed on a worker replica; the full calculation follows once editing stops
+    m_live_preview = new LivePreview(m_model, this);
+    connect(m_live_preview, &LivePreview::Settled, this, [this]() {
+        m_model->Calculate();
+    });
 
     m_advancedsearch = new AdvancedSearch(this);
     if (!m_model->isSimulation())
@@ -286,6 +295,11 @@ ModelWidget::ModelWidget(QSharedPointer<AbstractModel> model, Charts charts, boo
     QAction* minimize_normal = new QAction(tr("Tight"), this);
     connect(minimize_normal, SIGNAL(triggered()), this, SLOT(GlobalMinimize()));
 
+    m_stop_fit = new QAction(tr("Stop"), this);
+    m_stop_fit->setToolTip(tr("Stop the running fit and keep the best parameters found so far."));
+    m_stop_fit->setEnabled(false);
+    connect(m_stop_fit, &QAction::triggered, m_minimizer.data(), &Minimizer::Interrupt);
+
     QAction* minimize_loose = new QAction(tr("Progress"), this);
     connect(minimize_loose, SIGNAL(triggered()), this, SLOT(History()));
 
@@ -303,12 +317,18 @@ ModelWidget::ModelWidget(QSharedPointer<AbstractModel> model, Charts charts, boo
     QAction* solver_varpro = new QAction(tr("VarPro (projection)"), this);
     solver_varpro->setCheckable(true);
     solver_varpro->setData(QStringLiteral("VarPro"));
+    QAction* solver_block = new QAction(tr("Block LevMar (series structure)"), this);
+    solver_block->setCheckable(true);
+    solver_block->setData(QStringLiteral("BlockLevMar"));
+    solver_block->setToolTip(tr("Levenberg-Marquardt that eliminates the local parameters of each series blockwise; fast for many series and MetaModels."));
     QActionGroup* solver_group = new QActionGroup(this);
     solver_group->setExclusive(true);
     solver_group->addAction(solver_levmar);
     solver_group->addAction(solver_varpro);
+    solver_group->addAction(solver_block);
     m_solver_levmar = solver_levmar;
     m_solver_varpro = solver_varpro;
+    m_solver_block = solver_block;
     connect(solver_levmar, &QAction::triggered, this, [this]() {
         SetFitSolver(QStringLiteral("LevMar"));
         GlobalMinimize(); /* selecting a solver immediately (re)fits with it — Claude Generated */
@@ -317,6 +337,10 @@ ModelWidget::ModelWidget(QSharedPointer<AbstractModel> model, Charts charts, boo
         SetFitSolver(QStringLiteral("VarPro"));
         GlobalMinimize(); /* selecting a solver immediately (re)fits with it — Claude Generated */
     });
+    connect(solver_block, &QAction::triggered, this, [this]() {
+        SetFitSolver(QStringLiteral("BlockLevMar"));
+        GlobalMinimize();
+    });
 
     /* Speciation-solver selection (LevMar/Newton vs. legacy BFGS) for the reaction-driven *_any models.
        Writes the "SpeciationSolver" optimizer-config key, which AbstractTitrationModel/itc_any push into
@@ -345,11 +369,13 @@ ModelWidget::ModelWidget(QSharedPointer<AbstractModel> model, Charts charts, boo
 
     QMenu* menu = new QMenu(m_minimize_all);
     menu->addAction(minimize_normal);
+    menu->addAction(m_stop_fit);
     menu->addAction(minimize_loose);
     menu->addAction(fast_conf);
     menu->addSeparator();
     menu->addAction(solver_levmar);
     menu->addAction(solver_varpro);
+    menu->addAction(solver_block);
     QMenu* spec_menu = menu->addMenu(tr("Speciation solver"));
     spec_menu->setToolTip(tr("Equilibrium-concentration solver used by the reaction-driven models."));
     spec_menu->addAction(spec_levmar);
@@ -610,9 +636,7 @@ ModelWidget::ModelWidget(QSharedPointer<AbstractModel> model, Charts charts, boo
         PhaseTiming::Begin(QString("%1 on %2")
                                .arg(SupraFit::Method2Name(AccessCI(job, "Method").toInt()))
                                .arg(m_model->Name()));
-        QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-        this->m_jobmanager->AddSingleJob(job);
-        this->m_jobmanager->RunJobs();
+        StartJob(job);
     });
     connect(m_jobmanager, &JobManager::ShowResult, this, [this](SupraFit::Method type, int index) {
         if (type != SupraFit::Method::FastConfidence) {
@@ -620,17 +644,22 @@ ModelWidget::ModelWidget(QSharedPointer<AbstractModel> model, Charts charts, boo
             this->m_results->ShowResult(type, index);
         }
 
-        QApplication::restoreOverrideCursor();
         // The chart is on screen now — this is the end of what the user perceives as "running".
         PhaseTiming::Mark(QStringLiteral("render results widget + chart"));
         PhaseTiming::End();
     });
 
+    // Also reached on interrupt or when a job produced no result, so the cursor never stays busy
+    connect(m_jobmanager, &JobManager::AllFinished, this, [this]() {
+        if (m_jobs_running) {
+            m_jobs_running = false;
+            QApplication::restoreOverrideCursor();
+        }
+    });
+
     //connect(m_advancedsearch, &AdvancedSearch::Interrupt, m_jobmanager, &JobManager::Interrupt); //, Qt::DirectConnection);
     connect(m_advancedsearch, &AdvancedSearch::RunCalculation, m_jobmanager, [this](const QJsonObject& job) {
-        QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-        this->m_jobmanager->AddSingleJob(job);
-        this->m_jobmanager->RunJobs();
+        StartJob(job);
     });
     setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Minimum);
     m_SetUpFinished = true;
@@ -904,8 +933,7 @@ void ModelWidget::recalculate()
         return;
     m_pending = true;
     CollectParameters();
-    m_model->Calculate();
-    QTimer::singleShot(1, this, SLOT(Repaint()));
+    m_live_preview->Request();
     m_pending = false;
 }
 
@@ -990,9 +1018,12 @@ void ModelWidget::UpdateSolverMenu()
     const bool varpro = m_model->SupportsVarPro();
     m_solver_varpro->setEnabled(varpro);
     m_solver_varpro->setToolTip(varpro ? QString() : tr("Only available for nmr_any / uvvis_any models."));
-    const bool use_varpro = (varpro && solver == QLatin1String("VarPro"));
-    m_solver_levmar->setChecked(!use_varpro);
+    /* The analytic and Broyden variants are set in the optimizer settings; check their family here */
+    const bool use_varpro = (varpro && solver.startsWith(QLatin1String("VarPro")));
+    const bool use_block = solver.startsWith(QLatin1String("BlockLevMar"));
+    m_solver_levmar->setChecked(!use_varpro && !use_block);
     m_solver_varpro->setChecked(use_varpro);
+    m_solver_block->setChecked(use_block);
 
     /* Speciation solver: only meaningful for the reaction-driven models that use the SpeciationEngine. */
     const bool uses_engine = m_model->UsesSpeciationEngine();
@@ -1007,19 +1038,43 @@ void ModelWidget::UpdateSolverMenu()
 
 void ModelWidget::MinimizeModel(const QJsonObject& config)
 {
-    Waiter wait;
     if (m_pending)
         return;
     m_pending = true;
 
     CollectParameters();
     QJsonObject json = m_model->ExportModel(false, false);
-    QList<int> locked = m_model->LockedParameters();
     m_minimizer->setParameter(json);
 
     m_model->setOptimizerConfig(config);
-    int result;
-    result = m_minimizer->Minimize();
+
+    /* The fit runs on a clone in the thread pool; the window stays responsive, previews the best
+     * intermediate parameters and gets the final result in FinishMinimize() */
+    QApplication::setOverrideCursor(QCursor(Qt::BusyCursor));
+    m_stop_fit->setEnabled(true);
+    m_minimizer->MinimizeAsync();
+}
+
+void ModelWidget::PreviewMinimize(int iteration, qreal sse, const QJsonObject& best)
+{
+    if (!m_pending)
+        return;
+
+    emit Message(tr("Fitting %1: iteration %2, SSE %3").arg(m_model->Name()).arg(iteration).arg(sse));
+    if (best.isEmpty())
+        return;
+
+    m_model->ImportModel(best, false);
+    Repaint();
+}
+
+void ModelWidget::FinishMinimize(int result)
+{
+    if (!m_pending)
+        return;
+
+    m_stop_fit->setEnabled(false);
+    QApplication::restoreOverrideCursor();
 
     OptimisationHistory history = m_minimizer->History();
     int series = 0;
@@ -1038,7 +1093,7 @@ void ModelWidget::MinimizeModel(const QJsonObject& config)
         }
     }
     m_optimisationhistory << history;
-    json = m_minimizer->Parameter();
+    QJsonObject json = m_minimizer->Parameter();
     m_last_model = json;
     m_model->ImportModel(json, false);
     m_model->CollectOptimizationParameters();
@@ -1085,8 +1140,6 @@ void ModelWidget::ToggleStatisticDialog()
 
 void ModelWidget::FastConfidence()
 {
-    Waiter wait;
-
     QJsonObject job(ModelComparisonConfigBlock);
 
     job["FastConfidenceSteps"] = qApp->instance()->property("FastConfidenceSteps").toInt();
@@ -1099,19 +1152,29 @@ void ModelWidget::FastConfidence()
     job["IncludeSeries"] = qApp->instance()->property("series_confidence").toBool();
     job["Method"] = SupraFit::Method::FastConfidence;
 
-    m_jobmanager->AddSingleJob(job);
-    m_jobmanager->RunJobs();
+    StartJob(job);
 }
 
 void ModelWidget::setJob(const QJsonObject& job)
 {
-    Waiter wait;
+    StartJob(job);
+}
+
+void ModelWidget::StartJob(const QJsonObject& job)
+{
+    /* Jobs added while others run join the same queue and AllFinished() comes once for all of
+     * them, so the busy cursor is pushed once per queue, not once per job */
+    if (!m_jobs_running) {
+        m_jobs_running = true;
+        QApplication::setOverrideCursor(QCursor(Qt::BusyCursor));
+    }
     m_jobmanager->AddSingleJob(job);
-    m_jobmanager->RunJobs();
+    m_jobmanager->RunJobsAsync();
 }
 
 void ModelWidget::Interrupt()
 {
+    m_minimizer->Interrupt();
     m_jobmanager->Interrupt();
 }
 
@@ -22,6 +22,7 @@
 #include "src/core/models/AbstractModel.h"
 #include "src/core/models/dataclass.h"
 
+#include "src/core/livepreview.h"
 #include "src/core/minimizer.h"
 
 #include "src/ui/dialogs/modaldialog.h"
@@ -120,6 +121,7 @@ private:
 
     QSharedPointer<AbstractModel> m_model;
     QSharedPointer<Minimizer> m_minimizer;
+    QPointer<LivePreview> m_live_preview;
 
     QVector<QPointer<SpinBox>> m_constants;
     QVector<QPointer<ModelElement>> m_model_elements;
@@ -127,7 +129,8 @@ private:
     QPointer<StatisticDialog> m_statistic_dialog;
     ModelActions* m_actions;
     QPushButton* m_minimize_all;
-    QAction *m_solver_levmar, *m_solver_varpro; /* Fit-menu solver choice (LevMar/VarPro). Claude Generated. */
+    QAction* m_stop_fit;
+    QAction *m_solver_levmar, *m_solver_varpro, *m_solver_block; /* Fit-menu solver choice (LevMar/VarPro/BlockLevMar). Claude Generated. */
     QAction *m_speciation_levmar, *m_speciation_bfgs; /* Fit-menu speciation-solver choice. Claude Generated. */
     QMenu* m_speciation_menu; /* submenu holding the speciation-solver choice; disabled off-engine. CG. */
     QCheckBox *m_readonly, *m_legend;
@@ -143,10 +146,13 @@ private:
     void Data2Text();
     void Model2Text();
     void MinimizeModel(const QJsonObject& config);
+    void FinishMinimize(int result);
+    void PreviewMinimize(int iteration, qreal sse, const QJsonObject& best);
     void SetFitSolver(const QString& solver); /* Claude Generated */
     void SetSpeciationSolver(const QString& method); /* Claude Generated */
     void UpdateSolverMenu(); /* Claude Generated */
     void LoadStatistic(const QJsonObject& data);
+    void StartJob(const QJsonObject& job);
 
     QVBoxLayout* m_sign_layout;
     QLineEdit* m_model_name;
@@ -165,6 +171,7 @@ private:
     QList<QJsonObject> m_fast_confidence;
 
     JobManager* m_jobmanager;
+    bool m_jobs_running = false; ///< busy cursor pushed for the queue of m_jobmanager
 
     QPointer<QWidget> m_global_parameter, m_model_parameter, m_model_options,
         m_system_parameter, m_chai_widget, m_chai_execute;
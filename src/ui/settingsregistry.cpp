@@ -65,6 +65,8 @@ const QVector<SettingDef>& registry()
 
         // ---- General Settings ----
         v << Def("threads", ideal, Kind::Int).group(gGeneral).label(QObject::tr("Threads:")).range(1, 2 * ideal);
+        v << Def("workers", 0, Kind::Int).group(gGeneral).label(QObject::tr("Worker processes:")).range(0, 2 * ideal).tip(QObject::tr("Monte Carlo and cross validation refits run in this many separate processes, in addition to the threads for what is left. A crashing script model then only takes down its worker."));
+        v << Def("WorkerCommands", QString(), Kind::String).group(gGeneral).label(QObject::tr("Remote workers:")).tip(QObject::tr("Commands that start further workers, separated by ';', e.g. \"ssh node1 suprafit_worker\"."));
         v << Def("ScriptTimeout", 500, Kind::Int).group(gGeneral).label(QObject::tr("Timeout for Script Model (mscs):")).range(-1, 1e6);
         v << Def("ModelParameterColums", 2, Kind::Int).group(gGeneral).label(QObject::tr("Columns for Model Parameter:")).range(1, 1e6);
         v << Def("dirlevel", 1, Kind::Int).group(gGeneral).note(QObject::tr("Set directory behavior to:")).custom(); // directory-mode radio group (hand-built)
@@ -96,7 +98,13 @@ const QVector<SettingDef>& registry()
         v << Def("EntropyBins", 30, Kind::Int).group(gCalc).label(QObject::tr("# bins for Shannon Entropy Calculation")).range(10, 100000);
         v << Def("OverwriteBins", false, Kind::Bool).group(gCalc).label(QObject::tr("Overwrite stored bin number"));
         v << Def("FullShannon", false, Kind::Bool).group(gCalc).label(QObject::tr("Calculate full Shannon entropy!")).tip(QObject::tr("Calculate Shannon entropy including the discretisation term. Not recommended, as the ordering of appropriate parameters and models is reversed."));
-        v << Def("BC50IntegrationPoints", 10000, Kind::Int).group(gCalc).label(QObject::tr("# integration points for BC50")).range(20, 1000000).tip(QObject::tr("Number of Simpson panels for the BC50 integration. The substitution x = 1-t² makes the integrand smooth, so few points already suffice: the relative error stays below 1e-6 at 100 points, 1e-9 at 1000 and 1e-12 at 10000."));
+        v << Def("BC50Tolerance", -12, Kind::Int).group(gCalc).label(QObject::tr("BC50 integration tolerance (10^x)")).range(-14, -3).tip(QObject::tr("Relative error requested from the adaptive BC50 integration, as a power of ten. The integrand is smooth after the substitution x = 1-t², so even the default of 1e-12 needs only a few hundred evaluations per BC50."));
+        v << Def("FitCache", true, Kind::Bool).group(gCalc).label(QObject::tr("Reuse converged fits")).tip(QObject::tr("Store converged fits on disk and take the result from there if exactly the same model, data, start parameters and optimizer settings are fitted again."));
+        v << Def("FitCacheSize", 256, Kind::Int).group(gCalc).label(QObject::tr("Size of the fit cache (MB)")).range(1, 1e6).dependsOn("FitCache");
+        v << Def("Checkpoint", true, Kind::Bool).group(gCalc).label(QObject::tr("Checkpoint Monte Carlo and cross validation")).tip(QObject::tr("Write the finished refits of Monte Carlo and cross validation runs to a side file, so that an interrupted run can be continued."));
+        v << Def("Resume", true, Kind::Bool).group(gCalc).label(QObject::tr("Resume interrupted runs")).tip(QObject::tr("Continue from the checkpoint of an interrupted run of exactly the same job and model instead of starting over.")).dependsOn("Checkpoint");
+        v << Def("CheckpointInterval", 60, Kind::Int).group(gCalc).label(QObject::tr("Checkpoint interval (s)")).range(0, 1e6).dependsOn("Checkpoint");
+        v << Def("CheckpointMaxAge", 14, Kind::Int).group(gCalc).label(QObject::tr("Keep checkpoints (days)")).tip(QObject::tr("Checkpoints of runs that were not resumed within this time are removed.")).range(1, 3650).dependsOn("Checkpoint");
 
         // ---- Chart Settings ----
         v << Def("MaxSeriesPoints", 200, Kind::Int).group(gChart).note(QObject::tr("General Chart Settings:")).label(QObject::tr("Maximal number of visualised points per series.")).range(0, 2147483647).resetIfZero();
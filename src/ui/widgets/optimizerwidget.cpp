@@ -65,7 +65,9 @@ QJsonObject OptimizerWidget::Config() const
         /* Fit solver selection: "LevMar" = classic full-vector Levenberg-Marquardt (default, reference oracle);
            "VarPro" = variable-projection solver (only honoured by models with SupportsVarPro(), else LevMar).
            Round-trips the existing key so OptimizerSettings no longer silently drops the solver choice. Claude Generated. */
-        { "FitSolver", m_solver->currentText() },
+        { "FitSolver", m_solver->currentData().toString() },
+        { "BroydenRefresh", m_config.value("BroydenRefresh").toInt(5) },
+        { "FitCache", m_config.value("FitCache").toBool(true) },
 
         /* Speciation solver (LevMar/Newton vs. legacy BFGS) is chosen from the Fit menu, not here;
            round-trip it so applying this dialog does not silently reset the choice. Claude Generated. */
@@ -118,8 +120,12 @@ QWidget* OptimizerWidget::GeneralWidget()
     m_solver = new QComboBox;
     m_solver->addItem(tr("LevMar (classic)"), QStringLiteral("LevMar"));
     m_solver->addItem(tr("VarPro (projection)"), QStringLiteral("VarPro"));
+    m_solver->addItem(tr("VarPro + analytic Jacobian"), QStringLiteral("VarProAnalytic"));
+    m_solver->addItem(tr("Block LevMar (series structure)"), QStringLiteral("BlockLevMar"));
+    m_solver->addItem(tr("VarPro + Broyden updates"), QStringLiteral("VarProBroyden"));
+    m_solver->addItem(tr("Block LevMar + Broyden updates"), QStringLiteral("BlockLevMarBroyden"));
     const QString solver = m_config.value("FitSolver").toString(QStringLiteral("LevMar"));
-    m_solver->setCurrentIndex(solver == QLatin1String("VarPro") ? 1 : 0);
+    m_solver->setCurrentIndex(qMax(0, m_solver->findData(solver)));
 
     layout->addWidget(new QLabel(tr("Maximal No. of Iterations")), 0, 0);
     layout->addWidget(m_maxiter, 0, 1);
@@ -19,6 +19,7 @@
 
 #include <charts.h>
 
+#include "src/core/executioncontext.h"
 #include "src/core/models/AbstractModel.h"
 
 #include "src/core/phasetiming.h"
@@ -247,7 +248,7 @@ void ScatterWidget::MakePlot(int var_1, int var_2)
     m_xy_series = new QScatterSeries;
 
     QVector<CollectThread*> threads;
-    int thread_count = qApp->instance()->property("threads").toInt();
+    const int thread_count = m_model->Context().Threads();
     int step = m_models.size() / thread_count;
     QThreadPool* threadpool = QThreadPool::globalInstance();
     threadpool->setMaxThreadCount(thread_count);
@@ -35,6 +35,7 @@
 #include <QtCore/QDir>
 #include <QtCore/QList>
 #include <QtCore/QPointF>
+#include <QtCore/QSignalBlocker>
 #include <QtCore/QVector>
 
 #include <src/core/spectrahandler.h>
@@ -104,6 +105,18 @@ void SpectraWidget::setUI()
     m_values->setValue(5);
     m_varcovar = new QPushButton(tr("VarCovar"));
 
+    m_svd = new QCheckBox;
+    m_svd->setText(tr("Global (SVD)"));
+    m_svd->setToolTip(tr("Fit all wavelengths in the range through the scores of the leading abstract spectra instead of picked x values."));
+    m_svd->setChecked(false);
+
+    m_svd_components = new QSpinBox;
+    m_svd_components->setMinimum(0);
+    m_svd_components->setMaximum(50);
+    m_svd_components->setValue(0);
+    m_svd_components->setSpecialValueText(tr("auto"));
+    m_svd_components->setToolTip(tr("Number of abstract spectra; auto keeps 99.99 % of the signal."));
+
     QGridLayout* xlayout = new QGridLayout;
     xlayout->addWidget(m_add_xvalue, 0, 0);
     xlayout->addWidget(m_accept_x, 0, 1);
@@ -150,6 +163,8 @@ void SpectraWidget::setUI()
     chart_layout->addWidget(m_cluster, 0, 6);
     chart_layout->addWidget(m_averaged, 0, 7);
     chart_layout->addWidget(m_varcovar, 0, 8);
+    chart_layout->addWidget(m_svd, 0, 9);
+    chart_layout->addWidget(m_svd_components, 0, 10);
     m_spectra_view = new ChartView;
     m_spectra_view->setAutoScaleStrategy(AutoScaleStrategy::QtNiceNumbers);
     m_spectra_view->setVerticalLineEnabled(true);
@@ -159,7 +174,7 @@ void SpectraWidget::setUI()
     m_spectra_view->privateView()->setVerticalLinePrec(0);
     m_spectra_view->privateView()->setVerticalLinesPrec(-1);
 
-    chart_layout->addWidget(m_spectra_view, 1, 0, 1, 9);
+    chart_layout->addWidget(m_spectra_view, 1, 0, 1, 11);
 
     m_datatable = new DropTable;
 
@@ -217,6 +232,12 @@ void SpectraWidget::setUI()
         UpdateData();
     });
 
+    connect(m_svd, &QCheckBox::toggled, this, &SpectraWidget::UpdateData);
+    connect(m_svd_components, qOverload<int>(&QSpinBox::valueChanged), this, [this]() {
+        if (m_svd->isChecked())
+            UpdateData();
+    });
+
     connect(m_spectra_view, &ChartView::addRect, this, &SpectraWidget::UpdateXRange);
 
     connect(m_export_table, &QPushButton::clicked, this, &SpectraWidget::SaveToFile);
@@ -291,7 +312,12 @@ void SpectraWidget::PointDoubleClicked(const QPointF& point)
 
 void SpectraWidget::UpdateData()
 {
-    DataTable* data = qobject_cast<DataTable*>(m_handler->CompileSimpleTable());
+    DataTable* data = nullptr;
+    if (m_svd->isChecked()) {
+        m_handler->setXRange(m_x_start->value(), m_x_end->value());
+        data = m_handler->CompileCompressedTable(m_svd_components->value());
+    } else
+        data = qobject_cast<DataTable*>(m_handler->CompileSimpleTable());
     m_input_table = data->ExportTable(true);
     m_datatable->setModel(data);
     QPointer<DataTable> table = qobject_cast<DataTable*>(m_indep->model());
@@ -316,6 +342,12 @@ void SpectraWidget::setData(const QJsonObject& data)
     UpdateVerticaLines();
     for (auto d : m_handler->XValues())
         m_xvalues->addItem(QString::number(d));
+    {
+        const QSignalBlocker block_svd(m_svd), block_components(m_svd_components);
+        m_svd->setChecked(m_handler->Basis().isValid());
+        if (m_handler->Basis().isValid())
+            m_svd_components->setValue(m_handler->Basis().Components());
+    }
     UpdateData();
 }
 
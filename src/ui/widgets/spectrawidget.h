@@ -66,11 +66,11 @@ private:
     QSplitter *m_main_splitter, *m_list_splitter;
     QLineEdit* m_add_xvalue;
     QPushButton *m_accept_x, *m_varcovar, *m_export_table;
-    QSpinBox* m_values;
+    QSpinBox *m_values, *m_svd_components;
     QDoubleSpinBox *m_x_start, *m_x_end;
     SpectraHandler* m_handler;
     QJsonObject m_project, m_input_table;
-    QCheckBox *m_cluster, *m_averaged;
+    QCheckBox *m_cluster, *m_averaged, *m_svd;
 
     void UpdateXValues();
     void UpdateVerticaLines();